@@ -21,6 +21,15 @@ list(APPEND OCS2_CXX_FLAGS
   ${OpenMP_CXX_FLAGS}
   )
 
+# Solver tracing, see ocs2_core/misc/Tracing.h. To turn it on:
+#   catkin config --cmake-args -DOCS2_ENABLE_TRACING=ON
+option(OCS2_ENABLE_TRACING "Record trace events of the solvers" OFF)
+if (OCS2_ENABLE_TRACING)
+  list(APPEND OCS2_CXX_FLAGS
+    "-DOCS2_ENABLE_TRACING"
+    )
+endif (OCS2_ENABLE_TRACING)
+
 # Cpp standard version
 set(CMAKE_CXX_STANDARD 14)
 set(CMAKE_CXX_STANDARD_REQUIRED ON)
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/ComputationRequest.h>
 #include <ocs2_core/Types.h>
+#include <ocs2_core/reference/ReferenceCache.h>
 
 namespace ocs2 {
 
@@ -44,6 +45,9 @@ namespace ocs2 {
  * dynamics, cost and constraint terms, which can make use of the shared pre-computation.
  *
  * If pre-computation is not used, a default constructed PreComputation() can be passed to the getters.
+ *
+ * The solver may also attach the ReferenceCache of the current run, from which cost terms read the desired state and input
+ * at the nodes of the solver time grid instead of interpolating the TargetTrajectories.
  */
 class PreComputation {
  public:
@@ -65,9 +69,43 @@ class PreComputation {
   /** Request callback at final time */
   virtual void requestFinal(RequestSet request, scalar_t t, const vector_t& x) {}
 
+  /** Sets the reference cache of the current solver run. The cache is not owned; nullptr detaches it. */
+  void setReferenceCache(const ReferenceCache* referenceCachePtr) {
+    referenceCachePtr_ = referenceCachePtr;
+    referenceNodeHint_ = 0;
+  }
+
+  /** Returns the cached desired state at time t, or nullptr if no cache is attached or t is not a node of the cache. */
+  const vector_t* getCachedDesiredState(scalar_t t) const {
+    const int node = findReferenceNode(t);
+    return (node < 0) ? nullptr : &referenceCachePtr_->getDesiredState(node);
+  }
+
+  /** Returns the cached desired input at time t, or nullptr if no input is cached or t is not a node of the cache. */
+  const vector_t* getCachedDesiredInput(scalar_t t) const {
+    const int node = findReferenceNode(t);
+    return (node < 0 || !referenceCachePtr_->hasDesiredInput()) ? nullptr : &referenceCachePtr_->getDesiredInput(node);
+  }
+
  protected:
   /** Copy constructor */
   PreComputation(const PreComputation& other) = default;
+
+ private:
+  int findReferenceNode(scalar_t t) const {
+    if (referenceCachePtr_ == nullptr) {
+      return -1;
+    }
+    const int node = referenceCachePtr_->findNode(t, referenceNodeHint_);
+    if (node >= 0) {
+      referenceNodeHint_ = node;
+    }
+    return node;
+  }
+
+  const ReferenceCache* referenceCachePtr_ = nullptr;
+  // A PreComputation is used by a single thread at a time, so the lookup hint can be updated in the const getters.
+  mutable int referenceNodeHint_ = 0;
 };
 
 /** Helper to cast to const reference of derived class. */
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <Eigen/Core>
 
 // STL
+#include <memory>
 #include <string>
 
 // CppAD
@@ -45,6 +46,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+// forward declaration
+class CppAdModelBuilder;
+
 class CppAdInterface {
  public:
   enum class ApproximationOrder { Zero, First, Second };
@@ -82,7 +86,7 @@ class CppAdInterface {
   CppAdInterface(ad_function_t adFunction, size_t variableDim, std::string modelName, std::string folderName = "/tmp/ocs2",
                  std::vector<std::string> compileFlags = {"-O3", "-g", "-march=native", "-mtune=native", "-ffast-math"});
 
-  ~CppAdInterface() = default;
+  ~CppAdInterface();
 
   /**
    * Copy constructor. Models are reloaded if available.
@@ -100,7 +104,8 @@ class CppAdInterface {
   void loadModels(bool verbose = true);
 
   /**
-   * Creates models, compiles them, and saves them to disk
+   * Creates models, compiles them, and saves them to disk. The compilation is deferred to the CppAdModelBuilder if one is
+   * collecting models in the calling thread.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
@@ -108,7 +113,8 @@ class CppAdInterface {
   void createModels(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
   /**
-   * Load models if they are available on disk. Creates a new library otherwise.
+   * Load models if they are available on disk and were generated from the same tape, dimensions, compile flags, and
+   * approximation order. Creates a new library otherwise.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
@@ -165,7 +171,106 @@ class CppAdInterface {
    */
   matrix_t getHessian(const vector_t& w, const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Batched evaluation of the function at N points. The outputs are only resized if they do not have the right size, such that
+   * preallocated outputs are reused.
+   *
+   * @param [in] x : variableDim x N matrix with the points in the columns
+   * @param [in] p : parameterDim x N matrix with the parameters of each point, or a single column shared by all points.
+   * @param [out] y : rangeDim x N matrix with f(x_i, p_i) in the i-th column
+   */
+  void getFunctionValues(const matrix_t& x, const matrix_t& p, matrix_t& y) const;
+
+  /**
+   * Batched Jacobians at N points, see getFunctionValues.
+   *
+   * @param [in] x : variableDim x N matrix with the points in the columns
+   * @param [in] p : parameterDim x N matrix with the parameters of each point, or a single column shared by all points.
+   * @param [out] jacobians : rangeDim x (N * variableDim) matrix, the i-th block of variableDim columns is d/dx( f(x_i, p_i) )
+   */
+  void getJacobians(const matrix_t& x, const matrix_t& p, matrix_t& jacobians) const;
+
+  /**
+   * Batched Gauss-Newton approximations at N points, see getFunctionValues and getGaussNewtonApproximation.
+   *
+   * @param [in] x : variableDim x N matrix with the points in the columns
+   * @param [in] p : parameterDim x N matrix with the parameters of each point, or a single column shared by all points.
+   * @param [out] gnApproximations : N approximations
+   */
+  void getGaussNewtonApproximations(const matrix_t& x, const matrix_t& p,
+                                    std::vector<ScalarFunctionQuadraticApproximation>& gnApproximations) const;
+
+  /**
+   * Batched weighted Hessians at N points, see getFunctionValues.
+   *
+   * @param [in] w : rangeDim x N matrix with the weights of each point, or a single column shared by all points.
+   * @param [in] x : variableDim x N matrix with the points in the columns
+   * @param [in] p : parameterDim x N matrix with the parameters of each point, or a single column shared by all points.
+   * @param [out] hessians : variableDim x (N * variableDim) matrix, the i-th block of variableDim columns is
+   * dd/dxdx( sum_j w_ji * f_j(x_i, p_i) )
+   */
+  void getHessians(const matrix_t& w, const matrix_t& x, const matrix_t& p, matrix_t& hessians) const;
+
  private:
+  friend class CppAdModelBuilder;
+
+  /** The recorded tape and the generated sources of a model that still has to be compiled. */
+  struct ModelSources;
+
+  /**
+   * Records the tape of the function and computes its hash.
+   * @param approximationOrder : Order of derivatives to generate
+   * @return the tape and its hash, the sources are not generated yet.
+   */
+  std::unique_ptr<ModelSources> recordModel(ApproximationOrder approximationOrder);
+
+  /**
+   * Generates the C sources of the recorded tape.
+   * @param modelSources : the recorded tape.
+   * @param verbose : Print out extra information
+   */
+  void generateSources(ModelSources& modelSources, bool verbose);
+
+  /**
+   * Compiles the generated sources to the shared library and stores the hash next to it. This function does not use CppAD
+   * and is therefore safe to call concurrently for different models.
+   * @param modelSources : the generated sources.
+   * @param verbose : Print out extra information
+   */
+  void compileSources(ModelSources& modelSources, bool verbose) const;
+
+  /**
+   * Generates and compiles the library from the recorded tape and loads it, or hands it over to the active model builder.
+   * @param modelSources : the recorded tape.
+   * @param verbose : Print out extra information
+   */
+  void createModels(std::unique_ptr<ModelSources> modelSources, bool verbose);
+
+  /**
+   * Compiles the sources that wait for the model builder. Safe to call concurrently for different models.
+   * @param verbose : Print out extra information
+   */
+  void compilePendingModel(bool verbose) const;
+
+  /**
+   * Unregisters from the model builder and releases the sources that wait for compilation.
+   */
+  void discardPendingModel();
+
+  /**
+   * Reads the hash of the library on disk.
+   * @return the hash, or an empty string if no hash is stored.
+   */
+  std::string readLibraryHash() const;
+
+  /**
+   * Hashes the operation sequence of the tape together with the dimensions, the compile flags, and the approximation order.
+   * @param fun : taped ad function
+   * @param approximationOrder : Order of derivatives to generate
+   * @return hash as hexadecimal string
+   */
+  std::string getTapeHash(ad_fun_t& fun, ApproximationOrder approximationOrder) const;
+
   /**
    * Defines library folder names
    */
@@ -207,6 +312,25 @@ class CppAdInterface {
    */
   void setSparsityNonzeros();
 
+  /**
+   * Concatenates the i-th point of a batch.
+   * @param [in] x : variableDim x N points
+   * @param [in] p : parameterDim x N parameters, or a single column shared by all points
+   * @param [in] i : index of the point
+   * @param [out] xp : concatenated point and parameter
+   */
+  void setBatchPoint(const matrix_t& x, const matrix_t& p, size_t i, vector_t& xp) const;
+
+  /**
+   * Gauss-Newton approximation at the concatenated point and parameter xp.
+   * @param [in] xp : concatenated point and parameter
+   * @param [in, out] value : buffer of size rangeDim for the function value
+   * @param [in, out] sparseJacobian : buffer of size nnzJacobian for the Jacobian
+   * @param [out] gnApprox : the approximation, resized if necessary
+   */
+  void computeGaussNewtonApproximation(const vector_t& xp, vector_t& value, std::vector<scalar_t>& sparseJacobian,
+                                       ScalarFunctionQuadraticApproximation& gnApprox) const;
+
   /**
    * Creates sparsity pattern for the Jacobian that will be generated
    * @param fun : taped ad function
@@ -240,6 +364,11 @@ class CppAdInterface {
   std::string tmpName_;
   std::string tmpFolder_;
   std::string libraryName_;
+  const char* traceName_ = nullptr;  // modelName_ for OCS2_TRACE_SCOPE
+
+  // Deferred compilation
+  CppAdModelBuilder* modelBuilderPtr_ = nullptr;
+  std::unique_ptr<ModelSources> pendingModelSources_;
 };
 
 }  // namespace ocs2
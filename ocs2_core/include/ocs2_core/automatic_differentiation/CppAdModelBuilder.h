@@ -0,0 +1,125 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+/**
+ * Builds the libraries of many CppAdInterfaces at once.
+ *
+ * Recording the tape and generating the sources use CppAD, which is not thread safe, and therefore happen in the calling thread.
+ * Only the compilation of the outdated libraries is deferred and runs in parallel on build(). Libraries that are up to date with
+ * the recorded tape are loaded right away.
+ *
+ * While the builder is collecting, all calls to CppAdInterface::createModels and CppAdInterface::loadModelsIfAvailable from
+ * the collecting thread defer their compilation to the builder. This allows building all the models of a robot interface by
+ * constructing the interface in between startCollecting() and build(). The models of a deferred CppAdInterface can not be
+ * evaluated before build() returns.
+ *
+ * Usage:
+ *   CppAdModelBuilder modelBuilder(nThreads);
+ *   modelBuilder.startCollecting();
+ *   RobotInterface robotInterface(taskFile, libraryFolder, urdfFile);
+ *   modelBuilder.build();
+ */
+class CppAdModelBuilder {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] nThreads: Number of threads used for the compilation, including the calling thread.
+   * @param [in] threadPriority: The priority of the compilation threads.
+   */
+  explicit CppAdModelBuilder(size_t nThreads = 1, int threadPriority = 0);
+
+  /**
+   * Destructor. Stops collecting. The libraries that have not been built yet are discarded.
+   */
+  ~CppAdModelBuilder();
+
+  CppAdModelBuilder(const CppAdModelBuilder&) = delete;
+  CppAdModelBuilder& operator=(const CppAdModelBuilder&) = delete;
+
+  /**
+   * Starts deferring the compilation of all models created or loaded in the calling thread until build() is called. Only one
+   * builder can collect per thread.
+   */
+  void startCollecting();
+
+  /**
+   * Stops deferring the compilation of the models created or loaded in the calling thread.
+   */
+  void stopCollecting();
+
+  /**
+   * Loads the library of the model if it is up to date, defers its compilation to build() otherwise.
+   *
+   * @param [in] adInterface: The model. It should stay alive until build() returns.
+   * @param [in] approximationOrder: Order of derivatives to generate.
+   * @param [in] verbose: Print out extra information.
+   */
+  void add(CppAdInterface& adInterface, CppAdInterface::ApproximationOrder approximationOrder = CppAdInterface::ApproximationOrder::Second,
+           bool verbose = true);
+
+  /**
+   * Stops collecting, compiles the deferred libraries in parallel and loads them.
+   *
+   * @return The number of compiled libraries.
+   */
+  size_t build();
+
+  /** Number of libraries waiting for build(). */
+  size_t getNumPendingModels() const { return pendingModels_.size(); }
+
+ private:
+  friend class CppAdInterface;
+
+  /** The builder that collects the models of the calling thread, nullptr if none. */
+  static CppAdModelBuilder*& collectingModelBuilder();
+
+  /** Registers a model with generated sources for compilation. */
+  void defer(CppAdInterface& adInterface, bool verbose);
+
+  /** Unregisters a model, its sources are discarded. */
+  void remove(CppAdInterface& adInterface);
+
+  std::vector<std::pair<CppAdInterface*, bool>> pendingModels_;  // the models and their verbose flag
+  size_t nThreads_;
+  ThreadPool threadPool_;
+};
+
+}  // namespace ocs2
@@ -55,6 +55,9 @@ class StateConstraintCollection : public Collection<StateConstraint> {
   /** Returns the number of active constraints at a given time for each term. If a term is inactive, its size is zero. */
   size_array_t getTermsSize(scalar_t time) const;
 
+  /** In-place variant of getTermsSize, which reuses the memory of the given array. */
+  void getTermsSize(scalar_t time, size_array_t& termsSize) const;
+
   /** Get an array of all constraints. If a term is inactive, the corresponding element is a vector of size zero. */
   virtual vector_array_t getValue(scalar_t time, const vector_t& state, const PreComputation& preComp) const;
 
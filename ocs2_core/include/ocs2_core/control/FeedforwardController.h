@@ -110,6 +110,10 @@ class FeedforwardController final : public ControllerBase {
   scalar_array_t timeStamp_;
   vector_array_t uffArray_;
 
+ private:
+  /** Caches the last visited interval of timeStamp_ for sequential calls of computeInput */
+  LinearInterpolation::TimeSegmentCursor timeSegmentCursor_;
+
   friend void swap(FeedforwardController& a, FeedforwardController& b) noexcept;
 };
 
@@ -79,6 +79,8 @@ class LinearController final : public ControllerBase {
 
   vector_t computeInput(scalar_t t, const vector_t& x) override;
 
+  void computeInputInPlace(scalar_t t, const vector_t& x, vector_t& u) override;
+
   void concatenate(const ControllerBase* nextController, int index, int length) override;
 
   int size() const override;
@@ -111,6 +113,12 @@ class LinearController final : public ControllerBase {
   vector_array_t deltaBiasArray_;
   matrix_array_t gainArray_;
 
+ private:
+  /** Caches the last visited interval of timeStamp_ for sequential calls of computeInput */
+  LinearInterpolation::TimeSegmentCursor timeSegmentCursor_;
+  /** Storage of the interpolated gain, such that computeInputInPlace does not allocate */
+  matrix_t gainWorkspace_;
+
   friend void swap(LinearController& a, LinearController& b) noexcept;
 };
 
@@ -60,6 +60,11 @@ class QuadraticStateCost : public StateCost {
    * This method can be overwritten if desiredTrajectory has a different dimensions. */
   virtual vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const;
 
+  /** Computes the state deviation with access to the preComputation, e.g. to read the reference cache.
+   * The default implementation forwards to getStateDeviation() without preComputation. */
+  virtual vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                     const PreComputation& preComputation) const;
+
  private:
   matrix_t Q_;
 };
@@ -66,6 +66,12 @@ class QuadraticStateInputCost : public StateInputCost {
   virtual std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                const TargetTrajectories& targetTrajectories) const;
 
+  /** Computes the state-input deviation pair with access to the preComputation, e.g. to read the reference cache.
+   * The default implementation forwards to getStateInputDeviation() without preComputation. */
+  virtual std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                               const TargetTrajectories& targetTrajectories,
+                                                               const PreComputation& preComputation) const;
+
  private:
   matrix_t Q_;
   matrix_t R_;
@@ -92,6 +92,21 @@ class ControlledSystemBase : public OdeBase {
    */
   virtual vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp) = 0;
 
+  /**
+   * Computes the flow map of a system with exogenous input into a given vector, which reuses its memory if it has the right size.
+   *
+   * @note The default implementation calls the virtual computeFlowMap(). Systems which can write their flow map without temporaries
+   *       should override it, such that the discretizations of the multiple shooting solvers do not allocate.
+   *
+   * @param [in] t: The current time.
+   * @param [in] x: The current state.
+   * @param [in] u: The current input.
+   * @param [in] preComp: pre-computation module, safely ignore this parameter if not used.
+   *                      @see PreComputation class documentation.
+   * @param [out] dxdt: The state time derivative.
+   */
+  virtual void computeFlowMapInPlace(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp, vector_t& dxdt);
+
   /**
    * State map at the transition time
    *
@@ -112,6 +127,29 @@ class ControlledSystemBase : public OdeBase {
    */
   vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u);
 
+  /**
+   * Computes the flow map of a system with exogenous input into a given vector.
+   *
+   * @note This method calls the internal preComputation request() callback and the virtual
+   *       computeFlowMapInPlace() with the preComputation as parameter.
+   *       This interface is used by SensitivityIntegrator.
+   */
+  void computeFlowMapInPlace(scalar_t t, const vector_t& x, const vector_t& u, vector_t& dxdt);
+
+  /**
+   * Computes the flow maps of a batch of state-input pairs at the same time.
+   *
+   * @note The default implementation calls computeFlowMapInPlace(t, x, u, dxdt) for each column. Systems whose flow map can be written
+   *       as matrix products should override it to evaluate the whole batch at once.
+   *       This interface is used by BatchRollout.
+   *
+   * @param [in] t: The current time.
+   * @param [in] x: The states, one per column.
+   * @param [in] u: The inputs, one per column.
+   * @param [out] dxdt: The state time derivatives, one per column.
+   */
+  virtual void computeFlowMapBatch(scalar_t t, const matrix_t& x, const matrix_t& u, matrix_t& dxdt);
+
   /**
    * State map at the transition time
    *
@@ -52,12 +52,22 @@ class LinearSystemDynamics : public SystemDynamicsBase {
 
   vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) override;
 
+  void computeFlowMapBatch(scalar_t t, const matrix_t& x, const matrix_t& u, matrix_t& dxdt) override;
+
   vector_t computeJumpMap(scalar_t t, const vector_t& x, const PreComputation&) override;
 
   VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) override;
 
   VectorFunctionLinearApproximation jumpMapLinearApproximation(scalar_t t, const vector_t& x, const PreComputation&) override;
 
+  void computeFlowMapInPlace(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&, vector_t& dxdt) override;
+
+  void linearApproximationInPlace(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&,
+                                  VectorFunctionLinearApproximation& approximation) override;
+
+  void jumpMapLinearApproximationInPlace(scalar_t t, const vector_t& x, const PreComputation&,
+                                         VectorFunctionLinearApproximation& approximation) override;
+
  protected:
   LinearSystemDynamics(const LinearSystemDynamics& other) = default;
 
@@ -80,6 +80,35 @@ class SystemDynamicsBase : public ControlledSystemBase {
    */
   virtual VectorFunctionLinearApproximation jumpMapLinearApproximation(scalar_t t, const vector_t& x, const PreComputation& preComp);
 
+  /**
+   * Computes the linear approximation into a given approximation, which reuses its memory if it has the right size.
+   *
+   * @note The default implementation calls the virtual linearApproximation(). Systems which can write their approximation without
+   *       temporaries should override it, such that the discretizations of the multiple shooting solvers do not allocate.
+   *
+   * @param [in] t: The current time.
+   * @param [in] x: The current state.
+   * @param [in] u: The current input.
+   * @param [in] preComp: pre-computation module, safely ignore this parameter if not used.
+   *                      @see PreComputation class documentation.
+   * @param [out] approximation: The state time derivative linear approximation.
+   */
+  virtual void linearApproximationInPlace(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp,
+                                          VectorFunctionLinearApproximation& approximation);
+
+  /**
+   * Computes the jump map linear approximation into a given approximation. The default implementation calls the virtual
+   * jumpMapLinearApproximation().
+   *
+   * @param [in] t: The current time.
+   * @param [in] x: The current state.
+   * @param [in] preComp: pre-computation module, safely ignore this parameter if not used.
+   *                      @see PreComputation class documentation.
+   * @param [out] approximation: The linear approximation of the mapped state after transition
+   */
+  virtual void jumpMapLinearApproximationInPlace(scalar_t t, const vector_t& x, const PreComputation& preComp,
+                                                 VectorFunctionLinearApproximation& approximation);
+
   /** Computes the guard surfaces linear approximation */
   virtual VectorFunctionLinearApproximation guardSurfacesLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u);
 
@@ -129,6 +158,23 @@ class SystemDynamicsBase : public ControlledSystemBase {
    */
   VectorFunctionLinearApproximation jumpMapLinearApproximation(scalar_t t, const vector_t& x);
 
+  /**
+   * Computes the flow map linear approximation into a given approximation.
+   *
+   * @note This method updates the internal preComputation with the request() callback and passes it
+   *       to the virtual linearApproximationInPlace() with the preComputation parameter.
+   *       This interface is used by SensitivityIntegrator.
+   */
+  void linearApproximationInPlace(scalar_t t, const vector_t& x, const vector_t& u, VectorFunctionLinearApproximation& approximation);
+
+  /**
+   * Computes the jump map linear approximation into a given approximation.
+   *
+   * @note This method updates the internal preComputation with the requestPreJump() callback and
+   *       passes it to the virtual jumpMapLinearApproximationInPlace() with the preComputation parameter.
+   */
+  void jumpMapLinearApproximationInPlace(scalar_t t, const vector_t& x, VectorFunctionLinearApproximation& approximation);
+
  protected:
   /** Copy constructor */
   SystemDynamicsBase(const SystemDynamicsBase& other);
@@ -87,4 +87,28 @@ using DynamicsSensitivityDiscretizer =
  */
 DynamicsSensitivityDiscretizer selectDynamicsSensitivityDiscretization(SensitivityIntegratorType integratorType);
 
+/**
+ * In-place counterpart of DynamicsDiscretizer: x_{k+1} is written to the last argument, which reuses its memory if it has the right size.
+ * The last argument must not alias x.
+ */
+using DynamicsDiscretizerInPlace =
+    std::function<void(SystemDynamicsBase&, scalar_t, const vector_t&, const vector_t&, scalar_t, vector_t&)>;
+
+/**
+ * Select available in-place integrator based on enum
+ */
+DynamicsDiscretizerInPlace selectDynamicsDiscretizationInPlace(SensitivityIntegratorType integratorType);
+
+/**
+ * In-place counterpart of DynamicsSensitivityDiscretizer: the approximation is written to the last argument, which reuses its memory if it
+ * has the right size.
+ */
+using DynamicsSensitivityDiscretizerInPlace =
+    std::function<void(SystemDynamicsBase&, scalar_t, const vector_t&, const vector_t&, scalar_t, VectorFunctionLinearApproximation&)>;
+
+/**
+ * Select available in-place integrator based on enum
+ */
+DynamicsSensitivityDiscretizerInPlace selectDynamicsSensitivityDiscretizationInPlace(SensitivityIntegratorType integratorType);
+
 }  // namespace ocs2
\ No newline at end of file
@@ -76,4 +76,19 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt);
 
+/**
+ * In-place variants of the discretizations above. The result is written to the last argument, which must not alias x. The intermediate
+ * stages are kept in a scratch memory of the calling thread, such that the discretizations do not allocate once the sizes are settled,
+ * provided that the system overrides computeFlowMapInPlace() and linearApproximationInPlace().
+ */
+void eulerDiscretizationInPlace(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt, vector_t& xNext);
+void eulerSensitivityDiscretizationInPlace(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                           VectorFunctionLinearApproximation& approximation);
+void rk2DiscretizationInPlace(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt, vector_t& xNext);
+void rk2SensitivityDiscretizationInPlace(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                         VectorFunctionLinearApproximation& approximation);
+void rk4DiscretizationInPlace(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt, vector_t& xNext);
+void rk4SensitivityDiscretizationInPlace(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                         VectorFunctionLinearApproximation& approximation);
+
 }  // namespace ocs2
\ No newline at end of file
@@ -35,6 +35,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <unordered_map>
 #include <vector>
 
+#include "ocs2_core/misc/Tracing.h"
+
 namespace ocs2 {
 
 /**
@@ -101,12 +103,17 @@ class Collection {
   /** Copy constructor */
   Collection(const Collection& other);
 
+  /** Name of a term for OCS2_TRACE_SCOPE. The argument must be an element of terms_. */
+  const char* getTermTraceName(const std::unique_ptr<T>& term) const { return termTraceNames_[&term - terms_.data()]; }
+
   //! Contains all terms in the order they were added
   std::vector<std::unique_ptr<T>> terms_;
 
  private:
   //! Lookup from cost term name to index in the cost term vector
   std::unordered_map<std::string, size_t> termNameMap_;
+  //! Term names for tracing in the order of terms_, nullptr if tracing is disabled
+  std::vector<const char*> termTraceNames_;
 };
 
 /******************************************************************************************************/
@@ -116,6 +123,7 @@ template <typename T>
 void Collection<T>::clear() {
   terms_.clear();
   termNameMap_.clear();
+  termTraceNames_.clear();
 }
 
 /******************************************************************************************************/
@@ -127,6 +135,7 @@ void Collection<T>::add(std::string name, std::unique_ptr<T> term) {
   auto info = termNameMap_.emplace(std::move(name), nextIndex);
   if (info.second) {
     terms_.push_back(std::move(term));
+    termTraceNames_.push_back(OCS2_TRACE_NAME(info.first->first));
   } else {
     throw std::runtime_error(std::string("[Collection::add] Term with name \"") + info.first->first + "\" already exists");
   }
@@ -160,6 +169,7 @@ std::unique_ptr<T> Collection<T>::extract(const std::string& name) {
   auto term = (std::move(terms_[termInd]));
   // remove the term
   terms_.erase(terms_.begin() + termInd);
+  termTraceNames_.erase(termTraceNames_.begin() + termInd);
 
   return term;
 }
@@ -180,7 +190,7 @@ Derived& Collection<T>::get(const std::string& name) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 template <typename T>
-Collection<T>::Collection(const Collection& other) : termNameMap_(other.termNameMap_) {
+Collection<T>::Collection(const Collection& other) : termNameMap_(other.termNameMap_), termTraceNames_(other.termTraceNames_) {
   // Loop through all terms and clone. The name map can be copied directly because the order stays the same.
   terms_.reserve(other.terms_.size());
   for (const auto& term : other.terms_) {
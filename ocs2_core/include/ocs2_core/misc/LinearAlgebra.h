@@ -139,6 +139,42 @@ std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(co
 std::pair<VectorFunctionLinearApproximation, matrix_t> luConstraintProjection(const VectorFunctionLinearApproximation& constraint,
                                                                               bool extractPseudoInverse = false);
 
+/**
+ * Memory of the decompositions and intermediate results of the in-place constraint projections. Reusing it for constraints of the same
+ * size makes the projection allocation-free.
+ */
+struct ConstraintProjectionWorkspace {
+  Eigen::HouseholderQR<matrix_t> qr;
+  matrix_t Q;
+  vector_t householderWorkspace;
+  Eigen::FullPivLU<matrix_t> lu;
+  matrix_t luSolution;
+  matrix_t luKernel;
+  std::vector<Eigen::Index> luPivots;
+};
+
+/**
+ * In-place variant of qrConstraintProjection.
+ *
+ * @param [in] constraint : C = dfdx, D = dfdu, e = f;
+ * @param [out] projectionTerms : Projection terms Px = dfdx, Pu = dfdu, Pe = f.
+ * @param [out] pseudoInverse : Left pseudo-inverse of D^T.
+ * @param [in, out] workspace : Memory of the decomposition.
+ */
+void qrConstraintProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projectionTerms,
+                            matrix_t& pseudoInverse, ConstraintProjectionWorkspace& workspace);
+
+/**
+ * In-place variant of luConstraintProjection. The kernel and the solution are evaluated as by Eigen::FullPivLU, but with their
+ * intermediate results in the workspace.
+ *
+ * @param [in] constraint : C = dfdx, D = dfdu, e = f;
+ * @param [out] projectionTerms : Projection terms Px = dfdx, Pu = dfdu, Pe = f.
+ * @param [in, out] workspace : Memory of the decomposition.
+ */
+void luConstraintProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projectionTerms,
+                            ConstraintProjectionWorkspace& workspace);
+
 /** Computes the rank of a matrix */
 template <typename Derived>
 int rank(const Derived& A) {
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -53,6 +54,59 @@ using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>
  */
 index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
 
+/**
+ * Stateful version of timeSegment() for enquiry times that sweep the time array (almost) monotonically, such as the
+ * integration steps of a rollout or a high-rate MRT evaluating the same policy. The interval of the previous query is
+ * used as a hint: the search first walks a few intervals from there and only falls back to a binary search on the
+ * remaining part of the array. The result is always identical to timeSegment(), the hint only affects the cost.
+ *
+ * @note The hint is stored in a relaxed atomic such that sharing a cursor between threads is well defined.
+ */
+class TimeSegmentCursor {
+ public:
+  TimeSegmentCursor() = default;
+  TimeSegmentCursor(const TimeSegmentCursor& other) : hint_(other.hint_.load(std::memory_order_relaxed)) {}
+  TimeSegmentCursor& operator=(const TimeSegmentCursor& other) {
+    hint_.store(other.hint_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+  }
+
+  /**
+   * Get the interval index and interpolation coefficient alpha. See timeSegment().
+   *
+   * @param [in] enquiryTime: The enquiry time for interpolation.
+   * @param [in] timeArray: interpolation time array.
+   * @return {index, alpha}
+   */
+  index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
+
+  /** Forgets the last visited interval. */
+  void reset() { hint_.store(0, std::memory_order_relaxed); }
+
+ private:
+  /** Number of intervals that are visited linearly before falling back to a binary search. */
+  static constexpr int maxNumLinearSteps_ = 2;
+
+  std::atomic<int> hint_{0};
+};
+
+/**
+ * Fused evaluation of the interpolated affine function: result = b(t) + K(t) * x. The result is identical to
+ * interpolate(indexAlpha, biasArray) + interpolate(indexAlpha, gainArray) * x, but it is written into the given vector and
+ * the interpolated bias is blended directly into it. When alpha is 0 or 1 only one node is evaluated. Otherwise the interpolated
+ * gain is blended into gainWorkspace before the product, as in interpolate(), to keep the rounding unchanged. Once the workspace
+ * and the result have the right sizes, the evaluation does not allocate.
+ *
+ * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair
+ * @param [in] biasArray: vector of biases b
+ * @param [in] gainArray: vector of gains K
+ * @param [in] x: The argument of the affine function.
+ * @param [out] result: The interpolated affine function evaluated at x.
+ * @param [out] gainWorkspace: Storage of the interpolated gain, reused between calls.
+ */
+void interpolateAffine(index_alpha_t indexAlpha, const vector_array_t& biasArray, const matrix_array_t& gainArray, const vector_t& x,
+                       vector_t& result, matrix_t& gainWorkspace);
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
@@ -0,0 +1,161 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ocs2_core/Types.h"
+
+/**
+ * Low overhead tracing of scoped events, e.g. the phases of a solver iteration, the evaluation of a cost term or a thread pool task.
+ *
+ * Every thread records its completed events into its own fixed size ring buffer, so recording takes no lock. The recorded events can
+ * be exported in the Chrome trace event format (chrome://tracing, https://ui.perfetto.dev) or summarized into latency histograms.
+ *
+ * Tracing is compiled in with the OCS2_ENABLE_TRACING definition (cmake option of the same name). Otherwise the OCS2_TRACE_*
+ * macros expand to nothing and their arguments are not evaluated.
+ *
+ * The event category and name are stored as pointers. They must be string literals or strings returned by OCS2_TRACE_NAME.
+ */
+#ifdef OCS2_ENABLE_TRACING
+#define OCS2_TRACE_CONCAT_IMPL(a, b) a##b
+#define OCS2_TRACE_CONCAT(a, b) OCS2_TRACE_CONCAT_IMPL(a, b)
+/** Records the enclosing scope as an event */
+#define OCS2_TRACE_SCOPE(category, name) \
+  const ::ocs2::tracing::ScopedEvent OCS2_TRACE_CONCAT(ocs2TraceScopedEvent, __LINE__)(category, name)
+/** Records the enclosing scope as an event with an index, e.g. the node index */
+#define OCS2_TRACE_SCOPE_INDEX(category, name, index) \
+  const ::ocs2::tracing::ScopedEvent OCS2_TRACE_CONCAT(ocs2TraceScopedEvent, __LINE__)(category, name, index)
+/** Returns a pointer to a persistent copy of a std::string that can be used as an event name, nullptr if tracing is disabled */
+#define OCS2_TRACE_NAME(name) ::ocs2::tracing::internName(name)
+/** Sets the name of the calling thread in the exported trace */
+#define OCS2_TRACE_THREAD_NAME(name) ::ocs2::tracing::setThreadName(name)
+#else
+#define OCS2_TRACE_SCOPE(category, name)
+#define OCS2_TRACE_SCOPE_INDEX(category, name, index)
+#define OCS2_TRACE_NAME(name) nullptr
+#define OCS2_TRACE_THREAD_NAME(name)
+#endif
+
+namespace ocs2 {
+namespace tracing {
+
+/** A completed event */
+struct Event {
+  const char* category;
+  const char* name;
+  int index;          // user defined index, e.g. the node index. -1 if not set.
+  int64_t startTime;  // [ns] since the first use of the tracing clock
+  int64_t duration;   // [ns]
+};
+
+/** Latency statistics of all recorded events with the same category and name */
+struct LatencyHistogram {
+  /** Number of logarithmic buckets, bucket k counts the durations in [2^(k-1), 2^k) microseconds and bucket 0 those below 1 us */
+  static constexpr size_t numBuckets = 24;
+
+  std::string category;
+  std::string name;
+  size_t count = 0;
+  scalar_t totalInMicroseconds = 0.0;
+  scalar_t minInMicroseconds = 0.0;
+  scalar_t maxInMicroseconds = 0.0;
+  std::array<size_t, numBuckets> buckets{};
+
+  scalar_t getAverageInMicroseconds() const { return (count > 0) ? totalInMicroseconds / count : 0.0; }
+
+  /**
+   * Upper bound of the requested percentile, resolved to the bucket boundaries.
+   * @param [in] percentile: in [0, 100].
+   */
+  scalar_t getPercentileInMicroseconds(scalar_t percentile) const;
+};
+
+/** Whether recording is active. It is active by default if compiled with OCS2_ENABLE_TRACING. */
+bool isEnabled();
+
+/** Activates or deactivates the recording at runtime. Has no effect if compiled without OCS2_ENABLE_TRACING. */
+void setEnabled(bool enabled);
+
+/** The tracing clock [ns] */
+int64_t now();
+
+/** Records a completed event in the ring buffer of the calling thread. */
+void record(const char* category, const char* name, int index, int64_t startTime, int64_t endTime);
+
+/** Returns a pointer to a copy of the name that stays valid until the end of the program. Equal names return the same pointer. */
+const char* internName(const std::string& name);
+
+/** Sets the name of the calling thread in the exported trace */
+void setThreadName(const std::string& name);
+
+/** Returns the recorded events of all threads, ordered by thread. Only call while no traced code is running. */
+std::vector<std::pair<std::string, std::vector<Event>>> getEvents();
+
+/** Removes all recorded events. Only call while no traced code is running. */
+void clear();
+
+/** Writes the recorded events in the Chrome trace event (JSON) format. Only call while no traced code is running. */
+void exportChromeTrace(std::ostream& stream);
+
+/** Writes the recorded events in the Chrome trace event (JSON) format to a file. Only call while no traced code is running. */
+void exportChromeTrace(const std::string& fileName);
+
+/** Latency histograms of the recorded events per category and name. Only call while no traced code is running. */
+std::vector<LatencyHistogram> getLatencyHistograms();
+
+/** Records the lifetime of the object as an event. Use through the OCS2_TRACE_SCOPE macros. */
+class ScopedEvent {
+ public:
+  ScopedEvent(const char* category, const char* name, int index = -1)
+      : category_(category), name_(name), index_(index), startTime_(isEnabled() ? now() : -1) {}
+
+  ~ScopedEvent() {
+    if (startTime_ >= 0) {
+      record(category_, name_, index_, startTime_, now());
+    }
+  }
+
+  ScopedEvent(const ScopedEvent&) = delete;
+  ScopedEvent& operator=(const ScopedEvent&) = delete;
+
+ private:
+  const char* category_;
+  const char* name_;
+  int index_;
+  int64_t startTime_;
+};
+
+}  // namespace tracing
+}  // namespace ocs2
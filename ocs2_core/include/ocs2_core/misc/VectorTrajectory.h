@@ -0,0 +1,139 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+namespace ocs2 {
+
+/**
+ * A trajectory of vectors that is stored in a single contiguous allocation, as an alternative to vector_array_t (one heap
+ * block per node) for loops that sweep over whole trajectories.
+ *
+ * Each node can have a different dimension (e.g. no input at event nodes) and is accessed through an Eigen::Map. Every
+ * node starts on a cache line boundary such that threads that write to different nodes do not share cache lines. The
+ * padding between the nodes is kept at zero, therefore the flat view of the storage can be used for element-wise operations
+ * and norms over the whole trajectory at once.
+ *
+ * @note Only the iterates of PipgSolver use this container. The SQP and IPM solvers and PrimalSolution keep vector_array_t,
+ *       since their trajectories are exchanged node-wise with HPIPM, the controllers and the ROS conversions. There are no
+ *       adapters for them, use assign() and toArray() where a conversion is needed.
+ */
+class VectorTrajectory {
+ public:
+  using node_t = Eigen::Map<vector_t, Eigen::Aligned16>;
+  using const_node_t = Eigen::Map<const vector_t, Eigen::Aligned16>;
+
+  /** Constructor, an empty trajectory */
+  VectorTrajectory() = default;
+
+  /** Constructor, a zero trajectory with the given node dimensions */
+  explicit VectorTrajectory(const std::vector<int>& sizes) { resize(sizes); }
+
+  /** Constructor, copies the content of a vector_array_t */
+  explicit VectorTrajectory(const vector_array_t& array) { assign(array); }
+
+  /** Copy constructor */
+  VectorTrajectory(const VectorTrajectory& other);
+
+  /** Move constructor */
+  VectorTrajectory(VectorTrajectory&& other) noexcept { swap(other); }
+
+  /** Copy and move assignment (copy and swap idiom) */
+  VectorTrajectory& operator=(VectorTrajectory other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  /** Destructor */
+  ~VectorTrajectory() = default;
+
+  /** Number of nodes */
+  size_t size() const { return sizes_.size(); }
+
+  /** Checks if the trajectory has no nodes */
+  bool empty() const { return sizes_.empty(); }
+
+  /** Dimensions of the nodes */
+  const std::vector<int>& sizes() const { return sizes_; }
+
+  /** Checks if the other trajectory has the same node dimensions */
+  bool hasSameLayout(const VectorTrajectory& other) const { return sizes_ == other.sizes_; }
+
+  /**
+   * Sets the node dimensions and sets all values to zero. The storage is only reallocated if it is too small.
+   * @param [in] sizes: Dimensions of the nodes.
+   */
+  void resize(const std::vector<int>& sizes);
+
+  /** Sets all values to zero */
+  void setZero() { flat().setZero(); }
+
+  /** Access to node i */
+  node_t operator[](size_t i) { return node_t(data_ + offsets_[i], sizes_[i]); }
+  const_node_t operator[](size_t i) const { return const_node_t(data_ + offsets_[i], sizes_[i]); }
+
+  /** A flat view of all nodes including the zero padding between them */
+  node_t flat() { return node_t(data_, offsets_.empty() ? 0 : offsets_.back()); }
+  const_node_t flat() const { return const_node_t(data_, offsets_.empty() ? 0 : offsets_.back()); }
+
+  /** Resizes the trajectory to the dimensions of the array and copies its values */
+  void assign(const vector_array_t& array);
+
+  /** Copies the trajectory to an array. The existing vectors of the array are reused if their dimensions match. */
+  void toArray(vector_array_t& array) const;
+
+  /** Returns the trajectory as an array */
+  vector_array_t toArray() const {
+    vector_array_t array;
+    toArray(array);
+    return array;
+  }
+
+  /** Swaps the content in O(1) without copying the data */
+  void swap(VectorTrajectory& other) noexcept;
+
+ private:
+  /** Number of scalars in a cache line */
+  static constexpr int alignment_ = 64 / sizeof(scalar_t);
+
+  std::vector<int> sizes_;
+  std::vector<int> offsets_;  // start of each node in data_, the last entry is the total length
+  std::vector<scalar_t> buffer_;
+  scalar_t* data_ = nullptr;  // first cache line aligned element of buffer_
+};
+
+inline void swap(VectorTrajectory& a, VectorTrajectory& b) noexcept {
+  a.swap(b);
+}
+
+}  // namespace ocs2
@@ -66,13 +66,10 @@ const Data& stdAccessFun(const std::vector<Data, Alloc>& vec, size_t ind) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
-  // corner cases (no time set OR single time element)
-  if (timeArray.size() <= 1) {
-    return {0, scalar_t(1.0)};
-  }
-
-  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+/**
+ * Helper to compute the interpolation coefficient of the interval returned by lookup::findIntervalInTimeArray.
+ */
+inline index_alpha_t timeSegmentFromInterval(int index, scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
   const auto lastInterval = static_cast<int>(timeArray.size() - 1);
   if (index >= 0) {
     if (index < lastInterval) {
@@ -104,6 +101,105 @@ inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+  return timeSegmentFromInterval(index, enquiryTime, timeArray);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t TimeSegmentCursor::timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  // The interval index is the number of time stamps strictly smaller than enquiryTime minus one, i.e. the same as
+  // lookup::findIntervalInTimeArray. Interval i spans (timeArray[i], timeArray[i + 1]] with open ends at -1 and size - 1.
+  const auto numTimes = static_cast<int>(timeArray.size());
+  const auto hint = hint_.load(std::memory_order_relaxed);
+  int index = std::max(-1, std::min(hint, numTimes - 1));
+
+  if (index < 0 || timeArray[index] < enquiryTime) {
+    // search forward
+    int numSteps = 0;
+    while (index + 1 < numTimes && timeArray[index + 1] < enquiryTime && numSteps < maxNumLinearSteps_) {
+      ++index;
+      ++numSteps;
+    }
+    if (index + 1 < numTimes && timeArray[index + 1] < enquiryTime) {
+      const auto firstNotSmaller = std::lower_bound(timeArray.begin() + index + 1, timeArray.end(), enquiryTime);
+      index = static_cast<int>(firstNotSmaller - timeArray.begin()) - 1;
+    }
+  } else {
+    // search backward
+    int numSteps = 0;
+    while (index >= 0 && enquiryTime <= timeArray[index] && numSteps < maxNumLinearSteps_) {
+      --index;
+      ++numSteps;
+    }
+    if (index >= 0 && enquiryTime <= timeArray[index]) {
+      const auto firstNotSmaller = std::lower_bound(timeArray.begin(), timeArray.begin() + index + 1, enquiryTime);
+      index = static_cast<int>(firstNotSmaller - timeArray.begin()) - 1;
+    }
+  }
+
+  if (index != hint) {
+    hint_.store(index, std::memory_order_relaxed);
+  }
+  return timeSegmentFromInterval(index, enquiryTime, timeArray);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline void interpolateAffine(index_alpha_t indexAlpha, const vector_array_t& biasArray, const matrix_array_t& gainArray, const vector_t& x,
+                              vector_t& result, matrix_t& gainWorkspace) {
+  if (biasArray.size() > 1 && gainArray.size() > 1) {
+    const int index = indexAlpha.first;
+    const scalar_t alpha = indexAlpha.second;
+    const auto& lhsBias = biasArray[index];
+    const auto& rhsBias = biasArray[index + 1];
+    const auto& lhsGain = gainArray[index];
+    const auto& rhsGain = gainArray[index + 1];
+
+    if (areSameSize(lhsBias, rhsBias) && areSameSize(lhsGain, rhsGain)) {
+      if (alpha == scalar_t(1.0)) {
+        result = lhsBias;
+        result.noalias() += lhsGain * x;
+      } else if (alpha == scalar_t(0.0)) {
+        result = rhsBias;
+        result.noalias() += rhsGain * x;
+      } else {
+        // The gain is blended before the product, such that the rounding is the same as the one of interpolate(). Multiplying
+        // both gains separately would differ in the last digits, which changes the iterates of the solvers using the policy.
+        const scalar_t beta = scalar_t(1.0) - alpha;
+        result = alpha * lhsBias + beta * rhsBias;
+        gainWorkspace.noalias() = alpha * lhsGain + beta * rhsGain;
+        result.noalias() += gainWorkspace * x;
+      }
+      return;
+    }
+  } else if (biasArray.size() == 1 && gainArray.size() == 1) {
+    result = biasArray.front();
+    result.noalias() += gainArray.front() * x;
+    return;
+  }
+
+  // size mismatch or constant function: snap to the closest data point as interpolate() does
+  result = interpolate(indexAlpha, biasArray);
+  result.noalias() += interpolate(indexAlpha, gainArray) * x;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,87 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include "ocs2_core/Types.h"
+#include "ocs2_core/reference/TargetTrajectories.h"
+
+namespace ocs2 {
+
+/**
+ * Samples the TargetTrajectories once on the time grid of a solver, such that cost terms evaluated at the nodes of that grid
+ * can read the desired state and input without searching the reference time trajectory and without allocating the
+ * interpolated vectors. The cache is rebuilt before every solver run and is read-only while the solver runs.
+ */
+class ReferenceCache {
+ public:
+  /**
+   * Samples the target trajectories on the time grid. The storage of the previous update is reused.
+   *
+   * @param [in] targetTrajectories : The target trajectories of the current solver run.
+   * @param [in] timeGrid : The non-decreasing times at which the cost terms are evaluated.
+   */
+  void update(const TargetTrajectories& targetTrajectories, scalar_array_t timeGrid);
+
+  /** Empties the cache. */
+  void clear();
+
+  /** Returns the number of cached nodes. */
+  size_t size() const { return timeGrid_.size(); }
+
+  /** Returns the cached time grid. */
+  const scalar_array_t& getTimeGrid() const { return timeGrid_; }
+
+  /** Returns true if the desired input is cached. */
+  bool hasDesiredInput() const { return hasDesiredInput_; }
+
+  /** Returns the desired state at node index. */
+  const vector_t& getDesiredState(size_t index) const { return desiredStates_[index]; }
+
+  /** Returns the desired input at node index. */
+  const vector_t& getDesiredInput(size_t index) const { return desiredInputs_[index]; }
+
+  /**
+   * Finds the node whose time is exactly the given time. The hint and its successor are checked before a binary search is
+   * done, so queries that sweep the grid in order are resolved in constant time.
+   *
+   * @param [in] time : The enquiry time.
+   * @param [in] hint : The expected node index, e.g. the result of the previous query.
+   * @return The node index, or -1 if time is not a node of the grid.
+   */
+  int findNode(scalar_t time, int hint = 0) const;
+
+ private:
+  scalar_array_t timeGrid_;
+  vector_array_t desiredStates_;
+  vector_array_t desiredInputs_;
+  bool hasDesiredInput_ = false;
+};
+
+}  // namespace ocs2
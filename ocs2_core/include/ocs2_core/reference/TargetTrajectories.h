@@ -46,8 +46,8 @@ struct TargetTrajectories {
   bool empty() const { return timeTrajectory.empty() || stateTrajectory.empty(); }
   size_t size() const { return timeTrajectory.size(); }
 
-  bool operator==(const TargetTrajectories& other);
-  bool operator!=(const TargetTrajectories& other) { return !(*this == other); }
+  bool operator==(const TargetTrajectories& other) const;
+  bool operator!=(const TargetTrajectories& other) const { return !(*this == other); }
 
   vector_t getDesiredState(scalar_t time) const;
   vector_t getDesiredInput(scalar_t time) const;
@@ -0,0 +1,116 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace ocs2 {
+
+/**
+ * Sense-reversing barrier for a fixed number of threads that busy-wait for each other.
+ *
+ * Waiting threads spin on a single flag, so the release of a phase costs one cache line transfer instead of a mutex and a condition
+ * variable wake-up. This pays off when the phases are short (a few microseconds) and every participant has its own core. A thread that
+ * is still waiting after numSpinsBeforeSleep spins goes to sleep on a condition variable, such that an oversubscribed machine (or real-time
+ * threads sharing a core) still makes progress.
+ *
+ * @warning All participants must run concurrently, e.g. a runParallel() on a pool whose threads are not used by other tasks.
+ */
+class SpinBarrier {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] numParticipants: Number of threads that have to arrive before the barrier opens.
+   * @param [in] numSpinsBeforeSleep: Number of spins before a waiting thread goes to sleep.
+   */
+  explicit SpinBarrier(size_t numParticipants, size_t numSpinsBeforeSleep = 10000)
+      : numParticipants_(numParticipants), numSpinsBeforeSleep_(numSpinsBeforeSleep), numRemaining_(numParticipants) {}
+
+  SpinBarrier(const SpinBarrier&) = delete;
+  SpinBarrier& operator=(const SpinBarrier&) = delete;
+
+  /** Number of threads that have to arrive before the barrier opens. */
+  size_t numParticipants() const { return numParticipants_; }
+
+  /** Blocks until all participants have arrived. */
+  void arriveAndWait() {
+    arriveAndWait([] {});
+  }
+
+  /**
+   * Blocks until all participants have arrived. The last arriving thread runs the completion before releasing the others, such that
+   * its side effects are visible to all participants after the barrier.
+   *
+   * @param [in] completion: Callable without arguments.
+   */
+  template <typename Completion>
+  void arriveAndWait(Completion&& completion) {
+    // The sense cannot flip before this thread has arrived, and it has flipped for the previous phase before this thread left it.
+    const bool sense = sense_.load(std::memory_order_acquire);
+
+    if (numRemaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      completion();
+      numRemaining_.store(numParticipants_, std::memory_order_relaxed);
+      // sequentially consistent such that either the sleeping threads see the new sense or this thread sees them sleeping
+      sense_.store(!sense);
+      if (numSleeping_.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        sleepCondition_.notify_all();
+      }
+
+    } else {
+      for (size_t numSpins = 0; sense_.load(std::memory_order_acquire) == sense; numSpins++) {
+        if (numSpins >= numSpinsBeforeSleep_) {
+          std::unique_lock<std::mutex> lock(sleepMutex_);
+          ++numSleeping_;
+          sleepCondition_.wait(lock, [&] { return sense_.load() != sense; });
+          --numSleeping_;
+          break;
+        }
+      }
+    }
+  }
+
+ private:
+  const size_t numParticipants_;
+  const size_t numSpinsBeforeSleep_;
+  alignas(64) std::atomic<size_t> numRemaining_;
+  alignas(64) std::atomic_bool sense_{false};
+  std::atomic<size_t> numSleeping_{0};
+
+  std::mutex sleepMutex_;
+  std::condition_variable sleepCondition_;
+};
+
+}  // namespace ocs2
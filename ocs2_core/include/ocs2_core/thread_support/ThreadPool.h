@@ -29,7 +29,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <future>
 #include <mutex>
 #include <queue>
@@ -40,6 +43,13 @@ namespace ocs2 {
 
 /**
  * Thread pool class to execute tasks on multiple threads.
+ *
+ * The pool runs in one of two modes:
+ * - Default: all tasks go through a single mutex-protected queue and idle workers sleep on a condition variable.
+ * - Work-stealing: every worker owns a lock-free deque. Tasks submitted from a worker are pushed to its own deque, tasks
+ *   submitted from other threads go to a shared queue, and idle workers steal from each other. runParallel() does not
+ *   allocate any task; the workers claim instances of the parallel task directly. Idle workers (and the thread waiting in
+ *   runParallel()) busy-wait for the spin duration before going to sleep, which trades CPU time for wake-up latency.
  */
 class ThreadPool {
  public:
@@ -48,8 +58,11 @@ class ThreadPool {
    *
    * @param [in] nThreads: Number of threads to launch in the pool
    * @param [in] priority: The worker thread priority
+   * @param [in] workStealing: Whether to use the work-stealing mode.
+   * @param [in] spinDuration: Time an idle thread busy-waits before sleeping. Only used in the work-stealing mode.
    */
-  explicit ThreadPool(size_t nThreads = 1, int priority = 0);
+  explicit ThreadPool(size_t nThreads = 1, int priority = 0, bool workStealing = false,
+                      std::chrono::microseconds spinDuration = std::chrono::microseconds(0));
 
   /**
    * Destructor
@@ -83,12 +96,17 @@ class ThreadPool {
   /** Get the number of threads. */
   size_t numThreads() const { return workerThreads_.size(); }
 
+  /** Whether the pool runs in the work-stealing mode. */
+  bool isWorkStealing() const { return workStealingStatePtr_ != nullptr; }
+
  private:
   struct TaskBase;
 
   template <typename Functor>
   struct Task;
 
+  struct WorkStealingState;
+
   /**
    * Thread worker loop
    *
@@ -96,6 +114,13 @@ class ThreadPool {
    */
   void worker(int workerIndex);
 
+  /**
+   * Thread worker loop of the work-stealing mode
+   *
+   * @param [in] workerIndex: worker thread index
+   */
+  void workStealingWorker(int workerIndex);
+
   /**
    * Run a task asynchronously in another thread
    *
@@ -103,7 +128,24 @@ class ThreadPool {
    */
   void runTask(std::unique_ptr<TaskBase> taskPtr);
 
-  bool stop_{false};  //!< flag telling all threads to stop, protected by taskQueueLock_
+  /**
+   * Allocation-free runParallel of the work-stealing mode.
+   *
+   * @return false if another runParallel call is in progress on this pool, in which case nothing has been executed.
+   */
+  bool runParallelWorkStealing(std::function<void(int)>& taskFunction, int N);
+
+  /** Runs one pending instance of the current parallel task if there is any. Returns false if nothing was executed. */
+  bool runParallelInstance(int workerIndex);
+
+  /** Runs one queued task, taken from the own deque, the shared queue or stolen. Returns false if nothing was executed. */
+  bool runQueuedTask(int workerIndex);
+
+  /** Wakes up sleeping workers after new work has been published. */
+  void notifyWorkers(bool all);
+
+  std::atomic_bool stop_{false};  //!< flag telling all threads to stop
+  std::unique_ptr<WorkStealingState> workStealingStatePtr_;  //!< null in the default mode
 
   std::queue<std::unique_ptr<TaskBase>> taskQueue_;  // protected by taskQueueLock_
   std::condition_variable taskQueueCondition_;
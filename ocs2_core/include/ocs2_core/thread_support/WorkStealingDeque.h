@@ -0,0 +1,136 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace ocs2 {
+
+/**
+ * Bounded lock-free work-stealing deque (Chase-Lev) of pointers.
+ *
+ * Only the owner thread may call push() and pop(), which operate on the bottom of the deque. Any other thread may call
+ * steal(), which takes elements from the top. The deque does not own the pointed-to objects.
+ *
+ * Reference: N. M. Le, A. Pop, A. Cohen, F. Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013.
+ *
+ * @tparam T : pointed-to type
+ */
+template <typename T>
+class WorkStealingDeque {
+ public:
+  /**
+   * Constructor
+   * @param [in] capacityLog2: The deque holds at most 2^capacityLog2 elements.
+   */
+  explicit WorkStealingDeque(size_t capacityLog2 = 10)
+      : capacity_(int64_t(1) << capacityLog2), mask_(capacity_ - 1), buffer_(new std::atomic<T*>[capacity_]) {
+    for (int64_t i = 0; i < capacity_; ++i) {
+      buffer_[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  /**
+   * Pushes an element to the bottom of the deque. Owner thread only.
+   * @return false if the deque is full, in which case the element is not inserted.
+   */
+  bool push(T* item) {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_acquire);
+    if (b - t >= capacity_) {
+      return false;
+    }
+    buffer_[b & mask_].store(item, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * Pops an element from the bottom of the deque. Owner thread only.
+   * @return nullptr if the deque is empty.
+   */
+  T* pop() {
+    const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+
+    if (t > b) {  // empty
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    T* item = buffer_[b & mask_].load(std::memory_order_relaxed);
+    if (t == b) {  // last element, race against thieves
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  /**
+   * Steals an element from the top of the deque. Can be called from any thread.
+   * @return nullptr if the deque is empty or the steal lost a race.
+   */
+  T* steal() {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t b = bottom_.load(std::memory_order_acquire);
+
+    if (t < b) {
+      T* item = buffer_[t & mask_].load(std::memory_order_relaxed);
+      if (top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return item;
+      }
+    }
+    return nullptr;
+  }
+
+  /** Whether the deque appeared empty at the time of the call. */
+  bool empty() const { return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed); }
+
+ private:
+  const int64_t capacity_;
+  const int64_t mask_;
+  std::unique_ptr<std::atomic<T*>[]> buffer_;
+  std::atomic<int64_t> top_{0};
+  char padding_[64];  // keep top_ and bottom_ on separate cache lines
+  std::atomic<int64_t> bottom_{0};
+};
+
+}  // namespace ocs2
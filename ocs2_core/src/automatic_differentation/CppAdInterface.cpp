@@ -29,10 +29,94 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
 #include <boost/filesystem.hpp>
 
+#include <ocs2_core/automatic_differentiation/CppAdModelBuilder.h>
+#include <ocs2_core/misc/Tracing.h>
+
 namespace ocs2 {
 
+struct CppAdInterface::ModelSources {
+  ApproximationOrder approximationOrder;
+  std::string hash;
+  ad_fun_t fun;
+  std::unique_ptr<CppAD::cg::ModelCSourceGen<scalar_t>> sourceGen;
+  std::unique_ptr<CppAD::cg::ModelLibraryCSourceGen<scalar_t>> librarySourceGen;
+};
+
+namespace {
+
+/**
+ * Splits CppAD::cg::DynamicModelLibraryProcessor::createDynamicLibrary into the source generation, which uses CppAD and has to run
+ * serially, and the compilation, which only calls the compiler and can run concurrently for different libraries.
+ */
+class ModelLibraryCompiler : public CppAD::cg::ModelLibraryProcessor<scalar_t> {
+ public:
+  explicit ModelLibraryCompiler(CppAD::cg::ModelLibraryCSourceGen<scalar_t>& librarySourceGen)
+      : CppAD::cg::ModelLibraryProcessor<scalar_t>(librarySourceGen) {}
+
+  void generateSources() {
+    for (const auto& model : modelLibraryHelper_->getModels()) {
+      getSources(*model.second);
+    }
+    getLibrarySources();
+  }
+
+  void compile(CppAD::cg::GccCompiler<scalar_t>& compiler, const std::string& libraryName) {
+    try {
+      for (const auto& model : modelLibraryHelper_->getModels()) {
+        compiler.compileSources(getSources(*model.second), true);
+      }
+      compiler.compileSources(getLibrarySources(), true);
+      compiler.compileSources(modelLibraryHelper_->getCustomSources(), true);
+      compiler.buildDynamic(libraryName);
+    } catch (...) {
+      compiler.cleanup();
+      throw;
+    }
+    compiler.cleanup();
+  }
+};
+
+/** 64-bit FNV-1a hash */
+class Fnv1aHash {
+ public:
+  template <typename T>
+  void add(const T& value) {
+    addBytes(&value, sizeof(T));
+  }
+
+  void add(const std::string& value) {
+    add(value.size());
+    addBytes(value.data(), value.size());
+  }
+
+  std::string toString() const {
+    std::ostringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << hash_;
+    return stream.str();
+  }
+
+ private:
+  void addBytes(const void* data, size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash_ ^= bytes[i];
+      hash_ *= 1099511628211ULL;
+    }
+  }
+
+  uint64_t hash_ = 14695981039346656037ULL;
+};
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -45,6 +129,7 @@ CppAdInterface::CppAdInterface(ad_parameterized_function_t adFunction, size_t va
       folderName_(std::move(folderName)),
       compileFlags_(std::move(compileFlags)) {
   setFolderNames();
+  traceName_ = OCS2_TRACE_NAME(modelName_);
 }
 
 /******************************************************************************************************/
@@ -68,55 +153,15 @@ CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
-  createFolderStructure();
-
-  // set and declare independent variables and start tape recording
-  ad_vector_t xp(variableDim_ + parameterDim_);
-  xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
-  CppAD::Independent(xp);
-
-  // Split in variables and parameters
-  ad_vector_t x = xp.segment(0, variableDim_);
-  ad_vector_t p = xp.segment(variableDim_, parameterDim_);
-  // dependent variable vector
-  ad_vector_t y;
-  // the model equation
-  adFunction_(x, p, y);
-  rangeDim_ = y.rows();
-  // create f: xp -> y and stop tape recording
-  ad_fun_t fun(xp, y);
-  // Optimize the operation sequence
-  fun.optimize();
-
-  // generates source code
-  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(fun, modelName_);
-  setApproximationOrder(approximationOrder, sourceGen, fun);
-
-  // Compiler objects, compile to temporary shared library file to avoid interference between processes
-  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(sourceGen);
-  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
-  CppAD::cg::DynamicModelLibraryProcessor<scalar_t> libraryProcessor(libraryCSourceGen, libraryName_ + tmpName_);
-  setCompilerOptions(gccCompiler);
-
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Compiling Shared Library: "
-              << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
-  }
-
-  // Compile and store the library
-  dynamicLib_ = libraryProcessor.createDynamicLibrary(gccCompiler);
-  model_ = dynamicLib_->model(modelName_);
-
-  setSparsityNonzeros();
+CppAdInterface::~CppAdInterface() {
+  discardPendingModel();
+}
 
-  // Rename generated library after loading
-  if (verbose) {
-    std::cerr << "[CppAdInterface] Renaming " << libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << " to "
-              << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION << std::endl;
-  }
-  boost::filesystem::rename(libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION,
-                            libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
+  createModels(recordModel(approximationOrder), verbose);
 }
 
 /******************************************************************************************************/
@@ -138,10 +183,15 @@ void CppAdInterface::loadModels(bool verbose) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder, bool verbose) {
-  if (isLibraryAvailable()) {
+  auto modelSources = recordModel(approximationOrder);
+  if (isLibraryAvailable() && readLibraryHash() == modelSources->hash) {
     loadModels(verbose);
   } else {
-    createModels(approximationOrder, verbose);
+    if (verbose && isLibraryAvailable()) {
+      std::cerr << "[CppAdInterface] Library " << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION
+                << " is outdated and will be regenerated." << std::endl;
+    }
+    createModels(std::move(modelSources), verbose);
   }
 }
 
@@ -149,6 +199,7 @@ void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p) const {
+  OCS2_TRACE_SCOPE("cppad", traceName_);
   vector_t xp(variableDim_ + parameterDim_);
   xp << x, p;
 
@@ -163,6 +214,7 @@ vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p)
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const {
+  OCS2_TRACE_SCOPE("cppad", traceName_);
   // Concatenate input
   vector_t xp(variableDim_ + parameterDim_);
   xp << x, p;
@@ -190,56 +242,15 @@ matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const
 /******************************************************************************************************/
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p) const {
+  OCS2_TRACE_SCOPE("cppad", traceName_);
   // Concatenate input
   vector_t xp(variableDim_ + parameterDim_);
   xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
 
-  ScalarFunctionQuadraticApproximation gnApprox;
-
-  // Zero order
   vector_t valueVector(model_->Range());
-  model_->ForwardZero(xp, valueVector);
-  gnApprox.f = 0.5 * valueVector.squaredNorm();
-
-  // Jacobian
   std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
-  size_t const* rows;
-  size_t const* cols;
-  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
-
-  // Sparse evaluation of J' * f
-  gnApprox.dfdx.setZero(variableDim_);
-  for (size_t i = 0; i < nnzJacobian_; i++) {
-    gnApprox.dfdx(cols[i]) += sparseJacobian[i] * valueVector(rows[i]);
-  }
-
-  /*
-   * Sparse construction of the GN matrix, H = J' * J.
-   * H(i, j) = sum_rows { J(row, i) * J(row, j) }
-   * Because the sparse elements are ordered first by row, then by column, we process J row-by-row.
-   * For each row of J, we add the non-zero pairs (i, j) to H(i, j).
-   */
-  gnApprox.dfdxx.setZero(variableDim_, variableDim_);
-  for (size_t i = 0; i < nnzJacobian_; ++i) {
-    const size_t row_i = rows[i];
-    const size_t col_i = cols[i];
-    const scalar_t v_i = sparseJacobian[i];
-    // Diagonal element always exists:
-    gnApprox.dfdxx(col_i, col_i) += v_i * v_i;
-    // Process off-diagonals
-    size_t j = i + 1;
-    while (rows[j] == row_i) {
-      const size_t col_j = cols[j];
-      gnApprox.dfdxx(col_j, col_i) += v_i * sparseJacobian[j];
-      gnApprox.dfdxx(col_i, col_j) = gnApprox.dfdxx(col_j, col_i);  // Maintain symmetry as we go.
-      ++j;
-    }
-  }
-
-  assert(gnApprox.dfdx.allFinite());
-  assert(gnApprox.dfdxx.allFinite());
+  ScalarFunctionQuadraticApproximation gnApprox;
+  computeGaussNewtonApproximation(xp, valueVector, sparseJacobian, gnApprox);
   return gnApprox;
 }
 
@@ -247,6 +258,7 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const vector_t& p) const {
+  OCS2_TRACE_SCOPE("cppad", traceName_);
   vector_t w = vector_t::Zero(rangeDim_);
   w[outputIndex] = 1.0;
 
@@ -257,6 +269,7 @@ matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
+  OCS2_TRACE_SCOPE("cppad", traceName_);
   // Concatenate input
   vector_t xp(variableDim_ + parameterDim_);
   xp << x, p;
@@ -285,6 +298,329 @@ matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const
   return hessian;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<CppAdInterface::ModelSources> CppAdInterface::recordModel(ApproximationOrder approximationOrder) {
+  // A new recording replaces the sources that are still waiting for compilation
+  discardPendingModel();
+
+  // set and declare independent variables and start tape recording
+  ad_vector_t xp(variableDim_ + parameterDim_);
+  xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
+  CppAD::Independent(xp);
+
+  // Split in variables and parameters
+  ad_vector_t x = xp.segment(0, variableDim_);
+  ad_vector_t p = xp.segment(variableDim_, parameterDim_);
+  // dependent variable vector
+  ad_vector_t y;
+  // the model equation
+  adFunction_(x, p, y);
+  rangeDim_ = y.rows();
+
+  std::unique_ptr<ModelSources> modelSources(new ModelSources);
+  modelSources->approximationOrder = approximationOrder;
+  // create f: xp -> y and stop tape recording
+  modelSources->fun.Dependent(xp, y);
+  // Optimize the operation sequence
+  modelSources->fun.optimize();
+
+  modelSources->hash = getTapeHash(modelSources->fun, approximationOrder);
+  return modelSources;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::generateSources(ModelSources& modelSources, bool verbose) {
+  createFolderStructure();
+
+  modelSources.sourceGen.reset(new CppAD::cg::ModelCSourceGen<scalar_t>(modelSources.fun, modelName_));
+  setApproximationOrder(modelSources.approximationOrder, *modelSources.sourceGen, modelSources.fun);
+  modelSources.librarySourceGen.reset(new CppAD::cg::ModelLibraryCSourceGen<scalar_t>(*modelSources.sourceGen));
+
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Generating Sources: " << modelName_ << std::endl;
+  }
+  ModelLibraryCompiler(*modelSources.librarySourceGen).generateSources();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::compileSources(ModelSources& modelSources, bool verbose) const {
+  const std::string tmpLibraryName = libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+  const std::string libraryName = libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+
+  // Compile to temporary shared library file to avoid interference between processes
+  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
+  setCompilerOptions(gccCompiler);
+
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Compiling Shared Library: " << tmpLibraryName << std::endl;
+  }
+  ModelLibraryCompiler(*modelSources.librarySourceGen).compile(gccCompiler, tmpLibraryName);
+
+  // Rename generated library after compilation, and store the hash it was generated from
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Renaming " << tmpLibraryName << " to " << libraryName << std::endl;
+  }
+  boost::filesystem::rename(tmpLibraryName, libraryName);
+  {
+    std::ofstream hashFile(libraryName_ + tmpName_ + ".hash");
+    hashFile << modelSources.hash << std::endl;
+  }
+  boost::filesystem::rename(libraryName_ + tmpName_ + ".hash", libraryName_ + ".hash");
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::createModels(std::unique_ptr<ModelSources> modelSources, bool verbose) {
+  generateSources(*modelSources, verbose);
+
+  // Defer the compilation if a model builder collects the models of this thread
+  CppAdModelBuilder* modelBuilderPtr = CppAdModelBuilder::collectingModelBuilder();
+  if (modelBuilderPtr != nullptr) {
+    pendingModelSources_ = std::move(modelSources);
+    modelBuilderPtr_ = modelBuilderPtr;
+    modelBuilderPtr_->defer(*this, verbose);
+    return;
+  }
+
+  compileSources(*modelSources, verbose);
+  loadModels(verbose);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::compilePendingModel(bool verbose) const {
+  compileSources(*pendingModelSources_, verbose);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::discardPendingModel() {
+  if (modelBuilderPtr_ != nullptr) {
+    modelBuilderPtr_->remove(*this);
+    modelBuilderPtr_ = nullptr;
+  }
+  pendingModelSources_.reset();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::readLibraryHash() const {
+  std::string hash;
+  std::ifstream hashFile(libraryName_ + ".hash");
+  if (hashFile.good()) {
+    hashFile >> hash;
+  }
+  return hash;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::getTapeHash(ad_fun_t& fun, ApproximationOrder approximationOrder) const {
+  Fnv1aHash hash;
+  hash.add(std::string("ocs2_cppad_model_v1"));
+  hash.add(modelName_);
+  hash.add(variableDim_);
+  hash.add(parameterDim_);
+  hash.add(rangeDim_);
+  hash.add(static_cast<int>(approximationOrder));
+  hash.add(compileFlags_.size());
+  for (const auto& flag : compileFlags_) {
+    hash.add(flag);
+  }
+
+  // Size of the operation sequence
+  hash.add(fun.size_var());
+  hash.add(fun.size_par());
+  hash.add(fun.size_op());
+  hash.add(fun.size_op_arg());
+  hash.add(fun.size_text());
+  hash.add(fun.size_VecAD());
+
+  // Function values at fixed points, these distinguish tapes of the same size
+  fun.check_for_nan(false);
+  std::vector<ad_base_t> xp(fun.Domain());
+  for (size_t k = 0; k < 2; k++) {
+    for (size_t i = 0; i < xp.size(); i++) {
+      xp[i] = (k == 0) ? 1.0 : 0.5 + 0.1 * ((7 * i + 3) % 11);
+    }
+    const auto y = fun.Forward(0, xp);
+    for (const auto& yi : y) {
+      hash.add(yi.isValueDefined() ? yi.getValue() : std::numeric_limits<scalar_t>::quiet_NaN());
+    }
+  }
+  fun.capacity_order(0);
+
+  return hash.toString();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getFunctionValues(const matrix_t& x, const matrix_t& p, matrix_t& y) const {
+  OCS2_TRACE_SCOPE("cppad", traceName_);
+  const size_t numPoints = x.cols();
+  y.resize(rangeDim_, numPoints);
+
+  vector_t xp(variableDim_ + parameterDim_);
+  for (size_t i = 0; i < numPoints; i++) {
+    setBatchPoint(x, p, i, xp);
+    model_->ForwardZero(CppAD::cg::ArrayView<const scalar_t>(xp.data(), xp.size()),
+                        CppAD::cg::ArrayView<scalar_t>(y.col(i).data(), rangeDim_));
+  }
+
+  assert(y.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getJacobians(const matrix_t& x, const matrix_t& p, matrix_t& jacobians) const {
+  OCS2_TRACE_SCOPE("cppad", traceName_);
+  const size_t numPoints = x.cols();
+  jacobians.setZero(rangeDim_, numPoints * variableDim_);
+
+  vector_t xp(variableDim_ + parameterDim_);
+  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
+  size_t const* rows;
+  size_t const* cols;
+  for (size_t i = 0; i < numPoints; i++) {
+    setBatchPoint(x, p, i, xp);
+    model_->SparseJacobian(CppAD::cg::ArrayView<const scalar_t>(xp.data(), xp.size()), sparseJacobianArrayView, &rows, &cols);
+
+    // Scatter into the column-major block of this point. The pattern only contains the variables, not the parameters.
+    scalar_t* jacobian = jacobians.data() + i * variableDim_ * rangeDim_;
+    for (size_t k = 0; k < nnzJacobian_; k++) {
+      jacobian[cols[k] * rangeDim_ + rows[k]] = sparseJacobian[k];
+    }
+  }
+
+  assert(jacobians.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getGaussNewtonApproximations(const matrix_t& x, const matrix_t& p,
+                                                  std::vector<ScalarFunctionQuadraticApproximation>& gnApproximations) const {
+  OCS2_TRACE_SCOPE("cppad", traceName_);
+  const size_t numPoints = x.cols();
+  gnApproximations.resize(numPoints);
+
+  vector_t xp(variableDim_ + parameterDim_);
+  vector_t valueVector(rangeDim_);
+  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
+  for (size_t i = 0; i < numPoints; i++) {
+    setBatchPoint(x, p, i, xp);
+    computeGaussNewtonApproximation(xp, valueVector, sparseJacobian, gnApproximations[i]);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getHessians(const matrix_t& w, const matrix_t& x, const matrix_t& p, matrix_t& hessians) const {
+  OCS2_TRACE_SCOPE("cppad", traceName_);
+  assert(w.cols() == 1 || w.cols() == x.cols());
+  const size_t numPoints = x.cols();
+  hessians.setZero(variableDim_, numPoints * variableDim_);
+
+  vector_t xp(variableDim_ + parameterDim_);
+  std::vector<scalar_t> sparseHessian(nnzHessian_);
+  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(sparseHessian);
+  size_t const* rows;
+  size_t const* cols;
+  for (size_t i = 0; i < numPoints; i++) {
+    setBatchPoint(x, p, i, xp);
+    const auto wi = (w.cols() == 1) ? w.col(0) : w.col(i);
+    model_->SparseHessian(CppAD::cg::ArrayView<const scalar_t>(xp.data(), xp.size()),
+                          CppAD::cg::ArrayView<const scalar_t>(wi.data(), rangeDim_), sparseHessianArrayView, &rows, &cols);
+
+    // Scatter the upper triangular sparsity into both triangles of the column-major block of this point
+    scalar_t* hessian = hessians.data() + i * variableDim_ * variableDim_;
+    for (size_t k = 0; k < nnzHessian_; k++) {
+      hessian[cols[k] * variableDim_ + rows[k]] = sparseHessian[k];
+      hessian[rows[k] * variableDim_ + cols[k]] = sparseHessian[k];
+    }
+  }
+
+  assert(hessians.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::setBatchPoint(const matrix_t& x, const matrix_t& p, size_t i, vector_t& xp) const {
+  assert(static_cast<size_t>(x.rows()) == variableDim_);
+  assert(static_cast<size_t>(p.rows()) == parameterDim_);
+  assert(parameterDim_ == 0 || p.cols() == 1 || p.cols() == x.cols());
+  xp.head(variableDim_) = x.col(i);
+  if (parameterDim_ > 0) {
+    xp.tail(parameterDim_) = (p.cols() == 1) ? p.col(0) : p.col(i);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::computeGaussNewtonApproximation(const vector_t& xp, vector_t& value, std::vector<scalar_t>& sparseJacobian,
+                                                     ScalarFunctionQuadraticApproximation& gnApprox) const {
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xp.data(), xp.size());
+
+  // Zero order
+  model_->ForwardZero(xpArrayView, CppAD::cg::ArrayView<scalar_t>(value.data(), value.size()));
+  gnApprox.f = 0.5 * value.squaredNorm();
+
+  // Jacobian
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
+  size_t const* rows;
+  size_t const* cols;
+  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+
+  // Sparse evaluation of J' * f
+  gnApprox.dfdx.setZero(variableDim_);
+  for (size_t i = 0; i < nnzJacobian_; i++) {
+    gnApprox.dfdx(cols[i]) += sparseJacobian[i] * value(rows[i]);
+  }
+
+  /*
+   * Sparse construction of the GN matrix, H = J' * J.
+   * H(i, j) = sum_rows { J(row, i) * J(row, j) }
+   * Because the sparse elements are ordered first by row, then by column, we process J row-by-row.
+   * For each row of J, we add the non-zero pairs (i, j) to H(i, j).
+   */
+  gnApprox.dfdxx.setZero(variableDim_, variableDim_);
+  for (size_t i = 0; i < nnzJacobian_; ++i) {
+    const size_t row_i = rows[i];
+    const size_t col_i = cols[i];
+    const scalar_t v_i = sparseJacobian[i];
+    // Diagonal element always exists:
+    gnApprox.dfdxx(col_i, col_i) += v_i * v_i;
+    // Process off-diagonals
+    size_t j = i + 1;
+    while (j < nnzJacobian_ && rows[j] == row_i) {
+      const size_t col_j = cols[j];
+      gnApprox.dfdxx(col_j, col_i) += v_i * sparseJacobian[j];
+      gnApprox.dfdxx(col_i, col_j) = gnApprox.dfdxx(col_j, col_i);  // Maintain symmetry as we go.
+      ++j;
+    }
+  }
+
+  assert(gnApprox.dfdx.allFinite());
+  assert(gnApprox.dfdxx.allFinite());
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
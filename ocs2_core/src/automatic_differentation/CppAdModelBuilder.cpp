@@ -0,0 +1,161 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/automatic_differentiation/CppAdModelBuilder.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelBuilder::CppAdModelBuilder(size_t nThreads, int threadPriority)
+    : nThreads_(std::max(nThreads, size_t(1))), threadPool_(nThreads_ - 1, threadPriority) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelBuilder::~CppAdModelBuilder() {
+  stopCollecting();
+  std::vector<std::pair<CppAdInterface*, bool>> models;
+  models.swap(pendingModels_);
+  for (auto& model : models) {
+    model.first->discardPendingModel();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelBuilder::startCollecting() {
+  auto& modelBuilderPtr = collectingModelBuilder();
+  if (modelBuilderPtr != nullptr && modelBuilderPtr != this) {
+    throw std::runtime_error("[CppAdModelBuilder] Another model builder is already collecting in this thread.");
+  }
+  modelBuilderPtr = this;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelBuilder::stopCollecting() {
+  auto& modelBuilderPtr = collectingModelBuilder();
+  if (modelBuilderPtr == this) {
+    modelBuilderPtr = nullptr;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelBuilder::add(CppAdInterface& adInterface, CppAdInterface::ApproximationOrder approximationOrder, bool verbose) {
+  auto& modelBuilderPtr = collectingModelBuilder();
+  auto* const previousModelBuilderPtr = modelBuilderPtr;
+  modelBuilderPtr = this;
+  try {
+    adInterface.loadModelsIfAvailable(approximationOrder, verbose);
+  } catch (...) {
+    modelBuilderPtr = previousModelBuilderPtr;
+    throw;
+  }
+  modelBuilderPtr = previousModelBuilderPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t CppAdModelBuilder::build() {
+  stopCollecting();
+
+  std::vector<std::pair<CppAdInterface*, bool>> models;
+  models.swap(pendingModels_);
+
+  // Compile in parallel, the compilation does not touch CppAD
+  std::atomic_size_t modelIndex{0};
+  std::mutex errorMutex;
+  std::exception_ptr errorPtr;
+  auto compileTask = [&](int) {
+    size_t i;
+    while ((i = modelIndex++) < models.size()) {
+      try {
+        models[i].first->compilePendingModel(models[i].second);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!errorPtr) {
+          errorPtr = std::current_exception();
+        }
+      }
+    }
+  };
+  threadPool_.runParallel(compileTask, nThreads_);
+
+  // Release the tapes and load the libraries serially
+  for (auto& model : models) {
+    model.first->discardPendingModel();
+  }
+  if (errorPtr) {
+    std::rethrow_exception(errorPtr);
+  }
+  for (auto& model : models) {
+    model.first->loadModels(model.second);
+  }
+
+  return models.size();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdModelBuilder*& CppAdModelBuilder::collectingModelBuilder() {
+  static thread_local CppAdModelBuilder* modelBuilderPtr = nullptr;
+  return modelBuilderPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelBuilder::defer(CppAdInterface& adInterface, bool verbose) {
+  pendingModels_.emplace_back(&adInterface, verbose);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdModelBuilder::remove(CppAdInterface& adInterface) {
+  pendingModels_.erase(std::remove_if(pendingModels_.begin(), pendingModels_.end(),
+                                      [&](const std::pair<CppAdInterface*, bool>& model) { return model.first == &adInterface; }),
+                       pendingModels_.end());
+}
+
+}  // namespace ocs2
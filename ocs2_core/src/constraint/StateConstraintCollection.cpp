@@ -60,13 +60,21 @@ size_t StateConstraintCollection::getNumConstraints(scalar_t time) const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 size_array_t StateConstraintCollection::getTermsSize(scalar_t time) const {
-  size_array_t termsSize(this->terms_.size(), 0);
+  size_array_t termsSize;
+  getTermsSize(time, termsSize);
+  return termsSize;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateConstraintCollection::getTermsSize(scalar_t time, size_array_t& termsSize) const {
+  termsSize.assign(this->terms_.size(), 0);
   for (size_t i = 0; i < this->terms_.size(); ++i) {
     if (this->terms_[i]->isActive(time)) {
       termsSize[i] = this->terms_[i]->getNumConstraints(time);
     }
   }
-  return termsSize;
 }
 
 /******************************************************************************************************/
@@ -76,6 +84,7 @@ vector_array_t StateConstraintCollection::getValue(scalar_t time, const vector_t
   vector_array_t constraintValues(this->terms_.size());
   for (size_t i = 0; i < this->terms_.size(); ++i) {
     if (this->terms_[i]->isActive(time)) {
+      OCS2_TRACE_SCOPE("stateConstraint", getTermTraceName(this->terms_[i]));
       constraintValues[i] = this->terms_[i]->getValue(time, state, preComp);
     }
   }  // end of i loop
@@ -93,6 +102,7 @@ VectorFunctionLinearApproximation StateConstraintCollection::getLinearApproximat
   size_t i = 0;
   for (const auto& constraintTerm : this->terms_) {
     if (constraintTerm->isActive(time)) {
+      OCS2_TRACE_SCOPE("stateConstraint", getTermTraceName(constraintTerm));
       const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, preComp);
       const size_t nc = constraintTermApproximation.f.rows();
       linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
@@ -120,6 +130,7 @@ VectorFunctionQuadraticApproximation StateConstraintCollection::getQuadraticAppr
   size_t i = 0;
   for (const auto& constraintTerm : this->terms_) {
     if (constraintTerm->isActive(time)) {
+      OCS2_TRACE_SCOPE("stateConstraint", getTermTraceName(constraintTerm));
       auto constraintTermApproximation = constraintTerm->getQuadraticApproximation(time, state, preComp);
       const size_t nc = constraintTermApproximation.f.rows();
       quadraticApproximation.f.segment(i, nc) = constraintTermApproximation.f;
@@ -61,13 +61,21 @@ size_t StateInputConstraintCollection::getNumConstraints(scalar_t time) const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 size_array_t StateInputConstraintCollection::getTermsSize(scalar_t time) const {
-  size_array_t termsSize(this->terms_.size(), 0);
+  size_array_t termsSize;
+  getTermsSize(time, termsSize);
+  return termsSize;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputConstraintCollection::getTermsSize(scalar_t time, size_array_t& termsSize) const {
+  termsSize.assign(this->terms_.size(), 0);
   for (size_t i = 0; i < this->terms_.size(); ++i) {
     if (this->terms_[i]->isActive(time)) {
       termsSize[i] = this->terms_[i]->getNumConstraints(time);
     }
   }
-  return termsSize;
 }
 
 /******************************************************************************************************/
@@ -78,6 +86,7 @@ vector_array_t StateInputConstraintCollection::getValue(scalar_t time, const vec
   vector_array_t constraintValues(this->terms_.size());
   for (size_t i = 0; i < this->terms_.size(); ++i) {
     if (this->terms_[i]->isActive(time)) {
+      OCS2_TRACE_SCOPE("stateInputConstraint", getTermTraceName(this->terms_[i]));
       constraintValues[i] = this->terms_[i]->getValue(time, state, input, preComp);
     }
   }  // end of i loop
@@ -96,6 +105,7 @@ VectorFunctionLinearApproximation StateInputConstraintCollection::getLinearAppro
   size_t i = 0;
   for (const auto& constraintTerm : this->terms_) {
     if (constraintTerm->isActive(time)) {
+      OCS2_TRACE_SCOPE("stateInputConstraint", getTermTraceName(constraintTerm));
       const auto constraintTermApproximation = constraintTerm->getLinearApproximation(time, state, input, preComp);
       const size_t nc = constraintTermApproximation.f.rows();
       linearApproximation.f.segment(i, nc) = constraintTermApproximation.f;
@@ -128,6 +138,7 @@ VectorFunctionQuadraticApproximation StateInputConstraintCollection::getQuadrati
   size_t i = 0;
   for (const auto& constraintTerm : this->terms_) {
     if (constraintTerm->isActive(time)) {
+      OCS2_TRACE_SCOPE("stateInputConstraint", getTermTraceName(constraintTerm));
       auto constraintTermApproximation = constraintTerm->getQuadraticApproximation(time, state, input, preComp);
       const size_t nc = constraintTermApproximation.f.rows();
       quadraticApproximation.f.segment(i, nc) = constraintTermApproximation.f;
@@ -77,13 +77,17 @@ void LinearController::setController(const scalar_array_t& controllerTime, const
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t LinearController::computeInput(scalar_t t, const vector_t& x) {
-  const auto indexAlpha = LinearInterpolation::timeSegment(t, timeStamp_);
-
-  vector_t uff = LinearInterpolation::interpolate(indexAlpha, biasArray_);
-  const matrix_t k = LinearInterpolation::interpolate(indexAlpha, gainArray_);
+  vector_t u;
+  computeInputInPlace(t, x, u);
+  return u;
+}
 
-  uff.noalias() += k * x;
-  return uff;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearController::computeInputInPlace(scalar_t t, const vector_t& x, vector_t& u) {
+  const auto indexAlpha = timeSegmentCursor_.timeSegment(t, timeStamp_);
+  LinearInterpolation::interpolateAffine(indexAlpha, biasArray_, gainArray_, x, u, gainWorkspace_);
 }
 
 /******************************************************************************************************/
@@ -47,8 +47,8 @@ QuadraticStateCost* QuadraticStateCost::clone() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t QuadraticStateCost::getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
-                                      const PreComputation&) const {
-  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
+                                      const PreComputation& preComp) const {
+  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories, preComp);
   return 0.5 * xDeviation.dot(Q_ * xDeviation);
 }
 
@@ -57,8 +57,8 @@ scalar_t QuadraticStateCost::getValue(scalar_t time, const vector_t& state, cons
 /******************************************************************************************************/
 ScalarFunctionQuadraticApproximation QuadraticStateCost::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                    const TargetTrajectories& targetTrajectories,
-                                                                                   const PreComputation&) const {
-  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories);
+                                                                                   const PreComputation& preComp) const {
+  const vector_t xDeviation = getStateDeviation(time, state, targetTrajectories, preComp);
 
   ScalarFunctionQuadraticApproximation Phi;
   Phi.dfdxx = Q_;
@@ -74,4 +74,12 @@ vector_t QuadraticStateCost::getStateDeviation(scalar_t time, const vector_t& st
   return state - targetTrajectories.getDesiredState(time);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t QuadraticStateCost::getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                               const PreComputation&) const {
+  return getStateDeviation(time, state, targetTrajectories);
+}
+
 }  // namespace ocs2
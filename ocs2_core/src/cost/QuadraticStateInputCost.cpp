@@ -53,9 +53,9 @@ QuadraticStateInputCost* QuadraticStateInputCost::clone() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t QuadraticStateInputCost::getValue(scalar_t time, const vector_t& state, const vector_t& input,
-                                           const TargetTrajectories& targetTrajectories, const PreComputation&) const {
+                                           const TargetTrajectories& targetTrajectories, const PreComputation& preComp) const {
   vector_t stateDeviation, inputDeviation;
-  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories, preComp);
 
   if (P_.size() == 0) {
     return 0.5 * stateDeviation.dot(Q_ * stateDeviation) + 0.5 * inputDeviation.dot(R_ * inputDeviation);
@@ -71,9 +71,9 @@ scalar_t QuadraticStateInputCost::getValue(scalar_t time, const vector_t& state,
 ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                         const vector_t& input,
                                                                                         const TargetTrajectories& targetTrajectories,
-                                                                                        const PreComputation&) const {
+                                                                                        const PreComputation& preComp) const {
   vector_t stateDeviation, inputDeviation;
-  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories);
+  std::tie(stateDeviation, inputDeviation) = getStateInputDeviation(time, state, input, targetTrajectories, preComp);
 
   ScalarFunctionQuadraticApproximation L;
   L.dfdxx = Q_;
@@ -106,4 +106,13 @@ std::pair<vector_t, vector_t> QuadraticStateInputCost::getStateInputDeviation(sc
   return {stateDeviation, inputDeviation};
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<vector_t, vector_t> QuadraticStateInputCost::getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                              const TargetTrajectories& targetTrajectories,
+                                                                              const PreComputation&) const {
+  return getStateInputDeviation(time, state, input, targetTrajectories);
+}
+
 }  // namespace ocs2
@@ -53,6 +53,7 @@ scalar_t StateCostCollection::getValue(scalar_t time, const vector_t& state, con
   // accumulate cost terms
   for (const auto& costTerm : this->terms_) {
     if (costTerm->isActive(time)) {
+      OCS2_TRACE_SCOPE("stateCost", getTermTraceName(costTerm));
       cost += costTerm->getValue(time, state, targetTrajectories, preComp);
     }
   }
@@ -75,9 +76,14 @@ ScalarFunctionQuadraticApproximation StateCostCollection::getQuadraticApproximat
   }
 
   // Initialize with first active term, accumulate potentially other active terms.
-  auto cost = (*firstActive)->getQuadraticApproximation(time, state, targetTrajectories, preComp);
+  ScalarFunctionQuadraticApproximation cost;
+  {
+    OCS2_TRACE_SCOPE("stateCost", getTermTraceName(*firstActive));
+    cost = (*firstActive)->getQuadraticApproximation(time, state, targetTrajectories, preComp);
+  }
   std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateCost>& costTerm) {
     if (costTerm->isActive(time)) {
+      OCS2_TRACE_SCOPE("stateCost", getTermTraceName(costTerm));
       const auto costTermApproximation = costTerm->getQuadraticApproximation(time, state, targetTrajectories, preComp);
       cost.f += costTermApproximation.f;
       cost.dfdx += costTermApproximation.dfdx;
@@ -63,6 +63,40 @@ vector_t ControlledSystemBase::computeFlowMap(scalar_t t, const vector_t& x, con
   return computeFlowMap(t, x, u, *preCompPtr_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ControlledSystemBase::computeFlowMapInPlace(scalar_t t, const vector_t& x, const vector_t& u, vector_t& dxdt) {
+  assert(preCompPtr_ != nullptr);
+  preCompPtr_->request(Request::Dynamics, t, x, u);
+  computeFlowMapInPlace(t, x, u, *preCompPtr_, dxdt);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ControlledSystemBase::computeFlowMapInPlace(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp,
+                                                 vector_t& dxdt) {
+  // default implementation
+  dxdt = computeFlowMap(t, x, u, preComp);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ControlledSystemBase::computeFlowMapBatch(scalar_t t, const matrix_t& x, const matrix_t& u, matrix_t& dxdt) {
+  assert(x.cols() == u.cols());
+  dxdt.resize(x.rows(), x.cols());
+  // the column buffers are allocated once per batch and reused for every column
+  vector_t xCol, uCol, dxdtCol;
+  for (int i = 0; i < x.cols(); i++) {
+    xCol = x.col(i);
+    uCol = u.col(i);
+    computeFlowMapInPlace(t, xCol, uCol, dxdtCol);
+    dxdt.col(i) = dxdtCol;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
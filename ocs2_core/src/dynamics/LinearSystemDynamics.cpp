@@ -57,6 +57,14 @@ vector_t LinearSystemDynamics::computeFlowMap(scalar_t t, const vector_t& x, con
   return f;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearSystemDynamics::computeFlowMapBatch(scalar_t t, const matrix_t& x, const matrix_t& u, matrix_t& dxdt) {
+  dxdt.noalias() = A_ * x;
+  dxdt.noalias() += B_ * u;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -88,4 +96,33 @@ VectorFunctionLinearApproximation LinearSystemDynamics::jumpMapLinearApproximati
   return approximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearSystemDynamics::computeFlowMapInPlace(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&, vector_t& dxdt) {
+  dxdt.noalias() = A_ * x;
+  dxdt.noalias() += B_ * u;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearSystemDynamics::linearApproximationInPlace(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&,
+                                                      VectorFunctionLinearApproximation& approximation) {
+  approximation.f.noalias() = A_ * x;
+  approximation.f.noalias() += B_ * u;
+  approximation.dfdx = A_;
+  approximation.dfdu = B_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearSystemDynamics::jumpMapLinearApproximationInPlace(scalar_t t, const vector_t& x, const PreComputation&,
+                                                             VectorFunctionLinearApproximation& approximation) {
+  approximation.f.noalias() = G_ * x;
+  approximation.dfdx = G_;
+  approximation.dfdu.setZero(A_.rows(), 0);
+}
+
 }  // namespace ocs2
@@ -72,6 +72,43 @@ VectorFunctionLinearApproximation SystemDynamicsBase::jumpMapLinearApproximation
   return approximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SystemDynamicsBase::linearApproximationInPlace(scalar_t t, const vector_t& x, const vector_t& u,
+                                                    VectorFunctionLinearApproximation& approximation) {
+  assert(preCompPtr_ != nullptr);
+  preCompPtr_->request(Request::Dynamics + Request::Approximation, t, x, u);
+  linearApproximationInPlace(t, x, u, *preCompPtr_, approximation);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SystemDynamicsBase::jumpMapLinearApproximationInPlace(scalar_t t, const vector_t& x, VectorFunctionLinearApproximation& approximation) {
+  assert(preCompPtr_ != nullptr);
+  preCompPtr_->requestPreJump(Request::Dynamics + Request::Approximation, t, x);
+  jumpMapLinearApproximationInPlace(t, x, *preCompPtr_, approximation);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SystemDynamicsBase::linearApproximationInPlace(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComp,
+                                                    VectorFunctionLinearApproximation& approximation) {
+  // default implementation
+  approximation = linearApproximation(t, x, u, preComp);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SystemDynamicsBase::jumpMapLinearApproximationInPlace(scalar_t t, const vector_t& x, const PreComputation& preComp,
+                                                           VectorFunctionLinearApproximation& approximation) {
+  // default implementation
+  approximation = jumpMapLinearApproximation(t, x, preComp);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -67,6 +67,38 @@ DynamicsSensitivityDiscretizer selectDynamicsSensitivityDiscretization(Sensitivi
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+DynamicsDiscretizerInPlace selectDynamicsDiscretizationInPlace(SensitivityIntegratorType integratorType) {
+  switch (integratorType) {
+    case SensitivityIntegratorType::EULER:
+      return eulerDiscretizationInPlace;
+    case SensitivityIntegratorType::RK2:
+      return rk2DiscretizationInPlace;
+    case SensitivityIntegratorType::RK4:
+      return rk4DiscretizationInPlace;
+    default:
+      throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+DynamicsSensitivityDiscretizerInPlace selectDynamicsSensitivityDiscretizationInPlace(SensitivityIntegratorType integratorType) {
+  switch (integratorType) {
+    case SensitivityIntegratorType::EULER:
+      return eulerSensitivityDiscretizationInPlace;
+    case SensitivityIntegratorType::RK2:
+      return rk2SensitivityDiscretizationInPlace;
+    case SensitivityIntegratorType::RK4:
+      return rk4SensitivityDiscretizationInPlace;
+    default:
+      throw std::runtime_error("Integrator of type " + sensitivity_integrator::toString(integratorType) + " not supported.");
+  }
+}
+
 namespace sensitivity_integrator {
 
 /******************************************************************************************************/
@@ -31,13 +31,39 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+
+/** Intermediate stages of the in-place discretizations */
+struct DiscretizationWorkspace {
+  vector_t k1, k2, k3, k4;
+  vector_t xStage;
+  VectorFunctionLinearApproximation K2, K3, K4;
+  matrix_t tmp;
+};
+
+/** The solvers discretize the nodes concurrently, hence each thread has its own workspace. */
+DiscretizationWorkspace& getWorkspace() {
+  thread_local DiscretizationWorkspace workspace;
+  return workspace;
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t eulerDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
-  vector_t tmp = system.computeFlowMap(t, x, u);
-  tmp = x + dt * tmp;
-  return tmp;
+  vector_t xNext;
+  eulerDiscretizationInPlace(system, t, x, u, dt, xNext);
+  return xNext;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void eulerDiscretizationInPlace(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt, vector_t& xNext) {
+  system.computeFlowMapInPlace(t, x, u, xNext);
+  xNext = x + dt * xNext;
 }
 
 /******************************************************************************************************/
@@ -45,32 +71,49 @@ vector_t eulerDiscretization(SystemDynamicsBase& system, scalar_t t, const vecto
 /******************************************************************************************************/
 VectorFunctionLinearApproximation eulerSensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x,
                                                                  const vector_t& u, scalar_t dt) {
+  VectorFunctionLinearApproximation approximation;
+  eulerSensitivityDiscretizationInPlace(system, t, x, u, dt, approximation);
+  return approximation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void eulerSensitivityDiscretizationInPlace(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                           VectorFunctionLinearApproximation& approximation) {
   // x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
   // A_{k} = Id + dt * dfdx
   // B_{k} = dt * dfdu
   // b_{k} = x_{n} + dt * f(x_{n},u_{n})
-  auto continuousApproximation = system.linearApproximation(t, x, u);
-  continuousApproximation.dfdx *= dt;
-  continuousApproximation.dfdx.diagonal().array() += 1.0;  // plus Identity()
-  continuousApproximation.dfdu *= dt;
-  continuousApproximation.f = x + dt * continuousApproximation.f;
-  return continuousApproximation;
+  system.linearApproximationInPlace(t, x, u, approximation);
+  approximation.dfdx *= dt;
+  approximation.dfdx.diagonal().array() += 1.0;  // plus Identity()
+  approximation.dfdu *= dt;
+  approximation.f = x + dt * approximation.f;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t rk2Discretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  vector_t xNext;
+  rk2DiscretizationInPlace(system, t, x, u, dt, xNext);
+  return xNext;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void rk2DiscretizationInPlace(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt, vector_t& xNext) {
   const scalar_t dt_halve = dt / 2.0;
+  auto& ws = getWorkspace();
 
   // System evaluations
-  const vector_t k1 = system.computeFlowMap(t, x, u);
-
-  vector_t tmp = x + dt * k1;
-  const vector_t k2 = system.computeFlowMap(t + dt, tmp, u);
+  system.computeFlowMapInPlace(t, x, u, ws.k1);
+  ws.xStage = x + dt * ws.k1;
+  system.computeFlowMapInPlace(t + dt, ws.xStage, u, ws.k2);
 
-  tmp = x + dt_halve * k1 + dt_halve * k2;
-  return tmp;
+  xNext = x + dt_halve * ws.k1 + dt_halve * ws.k2;
 }
 
 /******************************************************************************************************/
@@ -78,11 +121,26 @@ vector_t rk2Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 /******************************************************************************************************/
 VectorFunctionLinearApproximation rk2SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt) {
+  VectorFunctionLinearApproximation approximation;
+  rk2SensitivityDiscretizationInPlace(system, t, x, u, dt, approximation);
+  return approximation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void rk2SensitivityDiscretizationInPlace(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                         VectorFunctionLinearApproximation& approximation) {
   const scalar_t dt_halve = dt / 2.0;
+  auto& ws = getWorkspace();
 
   // System evaluations
-  VectorFunctionLinearApproximation k1 = system.linearApproximation(t, x, u);
-  VectorFunctionLinearApproximation k2 = system.linearApproximation(t + dt, x + dt * k1.f, u);
+  // Re-use the output as k1 to collect the result
+  auto& k1 = approximation;
+  auto& k2 = ws.K2;
+  system.linearApproximationInPlace(t, x, u, k1);
+  ws.xStage = x + dt * k1.f;
+  system.linearApproximationInPlace(t + dt, ws.xStage, u, k2);
 
   // Input sensitivity \dot{Su} = dfdx(t) Su + dfdu(t), with Su(0) = Zero()
   // Re-use memory from k.dfdu as dkduk
@@ -92,36 +150,44 @@ VectorFunctionLinearApproximation rk2SensitivityDiscretization(SystemDynamicsBas
   // State sensitivity \dot{Sx} = dfdx(t) Sx, with Sx(0) = Identity()
   // Re-use memory from k.dfdx as dkdxk
   // dk1dxk = k1.dfdx;
-  k2.dfdx += dt * k2.dfdx * k1.dfdx;  // need one temporary to avoid alias
+  ws.tmp.noalias() = dt * k2.dfdx * k1.dfdx;  // need one temporary to avoid alias
+  k2.dfdx += ws.tmp;
 
   // Assemble discrete approximation
-  // Re-use k1 to collect the result
   k1.dfdx = dt_halve * k1.dfdx + dt_halve * k2.dfdx;
   k1.dfdx.diagonal().array() += 1.0;  // plus Identity()
   k1.dfdu = dt_halve * k1.dfdu + dt_halve * k2.dfdu;
   k1.f = x + dt_halve * k1.f + dt_halve * k2.f;
-  return k1;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+  vector_t xNext;
+  rk4DiscretizationInPlace(system, t, x, u, dt, xNext);
+  return xNext;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void rk4DiscretizationInPlace(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt, vector_t& xNext) {
   const scalar_t dt_halve = dt / 2.0;
   const scalar_t dt_sixth = dt / 6.0;
   const scalar_t dt_third = dt / 3.0;
+  auto& ws = getWorkspace();
 
   // System evaluations
-  const vector_t k1 = system.computeFlowMap(t, x, u);
-  vector_t tmp = x + dt_halve * k1;
-  const vector_t k2 = system.computeFlowMap(t + dt_halve, tmp, u);
-  tmp = x + dt_halve * k2;
-  const vector_t k3 = system.computeFlowMap(t + dt_halve, tmp, u);
-  tmp = x + dt * k3;
-  const vector_t k4 = system.computeFlowMap(t + dt, tmp, u);
-
-  tmp = x + dt_sixth * k1 + dt_third * k2 + dt_third * k3 + dt_sixth * k4;
-  return tmp;
+  system.computeFlowMapInPlace(t, x, u, ws.k1);
+  ws.xStage = x + dt_halve * ws.k1;
+  system.computeFlowMapInPlace(t + dt_halve, ws.xStage, u, ws.k2);
+  ws.xStage = x + dt_halve * ws.k2;
+  system.computeFlowMapInPlace(t + dt_halve, ws.xStage, u, ws.k3);
+  ws.xStage = x + dt * ws.k3;
+  system.computeFlowMapInPlace(t + dt, ws.xStage, u, ws.k4);
+
+  xNext = x + dt_sixth * ws.k1 + dt_third * ws.k2 + dt_third * ws.k3 + dt_sixth * ws.k4;
 }
 
 /******************************************************************************************************/
@@ -129,18 +195,34 @@ vector_t rk4Discretization(SystemDynamicsBase& system, scalar_t t, const vector_
 /******************************************************************************************************/
 VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
                                                                scalar_t dt) {
+  VectorFunctionLinearApproximation approximation;
+  rk4SensitivityDiscretizationInPlace(system, t, x, u, dt, approximation);
+  return approximation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void rk4SensitivityDiscretizationInPlace(SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                         VectorFunctionLinearApproximation& approximation) {
   const scalar_t dt_halve = dt / 2.0;
   const scalar_t dt_sixth = dt / 6.0;
   const scalar_t dt_third = dt / 3.0;
+  auto& ws = getWorkspace();
 
   // System evaluations
-  VectorFunctionLinearApproximation k1 = system.linearApproximation(t, x, u);
-  vector_t tmpV = x + dt_halve * k1.f;
-  VectorFunctionLinearApproximation k2 = system.linearApproximation(t + dt_halve, tmpV, u);
-  tmpV = x + dt_halve * k2.f;
-  VectorFunctionLinearApproximation k3 = system.linearApproximation(t + dt_halve, tmpV, u);
-  tmpV = x + dt * k3.f;
-  VectorFunctionLinearApproximation k4 = system.linearApproximation(t + dt, tmpV, u);
+  // Re-use the output as k1 to collect the result
+  auto& k1 = approximation;
+  auto& k2 = ws.K2;
+  auto& k3 = ws.K3;
+  auto& k4 = ws.K4;
+  system.linearApproximationInPlace(t, x, u, k1);
+  ws.xStage = x + dt_halve * k1.f;
+  system.linearApproximationInPlace(t + dt_halve, ws.xStage, u, k2);
+  ws.xStage = x + dt_halve * k2.f;
+  system.linearApproximationInPlace(t + dt_halve, ws.xStage, u, k3);
+  ws.xStage = x + dt * k3.f;
+  system.linearApproximationInPlace(t + dt, ws.xStage, u, k4);
 
   // Input sensitivity \dot{Su} = dfdx(t) Su + dfdu(t), with Su(0) = Zero()
   // Re-use memory from k.dfdu as dkduk
@@ -152,7 +234,8 @@ VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBas
   // State sensitivity \dot{Sx} = dfdx(t) Sx, with Sx(0) = Identity()
   // Re-use memory from k.dfdx as dkdxk
   // dk1dxk = k1.dfdx;
-  matrix_t tmp = dt_halve * k2.dfdx * k1.dfdx;  // need one temporary to avoid alias
+  auto& tmp = ws.tmp;  // need one temporary to avoid alias
+  tmp.noalias() = dt_halve * k2.dfdx * k1.dfdx;
   k2.dfdx += tmp;
   tmp.noalias() = dt_halve * k3.dfdx * k2.dfdx;
   k3.dfdx += tmp;
@@ -160,12 +243,10 @@ VectorFunctionLinearApproximation rk4SensitivityDiscretization(SystemDynamicsBas
   k4.dfdx += tmp;
 
   // Assemble discrete approximation
-  // Re-use k1 to collect the result
   k1.dfdx = dt_sixth * k1.dfdx + dt_third * k2.dfdx + dt_third * k3.dfdx + dt_sixth * k4.dfdx;
   k1.dfdx.diagonal().array() += 1.0;  // plus Identity()
   k1.dfdu = dt_sixth * k1.dfdu + dt_third * k2.dfdu + dt_third * k3.dfdu + dt_sixth * k4.dfdu;
   k1.f = x + dt_sixth * k1.f + dt_third * k2.f + dt_third * k3.f + dt_sixth * k4.f;
-  return k1;
 }
 
-}  // namespace ocs2
\ No newline at end of file
+}  // namespace ocs2
@@ -55,6 +55,7 @@
 
 // Logic
 #include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/reference/ReferenceCache.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
 
 // Loopshaping
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/misc/LinearAlgebra.h>
 
+#include <algorithm>
+
 namespace ocs2 {
 namespace LinearAlgebra {
 
@@ -158,23 +160,36 @@ void computeConstraintProjection(const matrix_t& Dm, const matrix_t& RmInvUmUmT,
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(const VectorFunctionLinearApproximation& constraint) {
+  ConstraintProjectionWorkspace workspace;
+  VectorFunctionLinearApproximation projectionTerms;
+  matrix_t pseudoInverse;
+  qrConstraintProjection(constraint, projectionTerms, pseudoInverse, workspace);
+  return std::make_pair(std::move(projectionTerms), std::move(pseudoInverse));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void qrConstraintProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projectionTerms,
+                            matrix_t& pseudoInverse, ConstraintProjectionWorkspace& workspace) {
   // Constraint Projectors are based on the QR decomposition
   const auto numConstraints = constraint.dfdu.rows();
   const auto numInputs = constraint.dfdu.cols();
-  const Eigen::HouseholderQR<matrix_t> QRof_DT(constraint.dfdu.transpose());
+  auto& QRof_DT = workspace.qr;
+  QRof_DT.compute(constraint.dfdu.transpose());
 
-  const matrix_t Q = QRof_DT.householderQ();
+  auto& Q = workspace.Q;
+  QRof_DT.householderQ().evalTo(Q, workspace.householderWorkspace);
   const auto Q1 = Q.leftCols(numConstraints);
 
+  // left pseudo-inverse of D^T
   const auto R = QRof_DT.matrixQR().topRows(numConstraints).triangularView<Eigen::Upper>();
-  const matrix_t pseudoInverse = R.solve(Q1.transpose());  // left pseudo-inverse of D^T
+  pseudoInverse = Q1.transpose();
+  R.solveInPlace(pseudoInverse);
 
-  VectorFunctionLinearApproximation projectionTerms;
   projectionTerms.dfdu = Q.rightCols(numInputs - numConstraints);
   projectionTerms.dfdx.noalias() = -pseudoInverse.transpose() * constraint.dfdx;
   projectionTerms.f.noalias() = -pseudoInverse.transpose() * constraint.f;
-
-  return std::make_pair(std::move(projectionTerms), std::move(pseudoInverse));
 }
 
 /******************************************************************************************************/
@@ -182,22 +197,96 @@ std::pair<VectorFunctionLinearApproximation, matrix_t> qrConstraintProjection(co
 /******************************************************************************************************/
 std::pair<VectorFunctionLinearApproximation, matrix_t> luConstraintProjection(const VectorFunctionLinearApproximation& constraint,
                                                                               bool extractPseudoInverse) {
-  // Constraint Projectors are based on the LU decomposition
-  const Eigen::FullPivLU<matrix_t> lu(constraint.dfdu);
-
+  ConstraintProjectionWorkspace workspace;
   VectorFunctionLinearApproximation projectionTerms;
-  projectionTerms.dfdu = lu.kernel();
-  projectionTerms.dfdx.noalias() = -lu.solve(constraint.dfdx);
-  projectionTerms.f.noalias() = -lu.solve(constraint.f);
+  luConstraintProjection(constraint, projectionTerms, workspace);
 
   matrix_t pseudoInverse;
   if (extractPseudoInverse) {
-    pseudoInverse = lu.solve(matrix_t::Identity(constraint.f.size(), constraint.f.size())).transpose();  // left pseudo-inverse of D^T
+    // left pseudo-inverse of D^T
+    pseudoInverse = workspace.lu.solve(matrix_t::Identity(constraint.f.size(), constraint.f.size())).transpose();
   }
 
   return std::make_pair(std::move(projectionTerms), std::move(pseudoInverse));
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void luConstraintProjection(const VectorFunctionLinearApproximation& constraint, VectorFunctionLinearApproximation& projectionTerms,
+                            ConstraintProjectionWorkspace& workspace) {
+  // Constraint Projectors are based on the LU decomposition
+  const auto numConstraints = constraint.dfdu.rows();
+  const auto numInputs = constraint.dfdu.cols();
+  const auto numStates = constraint.dfdx.cols();
+  auto& lu = workspace.lu;
+  lu.compute(constraint.dfdu);
+
+  const auto& LU = lu.matrixLU();
+  const auto& p = lu.permutationP().indices();
+  const auto& q = lu.permutationQ().indices();
+  const auto rank = lu.rank();
+  const auto dimKernel = numInputs - rank;
+  const auto smallDim = std::min(numConstraints, numInputs);
+
+  // Solution of D * [Px, Pe] = -[C, e], following FullPivLU::solve: P * D * Q = L * U
+  projectionTerms.dfdx.setZero(numInputs, numStates);
+  projectionTerms.f.setZero(numInputs);
+  if (rank > 0) {
+    auto& c = workspace.luSolution;
+    c.resize(numConstraints, numStates + 1);
+    for (Eigen::Index i = 0; i < numConstraints; ++i) {
+      c.row(p(i)).head(numStates) = constraint.dfdx.row(i);
+      c(p(i), numStates) = constraint.f(i);
+    }
+    LU.topLeftCorner(smallDim, smallDim).triangularView<Eigen::UnitLower>().solveInPlace(c.topRows(smallDim));
+    if (numConstraints > numInputs) {
+      c.bottomRows(numConstraints - numInputs).noalias() -= LU.bottomRows(numConstraints - numInputs) * c.topRows(numInputs);
+    }
+    LU.topLeftCorner(rank, rank).triangularView<Eigen::Upper>().solveInPlace(c.topRows(rank));
+    for (Eigen::Index i = 0; i < rank; ++i) {
+      projectionTerms.dfdx.row(q(i)) = -c.row(i).head(numStates);
+      projectionTerms.f(q(i)) = -c(i, numStates);
+    }
+  }
+
+  // Kernel of D, following FullPivLU::kernel: ker(D) = Q * ker(U). As in Eigen, a trivial kernel is a single zero column.
+  projectionTerms.dfdu.setZero(numInputs, std::max<Eigen::Index>(dimKernel, 1));
+  if (dimKernel > 0) {
+    auto& pivots = workspace.luPivots;
+    pivots.clear();
+    const scalar_t premultipliedThreshold = lu.maxPivot() * lu.threshold();
+    for (Eigen::Index i = 0; i < lu.nonzeroPivots(); ++i) {
+      if (std::abs(LU(i, i)) > premultipliedThreshold) {
+        pivots.push_back(i);
+      }
+    }
+
+    // Trapezoid matrix of the rows of U with non-negligible pivots, which are permuted to the top of the diagonal
+    auto& m = workspace.luKernel;
+    m.resize(rank, numInputs);
+    for (Eigen::Index i = 0; i < rank; ++i) {
+      m.row(i).head(i).setZero();
+      m.row(i).tail(numInputs - i) = LU.row(pivots[i]).tail(numInputs - i);
+    }
+    m.topLeftCorner(rank, rank).triangularView<Eigen::StrictlyLower>().setZero();
+    for (Eigen::Index i = 0; i < rank; ++i) {
+      m.col(i).swap(m.col(pivots[i]));
+    }
+    m.topLeftCorner(rank, rank).triangularView<Eigen::Upper>().solveInPlace(m.topRightCorner(rank, dimKernel));
+    for (Eigen::Index i = rank - 1; i >= 0; --i) {
+      m.col(i).swap(m.col(pivots[i]));
+    }
+
+    for (Eigen::Index i = 0; i < rank; ++i) {
+      projectionTerms.dfdu.row(q(i)) = -m.row(i).tail(dimKernel);
+    }
+    for (Eigen::Index k = 0; k < dimKernel; ++k) {
+      projectionTerms.dfdu(q(rank + k), k) = 1.0;
+    }
+  }
+}
+
 // Explicit instantiations for dynamic sized matrices
 template int rank(const matrix_t& A);
 template Eigen::VectorXcd eigenvalues(const matrix_t& A);
@@ -0,0 +1,317 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/Tracing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace ocs2 {
+namespace tracing {
+
+namespace {
+
+/** Number of events that are kept per thread */
+constexpr size_t ringBufferSize = 1 << 14;
+
+struct ThreadBuffer {
+  explicit ThreadBuffer(std::string name) : threadName(std::move(name)), events(ringBufferSize) {}
+
+  std::string threadName;  // guarded by the registry mutex
+  std::vector<Event> events;
+  std::atomic<size_t> numRecorded{0};
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> threadBuffers;
+  std::unordered_set<std::string> names;
+};
+
+/** The registry is never destroyed, such that threads that exit after main() can still access it. */
+Registry& getRegistry() {
+  static auto* registryPtr = new Registry;
+  return *registryPtr;
+}
+
+/** The ring buffer of the calling thread. It is kept alive by the registry after the thread exits. */
+ThreadBuffer& getThreadBuffer() {
+  thread_local const std::shared_ptr<ThreadBuffer> threadBufferPtr = [] {
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto bufferPtr = std::make_shared<ThreadBuffer>("thread " + std::to_string(registry.threadBuffers.size()));
+    registry.threadBuffers.push_back(bufferPtr);
+    return bufferPtr;
+  }();
+  return *threadBufferPtr;
+}
+
+#ifdef OCS2_ENABLE_TRACING
+std::atomic_bool enabledFlag{true};
+#else
+std::atomic_bool enabledFlag{false};
+#endif
+
+/** Writes a JSON string literal */
+void writeJsonString(std::ostream& stream, const char* str) {
+  stream << '"';
+  for (const char* c = (str != nullptr) ? str : ""; *c != '\0'; ++c) {
+    switch (*c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      case '\t':
+        stream << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20) {
+          stream << ' ';
+        } else {
+          stream << *c;
+        }
+    }
+  }
+  stream << '"';
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t LatencyHistogram::getPercentileInMicroseconds(scalar_t percentile) const {
+  if (count == 0) {
+    return 0.0;
+  }
+
+  const auto target = std::max<size_t>(1, static_cast<size_t>(std::ceil(percentile / 100.0 * count)));
+  size_t cumulativeCount = 0;
+  for (size_t k = 0; k < numBuckets; k++) {
+    cumulativeCount += buckets[k];
+    if (cumulativeCount >= target) {
+      const scalar_t bucketUpperBound = std::ldexp(1.0, static_cast<int>(k));
+      return std::min(bucketUpperBound, maxInMicroseconds);
+    }
+  }
+  return maxInMicroseconds;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isEnabled() {
+  return enabledFlag.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setEnabled(bool enabled) {
+#ifdef OCS2_ENABLE_TRACING
+  enabledFlag.store(enabled);
+#endif
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+int64_t now() {
+  static const auto origin = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void record(const char* category, const char* name, int index, int64_t startTime, int64_t endTime) {
+  auto& threadBuffer = getThreadBuffer();
+  const size_t numRecorded = threadBuffer.numRecorded.load(std::memory_order_relaxed);
+  threadBuffer.events[numRecorded % ringBufferSize] = Event{category, name, index, startTime, endTime - startTime};
+  threadBuffer.numRecorded.store(numRecorded + 1, std::memory_order_release);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const char* internName(const std::string& name) {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  // elements of an unordered_set are not moved on rehashing
+  return registry.names.insert(name).first->c_str();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setThreadName(const std::string& name) {
+  auto& threadBuffer = getThreadBuffer();
+  std::lock_guard<std::mutex> lock(getRegistry().mutex);
+  threadBuffer.threadName = name;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<std::pair<std::string, std::vector<Event>>> getEvents() {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  std::vector<std::pair<std::string, std::vector<Event>>> events;
+  events.reserve(registry.threadBuffers.size());
+  for (const auto& threadBufferPtr : registry.threadBuffers) {
+    const size_t numRecorded = threadBufferPtr->numRecorded.load(std::memory_order_acquire);
+    const size_t first = (numRecorded > ringBufferSize) ? numRecorded - ringBufferSize : 0;
+
+    std::vector<Event> threadEvents;
+    threadEvents.reserve(numRecorded - first);
+    for (size_t i = first; i < numRecorded; i++) {
+      threadEvents.push_back(threadBufferPtr->events[i % ringBufferSize]);
+    }
+    events.emplace_back(threadBufferPtr->threadName, std::move(threadEvents));
+  }
+
+  return events;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void clear() {
+  auto& registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (const auto& threadBufferPtr : registry.threadBuffers) {
+    threadBufferPtr->numRecorded.store(0, std::memory_order_release);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void exportChromeTrace(std::ostream& stream) {
+  const auto events = getEvents();
+
+  const auto flags = stream.flags();
+  const auto precision = stream.precision();
+  stream << std::fixed << std::setprecision(3);
+
+  stream << "{\"traceEvents\":[";
+  const char* separator = "\n";
+  for (size_t threadId = 0; threadId < events.size(); threadId++) {
+    stream << separator << R"({"name":"thread_name","ph":"M","pid":0,"tid":)" << threadId << R"(,"args":{"name":)";
+    writeJsonString(stream, events[threadId].first.c_str());
+    stream << "}}";
+    separator = ",\n";
+
+    for (const auto& event : events[threadId].second) {
+      stream << separator << R"({"name":)";
+      writeJsonString(stream, event.name);
+      stream << R"(,"cat":)";
+      writeJsonString(stream, event.category);
+      stream << R"(,"ph":"X","pid":0,"tid":)" << threadId << R"(,"ts":)" << 1e-3 * event.startTime << R"(,"dur":)"
+             << 1e-3 * event.duration;
+      if (event.index >= 0) {
+        stream << R"(,"args":{"index":)" << event.index << "}";
+      }
+      stream << "}";
+    }
+  }
+  stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  stream.flags(flags);
+  stream.precision(precision);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void exportChromeTrace(const std::string& fileName) {
+  std::ofstream file(fileName);
+  if (!file) {
+    throw std::runtime_error("[tracing::exportChromeTrace] Could not open file: " + fileName);
+  }
+  exportChromeTrace(file);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<LatencyHistogram> getLatencyHistograms() {
+  std::map<std::pair<std::string, std::string>, LatencyHistogram> histogramMap;
+  for (const auto& threadEvents : getEvents()) {
+    for (const auto& event : threadEvents.second) {
+      const std::string category = (event.category != nullptr) ? event.category : "";
+      const std::string name = (event.name != nullptr) ? event.name : "";
+      auto& histogram = histogramMap[{category, name}];
+
+      const scalar_t duration = 1e-3 * event.duration;
+      if (histogram.count == 0) {
+        histogram.category = category;
+        histogram.name = name;
+        histogram.minInMicroseconds = duration;
+        histogram.maxInMicroseconds = duration;
+      } else {
+        histogram.minInMicroseconds = std::min(histogram.minInMicroseconds, duration);
+        histogram.maxInMicroseconds = std::max(histogram.maxInMicroseconds, duration);
+      }
+      histogram.count++;
+      histogram.totalInMicroseconds += duration;
+
+      size_t bucket = 0;
+      while (bucket + 1 < LatencyHistogram::numBuckets && duration >= std::ldexp(1.0, static_cast<int>(bucket))) {
+        bucket++;
+      }
+      histogram.buckets[bucket]++;
+    }
+  }
+
+  std::vector<LatencyHistogram> histograms;
+  histograms.reserve(histogramMap.size());
+  for (auto& entry : histogramMap) {
+    histograms.push_back(std::move(entry.second));
+  }
+  return histograms;
+}
+
+}  // namespace tracing
+}  // namespace ocs2
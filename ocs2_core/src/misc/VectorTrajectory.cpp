@@ -0,0 +1,102 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/VectorTrajectory.h"
+
+#include <cstdint>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorTrajectory::VectorTrajectory(const VectorTrajectory& other) {
+  resize(other.sizes_);
+  flat() = other.flat();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VectorTrajectory::resize(const std::vector<int>& sizes) {
+  sizes_ = sizes;
+  offsets_.resize(sizes_.size() + 1);
+  offsets_[0] = 0;
+  for (size_t i = 0; i < sizes_.size(); i++) {
+    const int paddedSize = (sizes_[i] + alignment_ - 1) / alignment_ * alignment_;
+    offsets_[i + 1] = offsets_[i] + paddedSize;
+  }
+
+  const size_t requiredBufferSize = (offsets_.back() > 0) ? offsets_.back() + alignment_ - 1 : 0;
+  if (buffer_.size() < requiredBufferSize) {
+    buffer_.resize(requiredBufferSize);
+    constexpr std::uintptr_t alignmentBytes = alignment_ * sizeof(scalar_t);
+    const auto address = reinterpret_cast<std::uintptr_t>(buffer_.data());
+    data_ = buffer_.data() + ((alignmentBytes - address % alignmentBytes) % alignmentBytes) / sizeof(scalar_t);
+  }
+
+  setZero();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VectorTrajectory::assign(const vector_array_t& array) {
+  std::vector<int> sizes(array.size());
+  for (size_t i = 0; i < array.size(); i++) {
+    sizes[i] = static_cast<int>(array[i].size());
+  }
+
+  resize(sizes);
+  for (size_t i = 0; i < array.size(); i++) {
+    (*this)[i] = array[i];
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VectorTrajectory::toArray(vector_array_t& array) const {
+  array.resize(size());
+  for (size_t i = 0; i < size(); i++) {
+    array[i] = (*this)[i];
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VectorTrajectory::swap(VectorTrajectory& other) noexcept {
+  sizes_.swap(other.sizes_);
+  offsets_.swap(other.offsets_);
+  buffer_.swap(other.buffer_);
+  std::swap(data_, other.data_);
+}
+
+}  // namespace ocs2
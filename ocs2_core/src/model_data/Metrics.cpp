@@ -142,6 +142,19 @@ vector_array_t toConstraintArray(const size_array_t& termsSize, const vector_t&
   return constraintArray;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void toConstraintArray(const size_array_t& termsSize, const vector_t& vec, vector_array_t& constraintArray) {
+  constraintArray.resize(termsSize.size());
+
+  size_t head = 0;
+  for (size_t i = 0; i < termsSize.size(); ++i) {
+    constraintArray[i] = vec.segment(head, termsSize[i]);
+    head += termsSize[i];
+  }  // end of i loop
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
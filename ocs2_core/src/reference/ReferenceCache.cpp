@@ -0,0 +1,88 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/reference/ReferenceCache.h"
+
+#include <algorithm>
+
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ReferenceCache::update(const TargetTrajectories& targetTrajectories, scalar_array_t timeGrid) {
+  if (targetTrajectories.empty()) {
+    throw std::runtime_error("[ReferenceCache] TargetTrajectories is empty!");
+  }
+  assert(std::is_sorted(timeGrid.begin(), timeGrid.end()));
+
+  timeGrid_ = std::move(timeGrid);
+  hasDesiredInput_ = !targetTrajectories.inputTrajectory.empty();
+  desiredStates_.resize(timeGrid_.size());
+  desiredInputs_.resize(hasDesiredInput_ ? timeGrid_.size() : 0);
+
+  // the grid is sorted, so the cursor advances by at most a few intervals per node
+  LinearInterpolation::TimeSegmentCursor cursor;
+  for (size_t i = 0; i < timeGrid_.size(); i++) {
+    const auto indexAlpha = cursor.timeSegment(timeGrid_[i], targetTrajectories.timeTrajectory);
+    desiredStates_[i] = LinearInterpolation::interpolate(indexAlpha, targetTrajectories.stateTrajectory);
+    if (hasDesiredInput_) {
+      desiredInputs_[i] = LinearInterpolation::interpolate(indexAlpha, targetTrajectories.inputTrajectory);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ReferenceCache::clear() {
+  timeGrid_.clear();
+  desiredStates_.clear();
+  desiredInputs_.clear();
+  hasDesiredInput_ = false;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+int ReferenceCache::findNode(scalar_t time, int hint) const {
+  const int numNodes = static_cast<int>(timeGrid_.size());
+  for (int i = std::max(hint, 0); i < std::min(hint + 2, numNodes); i++) {
+    if (timeGrid_[i] == time) {
+      return i;
+    }
+  }
+
+  const auto it = std::lower_bound(timeGrid_.cbegin(), timeGrid_.cend(), time);
+  return (it != timeGrid_.cend() && *it == time) ? static_cast<int>(std::distance(timeGrid_.cbegin(), it)) : -1;
+}
+
+}  // namespace ocs2
@@ -27,18 +27,106 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <ocs2_core/misc/Tracing.h>
 #include <ocs2_core/thread_support/SetThreadPriority.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_core/thread_support/WorkStealingDeque.h>
 
 namespace ocs2 {
 
+namespace {
+
+/** The pool and worker index of the calling thread, set for the worker threads of work-stealing pools. */
+thread_local const ThreadPool* currentPoolPtr = nullptr;
+thread_local int currentWorkerIndex = -1;
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+ * Busy-waits until the predicate is satisfied or the spin duration has passed.
+ * @return The last evaluation of the predicate.
+ */
+template <typename Predicate>
+bool spinUntil(Predicate&& predicate, std::chrono::microseconds spinDuration) {
+  if (predicate()) {
+    return true;
+  }
+  if (spinDuration.count() > 0) {
+    const auto deadline = std::chrono::steady_clock::now() + spinDuration;
+    do {
+      for (int i = 0; i < 64; ++i) {
+        if (predicate()) {
+          return true;
+        }
+        cpuRelax();
+      }
+    } while (std::chrono::steady_clock::now() < deadline);
+  }
+  return predicate();
+}
+
+}  // unnamed namespace
+
+/**
+ * Shared state of the work-stealing mode.
+ */
+struct ThreadPool::WorkStealingState {
+  explicit WorkStealingState(size_t nThreads, std::chrono::microseconds spin) : spinDuration(spin) {
+    workerQueues.reserve(nThreads);
+    for (size_t i = 0; i < nThreads; i++) {
+      workerQueues.emplace_back(new WorkStealingDeque<TaskBase>());
+    }
+  }
+
+  ~WorkStealingState() {
+    for (auto& queue : workerQueues) {
+      while (auto* taskPtr = queue->pop()) {
+        delete taskPtr;
+      }
+    }
+  }
+
+  const std::chrono::microseconds spinDuration;
+
+  std::vector<std::unique_ptr<WorkStealingDeque<TaskBase>>> workerQueues;
+  std::atomic<size_t> numSharedTasks{0};  //!< number of tasks in the shared taskQueue_
+
+  std::atomic<uint64_t> workEpoch{0};  //!< incremented every time new work is published
+  std::atomic_int numSleepingWorkers{0};
+
+  // The current parallel task of runParallel
+  std::atomic_bool parallelTaskBusy{false};
+  std::function<void(int)>* parallelTaskPtr = nullptr;
+  std::atomic_int numUnclaimedInstances{0};
+  std::atomic_int numUnfinishedInstances{0};
+  std::atomic_bool callerWaiting{false};
+  std::atomic_bool parallelTaskFailed{false};
+  std::exception_ptr parallelTaskException;
+  std::mutex parallelTaskLock;
+  std::condition_variable parallelTaskCondition;
+};
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
-ThreadPool::ThreadPool(size_t nThreads, int priority) {
+ThreadPool::ThreadPool(size_t nThreads, int priority, bool workStealing, std::chrono::microseconds spinDuration) {
+  if (workStealing) {
+    workStealingStatePtr_.reset(new WorkStealingState(nThreads, spinDuration));
+  }
+
   workerThreads_.reserve(nThreads);
   for (size_t i = 0; i < nThreads; i++) {
-    workerThreads_.emplace_back(&ThreadPool::worker, this, i);
+    if (workStealing) {
+      workerThreads_.emplace_back(&ThreadPool::workStealingWorker, this, i);
+    } else {
+      workerThreads_.emplace_back(&ThreadPool::worker, this, i);
+    }
     setThreadPriority(priority, workerThreads_.back());
   }
 }
@@ -50,6 +138,9 @@ ThreadPool::~ThreadPool() {
   {  // set exit flag, wake up threads and join
     std::lock_guard<std::mutex> lock(taskQueueLock_);
     stop_ = true;
+    if (workStealingStatePtr_ != nullptr) {
+      workStealingStatePtr_->workEpoch.fetch_add(1);
+    }
   }
   taskQueueCondition_.notify_all();
   for (auto& thread : workerThreads_) {
@@ -63,6 +154,7 @@ ThreadPool::~ThreadPool() {
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::worker(int workerIndex) {
+  OCS2_TRACE_THREAD_NAME("ThreadPool worker " + std::to_string(workerIndex));
   while (true) {
     std::unique_ptr<ThreadPool::TaskBase> taskPtr;
     {
@@ -82,26 +174,218 @@ void ThreadPool::worker(int workerIndex) {
     }
 
     if (taskPtr) {
+      OCS2_TRACE_SCOPE("ThreadPool", "task");
       taskPtr->operator()(workerIndex);
     }
   }
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::workStealingWorker(int workerIndex) {
+  auto& state = *workStealingStatePtr_;
+  currentPoolPtr = this;
+  currentWorkerIndex = workerIndex;
+  OCS2_TRACE_THREAD_NAME("ThreadPool worker " + std::to_string(workerIndex));
+
+  while (true) {
+    // read the epoch before looking for work, such that work published in the meantime is not missed
+    const auto epoch = state.workEpoch.load();
+
+    if (runParallelInstance(workerIndex) || runQueuedTask(workerIndex)) {
+      continue;
+    }
+
+    // exit condition
+    if (stop_) {
+      break;
+    }
+
+    // spin, then sleep until new work is published
+    const auto hasNewWork = [&] { return state.workEpoch.load(std::memory_order_relaxed) != epoch; };
+    if (!spinUntil(hasNewWork, state.spinDuration)) {
+      std::unique_lock<std::mutex> lock(taskQueueLock_);
+      state.numSleepingWorkers.fetch_add(1);
+      taskQueueCondition_.wait(lock, [&] { return state.workEpoch.load() != epoch; });
+      state.numSleepingWorkers.fetch_sub(1);
+    }
+  }
+
+  currentPoolPtr = nullptr;
+  currentWorkerIndex = -1;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+bool ThreadPool::runParallelInstance(int workerIndex) {
+  auto& state = *workStealingStatePtr_;
+
+  int numUnclaimed = state.numUnclaimedInstances.load(std::memory_order_relaxed);
+  while (numUnclaimed > 0) {
+    if (state.numUnclaimedInstances.compare_exchange_weak(numUnclaimed, numUnclaimed - 1, std::memory_order_acquire,
+                                                          std::memory_order_relaxed)) {
+      try {
+        OCS2_TRACE_SCOPE("ThreadPool", "parallelTask");
+        (*state.parallelTaskPtr)(workerIndex);
+      } catch (...) {
+        if (!state.parallelTaskFailed.exchange(true)) {
+          state.parallelTaskException = std::current_exception();
+        }
+      }
+
+      // the last instance wakes up the caller of runParallel if it went to sleep
+      if (state.numUnfinishedInstances.fetch_sub(1) == 1 && state.callerWaiting.load()) {
+        { std::lock_guard<std::mutex> lock(state.parallelTaskLock); }
+        state.parallelTaskCondition.notify_one();
+      }
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+bool ThreadPool::runQueuedTask(int workerIndex) {
+  auto& state = *workStealingStatePtr_;
+
+  // own deque
+  TaskBase* taskPtr = state.workerQueues[workerIndex]->pop();
+
+  // shared queue
+  if (taskPtr == nullptr && state.numSharedTasks.load(std::memory_order_relaxed) > 0) {
+    std::lock_guard<std::mutex> lock(taskQueueLock_);
+    if (!taskQueue_.empty()) {
+      taskPtr = taskQueue_.front().release();
+      taskQueue_.pop();
+      state.numSharedTasks.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  // steal from the other workers
+  const int nQueues = static_cast<int>(state.workerQueues.size());
+  for (int i = 1; taskPtr == nullptr && i < nQueues; ++i) {
+    taskPtr = state.workerQueues[(workerIndex + i) % nQueues]->steal();
+  }
+
+  if (taskPtr == nullptr) {
+    return false;
+  }
+
+  std::unique_ptr<TaskBase> task(taskPtr);
+  OCS2_TRACE_SCOPE("ThreadPool", "task");
+  task->operator()(workerIndex);
+  return true;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::notifyWorkers(bool all) {
+  auto& state = *workStealingStatePtr_;
+  state.workEpoch.fetch_add(1);
+  if (state.numSleepingWorkers.load() > 0) {
+    // taking the lock guarantees that a worker which is about to sleep is already waiting on the condition
+    { std::lock_guard<std::mutex> lock(taskQueueLock_); }
+    if (all) {
+      taskQueueCondition_.notify_all();
+    } else {
+      taskQueueCondition_.notify_one();
+    }
+  }
+}
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::runTask(std::unique_ptr<TaskBase> taskPtr) {
-  {
+  if (workStealingStatePtr_ == nullptr) {
+    {
+      std::lock_guard<std::mutex> lock(taskQueueLock_);
+      taskQueue_.push(std::move(taskPtr));
+    }
+    taskQueueCondition_.notify_one();
+    return;
+  }
+
+  auto& state = *workStealingStatePtr_;
+  if (currentPoolPtr == this && state.workerQueues[currentWorkerIndex]->push(taskPtr.get())) {
+    taskPtr.release();
+  } else {
     std::lock_guard<std::mutex> lock(taskQueueLock_);
     taskQueue_.push(std::move(taskPtr));
+    state.numSharedTasks.fetch_add(1, std::memory_order_relaxed);
   }
-  taskQueueCondition_.notify_one();
+  notifyWorkers(false);
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+bool ThreadPool::runParallelWorkStealing(std::function<void(int)>& taskFunction, int N) {
+  auto& state = *workStealingStatePtr_;
+
+  // only one parallel task at a time, concurrent or nested calls fall back to the task based implementation
+  bool expected = false;
+  if (!state.parallelTaskBusy.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+    return false;
+  }
+
+  // publish the helper instances
+  const int numHelpers = N - 1;
+  state.parallelTaskPtr = &taskFunction;
+  state.parallelTaskFailed.store(false, std::memory_order_relaxed);
+  state.parallelTaskException = nullptr;
+  state.numUnfinishedInstances.store(numHelpers, std::memory_order_relaxed);
+  state.numUnclaimedInstances.store(numHelpers, std::memory_order_release);
+  notifyWorkers(true);
+
+  // Execute one instance in this thread, then help with the instances the workers have not claimed yet.
+  const auto workerId = static_cast<int>(numThreads());  // threadpool workers use ID 0 -> nThreads - 1
+  std::exception_ptr callerException;
+  try {
+    taskFunction(workerId);
+  } catch (...) {
+    callerException = std::current_exception();
+  }
+  while (runParallelInstance(workerId)) {
+  }
+
+  // Wait for helpers to finish.
+  const auto isFinished = [&] { return state.numUnfinishedInstances.load() == 0; };
+  if (!spinUntil(isFinished, state.spinDuration)) {
+    std::unique_lock<std::mutex> lock(state.parallelTaskLock);
+    state.callerWaiting.store(true);
+    state.parallelTaskCondition.wait(lock, isFinished);
+    state.callerWaiting.store(false);
+  }
+
+  if (callerException == nullptr && state.parallelTaskFailed.load(std::memory_order_relaxed)) {
+    callerException = state.parallelTaskException;
+  }
+  state.parallelTaskException = nullptr;
+  state.parallelTaskBusy.store(false, std::memory_order_release);
+
+  if (callerException != nullptr) {
+    std::rethrow_exception(callerException);
+  }
+  return true;
 }
 
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::runParallel(std::function<void(int)> taskFunction, int N) {
+  if (workStealingStatePtr_ != nullptr && N > 1 && !workerThreads_.empty()) {
+    if (runParallelWorkStealing(taskFunction, N)) {
+      return;
+    }
+  }
+
   // Launch tasks in helper threads
   std::vector<std::future<void>> futures;
   if (N > 1) {
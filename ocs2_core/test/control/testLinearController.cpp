@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
 #include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/test/AllocationCounter.h>
+
+OCS2_DEFINE_ALLOCATION_COUNTER
 
 using namespace ocs2;
 
@@ -24,3 +27,22 @@ TEST(testLinearController, testSerialization) {
     EXPECT_TRUE(controller.biasArray_[k].isApprox(controllerOut.biasArray_[k], 1e-6));
   }
 }
+
+TEST(testLinearController, computeInputInPlaceDoesNotAllocate) {
+  const scalar_array_t time = {0.0, 0.5, 1.0};
+  const vector_array_t bias = {vector_t::Random(2), vector_t::Random(2), vector_t::Random(2)};
+  const matrix_array_t gain = {matrix_t::Random(2, 3), matrix_t::Random(2, 3), matrix_t::Random(2, 3)};
+  LinearController controller(time, bias, gain);
+  const vector_t x = vector_t::Random(3);
+
+  // the first evaluation between two nodes sizes the gain workspace and the input
+  vector_t u;
+  controller.computeInputInPlace(0.25, x, u);
+
+  test::ScopedAllocationCounter allocationCounter;
+  for (int k = 0; k <= 100; ++k) {
+    controller.computeInputInPlace(-0.1 + 0.012 * k, x, u);
+  }
+  EXPECT_EQ(allocationCounter.count(), 0);
+  EXPECT_TRUE(u.isApprox(controller.computeInput(1.1, x)));
+}
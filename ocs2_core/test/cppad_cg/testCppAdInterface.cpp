@@ -60,3 +60,38 @@ TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ASSERT_TRUE(gnApproximation.dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
+
+TEST_F(CppAdInterfaceParameterizedFixture, batchedEvaluation) {
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelBatchedEvaluation");
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+
+  constexpr size_t numPoints = 5;
+  const matrix_t x = matrix_t::Random(variableDim_, numPoints);
+  const matrix_t p = matrix_t::Random(parameterDim_, numPoints);
+  const matrix_t w = matrix_t::Random(rangeDim_, numPoints);
+
+  matrix_t values, jacobians, hessians;
+  std::vector<ScalarFunctionQuadraticApproximation> gnApproximations;
+  adInterface.getFunctionValues(x, p, values);
+  adInterface.getJacobians(x, p, jacobians);
+  adInterface.getHessians(w, x, p, hessians);
+  adInterface.getGaussNewtonApproximations(x, p, gnApproximations);
+
+  ASSERT_EQ(gnApproximations.size(), numPoints);
+  for (size_t i = 0; i < numPoints; i++) {
+    EXPECT_TRUE(values.col(i).isApprox(testFun(x.col(i), p.col(i))));
+    EXPECT_TRUE(jacobians.middleCols(i * variableDim_, variableDim_).isApprox(testJacobian(x.col(i), p.col(i))));
+    EXPECT_TRUE(hessians.middleCols(i * variableDim_, variableDim_).isApprox(adInterface.getHessian(w.col(i), x.col(i), p.col(i))));
+
+    const auto gnApproximation = adInterface.getGaussNewtonApproximation(x.col(i), p.col(i));
+    EXPECT_DOUBLE_EQ(gnApproximations[i].f, gnApproximation.f);
+    EXPECT_TRUE(gnApproximations[i].dfdx.isApprox(gnApproximation.dfdx));
+    EXPECT_TRUE(gnApproximations[i].dfdxx.isApprox(gnApproximation.dfdxx));
+  }
+
+  // A single parameter column is shared by all points
+  adInterface.getJacobians(x, p.col(0), jacobians);
+  for (size_t i = 0; i < numPoints; i++) {
+    EXPECT_TRUE(jacobians.middleCols(i * variableDim_, variableDim_).isApprox(testJacobian(x.col(i), p.col(0))));
+  }
+}
@@ -0,0 +1,137 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <boost/filesystem.hpp>
+
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+#include <ocs2_core/automatic_differentiation/CppAdModelBuilder.h>
+
+using namespace ocs2;
+
+namespace {
+
+const std::string modelFolder = "/tmp/ocs2/testCppAdModelBuilder";
+
+/** y = scale * [x0 * x1, x1^2] */
+std::unique_ptr<CppAdInterface> getModel(scalar_t scale, const std::string& modelName) {
+  auto adFunction = [scale](const ad_vector_t& x, ad_vector_t& y) {
+    y.resize(2);
+    y(0) = scale * x(0) * x(1);
+    y(1) = scale * x(1) * x(1);
+  };
+  return std::unique_ptr<CppAdInterface>(new CppAdInterface(adFunction, 2, modelName, modelFolder));
+}
+
+vector_t getFunctionValue(scalar_t scale, const vector_t& x) {
+  vector_t y(2);
+  y << scale * x(0) * x(1), scale * x(1) * x(1);
+  return y;
+}
+
+}  // unnamed namespace
+
+class CppAdModelBuilderTest : public ::testing::Test {
+ protected:
+  CppAdModelBuilderTest() { boost::filesystem::remove_all(modelFolder); }
+
+  const vector_t x = vector_t::Random(2);
+};
+
+TEST_F(CppAdModelBuilderTest, regenerateOutdatedLibrary) {
+  const auto order = CppAdInterface::ApproximationOrder::First;
+
+  // Library is created and stored with its hash
+  auto model = getModel(1.0, "model");
+  model->loadModelsIfAvailable(order, false);
+  ASSERT_TRUE(boost::filesystem::exists(modelFolder + "/model/cppad_generated/model_lib.hash"));
+
+  // Same tape: library is loaded
+  CppAdModelBuilder modelBuilder;
+  auto sameModel = getModel(1.0, "model");
+  modelBuilder.add(*sameModel, order, false);
+  EXPECT_EQ(modelBuilder.getNumPendingModels(), 0u);
+  EXPECT_TRUE(sameModel->getFunctionValue(x).isApprox(getFunctionValue(1.0, x)));
+
+  // Different tape: library is outdated. The loaded library is closed first, dlopen would return it again otherwise.
+  model.reset();
+  sameModel.reset();
+  auto changedModel = getModel(2.0, "model");
+  modelBuilder.add(*changedModel, order, false);
+  EXPECT_EQ(modelBuilder.getNumPendingModels(), 1u);
+  EXPECT_EQ(modelBuilder.build(), 1u);
+  EXPECT_TRUE(changedModel->getFunctionValue(x).isApprox(getFunctionValue(2.0, x)));
+  EXPECT_TRUE(changedModel->getJacobian(x).isApprox((matrix_t(2, 2) << 2.0 * x(1), 2.0 * x(0), 0.0, 4.0 * x(1)).finished()));
+
+  // Different approximation order: library is outdated
+  auto secondOrderModel = getModel(2.0, "model");
+  modelBuilder.add(*secondOrderModel, CppAdInterface::ApproximationOrder::Second, false);
+  EXPECT_EQ(modelBuilder.getNumPendingModels(), 1u);
+}
+
+TEST_F(CppAdModelBuilderTest, parallelBuild) {
+  constexpr size_t numModels = 4;
+  CppAdModelBuilder modelBuilder(3);
+
+  std::vector<std::unique_ptr<CppAdInterface>> models;
+  modelBuilder.startCollecting();
+  for (size_t i = 0; i < numModels; i++) {
+    models.push_back(getModel(i + 1.0, "model" + std::to_string(i)));
+    models.back()->createModels(CppAdInterface::ApproximationOrder::First, false);
+  }
+  // Deferred models are compiled and loaded together
+  EXPECT_EQ(modelBuilder.getNumPendingModels(), numModels);
+  EXPECT_EQ(modelBuilder.build(), numModels);
+  EXPECT_EQ(modelBuilder.getNumPendingModels(), 0u);
+
+  for (size_t i = 0; i < numModels; i++) {
+    EXPECT_TRUE(models[i]->getFunctionValue(x).isApprox(getFunctionValue(i + 1.0, x)));
+  }
+
+  // After build, models are compiled directly
+  auto model = getModel(1.0, "model");
+  model->createModels(CppAdInterface::ApproximationOrder::First, false);
+  EXPECT_EQ(modelBuilder.getNumPendingModels(), 0u);
+  EXPECT_TRUE(model->getFunctionValue(x).isApprox(getFunctionValue(1.0, x)));
+}
+
+TEST_F(CppAdModelBuilderTest, destroyedModel) {
+  CppAdModelBuilder modelBuilder;
+  modelBuilder.startCollecting();
+  {
+    auto model = getModel(1.0, "model");
+    model->createModels(CppAdInterface::ApproximationOrder::First, false);
+    EXPECT_EQ(modelBuilder.getNumPendingModels(), 1u);
+  }
+  EXPECT_EQ(modelBuilder.getNumPendingModels(), 0u);
+  EXPECT_EQ(modelBuilder.build(), 0u);
+}
@@ -0,0 +1,132 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace ocs2 {
+namespace test {
+
+/** Number of heap allocations since the start of the program. Only counts in an executable that uses OCS2_DEFINE_ALLOCATION_COUNTER. */
+inline std::atomic<size_t>& allocationCounter() {
+  static std::atomic<size_t> counter{0};
+  return counter;
+}
+
+/** Nesting depth of ScopedAllocationPause on the calling thread */
+inline int& allocationPauseDepth() {
+  thread_local int depth = 0;
+  return depth;
+}
+
+/** Called by the replaced allocation functions, see OCS2_DEFINE_ALLOCATION_COUNTER */
+inline void countAllocation() {
+  if (allocationPauseDepth() == 0) {
+    ++allocationCounter();
+  }
+}
+
+/**
+ * Counts the heap allocations which happen during the lifetime of this object.
+ *
+ * Usage:
+ *    OCS2_DEFINE_ALLOCATION_COUNTER  // once, at global scope of a single translation unit of the test executable
+ *
+ *    ScopedAllocationCounter allocationCounter;
+ *    functionUnderTest();
+ *    EXPECT_EQ(allocationCounter.count(), 0);
+ */
+class ScopedAllocationCounter {
+ public:
+  ScopedAllocationCounter() : start_(allocationCounter().load()) {}
+
+  /** Number of heap allocations since the construction of this object */
+  size_t count() const { return allocationCounter().load() - start_; }
+
+ private:
+  size_t start_;
+};
+
+/**
+ * Excludes the heap allocations of the calling thread from the count during the lifetime of this object. This is used to leave out the
+ * allocations of user-defined models, which are not under control of the code under test.
+ */
+class ScopedAllocationPause {
+ public:
+  ScopedAllocationPause() { ++allocationPauseDepth(); }
+  ~ScopedAllocationPause() { --allocationPauseDepth(); }
+  ScopedAllocationPause(const ScopedAllocationPause&) = delete;
+  ScopedAllocationPause& operator=(const ScopedAllocationPause&) = delete;
+};
+
+}  // namespace test
+}  // namespace ocs2
+
+/**
+ * Replaces the global allocation functions such that they increment ocs2::test::allocationCounter(). On glibc, malloc itself is
+ * interposed, which also captures the allocations of Eigen and of the shared libraries. Elsewhere, only operator new is counted.
+ */
+#if defined(__GLIBC__)
+#define OCS2_DEFINE_ALLOCATION_COUNTER                                            \
+  extern "C" {                                                                    \
+  void* __libc_malloc(size_t size);                                               \
+  void* __libc_calloc(size_t num, size_t size);                                   \
+  void* __libc_realloc(void* ptr, size_t size);                                   \
+  void* malloc(size_t size) noexcept {                                            \
+    ocs2::test::countAllocation();                                                \
+    return __libc_malloc(size);                                                   \
+  }                                                                               \
+  void* calloc(size_t num, size_t size) noexcept {                                \
+    ocs2::test::countAllocation();                                                \
+    return __libc_calloc(num, size);                                              \
+  }                                                                               \
+  void* realloc(void* ptr, size_t size) noexcept {                                \
+    ocs2::test::countAllocation();                                                \
+    return __libc_realloc(ptr, size);                                             \
+  }                                                                               \
+  }
+#else
+#define OCS2_DEFINE_ALLOCATION_COUNTER                                            \
+  void* operator new(std::size_t size) {                                          \
+    ocs2::test::countAllocation();                                                \
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {                          \
+      return ptr;                                                                 \
+    }                                                                             \
+    throw std::bad_alloc();                                                       \
+  }                                                                               \
+  void* operator new[](std::size_t size) { return operator new(size); }           \
+  void operator delete(void* ptr) noexcept { std::free(ptr); }                    \
+  void operator delete[](void* ptr) noexcept { std::free(ptr); }                  \
+  void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }       \
+  void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+#endif
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <cstdlib>
 #include <iostream>
 
 #include <ocs2_core/misc/LinearInterpolation.h>
@@ -132,3 +133,76 @@ TEST(testLinearInterpolation, testDifferentEigenSizes) {
   result = ocs2::LinearInterpolation::interpolate(1.1, times, data);
   EXPECT_TRUE(result.isApprox(data[1]));
 }
+
+TEST(testLinearInterpolation, testTimeSegmentCursor) {
+  // includes an event time and a duplicated time stamp
+  const std::vector<double> times{0.0, 0.1, 0.25, 0.25, 0.4, 0.4, 0.4, 0.7, 1.0, 1.2, 1.5, 1.5, 2.0};
+
+  std::vector<double> queries;
+  for (int i = -5; i <= 215; ++i) {
+    queries.push_back(0.01 * i);  // monotone sweep
+  }
+  queries.insert(queries.end(), times.begin(), times.end());   // exactly on the time stamps
+  queries.insert(queries.end(), times.rbegin(), times.rend());  // backward
+  std::srand(0);
+  for (int i = 0; i < 200; ++i) {
+    queries.push_back(2.4 * std::rand() / RAND_MAX - 0.2);  // random jumps
+  }
+
+  ocs2::LinearInterpolation::TimeSegmentCursor cursor;
+  for (const auto t : queries) {
+    const auto expected = ocs2::LinearInterpolation::timeSegment(t, times);
+    const auto indexAlpha = cursor.timeSegment(t, times);
+    EXPECT_EQ(indexAlpha.first, expected.first) << "t = " << t;
+    EXPECT_DOUBLE_EQ(indexAlpha.second, expected.second) << "t = " << t;
+  }
+
+  // the hint stays valid if the time array shrinks
+  const std::vector<double> shortTimes{0.0, 1.0};
+  const auto indexAlpha = cursor.timeSegment(0.5, shortTimes);
+  EXPECT_EQ(indexAlpha.first, 0);
+  EXPECT_DOUBLE_EQ(indexAlpha.second, 0.5);
+  EXPECT_EQ(cursor.timeSegment(0.5, std::vector<double>{}).first, 0);
+}
+
+TEST(testLinearInterpolation, testInterpolateAffine) {
+  const std::vector<double> times{0.0, 1.0, 1.0, 2.0};
+  const ocs2::vector_array_t bias{ocs2::vector_t::Random(3), ocs2::vector_t::Random(3), ocs2::vector_t::Random(3), ocs2::vector_t::Random(3)};
+  const ocs2::matrix_array_t gain{ocs2::matrix_t::Random(3, 2), ocs2::matrix_t::Random(3, 2), ocs2::matrix_t::Random(3, 2),
+                                  ocs2::matrix_t::Random(3, 2)};
+  const ocs2::vector_t x = ocs2::vector_t::Random(2);
+
+  ocs2::vector_t result;
+  ocs2::matrix_t gainWorkspace;
+  for (const auto t : {-0.5, 0.0, 0.3, 1.0, 1.5, 2.0, 2.5}) {
+    const auto indexAlpha = ocs2::LinearInterpolation::timeSegment(t, times);
+    const ocs2::vector_t expected =
+        ocs2::LinearInterpolation::interpolate(indexAlpha, bias) + ocs2::LinearInterpolation::interpolate(indexAlpha, gain) * x;
+    ocs2::LinearInterpolation::interpolateAffine(indexAlpha, bias, gain, x, result, gainWorkspace);
+    EXPECT_TRUE(result.isApprox(expected)) << "t = " << t;
+  }
+
+  // the result is bit-identical to the one of the interpolated bias and gain, the solvers are sensitive to the rounding
+  const ocs2::vector_array_t largeBias{ocs2::vector_t::Random(12), ocs2::vector_t::Random(12)};
+  const ocs2::matrix_array_t largeGain{ocs2::matrix_t::Random(12, 24), ocs2::matrix_t::Random(12, 24)};
+  const ocs2::vector_t largeX = ocs2::vector_t::Random(24);
+  for (const auto alpha : {0.0, 0.123456789, 0.5, 0.987654321, 1.0}) {
+    ocs2::vector_t expected = ocs2::LinearInterpolation::interpolate({0, alpha}, largeBias);
+    const ocs2::matrix_t interpolatedGain = ocs2::LinearInterpolation::interpolate({0, alpha}, largeGain);
+    expected.noalias() += interpolatedGain * largeX;
+    ocs2::LinearInterpolation::interpolateAffine({0, alpha}, largeBias, largeGain, largeX, result, gainWorkspace);
+    EXPECT_TRUE(result == expected) << "alpha = " << alpha;
+  }
+
+  // a single node is a constant function
+  const ocs2::vector_array_t singleBias{bias[0]};
+  const ocs2::matrix_array_t singleGain{gain[0]};
+  ocs2::LinearInterpolation::interpolateAffine({0, 1.0}, singleBias, singleGain, x, result, gainWorkspace);
+  EXPECT_TRUE(result.isApprox(bias[0] + gain[0] * x));
+
+  // different sizes snap to the closest node
+  const ocs2::matrix_array_t mixedGain{ocs2::matrix_t::Random(3, 2), ocs2::matrix_t::Random(3, 3)};
+  const ocs2::vector_array_t mixedBias{bias[0], bias[1]};
+  ocs2::LinearInterpolation::interpolateAffine({0, 0.7}, mixedBias, mixedGain, x, result, gainWorkspace);
+  EXPECT_TRUE(result.isApprox(0.7 * bias[0] + 0.3 * bias[1] + mixedGain[0] * x));
+}
@@ -108,6 +108,36 @@ TEST(test_projection, testProjectionLU) {
   ASSERT_TRUE((pseudoInverse.transpose() * constraint.f).isApprox(-projection.f));
 }
 
+TEST(test_projection, testProjectionLURankDeficient) {
+  constexpr int nx = 6;
+  constexpr int nu = 5;
+  constexpr int nc = 4;
+  const auto constraint = [&]() {
+    ocs2::VectorFunctionLinearApproximation approx;
+    approx.dfdx = ocs2::matrix_t::Random(nc, nx);
+    approx.dfdu = ocs2::matrix_t::Random(nc, nu);
+    approx.dfdu.row(nc - 1) = approx.dfdu.row(0) - approx.dfdu.row(1);  // rank nc - 1
+    approx.f = ocs2::vector_t::Random(nc);
+    return approx;
+  }();
+
+  // Compare against the decomposition of Eigen
+  const Eigen::FullPivLU<ocs2::matrix_t> lu(constraint.dfdu);
+  ASSERT_EQ(lu.rank(), nc - 1);
+
+  ocs2::VectorFunctionLinearApproximation projection;
+  ocs2::LinearAlgebra::ConstraintProjectionWorkspace workspace;
+  ocs2::LinearAlgebra::luConstraintProjection(constraint, projection, workspace);
+  ASSERT_EQ(projection.dfdu.cols(), nu - lu.rank());
+  ASSERT_TRUE(projection.dfdu.isApprox(lu.kernel()));
+  ASSERT_TRUE(projection.dfdx.isApprox(-lu.solve(constraint.dfdx)));
+  ASSERT_TRUE(projection.f.isApprox(-lu.solve(constraint.f)));
+
+  // The workspace is reusable
+  ocs2::LinearAlgebra::luConstraintProjection(constraint, projection, workspace);
+  ASSERT_TRUE(projection.dfdu.isApprox(lu.kernel()));
+}
+
 TEST(LLTofInverse, checkAgainstFullInverse) {
   constexpr size_t n = 10;        // matrix size
   constexpr ocs2::scalar_t tol = 1e-9;  // Coefficient-wise tolerance
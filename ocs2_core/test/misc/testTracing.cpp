@@ -0,0 +1,142 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+#include <ocs2_core/misc/Tracing.h>
+
+using namespace ocs2;
+
+namespace {
+size_t countEvents(const char* category) {
+  size_t count = 0;
+  for (const auto& threadEvents : tracing::getEvents()) {
+    for (const auto& event : threadEvents.second) {
+      count += (event.category == category) ? 1 : 0;
+    }
+  }
+  return count;
+}
+}  // namespace
+
+TEST(testTracing, record) {
+  tracing::clear();
+  tracing::record("testRecord", "event", 3, 1000, 3500);
+  std::thread([] { tracing::record("testRecord", "event", -1, 2000, 2500); }).join();
+
+  ASSERT_EQ(countEvents("testRecord"), 2u);
+  for (const auto& threadEvents : tracing::getEvents()) {
+    for (const auto& event : threadEvents.second) {
+      if (event.index == 3) {
+        EXPECT_STREQ(event.name, "event");
+        EXPECT_EQ(event.startTime, 1000);
+        EXPECT_EQ(event.duration, 2500);
+      }
+    }
+  }
+
+  tracing::clear();
+  EXPECT_EQ(countEvents("testRecord"), 0u);
+}
+
+TEST(testTracing, ringBuffer) {
+  tracing::clear();
+  const int numEvents = 100000;
+  for (int i = 0; i < numEvents; i++) {
+    tracing::record("testRingBuffer", "event", i, i, i + 1);
+  }
+
+  const size_t numKept = countEvents("testRingBuffer");
+  ASSERT_GT(numKept, 0u);
+  ASSERT_LT(numKept, static_cast<size_t>(numEvents));
+  // the most recent events are kept in order
+  for (const auto& threadEvents : tracing::getEvents()) {
+    if (!threadEvents.second.empty() && threadEvents.second.front().category == std::string("testRingBuffer")) {
+      EXPECT_EQ(threadEvents.second.back().index, numEvents - 1);
+      EXPECT_EQ(threadEvents.second.front().index, numEvents - static_cast<int>(numKept));
+    }
+  }
+  tracing::clear();
+}
+
+TEST(testTracing, scopedEvent) {
+  tracing::clear();
+  { const tracing::ScopedEvent scopedEvent("testScopedEvent", "scope", 7); }
+  EXPECT_EQ(countEvents("testScopedEvent"), tracing::isEnabled() ? 1u : 0u);
+  tracing::clear();
+}
+
+TEST(testTracing, internName) {
+  const std::string name = "dynamicName";
+  const char* ptr = tracing::internName(name);
+  EXPECT_STREQ(ptr, "dynamicName");
+  EXPECT_EQ(tracing::internName(std::string("dynamic") + "Name"), ptr);
+  EXPECT_NE(tracing::internName("otherName"), ptr);
+}
+
+TEST(testTracing, latencyHistogram) {
+  tracing::clear();
+  // durations of 1, 2, ..., 100 microseconds
+  for (int i = 1; i <= 100; i++) {
+    tracing::record("testHistogram", "event", -1, 0, 1000 * i);
+  }
+
+  const auto histograms = tracing::getLatencyHistograms();
+  const auto it = std::find_if(histograms.begin(), histograms.end(),
+                               [](const tracing::LatencyHistogram& h) { return h.category == "testHistogram" && h.name == "event"; });
+  ASSERT_TRUE(it != histograms.end());
+  EXPECT_EQ(it->count, 100u);
+  EXPECT_DOUBLE_EQ(it->minInMicroseconds, 1.0);
+  EXPECT_DOUBLE_EQ(it->maxInMicroseconds, 100.0);
+  EXPECT_NEAR(it->getAverageInMicroseconds(), 50.5, 1e-9);
+  // percentiles are resolved to the power of two bucket boundaries
+  EXPECT_DOUBLE_EQ(it->getPercentileInMicroseconds(50.0), 64.0);
+  EXPECT_DOUBLE_EQ(it->getPercentileInMicroseconds(10.0), 16.0);
+  EXPECT_DOUBLE_EQ(it->getPercentileInMicroseconds(100.0), 100.0);
+  tracing::clear();
+}
+
+TEST(testTracing, chromeTrace) {
+  tracing::clear();
+  tracing::setThreadName("main \"thread\"");
+  tracing::record("testChromeTrace", "node", 4, 1000, 3000);
+
+  std::stringstream stream;
+  tracing::exportChromeTrace(stream);
+  const std::string json = stream.str();
+  EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+  EXPECT_NE(json.find(R"("args":{"name":"main \"thread\""})"), std::string::npos);
+  EXPECT_NE(json.find(R"({"name":"node","cat":"testChromeTrace","ph":"X")"), std::string::npos);
+  EXPECT_NE(json.find(R"("ts":1.000,"dur":2.000,"args":{"index":4})"), std::string::npos);
+  tracing::clear();
+}
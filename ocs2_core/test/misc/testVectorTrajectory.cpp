@@ -0,0 +1,112 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include <ocs2_core/misc/VectorTrajectory.h>
+
+using namespace ocs2;
+
+namespace {
+vector_array_t getRandomArray() {
+  // includes an empty node, e.g. the input at an event node
+  return {vector_t::Random(3), vector_t::Random(12), vector_t(), vector_t::Random(1), vector_t::Random(8), vector_t::Random(9)};
+}
+}  // namespace
+
+TEST(testVectorTrajectory, conversion) {
+  const vector_array_t array = getRandomArray();
+  const VectorTrajectory trajectory(array);
+
+  ASSERT_EQ(trajectory.size(), array.size());
+  for (size_t i = 0; i < array.size(); i++) {
+    ASSERT_EQ(trajectory[i].size(), array[i].size());
+    EXPECT_TRUE(trajectory[i] == array[i]);
+    // nodes start on a cache line
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(trajectory[i].data()) % 64, 0);
+  }
+
+  vector_array_t result(2, vector_t::Zero(3));
+  trajectory.toArray(result);
+  ASSERT_EQ(result.size(), array.size());
+  for (size_t i = 0; i < array.size(); i++) {
+    EXPECT_TRUE(result[i] == array[i]);
+  }
+}
+
+TEST(testVectorTrajectory, flatView) {
+  const vector_array_t array = getRandomArray();
+  VectorTrajectory trajectory(array);
+
+  scalar_t squaredNorm = 0.0;
+  for (const auto& v : array) {
+    squaredNorm += v.squaredNorm();
+  }
+  EXPECT_DOUBLE_EQ(trajectory.flat().squaredNorm(), squaredNorm);
+
+  // element-wise operations on the flat view leave the padding at zero
+  const VectorTrajectory other(array);
+  trajectory.flat() += 2.0 * other.flat();
+  EXPECT_DOUBLE_EQ(trajectory.flat().squaredNorm(), 9.0 * squaredNorm);
+  for (size_t i = 0; i < array.size(); i++) {
+    EXPECT_TRUE(trajectory[i].isApprox(3.0 * array[i]));
+  }
+}
+
+TEST(testVectorTrajectory, copyAndSwap) {
+  const vector_array_t array = getRandomArray();
+  VectorTrajectory trajectory(array);
+
+  VectorTrajectory copy = trajectory;
+  ASSERT_TRUE(copy.hasSameLayout(trajectory));
+  EXPECT_TRUE(copy.flat() == trajectory.flat());
+  EXPECT_NE(copy.flat().data(), trajectory.flat().data());
+
+  VectorTrajectory other(std::vector<int>{2, 2});
+  EXPECT_TRUE(other[1].isZero());
+  const auto* otherData = other.flat().data();
+  swap(trajectory, other);
+  EXPECT_EQ(trajectory.flat().data(), otherData);
+  EXPECT_EQ(trajectory.size(), 2u);
+  EXPECT_EQ(other.size(), array.size());
+  EXPECT_TRUE(other[1] == array[1]);
+
+  // shrinking keeps the storage and zeros it
+  const auto* data = copy.flat().data();
+  copy.resize({4});
+  EXPECT_EQ(copy.flat().data(), data);
+  EXPECT_TRUE(copy.flat().isZero());
+
+  VectorTrajectory empty;
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(empty.flat().size(), 0);
+  EXPECT_TRUE(VectorTrajectory(empty).empty());
+}
@@ -0,0 +1,126 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/PreComputation.h>
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/reference/ReferenceCache.h>
+
+using namespace ocs2;
+
+namespace {
+TargetTrajectories getTargetTrajectories() {
+  const scalar_array_t timeTrajectory{0.0, 0.35, 0.7, 1.0};
+  vector_array_t stateTrajectory, inputTrajectory;
+  for (size_t i = 0; i < timeTrajectory.size(); i++) {
+    stateTrajectory.push_back(vector_t::Random(3));
+    inputTrajectory.push_back(vector_t::Random(2));
+  }
+  return {timeTrajectory, stateTrajectory, inputTrajectory};
+}
+
+scalar_array_t getTimeGrid() {
+  // extends beyond the target trajectories on both sides
+  scalar_array_t timeGrid;
+  for (int i = 0; i <= 15; i++) {
+    timeGrid.push_back(-0.2 + 0.1 * i);
+  }
+  return timeGrid;
+}
+}  // unnamed namespace
+
+TEST(testReferenceCache, sampledReference) {
+  const auto targetTrajectories = getTargetTrajectories();
+  const auto timeGrid = getTimeGrid();
+
+  ReferenceCache referenceCache;
+  referenceCache.update(targetTrajectories, timeGrid);
+  ASSERT_EQ(referenceCache.size(), timeGrid.size());
+  ASSERT_TRUE(referenceCache.hasDesiredInput());
+
+  for (size_t i = 0; i < timeGrid.size(); i++) {
+    EXPECT_TRUE(referenceCache.getDesiredState(i).isApprox(targetTrajectories.getDesiredState(timeGrid[i])));
+    EXPECT_TRUE(referenceCache.getDesiredInput(i).isApprox(targetTrajectories.getDesiredInput(timeGrid[i])));
+  }
+
+  // update reuses the cache for a grid of a different size
+  const scalar_array_t coarseGrid{0.0, 0.5, 1.0};
+  referenceCache.update(targetTrajectories, coarseGrid);
+  ASSERT_EQ(referenceCache.size(), coarseGrid.size());
+  EXPECT_TRUE(referenceCache.getDesiredState(1).isApprox(targetTrajectories.getDesiredState(0.5)));
+}
+
+TEST(testReferenceCache, findNode) {
+  ReferenceCache referenceCache;
+  const auto timeGrid = getTimeGrid();
+  referenceCache.update(getTargetTrajectories(), timeGrid);
+
+  const int numNodes = timeGrid.size();
+  for (int i = 0; i < numNodes; i++) {
+    EXPECT_EQ(referenceCache.findNode(timeGrid[i]), i);            // without hint
+    EXPECT_EQ(referenceCache.findNode(timeGrid[i], i - 1), i);     // the successor of the hint
+    EXPECT_EQ(referenceCache.findNode(timeGrid[i], numNodes), i);  // out of range hint
+  }
+  EXPECT_EQ(referenceCache.findNode(0.05), -1);
+  EXPECT_EQ(referenceCache.findNode(-1.0), -1);
+  EXPECT_EQ(referenceCache.findNode(2.0), -1);
+
+  referenceCache.clear();
+  EXPECT_EQ(referenceCache.findNode(timeGrid.front()), -1);
+}
+
+TEST(testReferenceCache, quadraticCost) {
+  const auto targetTrajectories = getTargetTrajectories();
+  const auto timeGrid = getTimeGrid();
+  ReferenceCache referenceCache;
+  referenceCache.update(targetTrajectories, timeGrid);
+
+  const QuadraticStateInputCost stateInputCost(matrix_t::Identity(3, 3), 2.0 * matrix_t::Identity(2, 2));
+  const QuadraticStateCost stateCost(matrix_t::Identity(3, 3));
+  PreComputation preComp;
+  const PreComputation noCache;
+  preComp.setReferenceCache(&referenceCache);
+
+  const vector_t x = vector_t::Random(3);
+  const vector_t u = vector_t::Random(2);
+  // nodes of the grid are read from the cache, all other times are interpolated
+  for (const scalar_t t : {-0.2, 0.1, 0.15, 0.5, 0.9, 1.3}) {
+    const auto cached = stateInputCost.getQuadraticApproximation(t, x, u, targetTrajectories, preComp);
+    const auto interpolated = stateInputCost.getQuadraticApproximation(t, x, u, targetTrajectories, noCache);
+    EXPECT_NEAR(cached.f, interpolated.f, 1e-12);
+    EXPECT_TRUE(cached.dfdx.isApprox(interpolated.dfdx));
+    EXPECT_TRUE(cached.dfdu.isApprox(interpolated.dfdu));
+    EXPECT_NEAR(stateCost.getValue(t, x, targetTrajectories, preComp), stateCost.getValue(t, x, targetTrajectories, noCache), 1e-12);
+  }
+
+  preComp.setReferenceCache(nullptr);
+  EXPECT_EQ(preComp.getCachedDesiredState(timeGrid.front()), nullptr);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/thread_support/SpinBarrier.h>
+
+using namespace ocs2;
+
+TEST(testSpinBarrier, testPhases) {
+  constexpr size_t numThreads = 4;
+  constexpr int numPhases = 1000;
+  SpinBarrier barrier(numThreads, 100);
+
+  // every thread writes its own slot in each phase, the completion checks that all slots of the phase are written
+  std::vector<int> phaseOfThread(numThreads, -1);
+  int numCompletions = 0;
+  std::atomic_bool isConsistent{true};
+
+  auto task = [&](size_t threadId) {
+    for (int phase = 0; phase < numPhases; phase++) {
+      phaseOfThread[threadId] = phase;
+      barrier.arriveAndWait([&] {
+        for (const auto p : phaseOfThread) {
+          if (p != phase) {
+            isConsistent = false;
+          }
+        }
+        ++numCompletions;
+      });
+      // the completion of this phase is visible to all threads
+      if (numCompletions != phase + 1) {
+        isConsistent = false;
+      }
+      barrier.arriveAndWait();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < numThreads; i++) {
+    threads.emplace_back(task, i);
+  }
+  task(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_TRUE(isConsistent);
+  EXPECT_EQ(numCompletions, numPhases);
+}
+
+TEST(testSpinBarrier, testSingleParticipant) {
+  SpinBarrier barrier(1);
+  int numCompletions = 0;
+  for (int i = 0; i < 10; i++) {
+    barrier.arriveAndWait([&] { ++numCompletions; });
+  }
+  EXPECT_EQ(numCompletions, 10);
+}
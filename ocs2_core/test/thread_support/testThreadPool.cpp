@@ -1,4 +1,9 @@
 #include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 using namespace ocs2;
@@ -121,3 +126,107 @@ TEST(testThreadPool, testMoveOnlyTask) {
 
   EXPECT_EQ(result.get(), 3.14);
 }
+
+TEST(testThreadPool, testWorkStealingRunTasks) {
+  ThreadPool pool(3, 0, true);
+  ASSERT_TRUE(pool.isWorkStealing());
+
+  std::vector<std::future<int>> futures;
+  for (int i = 0; i < 100; ++i) {
+    futures.emplace_back(pool.run([i](int workerIndex) {
+      EXPECT_GE(workerIndex, 0);
+      EXPECT_LT(workerIndex, 3);
+      return i;
+    }));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(futures[i].get(), i);
+  }
+}
+
+TEST(testThreadPool, testWorkStealingNestedTasks) {
+  ThreadPool pool(4, 0, true, std::chrono::microseconds(50));
+  std::atomic_int counter;
+  counter = 0;
+
+  // tasks spawned from a worker go to its own deque and are stolen by the others
+  auto result = pool.run([&](int) {
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 1000; ++i) {
+      futures.emplace_back(pool.run([&](int) { counter++; }));
+    }
+    return futures;
+  });
+  for (auto& fut : result.get()) {
+    fut.get();
+  }
+
+  EXPECT_EQ(counter, 1000);
+}
+
+TEST(testThreadPool, testWorkStealingRunParallel) {
+  for (const auto spin : {std::chrono::microseconds(0), std::chrono::microseconds(100)}) {
+    ThreadPool pool(3, 0, true, spin);
+    constexpr int numWorkers = 4;
+
+    for (int trial = 0; trial < 200; ++trial) {
+      std::atomic_int counter;
+      counter = 0;
+      std::vector<std::atomic_int> workerIndexUsage(numWorkers);
+      for (auto& usage : workerIndexUsage) {
+        usage = 0;
+      }
+
+      pool.runParallel(
+          [&](int workerIndex) {
+            // an index must never be used by two instances at the same time
+            EXPECT_EQ(workerIndexUsage[workerIndex]++, 0);
+            counter++;
+            workerIndexUsage[workerIndex]--;
+          },
+          numWorkers + trial % 3);
+
+      EXPECT_EQ(counter, numWorkers + trial % 3);
+    }
+  }
+}
+
+TEST(testThreadPool, testWorkStealingRunParallelException) {
+  ThreadPool pool(2, 0, true);
+  std::atomic_int counter;
+  counter = 0;
+
+  EXPECT_THROW(pool.runParallel(
+                   [&](int) {
+                     if (counter++ == 3) {
+                       throw std::runtime_error("exception");
+                     }
+                   },
+                   6),
+               std::runtime_error);
+  EXPECT_EQ(counter, 6);
+
+  // pool is still usable
+  counter = 0;
+  pool.runParallel([&](int) { counter++; }, 3);
+  EXPECT_EQ(counter, 3);
+}
+
+TEST(testThreadPool, testWorkStealingConcurrentRunParallel) {
+  ThreadPool pool(2, 0, true);
+  std::atomic_int counter;
+  counter = 0;
+
+  // the second concurrent call falls back to the task based implementation
+  auto fut = std::async(std::launch::async, [&] {
+    for (int i = 0; i < 100; ++i) {
+      pool.runParallel([&](int) { counter++; }, 3);
+    }
+  });
+  for (int i = 0; i < 100; ++i) {
+    pool.runParallel([&](int) { counter++; }, 3);
+  }
+  fut.get();
+
+  EXPECT_EQ(counter, 600);
+}
@@ -68,6 +68,10 @@ struct Settings {
   size_t nThreads_ = 1;
   /** Priority of threads used in the multi-threading scheme. */
   int threadPriority_ = 99;
+  /** Whether to use the work-stealing thread pool with allocation-free parallel tasks. */
+  bool threadPoolWorkStealing_ = false;
+  /** Time in microseconds idle threads busy-wait for work before sleeping (only used by the work-stealing thread pool). */
+  size_t threadSpinDuration_ = 0;
 
   /** Maximum number of iterations of DDP. */
   size_t maxNumIterations_ = 15;
@@ -103,6 +107,12 @@ struct Settings {
 
   /** If true, terms of the Riccati equation will be pre-computed before interpolation in the flow-map */
   bool preComputeRiccatiTerms_ = true;
+  /**
+   * If true, ILQR solves the Riccati equations of the first iteration with the exact parallel-in-time Riccati solver. It falls back to
+   * the sequential recursion if the problem has events, state-input equality constraints or a non positive definite input Hessian,
+   * for the risk-sensitive variant, and if the Hessian correction is anything else than the diagonal shift of the line-search strategy.
+   */
+  bool useParallelRiccatiSolver_ = false;
 
   /** Use either the optimized control policy (true) or the optimized state-input trajectory (false). */
   bool useFeedbackPolicy_ = false;
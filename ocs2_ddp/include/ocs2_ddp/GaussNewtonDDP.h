@@ -125,6 +125,9 @@ class GaussNewtonDDP : public SolverBase {
     threadPool_.runParallel([&](int) { taskFunction(); }, N);
   }
 
+  /** Access to the thread pool, for the parallel passes which are run by other solvers, e.g. the ParallelRiccatiSolver. */
+  ThreadPool& getThreadPool() { return threadPool_; }
+
   /**
    * Takes the following steps: (1) Computes the Hessian of the Hamiltonian (i.e., Hm) (2) Based on Hm, it calculates
    * the range space and the null space projections of the input-state equality constraints. (3) Based on these two
@@ -176,13 +179,24 @@ class GaussNewtonDDP : public SolverBase {
   virtual scalar_t solveSequentialRiccatiEquations(const ScalarFunctionQuadraticApproximation& finalValueFunction) = 0;
 
   /**
-   * The implementation for solving Riccati equations for all the partitions.
+   * The implementation for solving Riccati equations for all the partitions. The first iteration has no cached value function to start
+   * the partitions from. It is solved by solveParallelRiccatiEquations if supported, otherwise sequentially. The following iterations
+   * start the partitions from the cached value function of the previous iteration.
    *
    * @param [in] finalValueFunction The final Sm(dfdxx), Sv(dfdx), s(f), for Riccati equation.
    * @return average time step
    */
   scalar_t solveSequentialRiccatiEquationsImpl(const ScalarFunctionQuadraticApproximation& finalValueFunction);
 
+  /**
+   * Solves the Riccati equations of the whole horizon exactly with a parallel-in-time method. The solution is written to the same
+   * containers as riccatiEquationsWorker.
+   *
+   * @param [in] finalValueFunction The final Sm(dfdxx), Sv(dfdx), s(f), for Riccati equation.
+   * @return true if the equations are solved, false if the problem is not supported.
+   */
+  virtual bool solveParallelRiccatiEquations(const ScalarFunctionQuadraticApproximation& finalValueFunction) { return false; }
+
   /**
    * Solves a Riccati equations and type_1 constraints error correction compensation for the partition in the given index.
    *
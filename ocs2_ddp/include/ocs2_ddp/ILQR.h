@@ -32,6 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
 
+#include <ocs2_oc/oc_solver/ParallelRiccatiSolver.h>
+
 #include "GaussNewtonDDP.h"
 #include "riccati_equations/DiscreteTimeRiccatiEquations.h"
 
@@ -64,6 +66,14 @@ class ILQR : public GaussNewtonDDP {
   void riccatiEquationsWorker(size_t workerIndex, const std::pair<int, int>& partitionInterval,
                               const ScalarFunctionQuadraticApproximation& finalValueFunction) override;
 
+  /**
+   * Solves the Riccati equations with the ParallelRiccatiSolver if useParallelRiccatiSolver_ is set and the problem is supported: no
+   * events, no state-input equality constraints, no risk sensitivity and the line-search strategy with the diagonal shift as Hessian
+   * correction. The diagonal shift does not depend on the value function and is added to the stage costs. The projection, the Riccati
+   * modification and the gains of every node are then computed concurrently from the cost-to-go of the next node.
+   */
+  bool solveParallelRiccatiEquations(const ScalarFunctionQuadraticApproximation& finalValueFunction) override;
+
   void calculateControllerWorker(size_t timeIndex, const PrimalDataContainer& primalData, const DualDataContainer& dualData,
                                  LinearController& dstController) override;
 
@@ -93,6 +103,13 @@ class ILQR : public GaussNewtonDDP {
 
   DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
   std::vector<std::unique_ptr<DiscreteTimeRiccatiEquations>> riccatiEquationsPtrStock_;
+
+  ParallelRiccatiSolver parallelRiccatiSolver_;
+  OcpSize parallelRiccatiOcpSize_;
+  std::vector<VectorFunctionLinearApproximation> parallelRiccatiDynamics_;
+  std::vector<ScalarFunctionQuadraticApproximation> parallelRiccatiCost_;
+  vector_array_t parallelRiccatiStateTrajectory_;
+  vector_array_t parallelRiccatiInputTrajectory_;
 };
 
 }  // namespace ocs2
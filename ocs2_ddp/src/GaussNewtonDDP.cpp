@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/Tracing.h>
 
 #include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 #include <ocs2_oc/rollout/InitializerRollout.h>
@@ -53,7 +54,9 @@ namespace ocs2 {
 /******************************************************************************************************/
 GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
                                const Initializer& initializer)
-    : ddpSettings_(std::move(ddpSettings)), threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_) {
+    : ddpSettings_(std::move(ddpSettings)),
+      threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_, ddpSettings_.threadPoolWorkStealing_,
+                  std::chrono::microseconds(ddpSettings_.threadSpinDuration_)) {
   Eigen::setNbThreads(1);  // no multithreading within Eigen.
   Eigen::initParallel();
 
@@ -514,6 +517,8 @@ scalar_t GaussNewtonDDP::calculateRolloutMerit(const PerformanceIndex& performan
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctionQuadraticApproximation& finalValueFunction) {
+  OCS2_TRACE_SCOPE("GaussNewtonDDP", "solveSequentialRiccatiEquations");
+
   // pre-allocate memory for dual solution
   const size_t outputN = nominalPrimalData_.primalSolution.timeTrajectory_.size();
   nominalDualData_.valueFunctionTrajectory.clear();
@@ -525,10 +530,12 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
   // [first1,last1), [first2(last1), last2).
   nominalDualData_.valueFunctionTrajectory.back() = finalValueFunction;
 
-  // solve it sequentially for the first iteration
+  // solve it with the parallel-in-time solver if possible, otherwise sequentially, for the first iteration
   if (totalNumIterations_ == 0) {
-    const std::pair<int, int> partitionInterval{0, outputN - 1};
-    riccatiEquationsWorker(0, partitionInterval, finalValueFunction);
+    if (!solveParallelRiccatiEquations(finalValueFunction)) {
+      const std::pair<int, int> partitionInterval{0, outputN - 1};
+      riccatiEquationsWorker(0, partitionInterval, finalValueFunction);
+    }
   } else {  // solve it in parallel
     // do equal-time partitions based on available thread resource
     const auto partitionIntervals = computePartitionIntervals(nominalPrimalData_.primalSolution.timeTrajectory_, ddpSettings_.nThreads_);
@@ -586,6 +593,8 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::calculateController() {
+  OCS2_TRACE_SCOPE("GaussNewtonDDP", "calculateController");
+
   const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
 
   unoptimizedController_.clear();
@@ -645,6 +654,8 @@ void GaussNewtonDDP::calculateController() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::approximateOptimalControlProblem() {
+  OCS2_TRACE_SCOPE("GaussNewtonDDP", "approximateOptimalControlProblem");
+
   /*
    * compute and augment the LQ approximation of intermediate times
    */
@@ -830,6 +841,8 @@ void GaussNewtonDDP::updateConstraintPenalties(scalar_t equalityConstraintsSSE)
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool GaussNewtonDDP::initializePrimalSolution() {
+  OCS2_TRACE_SCOPE("GaussNewtonDDP", "initializePrimalSolution");
+
   try {
     // clear before starting to fill
     nominalPrimalData_.clear();
@@ -901,6 +914,8 @@ void GaussNewtonDDP::initializeDualSolutionAndMetrics() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
+  OCS2_TRACE_SCOPE("GaussNewtonDDP", "takePrimalDualStep");
+
   // update primal: run search strategy and find the optimal stepLength
   searchStrategyTimer_.startTimer();
   scalar_t avgTimeStep;
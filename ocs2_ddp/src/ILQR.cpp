@@ -28,6 +28,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include "ocs2_ddp/ILQR.h"
+
+#include <algorithm>
+
 #include <ocs2_ddp/riccati_equations/RiccatiTransversalityConditions.h>
 
 namespace ocs2 {
@@ -211,6 +214,86 @@ scalar_t ILQR::solveSequentialRiccatiEquations(const ScalarFunctionQuadraticAppr
   return solveSequentialRiccatiEquationsImpl(finalValueFunction);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ILQR::solveParallelRiccatiEquations(const ScalarFunctionQuadraticApproximation& finalValueFunction) {
+  const bool isRiskSensitive = !numerics::almost_eq(settings().riskSensitiveCoeff_, 0.0);
+  const bool isDiagonalShift = settings().strategy_ == search_strategy::Type::LINE_SEARCH &&
+                               settings().lineSearch_.hessianCorrectionStrategy == hessian_correction::Strategy::DIAGONAL_SHIFT;
+  if (!settings().useParallelRiccatiSolver_ || isRiskSensitive || !isDiagonalShift) {
+    return false;
+  }
+
+  // number of stages, the last node holds the final value function
+  const auto& modelDataTrajectory = nominalPrimalData_.modelDataTrajectory;
+  const int N = static_cast<int>(nominalPrimalData_.primalSolution.timeTrajectory_.size()) - 1;
+  if (N < 1) {
+    return false;
+  }
+
+  // an event at the final time does not add a jump to the backward pass
+  const auto& postEventIndices = nominalPrimalData_.primalSolution.postEventIndices_;
+  const auto hasEventInHorizon = [N](size_t postEventIndex) { return postEventIndex > 0 && postEventIndex < static_cast<size_t>(N); };
+  if (std::any_of(postEventIndices.cbegin(), postEventIndices.cend(), hasEventInHorizon)) {
+    return false;
+  }
+
+  // discrete LQ problem, the diagonal shift of the Hessian correction is added to the stage costs
+  parallelRiccatiDynamics_.resize(N);
+  parallelRiccatiCost_.resize(N + 1);
+  for (int k = 0; k < N; k++) {
+    const auto& modelData = modelDataTrajectory[k];
+    if (modelData.stateInputEqConstraint.f.size() > 0) {
+      return false;
+    }
+    parallelRiccatiDynamics_[k].f = modelData.dynamicsBias;
+    parallelRiccatiDynamics_[k].dfdx = modelData.dynamics.dfdx;
+    parallelRiccatiDynamics_[k].dfdu = modelData.dynamics.dfdu;
+    parallelRiccatiCost_[k] = modelData.cost;
+    parallelRiccatiCost_[k].dfdxx.diagonal().array() += settings().lineSearch_.hessianCorrectionMultiple;
+  }
+  parallelRiccatiCost_[N] = finalValueFunction;
+
+  extractSizesFromProblem(parallelRiccatiDynamics_, parallelRiccatiCost_, nullptr, parallelRiccatiOcpSize_);
+  parallelRiccatiSolver_.resize(parallelRiccatiOcpSize_);
+  const vector_t x0 = vector_t::Zero(modelDataTrajectory.front().stateDim);
+  if (!parallelRiccatiSolver_.solve(getThreadPool(), x0, parallelRiccatiDynamics_, parallelRiccatiCost_, parallelRiccatiStateTrajectory_,
+                                    parallelRiccatiInputTrajectory_)) {
+    return false;
+  }
+  const auto costToGo = parallelRiccatiSolver_.getRiccatiCostToGo();
+
+  // projection, Riccati modification and gains of every node from the cost-to-go of the next node. The constant term of the cost-to-go
+  // is not provided by the solver, the increments are computed here and summed up afterwards.
+  nextTimeIndex_ = 0;
+  nextTaskId_ = 0;
+  auto task = [&]() {
+    const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
+
+    size_t k;
+    while ((k = nextTimeIndex_++) < static_cast<size_t>(N)) {
+      auto& projectedModelData = nominalDualData_.projectedModelDataTrajectory[k];
+      auto& riccatiModification = nominalDualData_.riccatiModificationTrajectory[k];
+      auto& valueFunction = nominalDualData_.valueFunctionTrajectory[k];
+      const auto& SmNext = costToGo[k + 1].dfdxx;
+      const auto& SvNext = costToGo[k + 1].dfdx;
+
+      computeProjectionAndRiccatiModification(modelDataTrajectory[k], SmNext, projectedModelData, riccatiModification);
+      riccatiEquationsPtrStock_[taskId]->computeMap(projectedModelData, riccatiModification, SmNext, SvNext, 0.0,
+                                                    projectedKmTrajectoryStock_[k], projectedLvTrajectoryStock_[k], valueFunction.dfdxx,
+                                                    valueFunction.dfdx, valueFunction.f);
+    }
+  };
+  runParallel(task, settings().nThreads_);
+
+  for (int k = N - 1; k >= 0; k--) {
+    nominalDualData_.valueFunctionTrajectory[k].f += nominalDualData_.valueFunctionTrajectory[k + 1].f;
+  }
+
+  return true;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -178,6 +178,34 @@ TEST_P(FinalDoubleIntegratorReachingTask, SLQ) {
   printSolution(primalSolution, display);
 }
 
+TEST_P(FinalDoubleIntegratorReachingTask, ILQR_ParallelRiccati) {
+  constexpr bool display = true;
+  constexpr auto alg = ddp::Algorithm::ILQR;
+  // rollout
+  TimeTriggeredRollout rollout(*ocp.dynamicsPtr, getRolloutSettings(alg));
+  // solve with the sequential and the parallel-in-time Riccati solver in the first iteration, the event at the final time does not
+  // prevent the parallel solver. Both should result in the same iterates.
+  auto solve = [&](bool useParallelRiccatiSolver) {
+    auto settings = getDdpSettings(alg, display);
+    settings.nThreads_ = 4;
+    settings.useParallelRiccatiSolver_ = useParallelRiccatiSolver;
+    ILQR ddp(settings, rollout, ocp, *getInitializer());
+    ddp.setReferenceManager(referenceManagerPtr);
+    ddp.run(0.0, xInit, tGoal);
+    PrimalSolution primalSolution;
+    ddp.getPrimalSolution(tGoal, &primalSolution);
+    return primalSolution;
+  };
+  const auto sequentialSolution = solve(false);
+  const auto parallelSolution = solve(true);
+  // test
+  ASSERT_EQ(parallelSolution.timeTrajectory_.size(), sequentialSolution.timeTrajectory_.size());
+  for (size_t i = 0; i < parallelSolution.timeTrajectory_.size(); ++i) {
+    EXPECT_TRUE(parallelSolution.stateTrajectory_[i].isApprox(sequentialSolution.stateTrajectory_[i], 1e-6)) << " at index " << i;
+    EXPECT_TRUE(parallelSolution.inputTrajectory_[i].isApprox(sequentialSolution.inputTrajectory_[i], 1e-6)) << " at index " << i;
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(FinalDoubleIntegratorReachingTaskCase, FinalDoubleIntegratorReachingTask,
                         testing::ValuesIn({DoubleIntegratorReachingTask::PenaltyType::QuadraticPenalty,
                                            DoubleIntegratorReachingTask::PenaltyType::SmoothAbsolutePenalty}),
@@ -99,6 +99,18 @@ vector_t retrieveSlackDirection(const VectorFunctionLinearApproximation& stateIn
  */
 vector_t retrieveDualDirection(scalar_t barrierParam, const vector_t& slack, const vector_t& dual, const vector_t& slackDirection);
 
+/** In-place variant of retrieveSlackDirection for the state-input inequality constraints, which reuses the memory of slackDirection. */
+void retrieveSlackDirection(const VectorFunctionLinearApproximation& stateInputIneqConstraints, const vector_t& dx, const vector_t& du,
+                            scalar_t barrierParam, const vector_t& slackStateInputIneq, vector_t& slackDirection);
+
+/** In-place variant of retrieveSlackDirection for the state-only inequality constraints, which reuses the memory of slackDirection. */
+void retrieveSlackDirection(const VectorFunctionLinearApproximation& stateIneqConstraints, const vector_t& dx, scalar_t barrierParam,
+                            const vector_t& slackStateIneq, vector_t& slackDirection);
+
+/** In-place variant of retrieveDualDirection, which reuses the memory of dualDirection. */
+void retrieveDualDirection(scalar_t barrierParam, const vector_t& slack, const vector_t& dual, const vector_t& slackDirection,
+                           vector_t& dualDirection);
+
 /**
  * Computes the step size via fraction-to-boundary-rule, which is introduced in the IPOPT's implementaion paper,
  * "On the implementation of an interior-point filter line-search algorithm for large-scale nonlinear programming"
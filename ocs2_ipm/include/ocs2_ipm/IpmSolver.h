@@ -38,6 +38,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/oc_solver/ParallelRiccatiSolver.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
 #include <ocs2_oc/search_strategy/FilterLinesearch.h>
 
@@ -116,12 +117,14 @@ class IpmSolver : public SolverBase {
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
 
-  /** Initializes for the costate trajectories */
+  /** Initializes for the costate trajectories by interpolating the previous solution, see getWarmStartNodeInterpolation */
   void initializeCostateTrajectory(const std::vector<AnnotatedTime>& timeDiscretization, const vector_array_t& stateTrajectory,
+                                   const std::vector<LinearInterpolation::index_alpha_t>& warmStartNodeInterpolation,
                                    vector_array_t& costateTrajectory) const;
 
-  /** Initializes for the Lagrange multiplier trajectories of the constraint projection */
+  /** Initializes for the Lagrange multiplier trajectories of the constraint projection by interpolating the previous solution */
   void initializeProjectionMultiplierTrajectory(const std::vector<AnnotatedTime>& timeDiscretization,
+                                                const std::vector<LinearInterpolation::index_alpha_t>& warmStartNodeInterpolation,
                                                 vector_array_t& projectionMultiplierTrajectory) const;
 
   /** Initializes for the slack and dual trajectories of the hard inequality constraints */
@@ -136,12 +139,26 @@ class IpmSolver : public SolverBase {
                                             const vector_array_t& slackStateInputIneq, const vector_array_t& dualStateIneq,
                                             const vector_array_t& dualStateInputIneq, std::vector<Metrics>& metrics);
 
-  /** Computes only the performance metrics at the current {t, x(t), u(t)} */
-  PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                      const vector_array_t& u, scalar_t barrierParam, const vector_array_t& slackStateIneq,
-                                      const vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics);
+  /** A trial step of the linesearch: the primal step size, the resulting {x(t), u(t)} and slacks, and its performance metrics */
+  struct LinesearchTrial {
+    scalar_t alpha = 0.0;
+    vector_array_t x;
+    vector_array_t u;
+    vector_array_t slackStateIneq;
+    vector_array_t slackStateInputIneq;
+    std::vector<Metrics> metrics;
+    std::vector<PerformanceIndex> nodePerformance;
+    PerformanceIndex performance;
+  };
 
-  /** Returns solution of the QP subproblem in delta coordinates: */
+  /**
+   * Computes only the performance metrics of the first numTrials linesearch trials. The nodes of all trials are distributed over the
+   * threads together, while the performance of each trial is summed in node order. The result is therefore independent of the number
+   * of trials and threads.
+   */
+  void computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, scalar_t barrierParam, size_t numTrials);
+
+  /** Returns solution of the QP subproblem in delta coordinates. The solution is held by the solver and valid until the next call. */
   struct OcpSubproblemSolution {
     vector_array_t deltaXSol;    // delta_x(t)
     vector_array_t deltaUSol;    // delta_u(t)
@@ -155,9 +172,9 @@ class IpmSolver : public SolverBase {
     scalar_t maxPrimalStepSize;
     scalar_t maxDualStepSize;
   };
-  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0, scalar_t barrierParam, const vector_array_t& slackStateIneq,
-                                       const vector_array_t& dualStateIneq, const vector_array_t& slackStateInputIneq,
-                                       const vector_array_t& dualStateInputIneq);
+  const OcpSubproblemSolution& getOCPSolution(const vector_t& delta_x0, scalar_t barrierParam, const vector_array_t& slackStateIneq,
+                                              const vector_array_t& dualStateIneq, const vector_array_t& slackStateInputIneq,
+                                              const vector_array_t& dualStateInputIneq);
 
   /** Extract the value function based on the last solved QP */
   void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& lmd,
@@ -181,19 +198,20 @@ class IpmSolver : public SolverBase {
   scalar_t updateBarrierParameter(scalar_t currentBarrierParameter, const PerformanceIndex& baseline, const ipm::StepInfo& stepInfo) const;
 
   /** Determine convergence after a step */
-  ipm::Convergence checkConvergence(int iteration, scalar_t barrierParam, const PerformanceIndex& baseline,
+  ipm::Convergence checkConvergence(int iteration, size_t maxNumIterations, scalar_t barrierParam, const PerformanceIndex& baseline,
                                     const ipm::StepInfo& stepInfo) const;
 
   // Problem definition
   const ipm::Settings settings_;
-  DynamicsDiscretizer discretizer_;
-  DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
+  DynamicsDiscretizerInPlace discretizer_;
+  DynamicsSensitivityDiscretizerInPlace sensitivityDiscretizer_;
   std::vector<OptimalControlProblem> ocpDefinitions_;
   std::unique_ptr<Initializer> initializerPtr_;
   FilterLinesearch filterLinesearch_;
 
   // Solver interface
   HpipmInterface hpipmInterface_;
+  ParallelRiccatiSolver parallelRiccatiSolver_;
 
   // Threading
   ThreadPool threadPool_;
@@ -215,6 +233,7 @@ class IpmSolver : public SolverBase {
   std::vector<VectorFunctionLinearApproximation> stateIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> stateInputIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
+  std::vector<std::vector<int>> projectedFreeInputs_;
 
   // Constraint terms size
   std::vector<multiple_shooting::ConstraintsSize> constraintsSize_;
@@ -222,6 +241,19 @@ class IpmSolver : public SolverBase {
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
 
+  // Workspace which persists across iterations and MPC calls. The buffers are swapped in and out instead of reallocated.
+  std::vector<multiple_shooting::Transcription> workerTranscription_;
+  std::vector<multiple_shooting::EventTranscription> workerEventTranscription_;
+  multiple_shooting::TerminalTranscription terminalTranscription_;
+  std::vector<multiple_shooting::ProjectionWorkspace> projectionWorkspace_;  // one per node
+  std::vector<PerformanceIndex> nodePerformance_;
+  std::vector<LinesearchTrial> linesearchTrials_;
+  OcpSize ocpSize_;
+  OcpSubproblemSolution subproblemSolution_;
+  scalar_array_t workerPrimalStepSizes_;
+  scalar_array_t workerDualStepSizes_;
+  vector_t delta_x0_;
+
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
@@ -69,35 +69,55 @@ void condenseIneqConstraints(scalar_t barrierParam, const vector_t& slack, const
 
 vector_t retrieveSlackDirection(const VectorFunctionLinearApproximation& stateInputIneqConstraints, const vector_t& dx, const vector_t& du,
                                 scalar_t barrierParam, const vector_t& slackStateInputIneq) {
+  vector_t slackDirection;
+  retrieveSlackDirection(stateInputIneqConstraints, dx, du, barrierParam, slackStateInputIneq, slackDirection);
+  return slackDirection;
+}
+
+void retrieveSlackDirection(const VectorFunctionLinearApproximation& stateInputIneqConstraints, const vector_t& dx, const vector_t& du,
+                            scalar_t barrierParam, const vector_t& slackStateInputIneq, vector_t& slackDirection) {
   assert(barrierParam > 0.0);
   if (stateInputIneqConstraints.f.size() == 0) {
-    return vector_t();
+    slackDirection.resize(0);
+    return;
   }
 
-  vector_t slackDirection = stateInputIneqConstraints.f - slackStateInputIneq;
+  slackDirection = stateInputIneqConstraints.f - slackStateInputIneq;
   slackDirection.noalias() += stateInputIneqConstraints.dfdx * dx;
   slackDirection.noalias() += stateInputIneqConstraints.dfdu * du;
-  return slackDirection;
 }
 
 vector_t retrieveSlackDirection(const VectorFunctionLinearApproximation& stateIneqConstraints, const vector_t& dx, scalar_t barrierParam,
                                 const vector_t& slackStateIneq) {
+  vector_t slackDirection;
+  retrieveSlackDirection(stateIneqConstraints, dx, barrierParam, slackStateIneq, slackDirection);
+  return slackDirection;
+}
+
+void retrieveSlackDirection(const VectorFunctionLinearApproximation& stateIneqConstraints, const vector_t& dx, scalar_t barrierParam,
+                            const vector_t& slackStateIneq, vector_t& slackDirection) {
   assert(barrierParam > 0.0);
   if (stateIneqConstraints.f.size() == 0) {
-    return vector_t();
+    slackDirection.resize(0);
+    return;
   }
 
-  vector_t slackDirection = stateIneqConstraints.f - slackStateIneq;
+  slackDirection = stateIneqConstraints.f - slackStateIneq;
   slackDirection.noalias() += stateIneqConstraints.dfdx * dx;
-  return slackDirection;
 }
 
 vector_t retrieveDualDirection(scalar_t barrierParam, const vector_t& slack, const vector_t& dual, const vector_t& slackDirection) {
+  vector_t dualDirection;
+  retrieveDualDirection(barrierParam, slack, dual, slackDirection, dualDirection);
+  return dualDirection;
+}
+
+void retrieveDualDirection(scalar_t barrierParam, const vector_t& slack, const vector_t& dual, const vector_t& slackDirection,
+                           vector_t& dualDirection) {
   assert(barrierParam > 0.0);
-  vector_t dualDirection = dual.cwiseProduct(slack + slackDirection);
+  dualDirection = dual.cwiseProduct(slack + slackDirection);
   dualDirection.array() -= barrierParam;
   dualDirection.array() /= -slack.array();
-  return dualDirection;
 }
 
 scalar_t fractionToBoundaryStepSize(const vector_t& v, const vector_t& dv, scalar_t marginRate) {
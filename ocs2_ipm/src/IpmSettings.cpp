@@ -51,18 +51,23 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   }
 
   loadData::loadPtreeValue(pt, settings.ipmIteration, fieldName + ".ipmIteration", verbose);
+  loadData::loadPtreeValue(pt, settings.warmStartIpmIteration, fieldName + ".warmStartIpmIteration", verbose);
   loadData::loadPtreeValue(pt, settings.deltaTol, fieldName + ".deltaTol", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_decay, fieldName + ".alpha_decay", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_min, fieldName + ".alpha_min", verbose);
+  loadData::loadPtreeValue(pt, settings.linesearchTrials, fieldName + ".linesearchTrials", verbose);
   loadData::loadPtreeValue(pt, settings.gamma_c, fieldName + ".gamma_c", verbose);
   loadData::loadPtreeValue(pt, settings.g_max, fieldName + ".g_max", verbose);
   loadData::loadPtreeValue(pt, settings.g_min, fieldName + ".g_min", verbose);
   loadData::loadPtreeValue(pt, settings.armijoFactor, fieldName + ".armijoFactor", verbose);
   loadData::loadPtreeValue(pt, settings.costTol, fieldName + ".costTol", verbose);
   loadData::loadPtreeValue(pt, settings.dt, fieldName + ".dt", verbose);
+  loadData::loadPtreeValue(pt, settings.cacheReferenceOnTimeGrid, fieldName + ".cacheReferenceOnTimeGrid", verbose);
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy, fieldName + ".useFeedbackPolicy", verbose);
   loadData::loadPtreeValue(pt, settings.createValueFunction, fieldName + ".createValueFunction", verbose);
   loadData::loadPtreeValue(pt, settings.computeLagrangeMultipliers, fieldName + ".computeLagrangeMultipliers", verbose);
+  loadData::loadPtreeValue(pt, settings.fixedSizeProjection, fieldName + ".fixedSizeProjection", verbose);
+  loadData::loadPtreeValue(pt, settings.structuredProjection, fieldName + ".structuredProjection", verbose);
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".integratorType", verbose);
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
@@ -78,11 +83,14 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.initialDualLowerBound, fieldName + ".initialDualLowerBound", verbose);
   loadData::loadPtreeValue(pt, settings.initialSlackMarginRate, fieldName + ".initialSlackMarginRate", verbose);
   loadData::loadPtreeValue(pt, settings.initialDualMarginRate, fieldName + ".initialDualMarginRate", verbose);
+  loadData::loadPtreeValue(pt, settings.useParallelRiccatiSolver, fieldName + ".useParallelRiccatiSolver", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatus, fieldName + ".printSolverStatus", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatistics, fieldName + ".printSolverStatistics", verbose);
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
+  loadData::loadPtreeValue(pt, settings.threadPoolWorkStealing, fieldName + ".threadPoolWorkStealing", verbose);
+  loadData::loadPtreeValue(pt, settings.threadSpinDuration, fieldName + ".threadSpinDuration", verbose);
 
   if (settings.initialSlackLowerBound <= 0.0) {
     throw std::runtime_error("[MultipleShootingIpmSettings] initialSlackLowerBound must be positive!");
@@ -99,6 +107,9 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   if (settings.fractionToBoundaryMargin <= 0.0 || settings.fractionToBoundaryMargin > 1.0) {
     throw std::runtime_error("[MultipleShootingIpmSettings] fractionToBoundaryMargin must be positive and no more than 1.0!");
   }
+  if (settings.structuredProjection && settings.fixedSizeProjection) {
+    throw std::runtime_error("[MultipleShootingIpmSettings] structuredProjection and fixedSizeProjection cannot be enabled together!");
+  }
 
   if (verbose) {
     std::cerr << settings.hpipmSettings;
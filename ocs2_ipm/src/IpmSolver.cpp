@@ -29,16 +29,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ipm/IpmSolver.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
 
+#include <ocs2_core/misc/Tracing.h>
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
+#include <ocs2_oc/multiple_shooting/FixedSizeTranscription.h>
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
 #include <ocs2_oc/multiple_shooting/LagrangianEvaluation.h>
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
 #include <ocs2_oc/multiple_shooting/PerformanceIndexComputation.h>
+#include <ocs2_oc/multiple_shooting/StructuredProjection.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
 #include <ocs2_oc/trajectory_adjustment/TrajectorySpreadingHelperFunctions.h>
 
@@ -61,27 +65,58 @@ ipm::Settings rectifySettings(const OptimalControlProblem& ocp, ipm::Settings&&
   }
   return settings;
 }
+
+/**
+ * Interpolates the previous trajectory at a matched node, see multiple_shooting::getWarmStartNodeInterpolation. Holds the matched node if
+ * its successor has a different size. Returns false if there is no previous node of the given size.
+ */
+bool interpolatePreviousNode(const LinearInterpolation::index_alpha_t& indexAlpha, const vector_array_t& previousTrajectory, size_t size,
+                             vector_t& value) {
+  const int index = indexAlpha.first;
+  const scalar_t alpha = indexAlpha.second;
+  if (index < 0 || index >= previousTrajectory.size() || previousTrajectory[index].size() != size) {
+    return false;
+  }
+  if (alpha < scalar_t(1.0) && index + 1 < previousTrajectory.size() && previousTrajectory[index + 1].size() == size) {
+    value = alpha * previousTrajectory[index] + (scalar_t(1.0) - alpha) * previousTrajectory[index + 1];
+  } else {
+    value = previousTrajectory[index];
+  }
+  return true;
+}
 }  // anonymous namespace
 
 IpmSolver::IpmSolver(ipm::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(rectifySettings(optimalControlProblem, std::move(settings))),
       hpipmInterface_(OcpSize(), settings_.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority, settings_.threadPoolWorkStealing,
+                  std::chrono::microseconds(settings_.threadSpinDuration)) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
   // Dynamics discretization
-  discretizer_ = selectDynamicsDiscretization(settings_.integratorType);
-  sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings_.integratorType);
+  discretizer_ = selectDynamicsDiscretizationInPlace(settings_.integratorType);
+  sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretizationInPlace(settings_.integratorType);
 
   // Clone objects to have one for each worker
   for (int w = 0; w < settings_.nThreads; w++) {
     ocpDefinitions_.push_back(optimalControlProblem);
   }
+  workerTranscription_.resize(settings_.nThreads);
+  workerEventTranscription_.resize(settings_.nThreads);
+  linesearchTrials_.resize(std::max(settings_.linesearchTrials, size_t(1)));
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
 
+  // Sample the references on the nodes of the time discretization, see setupQuadraticSubproblem()
+  if (settings_.cacheReferenceOnTimeGrid) {
+    const scalar_t dt = settings_.dt;
+    setReferenceTimeGrid([dt](scalar_t initTime, scalar_t finalTime, const ModeSchedule& modeSchedule) {
+      return toIntervalStartTime(timeDiscretizationWithEvents(initTime, finalTime, dt, modeSchedule.eventTimes));
+    });
+  }
+
   // Linesearch
   filterLinesearch_.g_max = settings_.g_max;
   filterLinesearch_.g_min = settings_.g_min;
@@ -215,6 +250,7 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   for (auto& ocpDefinition : ocpDefinitions_) {
     const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
     ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+    ocpDefinition.preComputationPtr->setReferenceCache(this->getReferenceManager().getReferenceCache());
   }
 
   // old and new mode schedules for the trajectory spreading
@@ -222,8 +258,13 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   const auto& newModeSchedule = this->getReferenceManager().getModeSchedule();
 
   initializationTimer_.startTimer();
+  // Match the nodes of the previous solution before it is adjusted to the new mode schedule
+  const bool isWarmStarted = !primalSolution_.timeTrajectory_.empty();
+  const auto warmStartNodeInterpolation =
+      multiple_shooting::getWarmStartNodeInterpolation(primalSolution_, newModeSchedule, timeDiscretization);
+
   // Initialize the state and input
-  if (!primalSolution_.timeTrajectory_.empty()) {
+  if (isWarmStarted) {
     std::ignore = trajectorySpread(oldModeSchedule, newModeSchedule, primalSolution_);
   }
   vector_array_t x, u;
@@ -242,8 +283,8 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   // Initialize the costate and projection multiplier
   vector_array_t lmd, nu;
   if (settings_.computeLagrangeMultipliers) {
-    initializeCostateTrajectory(timeDiscretization, x, lmd);
-    initializeProjectionMultiplierTrajectory(timeDiscretization, nu);
+    initializeCostateTrajectory(timeDiscretization, x, warmStartNodeInterpolation, lmd);
+    initializeProjectionMultiplierTrajectory(timeDiscretization, warmStartNodeInterpolation, nu);
   }
   initializationTimer_.endTimer();
 
@@ -251,6 +292,10 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   performanceIndeces_.clear();
   std::vector<Metrics> metrics;
 
+  // Warm-started runs can be capped to fewer iterations (real-time iteration)
+  const size_t maxNumIterations =
+      (isWarmStarted && settings_.warmStartIpmIteration > 0) ? settings_.warmStartIpmIteration : settings_.ipmIteration;
+
   int iter = 0;
   ipm::Convergence convergence = ipm::Convergence::FALSE;
   while (convergence == ipm::Convergence::FALSE) {
@@ -266,9 +311,9 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
     // Solve QP
     solveQpTimer_.startTimer();
-    const vector_t delta_x0 = initState - x[0];
-    const auto deltaSolution =
-        getOCPSolution(delta_x0, barrierParam, slackStateIneq, dualStateIneq, slackStateInputIneq, dualStateInputIneq);
+    delta_x0_ = initState - x[0];
+    const auto& deltaSolution =
+        getOCPSolution(delta_x0_, barrierParam, slackStateIneq, dualStateIneq, slackStateInputIneq, dualStateInputIneq);
     extractValueFunction(timeDiscretization, x, lmd, deltaSolution.deltaXSol);
     solveQpTimer_.endTimer();
 
@@ -284,7 +329,7 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     linesearchTimer_.endTimer();
 
     // Check convergence
-    convergence = checkConvergence(iter, barrierParam, baselinePerformance, stepInfo);
+    convergence = checkConvergence(iter, maxNumIterations, barrierParam, baselinePerformance, stepInfo);
 
     // Update the barrier parameter
     barrierParam = updateBarrierParameter(barrierParam, baselinePerformance, stepInfo);
@@ -316,60 +361,27 @@ void IpmSolver::runParallel(std::function<void(int)> taskFunction) {
 }
 
 void IpmSolver::initializeCostateTrajectory(const std::vector<AnnotatedTime>& timeDiscretization, const vector_array_t& stateTrajectory,
+                                            const std::vector<LinearInterpolation::index_alpha_t>& warmStartNodeInterpolation,
                                             vector_array_t& costateTrajectory) const {
-  costateTrajectory.clear();
-  costateTrajectory.reserve(stateTrajectory.size());
-
-  // Determine till when to use the previous solution
-  const auto interpolateTill =
-      primalSolution_.timeTrajectory_.size() < 2 ? timeDiscretization.front().time : primalSolution_.timeTrajectory_.back();
+  costateTrajectory.resize(stateTrajectory.size());
 
-  const scalar_t initTime = getIntervalStart(timeDiscretization[0]);
-  if (initTime < interpolateTill) {
-    costateTrajectory.push_back(LinearInterpolation::interpolate(initTime, primalSolution_.timeTrajectory_, costateTrajectory_));
-  } else {
-    costateTrajectory.push_back(vector_t::Zero(stateTrajectory[0].size()));
-  }
-
-  for (int i = 1; i < stateTrajectory.size(); i++) {
-    const auto time = getIntervalEnd(timeDiscretization[i]);
-    if (time < interpolateTill) {  // interpolate previous solution
-      costateTrajectory.push_back(LinearInterpolation::interpolate(time, primalSolution_.timeTrajectory_, costateTrajectory_));
-    } else {  // Initialize with zero
-      costateTrajectory.push_back(vector_t::Zero(stateTrajectory[i].size()));
+  for (int i = 0; i < stateTrajectory.size(); i++) {
+    const auto stateDim = stateTrajectory[i].size();
+    if (!interpolatePreviousNode(warmStartNodeInterpolation[i], costateTrajectory_, stateDim, costateTrajectory[i])) {
+      // Initialize with zero
+      costateTrajectory[i].setZero(stateDim);
     }
   }
 }
 
 void IpmSolver::initializeProjectionMultiplierTrajectory(const std::vector<AnnotatedTime>& timeDiscretization,
+                                                         const std::vector<LinearInterpolation::index_alpha_t>& warmStartNodeInterpolation,
                                                          vector_array_t& projectionMultiplierTrajectory) const {
   const size_t N = static_cast<int>(timeDiscretization.size()) - 1;  // size of the input trajectory
   projectionMultiplierTrajectory.clear();
   projectionMultiplierTrajectory.reserve(N);
   const auto& ocpDefinition = ocpDefinitions_[0];
 
-  // Determine till when to use the previous solution
-  const auto interpolateTill =
-      primalSolution_.timeTrajectory_.size() < 2 ? timeDiscretization.front().time : *std::prev(primalSolution_.timeTrajectory_.end(), 2);
-
-  // @todo Fix this using trajectory spreading
-  auto interpolateProjectionMultiplierTrajectory = [&](scalar_t time) -> vector_t {
-    const size_t numConstraints = ocpDefinition.equalityConstraintPtr->getNumConstraints(time);
-    const size_t index = LinearInterpolation::timeSegment(time, primalSolution_.timeTrajectory_).first;
-    if (projectionMultiplierTrajectory_.size() > index + 1) {
-      if (projectionMultiplierTrajectory_[index].size() == numConstraints &&
-          projectionMultiplierTrajectory_[index].size() == projectionMultiplierTrajectory_[index + 1].size()) {
-        return LinearInterpolation::interpolate(time, primalSolution_.timeTrajectory_, projectionMultiplierTrajectory_);
-      }
-    }
-    if (projectionMultiplierTrajectory_.size() > index) {
-      if (projectionMultiplierTrajectory_[index].size() == numConstraints) {
-        return projectionMultiplierTrajectory_[index];
-      }
-    }
-    return vector_t::Zero(numConstraints);
-  };
-
   for (int i = 0; i < N; i++) {
     if (timeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
       // Event Node
@@ -378,11 +390,12 @@ void IpmSolver::initializeProjectionMultiplierTrajectory(const std::vector<Annot
       // Intermediate node
       const scalar_t time = getIntervalStart(timeDiscretization[i]);
       const size_t numConstraints = ocpDefinition.equalityConstraintPtr->getNumConstraints(time);
-      if (time < interpolateTill) {  // interpolate previous solution
-        projectionMultiplierTrajectory.push_back(interpolateProjectionMultiplierTrajectory(time));
-      } else {  // Initialize with zero
-        projectionMultiplierTrajectory.push_back(vector_t::Zero(numConstraints));
+      vector_t multiplier;
+      if (!interpolatePreviousNode(warmStartNodeInterpolation[i], projectionMultiplierTrajectory_, numConstraints, multiplier)) {
+        // Initialize with zero
+        multiplier.setZero(numConstraints);
       }
+      projectionMultiplierTrajectory.push_back(std::move(multiplier));
     }
   }
 }
@@ -467,19 +480,29 @@ void IpmSolver::initializeSlackDualTrajectory(const std::vector<AnnotatedTime>&
   }
 }
 
-IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta_x0, scalar_t barrierParam,
+const IpmSolver::OcpSubproblemSolution& IpmSolver::getOCPSolution(const vector_t& delta_x0, scalar_t barrierParam,
                                                            const vector_array_t& slackStateIneq, const vector_array_t& dualStateIneq,
                                                            const vector_array_t& slackStateInputIneq,
                                                            const vector_array_t& dualStateInputIneq) {
-  // Solve the QP
-  OcpSubproblemSolution solution;
+  OCS2_TRACE_SCOPE("IpmSolver", "getOCPSolution");
+
+  // Solve the QP, reusing the memory of the previous solution
+  auto& solution = subproblemSolution_;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
-  hpipm_status status;
-  hpipmInterface_.resize(extractSizesFromProblem(dynamics_, lagrangian_, nullptr));
-  status = hpipmInterface_.solve(delta_x0, dynamics_, lagrangian_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+  bool success;
+  if (settings_.useParallelRiccatiSolver) {
+    extractSizesFromProblem(dynamics_, lagrangian_, nullptr, ocpSize_);
+    parallelRiccatiSolver_.resize(ocpSize_);
+    success = parallelRiccatiSolver_.solve(threadPool_, delta_x0, dynamics_, lagrangian_, deltaXSol, deltaUSol);
+  } else {
+    hpipmInterface_.resize(extractSizesFromProblem(dynamics_, lagrangian_, nullptr));
+    const auto status =
+        hpipmInterface_.solve(delta_x0, dynamics_, lagrangian_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    success = status == hpipm_status::SUCCESS;
+  }
 
-  if (status != hpipm_status::SUCCESS) {
+  if (!success) {
     throw std::runtime_error("[IpmSolver] Failed to solve QP");
   }
 
@@ -488,7 +511,8 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
 
   // Extract value function
   if (settings_.createValueFunction) {
-    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], lagrangian_[0]);
+    valueFunction_ = settings_.useParallelRiccatiSolver ? parallelRiccatiSolver_.getRiccatiCostToGo()
+                                                        : hpipmInterface_.getRiccatiCostToGo(dynamics_[0], lagrangian_[0]);
   }
 
   // Problem horizon
@@ -507,8 +531,10 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
   deltaSlackStateInputIneq.resize(N);
   deltaDualStateInputIneq.resize(N);
 
-  scalar_array_t primalStepSizes(settings_.nThreads, 1.0);
-  scalar_array_t dualStepSizes(settings_.nThreads, 1.0);
+  auto& primalStepSizes = workerPrimalStepSizes_;
+  auto& dualStepSizes = workerDualStepSizes_;
+  primalStepSizes.assign(settings_.nThreads, 1.0);
+  dualStepSizes.assign(settings_.nThreads, 1.0);
 
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
@@ -517,12 +543,12 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
 
     int i = timeIndex++;
     while (i < N) {
-      deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
-      deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
-      deltaSlackStateInputIneq[i] =
-          ipm::retrieveSlackDirection(stateInputIneqConstraints_[i], deltaXSol[i], deltaUSol[i], barrierParam, slackStateInputIneq[i]);
-      deltaDualStateInputIneq[i] =
-          ipm::retrieveDualDirection(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i], deltaSlackStateInputIneq[i]);
+      ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i], deltaSlackStateIneq[i]);
+      ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i], deltaDualStateIneq[i]);
+      ipm::retrieveSlackDirection(stateInputIneqConstraints_[i], deltaXSol[i], deltaUSol[i], barrierParam, slackStateInputIneq[i],
+                                  deltaSlackStateInputIneq[i]);
+      ipm::retrieveDualDirection(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i], deltaSlackStateInputIneq[i],
+                                 deltaDualStateInputIneq[i]);
       primalStepSizes[workerId] = std::min(
           {primalStepSizes[workerId],
            ipm::fractionToBoundaryStepSize(slackStateIneq[i], deltaSlackStateIneq[i], settings_.fractionToBoundaryMargin),
@@ -555,8 +581,8 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
     }
 
     if (i == N) {  // Only one worker will execute this
-      deltaSlackStateIneq[i] = ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i]);
-      deltaDualStateIneq[i] = ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i]);
+      ipm::retrieveSlackDirection(stateIneqConstraints_[i], deltaXSol[i], barrierParam, slackStateIneq[i], deltaSlackStateIneq[i]);
+      ipm::retrieveDualDirection(barrierParam, slackStateIneq[i], dualStateIneq[i], deltaSlackStateIneq[i], deltaDualStateIneq[i]);
       primalStepSizes[workerId] =
           std::min(primalStepSizes[workerId],
                    ipm::fractionToBoundaryStepSize(slackStateIneq[i], deltaSlackStateIneq[i], settings_.fractionToBoundaryMargin));
@@ -569,7 +595,7 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
       }
     }
   };
-  runParallel(std::move(parallelTask));
+  runParallel(std::ref(parallelTask));
 
   solution.maxPrimalStepSize = *std::min_element(primalStepSizes.begin(), primalStepSizes.end());
   solution.maxDualStepSize = *std::min_element(dualStepSizes.begin(), dualStepSizes.end());
@@ -591,10 +617,16 @@ void IpmSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, con
 }
 
 PrimalSolution IpmSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
+  OCS2_TRACE_SCOPE("IpmSolver", "toPrimalSolution");
   if (settings_.useFeedbackPolicy) {
     ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], lagrangian_[0]);
-    multiple_shooting::remapProjectedGain(constraintsProjection_, KMatrices);
+    matrix_array_t KMatrices = settings_.useParallelRiccatiSolver ? parallelRiccatiSolver_.getRiccatiFeedback()
+                                                                  : hpipmInterface_.getRiccatiFeedback(dynamics_[0], lagrangian_[0]);
+    if (settings_.structuredProjection) {
+      multiple_shooting::remapProjectedGain(constraintsProjection_, projectedFreeInputs_, KMatrices);
+    } else {
+      multiple_shooting::remapProjectedGain(constraintsProjection_, KMatrices);
+    }
     return multiple_shooting::toPrimalSolution(time, std::move(modeSchedule), std::move(x), std::move(u), std::move(KMatrices));
 
   } else {
@@ -608,17 +640,21 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
                                                      const vector_array_t& nu, scalar_t barrierParam, const vector_array_t& slackStateIneq,
                                                      const vector_array_t& slackStateInputIneq, const vector_array_t& dualStateIneq,
                                                      const vector_array_t& dualStateInputIneq, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_SCOPE("IpmSolver", "setupQuadraticSubproblem");
+
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
+  nodePerformance_.resize(N + 1);
   lagrangian_.resize(N + 1);
   dynamics_.resize(N);
   stateInputEqConstraints_.resize(N + 1);
   stateIneqConstraints_.resize(N + 1);
   stateInputIneqConstraints_.resize(N + 1);
   constraintsProjection_.resize(N);
+  projectedFreeInputs_.resize(N);
   projectionMultiplierCoefficients_.resize(N);
+  projectionWorkspace_.resize(N);
   constraintsSize_.resize(N + 1);
   metrics.resize(N + 1);
 
@@ -629,62 +665,89 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
 
     int i = timeIndex++;
     while (i < N) {
+      OCS2_TRACE_SCOPE_INDEX("IpmSolver", "setupNode", i);
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        performance[workerId] += ipm::computePerformanceIndex(result, barrierParam, slackStateIneq[i]);
-        dynamics_[i] = std::move(result.dynamics);
+        auto& result = workerEventTranscription_[workerId];
+        multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1], result);
+        multiple_shooting::computeMetrics(result, metrics[i]);
+        nodePerformance_[i] = ipm::computePerformanceIndex(result, barrierParam, slackStateIneq[i]);
+        std::swap(dynamics_[i], result.dynamics);
         stateInputEqConstraints_[i].resize(0, x[i].size());
-        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+        std::swap(stateIneqConstraints_[i], result.ineqConstraints);
         stateInputIneqConstraints_[i].resize(0, x[i].size());
         constraintsProjection_[i].resize(0, x[i].size());
-        projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
-        constraintsSize_[i] = std::move(result.constraintsSize);
+        projectedFreeInputs_[i].clear();
+        projectionMultiplierCoefficients_[i].clear();
+        std::swap(constraintsSize_[i], result.constraintsSize);
+        std::swap(lagrangian_[i], result.cost);
         if (settings_.computeLagrangeMultipliers) {
-          lagrangian_[i] = multiple_shooting::evaluateLagrangianEventNode(lmd[i], lmd[i + 1], std::move(result.cost), dynamics_[i]);
-        } else {
-          lagrangian_[i] = std::move(result.cost);
+          lagrangian_[i] = multiple_shooting::evaluateLagrangianEventNode(lmd[i], lmd[i + 1], std::move(lagrangian_[i]), dynamics_[i]);
         }
 
         ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i]);
-        performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[i]);
-        performance[workerId].dualFeasibilitiesSSE +=
+        nodePerformance_[i].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[i]);
+        nodePerformance_[i].dualFeasibilitiesSSE +=
             ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[i], dualStateIneq[i]);
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+        auto& result = workerTranscription_[workerId];
+        multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i], result);
         // Disable the state-only inequality constraints at the initial node
         if (i == 0) {
           result.stateIneqConstraints.setZero(0, x[i].size());
           std::fill(result.constraintsSize.stateIneq.begin(), result.constraintsSize.stateIneq.end(), 0);
         }
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        performance[workerId] += ipm::computePerformanceIndex(result, dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
-        multiple_shooting::projectTranscription(result, settings_.computeLagrangeMultipliers);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
-        constraintsSize_[i] = std::move(result.constraintsSize);
-        if (settings_.computeLagrangeMultipliers) {
-          lagrangian_[i] = multiple_shooting::evaluateLagrangianIntermediateNode(lmd[i], lmd[i + 1], nu[i], std::move(result.cost),
-                                                                                 dynamics_[i], stateInputEqConstraints_[i]);
+        multiple_shooting::computeMetrics(result, metrics[i]);
+        nodePerformance_[i] = ipm::computePerformanceIndex(result, dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
+        if (!settings_.structuredProjection && !settings_.fixedSizeProjection) {
+          // The projected terms are written to the node, such that neither the node nor the worker's transcription changes its size
+          multiple_shooting::ProjectedTranscription projected{lagrangian_[i],
+                                                              dynamics_[i],
+                                                              stateInputIneqConstraints_[i],
+                                                              constraintsProjection_[i],
+                                                              projectedFreeInputs_[i],
+                                                              projectionMultiplierCoefficients_[i]};
+          multiple_shooting::projectTranscription(result, projected, projectionWorkspace_[i], settings_.computeLagrangeMultipliers);
+          stateInputEqConstraints_[i].resize(0, x[i].size());
+          std::swap(stateIneqConstraints_[i], result.stateIneqConstraints);
+          std::swap(constraintsSize_[i], result.constraintsSize);
+          if (settings_.computeLagrangeMultipliers) {
+            lagrangian_[i] = multiple_shooting::evaluateLagrangianIntermediateNode(lmd[i], lmd[i + 1], nu[i], std::move(lagrangian_[i]),
+                                                                                   dynamics_[i], stateInputEqConstraints_[i]);
+          }
         } else {
-          lagrangian_[i] = std::move(result.cost);
+          if (settings_.structuredProjection) {
+            multiple_shooting::projectTranscriptionStructured(result, settings_.computeLagrangeMultipliers);
+          } else {
+            multiple_shooting::projectTranscriptionFixedSize(result, settings_.computeLagrangeMultipliers);
+          }
+          // Swap, such that the worker's transcription takes over the buffers of the previous iteration
+          std::swap(dynamics_[i], result.dynamics);
+          std::swap(stateInputEqConstraints_[i], result.stateInputEqConstraints);
+          std::swap(stateIneqConstraints_[i], result.stateIneqConstraints);
+          std::swap(stateInputIneqConstraints_[i], result.stateInputIneqConstraints);
+          std::swap(constraintsProjection_[i], result.constraintsProjection);
+          std::swap(projectedFreeInputs_[i], result.projectedFreeInputs);
+          std::swap(projectionMultiplierCoefficients_[i], result.projectionMultiplierCoefficients);
+          std::swap(constraintsSize_[i], result.constraintsSize);
+          if (settings_.computeLagrangeMultipliers) {
+            lagrangian_[i] = multiple_shooting::evaluateLagrangianIntermediateNode(lmd[i], lmd[i + 1], nu[i], std::move(result.cost),
+                                                                                   dynamics_[i], stateInputEqConstraints_[i]);
+          } else {
+            std::swap(lagrangian_[i], result.cost);
+          }
         }
 
         ipm::condenseIneqConstraints(barrierParam, slackStateIneq[i], dualStateIneq[i], stateIneqConstraints_[i], lagrangian_[i]);
         ipm::condenseIneqConstraints(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i], stateInputIneqConstraints_[i],
                                      lagrangian_[i]);
-        performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[i]);
-        performance[workerId].dualFeasibilitiesSSE +=
+        nodePerformance_[i].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[i]);
+        nodePerformance_[i].dualFeasibilitiesSSE +=
             ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[i], dualStateIneq[i]);
-        performance[workerId].dualFeasibilitiesSSE +=
+        nodePerformance_[i].dualFeasibilitiesSSE +=
             ipm::evaluateComplementarySlackness(barrierParam, slackStateInputIneq[i], dualStateInputIneq[i]);
       }
 
@@ -693,94 +756,110 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
 
     if (i == N) {  // Only one worker will execute this
       const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      metrics[i] = multiple_shooting::computeMetrics(result);
-      performance[workerId] += ipm::computePerformanceIndex(result, barrierParam, slackStateIneq[N]);
+      auto& result = terminalTranscription_;
+      multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N], result);
+      multiple_shooting::computeMetrics(result, metrics[i]);
+      nodePerformance_[N] = ipm::computePerformanceIndex(result, barrierParam, slackStateIneq[N]);
       stateInputEqConstraints_[i].resize(0, x[i].size());
-      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
-      constraintsSize_[i] = std::move(result.constraintsSize);
+      std::swap(stateIneqConstraints_[i], result.ineqConstraints);
+      std::swap(constraintsSize_[i], result.constraintsSize);
+      std::swap(lagrangian_[i], result.cost);
       if (settings_.computeLagrangeMultipliers) {
-        lagrangian_[i] = multiple_shooting::evaluateLagrangianTerminalNode(lmd[i], std::move(result.cost));
-      } else {
-        lagrangian_[i] = std::move(result.cost);
+        lagrangian_[i] = multiple_shooting::evaluateLagrangianTerminalNode(lmd[i], std::move(lagrangian_[i]));
       }
       ipm::condenseIneqConstraints(barrierParam, slackStateIneq[N], dualStateIneq[N], stateIneqConstraints_[N], lagrangian_[N]);
-      performance[workerId].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[N]);
-      performance[workerId].dualFeasibilitiesSSE += ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[N], dualStateIneq[N]);
+      nodePerformance_[N].dualFeasibilitiesSSE += multiple_shooting::evaluateDualFeasibilities(lagrangian_[N]);
+      nodePerformance_[N].dualFeasibilitiesSSE += ipm::evaluateComplementarySlackness(barrierParam, slackStateIneq[N], dualStateIneq[N]);
     }
   };
-  runParallel(std::move(parallelTask));
+  runParallel(std::ref(parallelTask));
 
-  // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  // Sum performance of the nodes in a fixed order, such that the result does not depend on the thread scheduling
+  PerformanceIndex totalPerformance = std::accumulate(nodePerformance_.begin(), nodePerformance_.end(), PerformanceIndex());
 
-  // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
+  // Account for initial state in performance
+  metrics.front().dynamicsViolation += initState - x.front();
+  totalPerformance.dynamicsViolationSSE += (initState - x.front()).squaredNorm();
   totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
 
   return totalPerformance;
 }
 
-PerformanceIndex IpmSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                               const vector_array_t& u, scalar_t barrierParam, const vector_array_t& slackStateIneq,
-                                               const vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics) {
+void IpmSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, scalar_t barrierParam,
+                                   size_t numTrials) {
+  OCS2_TRACE_SCOPE("IpmSolver", "computePerformance");
+
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
-  metrics.resize(N + 1);
+  const int numTasks = static_cast<int>(numTrials) * (N + 1);
+  for (size_t k = 0; k < numTrials; k++) {
+    linesearchTrials_[k].metrics.resize(N + 1);
+    linesearchTrials_[k].nodePerformance.resize(N + 1);
+  }
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
+  std::atomic_int taskIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    int j = taskIndex++;
+    while (j < numTasks) {
+      // The nodes of a trial are consecutive tasks
+      auto& trial = linesearchTrials_[j / (N + 1)];
+      const auto& x = trial.x;
+      const auto& u = trial.u;
+      const auto& slackStateIneq = trial.slackStateIneq;
+      const auto& slackStateInputIneq = trial.slackStateInputIneq;
+      auto& metrics = trial.metrics;
+      const int i = j % (N + 1);
+      OCS2_TRACE_SCOPE_INDEX("IpmSolver", "computeNodePerformance", i);
+
+      if (i == N) {
+        // Terminal node
+        const scalar_t tN = getIntervalStart(time[N]);
+        multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N], metrics[N]);
+        trial.nodePerformance[N] = ipm::toPerformanceIndex(metrics[N], barrierParam, slackStateIneq[N]);
+      } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += ipm::toPerformanceIndex(metrics[i], barrierParam, slackStateIneq[i]);
+        multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1], metrics[i]);
+        trial.nodePerformance[i] = ipm::toPerformanceIndex(metrics[i], barrierParam, slackStateIneq[i]);
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        const bool enableStateInequalityConstraints = (i > 0);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+        multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i], metrics[i]);
         // Disable the state-only inequality constraints at the initial node
         if (i == 0) {
           metrics[i].stateIneqConstraint.clear();
         }
-        performance[workerId] += ipm::toPerformanceIndex(metrics[i], dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
+        trial.nodePerformance[i] = ipm::toPerformanceIndex(metrics[i], dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
       }
 
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += ipm::toPerformanceIndex(metrics[N], barrierParam, slackStateIneq[N]);
+      j = taskIndex++;
     }
   };
-  runParallel(std::move(parallelTask));
+  runParallel(std::ref(parallelTask));
 
-  // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  for (size_t k = 0; k < numTrials; k++) {
+    auto& trial = linesearchTrials_[k];
 
-  // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
-  totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
-  return totalPerformance;
+    // Sum performance of the nodes in a fixed order, such that the result does not depend on the thread scheduling
+    PerformanceIndex totalPerformance = std::accumulate(trial.nodePerformance.begin(), trial.nodePerformance.end(), PerformanceIndex());
+
+    // Account for initial state in performance
+    trial.metrics.front().dynamicsViolation += initState - trial.x.front();
+    totalPerformance.dynamicsViolationSSE += (initState - trial.x.front()).squaredNorm();
+
+    totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
+    trial.performance = totalPerformance;
+  }
 }
 
 ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
                                         const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
                                         vector_array_t& u, scalar_t barrierParam, vector_array_t& slackStateIneq,
                                         vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_SCOPE("IpmSolver", "takePrimalStep");
   using StepType = FilterLinesearch::StepType;
 
   /*
@@ -805,66 +884,94 @@ ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const
   const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
   const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
 
+  auto isStepTooSmall = [&](scalar_t stepSize) {
+    return stepSize * deltaXnorm < settings_.deltaTol && stepSize * deltaUnorm < settings_.deltaTol;
+  };
+
   scalar_t alpha = subproblemSolution.maxPrimalStepSize;
-  vector_array_t xNew(x.size());
-  vector_array_t uNew(u.size());
-  vector_array_t slackStateIneqNew(slackStateIneq.size());
-  vector_array_t slackStateInputIneqNew(slackStateInputIneq.size());
-  std::vector<Metrics> metricsNew(metrics.size());
-  do {
+  bool terminate = false;
+  while (!terminate) {
+    // Collect the next step sizes of the backtracking, which are evaluated together
+    size_t numTrials = 0;
+    scalar_t trialAlpha = alpha;
+    do {
+      linesearchTrials_[numTrials++].alpha = trialAlpha;
+      trialAlpha *= settings_.alpha_decay;
+    } while (numTrials < linesearchTrials_.size() && !isStepTooSmall(trialAlpha) && trialAlpha >= settings_.alpha_min);
+
     // Compute step
-    multiple_shooting::incrementTrajectory(u, du, alpha, uNew);
-    multiple_shooting::incrementTrajectory(x, dx, alpha, xNew);
-    multiple_shooting::incrementTrajectory(slackStateIneq, deltaSlackStateIneq, alpha, slackStateIneqNew);
-    multiple_shooting::incrementTrajectory(slackStateInputIneq, deltaSlackStateInputIneq, alpha, slackStateInputIneqNew);
+    for (size_t k = 0; k < numTrials; k++) {
+      auto& trial = linesearchTrials_[k];
+      trial.x.resize(x.size());
+      trial.u.resize(u.size());
+      trial.slackStateIneq.resize(slackStateIneq.size());
+      trial.slackStateInputIneq.resize(slackStateInputIneq.size());
+      multiple_shooting::incrementTrajectory(u, du, trial.alpha, trial.u);
+      multiple_shooting::incrementTrajectory(x, dx, trial.alpha, trial.x);
+      multiple_shooting::incrementTrajectory(slackStateIneq, deltaSlackStateIneq, trial.alpha, trial.slackStateIneq);
+      multiple_shooting::incrementTrajectory(slackStateInputIneq, deltaSlackStateInputIneq, trial.alpha, trial.slackStateInputIneq);
+    }
 
     // Compute cost and constraints
-    const PerformanceIndex performanceNew =
-        computePerformance(timeDiscretization, initState, xNew, uNew, barrierParam, slackStateIneqNew, slackStateInputIneqNew, metricsNew);
-
-    // Step acceptance and record step type
-    bool stepAccepted;
-    StepType stepType;
-    std::tie(stepAccepted, stepType) =
-        filterLinesearch_.acceptStep(baseline, performanceNew, alpha * subproblemSolution.armijoDescentMetric);
-
-    if (settings_.printLinesearch) {
-      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
-                << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
-      std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
-      std::cerr << performanceNew << "\n";
-    }
+    computePerformance(timeDiscretization, initState, barrierParam, numTrials);
+
+    // Check the trials in the order of the sequential backtracking
+    for (size_t k = 0; k < numTrials; k++) {
+      auto& trial = linesearchTrials_[k];
+      alpha = trial.alpha;
+      const PerformanceIndex& performanceNew = trial.performance;
+
+      // Step acceptance and record step type
+      bool stepAccepted;
+      StepType stepType;
+      std::tie(stepAccepted, stepType) =
+          filterLinesearch_.acceptStep(baseline, performanceNew, alpha * subproblemSolution.armijoDescentMetric);
+
+      if (settings_.printLinesearch) {
+        std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
+                  << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+        std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
+        std::cerr << performanceNew << "\n";
+      }
 
-    if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
-      slackStateIneq = std::move(slackStateIneqNew);
-      slackStateInputIneq = std::move(slackStateInputIneqNew);
-      metrics = std::move(metricsNew);
-
-      // Prepare step info
-      ipm::StepInfo stepInfo;
-      stepInfo.primalStepSize = alpha;
-      stepInfo.stepType = stepType;
-      stepInfo.dx_norm = alpha * deltaXnorm;
-      stepInfo.du_norm = alpha * deltaUnorm;
-      stepInfo.performanceAfterStep = performanceNew;
-      stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
-      return stepInfo;
-
-    } else {  // Try smaller step
-      alpha *= settings_.alpha_decay;
-
-      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
-      if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
-        if (settings_.printLinesearch) {
-          std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
-                    << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
+      if (stepAccepted) {  // Return if step accepted
+        // Swap, such that the workspace keeps the previous buffers for the next linesearch
+        x.swap(trial.x);
+        u.swap(trial.u);
+        slackStateIneq.swap(trial.slackStateIneq);
+        slackStateInputIneq.swap(trial.slackStateInputIneq);
+        metrics.swap(trial.metrics);
+
+        // Prepare step info
+        ipm::StepInfo stepInfo;
+        stepInfo.primalStepSize = alpha;
+        stepInfo.stepType = stepType;
+        stepInfo.dx_norm = alpha * deltaXnorm;
+        stepInfo.du_norm = alpha * deltaUnorm;
+        stepInfo.performanceAfterStep = performanceNew;
+        stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
+        return stepInfo;
+
+      } else {  // Try smaller step
+        alpha *= settings_.alpha_decay;
+
+        // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
+        if (isStepTooSmall(alpha)) {
+          if (settings_.printLinesearch) {
+            std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
+                      << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
+          }
+          terminate = true;
+          break;
+        }
+
+        if (alpha < settings_.alpha_min) {
+          terminate = true;
+          break;
         }
-        break;
       }
     }
-  } while (alpha >= settings_.alpha_min);
+  }
 
   // Alpha_min reached -> Don't take a step
   ipm::StepInfo stepInfo;
@@ -885,6 +992,7 @@ ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const
 
 void IpmSolver::takeDualStep(const OcpSubproblemSolution& subproblemSolution, const ipm::StepInfo& stepInfo, vector_array_t& lmd,
                              vector_array_t& nu, vector_array_t& dualStateIneq, vector_array_t& dualStateInputIneq) const {
+  OCS2_TRACE_SCOPE("IpmSolver", "takeDualStep");
   if (settings_.computeLagrangeMultipliers) {
     multiple_shooting::incrementTrajectory(lmd, subproblemSolution.deltaLmdSol, stepInfo.primalStepSize, lmd);
     multiple_shooting::incrementTrajectory(nu, subproblemSolution.deltaNuSol, stepInfo.primalStepSize, nu);
@@ -908,10 +1016,10 @@ scalar_t IpmSolver::updateBarrierParameter(scalar_t currentBarrierParameter, con
   }
 }
 
-ipm::Convergence IpmSolver::checkConvergence(int iteration, scalar_t barrierParam, const PerformanceIndex& baseline,
-                                             const ipm::StepInfo& stepInfo) const {
+ipm::Convergence IpmSolver::checkConvergence(int iteration, size_t maxNumIterations, scalar_t barrierParam,
+                                             const PerformanceIndex& baseline, const ipm::StepInfo& stepInfo) const {
   using Convergence = ipm::Convergence;
-  if ((iteration + 1) >= settings_.ipmIteration) {
+  if ((iteration + 1) >= maxNumIterations) {
     // Converged because the next iteration would exceed the specified number of iterations
     return Convergence::ITERATIONS;
   } else if (stepInfo.primalStepSize < settings_.alpha_min) {
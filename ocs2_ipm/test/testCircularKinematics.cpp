@@ -343,4 +343,59 @@ TEST(test_circular_kinematics, solve_projected_EqConstraints_MixedIneqConstraint
   for (const auto e : shiftTime) {
     solver.run(startTime + e, initState, finalTime + e);
   }
-}
\ No newline at end of file
+}
+TEST(test_circular_kinematics, solve_parallelLinesearchTrials) {
+  // optimal control problem
+  OptimalControlProblem problem = createCircularKinematicsProblem("/tmp/ocs2/ipm_test_generated");
+
+  // input box constraints
+  const vector_t e = (vector_t(4) << 0.5, 0.5, 0.5, 0.5).finished();
+  const matrix_t C = matrix_t::Zero(4, 2);
+  const matrix_t D = (matrix_t(4, 2) << matrix_t::Identity(2, 2), -matrix_t::Identity(2, 2)).finished();
+  problem.inequalityConstraintPtr->add("ubound", std::make_unique<LinearStateInputConstraint>(e, C, D));
+
+  // Initializer
+  DefaultInitializer zeroInitializer(2);
+
+  // Additional problem definitions
+  const scalar_t startTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const vector_t initState = (vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  auto solve = [&](size_t linesearchTrials, size_t nThreads) {
+    ipm::Settings s;
+    s.dt = 0.01;
+    s.ipmIteration = 20;
+    s.printLinesearch = true;
+    s.linesearchTrials = linesearchTrials;
+    s.nThreads = nThreads;
+    s.initialBarrierParameter = 1.0e-02;
+    s.targetBarrierParameter = 1.0e-04;
+
+    IpmSolver solver(s, problem, zeroInitializer);
+    solver.run(startTime, initState, finalTime);
+    return std::make_pair(solver.primalSolution(finalTime), solver.getIterationsLog());
+  };
+
+  // The concurrent trials must not change the result of the sequential backtracking
+  const auto sequential = solve(1, 1);
+  const auto concurrent = solve(4, 3);
+
+  const auto& sequentialLog = sequential.second;
+  const auto& concurrentLog = concurrent.second;
+  ASSERT_EQ(sequentialLog.size(), concurrentLog.size());
+  for (int i = 0; i < sequentialLog.size(); i++) {
+    EXPECT_EQ(sequentialLog[i].merit, concurrentLog[i].merit);
+    EXPECT_EQ(sequentialLog[i].cost, concurrentLog[i].cost);
+    EXPECT_EQ(sequentialLog[i].dynamicsViolationSSE, concurrentLog[i].dynamicsViolationSSE);
+    EXPECT_EQ(sequentialLog[i].inequalityConstraintsSSE, concurrentLog[i].inequalityConstraintsSSE);
+  }
+
+  const auto& sequentialSolution = sequential.first;
+  const auto& concurrentSolution = concurrent.first;
+  ASSERT_EQ(sequentialSolution.stateTrajectory_.size(), concurrentSolution.stateTrajectory_.size());
+  for (int i = 0; i < sequentialSolution.stateTrajectory_.size(); i++) {
+    EXPECT_TRUE(sequentialSolution.stateTrajectory_[i] == concurrentSolution.stateTrajectory_[i]);
+    EXPECT_TRUE(sequentialSolution.inputTrajectory_[i] == concurrentSolution.inputTrajectory_[i]);
+  }
+}
@@ -0,0 +1,111 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_ipm/IpmSolver.h"
+
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/test/AllocationCounter.h>
+
+#include <ocs2_oc/test/AllocationPausedCost.h>
+#include <ocs2_oc/test/DoubleIntegratorReachingTask.h>
+
+OCS2_DEFINE_ALLOCATION_COUNTER
+
+using namespace ocs2;
+
+/*
+ * Counterpart of the SQP workspace allocation test, see ocs2_sqp/test/testWorkspaceAllocations.cpp for the scope. The IPM iterations
+ * reuse the workspace of the solver. The bookkeeping of run() additionally initializes the slack and dual trajectories, and the costates
+ * and projection multipliers if computeLagrangeMultipliers is set.
+ */
+
+namespace {
+
+class IpmWorkspaceAllocations : public DoubleIntegratorReachingTask, public testing::TestWithParam<size_t> {
+ protected:
+  IpmWorkspaceAllocations() {
+    problem_.dynamicsPtr = getDynamicsPtr();
+    problem_.costPtr->add("cost", std::make_unique<test::AllocationPausedCost>(getCostPtr()));
+    problem_.finalCostPtr->add("finalCost", std::make_unique<test::AllocationPausedStateCost>(
+                                                std::make_unique<QuadraticStateCost>(matrix_t::Identity(STATE_DIM, STATE_DIM))));
+
+    referenceManagerPtr_ = std::make_shared<ReferenceManager>(TargetTrajectories({tGoal}, {xGoal}, {vector_t::Zero(INPUT_DIM)}));
+    problem_.targetTrajectoriesPtr = &referenceManagerPtr_->getTargetTrajectories();
+  }
+
+  /** Number of allocations of a cold-started run() with the given number of IPM iterations, after warming up the solver. */
+  size_t countRunAllocations(size_t ipmIteration) {
+    ipm::Settings settings;
+    settings.dt = 0.05;
+    settings.ipmIteration = ipmIteration;
+    settings.nThreads = GetParam();
+    settings.threadPoolWorkStealing = true;
+    settings.useParallelRiccatiSolver = true;
+    settings.printSolverStatistics = false;
+    settings.printSolverStatus = false;
+    settings.printLinesearch = false;
+
+    IpmSolver solver(settings, problem_, *getInitializer());
+    solver.setReferenceManager(referenceManagerPtr_);
+
+    constexpr size_t numWarmUpRuns = 3;
+    for (size_t i = 0; i < numWarmUpRuns; i++) {
+      solver.reset();
+      solver.run(0.0, xInit, tGoal);
+    }
+
+    solver.reset();
+    test::ScopedAllocationCounter allocationCounter;
+    solver.run(0.0, xInit, tGoal);
+    const size_t numAllocations = allocationCounter.count();
+
+    numIterations_ = solver.getIterationsLog().size();
+    return numAllocations;
+  }
+
+  OptimalControlProblem problem_;
+  std::shared_ptr<ReferenceManager> referenceManagerPtr_;
+  size_t numIterations_ = 0;
+};
+
+}  // unnamed namespace
+
+TEST_P(IpmWorkspaceAllocations, noAllocationsPerIteration) {
+  // A run with more iterations does not allocate more, i.e. the second iteration does not allocate at all
+  const size_t oneIterationAllocations = countRunAllocations(1);
+  ASSERT_EQ(numIterations_, 1);
+  const size_t twoIterationsAllocations = countRunAllocations(2);
+  ASSERT_EQ(numIterations_, 2);
+
+  EXPECT_EQ(twoIterationsAllocations, oneIterationAllocations);
+}
+
+INSTANTIATE_TEST_SUITE_P(NumThreads, IpmWorkspaceAllocations, testing::Values(1, 3));
@@ -61,12 +61,22 @@ class MPC_BASE {
 
   /**
    * The main routine of MPC which runs MPC for the given state and time.
+   * After a successful prepare(), this is the feedback phase of the real-time iteration.
    *
    * @param [in] currentTime: The given time.
    * @param [in] currentState: The given state.
    */
   virtual bool run(scalar_t currentTime, const vector_t& currentState);
 
+  /**
+   * Preparation phase of a real-time iteration. Solvers that support it set up the next problem around the current solution before the
+   * state at nextTime is measured, such that the following run() only performs the feedback phase for the measured state.
+   *
+   * @param [in] nextTime: The expected time of the next run().
+   * @return Whether the next run() is prepared.
+   */
+  bool prepare(scalar_t nextTime);
+
   /** Gets a pointer to the underlying solver used in the MPC. */
   virtual SolverBase* getSolverPtr() = 0;
 
@@ -89,6 +99,16 @@ class MPC_BASE {
    */
   virtual void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
+  /**
+   * Prepares the solver for the next calculateController() call on [initTime,finalTime], see prepare(). The default implementation
+   * does not prepare.
+   *
+   * @param [in] initTime: The expected initial time.
+   * @param [in] finalTime: The final time.
+   * @return Whether the solver is prepared.
+   */
+  virtual bool prepareController(scalar_t initTime, scalar_t finalTime) { return false; }
+
   /** Whether this is the first iteration of MPC or not. */
   bool isFirstMpcRun() const { return initRun_; }
 
@@ -73,6 +73,15 @@ class MPC_MRT_Interface final : public MRT_BASE {
    */
   void advanceMpc();
 
+  /**
+   * Prepares the next advanceMpc() call for an observation at the given time (real-time iteration). The next advanceMpc() then only
+   * runs the feedback phase of the solver, if it supports the split. Must not be called while advanceMpc() is running.
+   *
+   * @param [in] nextObservationTime: The expected time of the observation used by the next advanceMpc() call.
+   * @return Whether the next advanceMpc() call is prepared.
+   */
+  bool prepareMpc(scalar_t nextObservationTime);
+
   /**
    * @brief Retrieves the gain matrix from solver capable of optimizing over LinearController type.
    *
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <Eigen/Dense>
 
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <memory>
@@ -54,6 +55,12 @@ namespace ocs2 {
 /**
  * This class implements core MRT (Model Reference Tracking) functionality.
  * The responsibility of filling the buffer variables is left to the deriving classes.
+ *
+ * The policy is handed from the publishing thread (MPC or communication thread) to the MRT thread through a triple buffer: the
+ * publisher writes into its own buffer and exchanges it with the ready buffer, updatePolicy() exchanges the active buffer with the
+ * ready buffer if it holds a new policy. Both exchanges are single atomic operations, such that updatePolicy() never waits for the
+ * publisher and never misses the latest policy. The buffers are recycled, the publisher can write into the objects of an older
+ * policy with fillBuffer() instead of allocating new ones.
  */
 class MRT_BASE {
  public:
@@ -141,7 +148,7 @@ class MRT_BASE {
   /**
    * Checks the data buffer for an update of the MPC policy. If a new policy
    * is available on the buffer this method will load it to the in-use policy.
-   * This method also calls the modifyActiveSolution() method.
+   * This method also calls the modifyActiveSolution() method. It is wait-free.
    *
    * @return True if the policy is updated.
    */
@@ -159,37 +166,75 @@ class MRT_BASE {
   void addMrtObserver(std::shared_ptr<MrtObserver> mrtObserver) { observerPtrArray_.push_back(std::move(mrtObserver)); };
 
  protected:
+  /**
+   * Publishes a new policy. The given objects replace the ones of the publisher buffer.
+   */
   void moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
                     std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
 
+  /**
+   * Publishes a new policy by writing it into the objects of the publisher buffer. These objects hold an older policy which has
+   * been released by the MRT thread, such that their memory is reused.
+   *
+   * @param [in] fill: Callable with the signature void(CommandData&, PrimalSolution&, PerformanceIndex&) that overwrites the objects
+   * with the new policy.
+   */
+  template <typename Fill>
+  void fillBuffer(Fill&& fill);
+
  private:
-  /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** The objects of one policy. */
+  struct PolicyBuffer {
+    std::unique_ptr<CommandData> commandPtr;
+    std::unique_ptr<PrimalSolution> primalSolutionPtr;
+    std::unique_ptr<PerformanceIndex> performanceIndicesPtr;
+  };
+
+  /** The buffer of the policy in use by the MRT thread. */
+  const PolicyBuffer& activeBuffer() const { return policyBuffers_[activeBufferIndex_]; }
+
+  /** Makes the publisher buffer the ready buffer and takes over the previous ready buffer. Called while holding publishMutex_. */
+  void publishBuffer();
+
+  /** Calls modifyActiveSolution on all mrt observers. This function is called by the MRT thread on the active buffer */
   void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution);
 
-  /** Calls modifyBufferedSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** Calls modifyBufferedSolution on all mrt observers. This function is called while holding a publishMutex_ lock */
   void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer);
 
   // flags on state of the class
   std::atomic_bool policyReceivedEver_;
-  bool newPolicyInBuffer_;  // whether a new policy is waiting to be swapped in
 
-  // variables related to the MPC output
-  std::unique_ptr<CommandData> activeCommandPtr_;
-  std::unique_ptr<CommandData> bufferCommandPtr_;
-  std::unique_ptr<PrimalSolution> activePrimalSolutionPtr_;
-  std::unique_ptr<PrimalSolution> bufferPrimalSolutionPtr_;
-  std::unique_ptr<PerformanceIndex> activePerformanceIndicesPtr_;
-  std::unique_ptr<PerformanceIndex> bufferPerformanceIndicesPtr_;
+  // triple buffer of the MPC output
+  std::array<PolicyBuffer, 3> policyBuffers_;
+  size_t activeBufferIndex_;                // owned by the MRT thread
+  size_t publishBufferIndex_;               // owned by the publisher, guarded by publishMutex_
+  std::atomic_size_t readyBufferIndex_{0};  // index of the ready buffer, combined with a flag if it holds a new policy
 
-  // thread safety
-  mutable std::mutex bufferMutex_;  // for policy variables with the prefix (buffer*)
-  const size_t mrtTrylockWarningThreshold_ = 5;
-  size_t mrtTrylockWarningCount_;
+  // serializes the publishers and reset()
+  std::mutex publishMutex_;
 
   // variables needed for policy evaluation
   std::unique_ptr<RolloutBase> rolloutPtr_;
+  LinearInterpolation::TimeSegmentCursor stateTrajectoryCursor_;  // owned by the MRT thread
 
   std::vector<std::shared_ptr<MrtObserver>> observerPtrArray_;
 };
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Fill>
+void MRT_BASE::fillBuffer(Fill&& fill) {
+  std::lock_guard<std::mutex> lock(publishMutex_);
+  auto& buffer = policyBuffers_[publishBufferIndex_];
+  if (buffer.commandPtr == nullptr) {
+    buffer.commandPtr = std::make_unique<CommandData>();
+    buffer.primalSolutionPtr = std::make_unique<PrimalSolution>();
+    buffer.performanceIndicesPtr = std::make_unique<PerformanceIndex>();
+  }
+  fill(*buffer.commandPtr, *buffer.primalSolutionPtr, *buffer.performanceIndicesPtr);
+  publishBuffer();
+}
+
 }  // namespace ocs2
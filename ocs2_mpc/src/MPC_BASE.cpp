@@ -89,4 +89,16 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
   return true;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_BASE::prepare(scalar_t nextTime) {
+  // the preparation is based on the current solution
+  if (initRun_ || nextTime >= getSolverPtr()->getFinalTime()) {
+    return false;
+  }
+
+  return prepareController(nextTime, nextTime + mpcSettings_.timeHorizon_);
+}
+
 }  // namespace ocs2
@@ -33,6 +33,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+// The ready buffer index is combined with this flag when the ready buffer holds a policy that has not been taken by the MRT thread.
+constexpr size_t newPolicyFlag = 4;
+constexpr size_t bufferIndexMask = 3;
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -44,26 +50,26 @@ MRT_BASE::MRT_BASE() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_BASE::reset() {
-  std::lock_guard<std::mutex> lock(bufferMutex_);
+  std::lock_guard<std::mutex> lock(publishMutex_);
 
   policyReceivedEver_ = false;
-  newPolicyInBuffer_ = false;
-  mrtTrylockWarningCount_ = 0;
-
-  activeCommandPtr_.reset();
-  bufferCommandPtr_.reset();
-  activePrimalSolutionPtr_.reset();
-  bufferPrimalSolutionPtr_.reset();
-  activePerformanceIndicesPtr_.reset();
-  bufferPerformanceIndicesPtr_.reset();
+
+  for (auto& buffer : policyBuffers_) {
+    buffer.commandPtr.reset();
+    buffer.primalSolutionPtr.reset();
+    buffer.performanceIndicesPtr.reset();
+  }
+  activeBufferIndex_ = 0;
+  readyBufferIndex_ = 1;
+  publishBufferIndex_ = 2;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 const CommandData& MRT_BASE::getCommand() const {
-  if (activeCommandPtr_ != nullptr) {
-    return *activeCommandPtr_;
+  if (activeBuffer().commandPtr != nullptr) {
+    return *activeBuffer().commandPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getCommand] updatePolicy() should be called first!");
   }
@@ -73,8 +79,8 @@ const CommandData& MRT_BASE::getCommand() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PrimalSolution& MRT_BASE::getPolicy() const {
-  if (activePrimalSolutionPtr_ != nullptr) {
-    return *activePrimalSolutionPtr_;
+  if (activeBuffer().primalSolutionPtr != nullptr) {
+    return *activeBuffer().primalSolutionPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getPolicy] updatePolicy() should be called first!");
   }
@@ -84,8 +90,8 @@ const PrimalSolution& MRT_BASE::getPolicy() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PerformanceIndex& MRT_BASE::getPerformanceIndices() const {
-  if (activePerformanceIndicesPtr_ != nullptr) {
-    return *activePerformanceIndicesPtr_;
+  if (activeBuffer().performanceIndicesPtr != nullptr) {
+    return *activeBuffer().performanceIndicesPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getPerformanceIndices] updatePolicy() should be called first!");
   }
@@ -102,20 +108,21 @@ void MRT_BASE::initRollout(const RolloutBase* rolloutPtr) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_BASE::evaluatePolicy(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput, size_t& mode) {
-  if (activePrimalSolutionPtr_ == nullptr) {
+  const auto& activePrimalSolutionPtr = activeBuffer().primalSolutionPtr;
+  if (activePrimalSolutionPtr == nullptr) {
     throw std::runtime_error("[MRT_BASE::evaluatePolicy] updatePolicy() should be called first!");
   }
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > activePrimalSolutionPtr->timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(activePrimalSolutionPtr->timeTrajectory_.back()) << "\n";
   }
 
-  mpcInput = activePrimalSolutionPtr_->controllerPtr_->computeInput(currentTime, currentState);
-  mpcState =
-      LinearInterpolation::interpolate(currentTime, activePrimalSolutionPtr_->timeTrajectory_, activePrimalSolutionPtr_->stateTrajectory_);
+  mpcInput = activePrimalSolutionPtr->controllerPtr_->computeInput(currentTime, currentState);
+  const auto indexAlpha = stateTrajectoryCursor_.timeSegment(currentTime, activePrimalSolutionPtr->timeTrajectory_);
+  mpcState = LinearInterpolation::interpolate(indexAlpha, activePrimalSolutionPtr->stateTrajectory_);
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(currentTime);
+  mode = activePrimalSolutionPtr->modeSchedule_.modeAtTime(currentTime);
 }
 
 /******************************************************************************************************/
@@ -127,13 +134,14 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] rollout class is not set! Use initRollout() to initialize it!");
   }
 
-  if (activePrimalSolutionPtr_ == nullptr) {
+  const auto& activePrimalSolutionPtr = activeBuffer().primalSolutionPtr;
+  if (activePrimalSolutionPtr == nullptr) {
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] updatePolicy() should be called first!");
   }
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > activePrimalSolutionPtr->timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(activePrimalSolutionPtr->timeTrajectory_.back()) << "\n";
   }
 
   // perform a rollout
@@ -141,42 +149,28 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
   size_array_t postEventIndicesStock;
   vector_array_t stateTrajectory, inputTrajectory;
   const scalar_t finalTime = currentTime + timeStep;
-  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolutionPtr_->controllerPtr_.get(),
-                   activePrimalSolutionPtr_->modeSchedule_, timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
+  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolutionPtr->controllerPtr_.get(),
+                   activePrimalSolutionPtr->modeSchedule_, timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
 
   mpcState = stateTrajectory.back();
   mpcInput = inputTrajectory.back();
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(finalTime);
+  mode = activePrimalSolutionPtr->modeSchedule_.modeAtTime(finalTime);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool MRT_BASE::updatePolicy() {
-  std::unique_lock<std::mutex> lock(bufferMutex_, std::try_to_lock);
-  if (lock.owns_lock()) {
-    mrtTrylockWarningCount_ = 0;
-    if (newPolicyInBuffer_) {
-      // update the active solution from buffer
-      activeCommandPtr_.swap(bufferCommandPtr_);
-      activePrimalSolutionPtr_.swap(bufferPrimalSolutionPtr_);
-      activePerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
-      newPolicyInBuffer_ = false;  // make sure we don't swap in the old policy again
-
-      modifyActiveSolution(*activeCommandPtr_, *activePrimalSolutionPtr_);
-      return true;
-    } else {
-      return false;  // No policy update: the buffer contains nothing new.
-    }
-  } else {
-    ++mrtTrylockWarningCount_;
-    if (mrtTrylockWarningCount_ > mrtTrylockWarningThreshold_) {
-      std::cerr << "[MRT_BASE::updatePolicy] failed to lock the policyBufferMutex for " << mrtTrylockWarningCount_
-                << " consecutive times.\n";
-    }
-    return false;  // No policy update: the lock could not be acquired.
+  if ((readyBufferIndex_.load(std::memory_order_relaxed) & newPolicyFlag) == 0) {
+    return false;  // No policy update: the buffer contains nothing new.
   }
+
+  // update the active solution from buffer, the previous active buffer is handed back to the publisher
+  activeBufferIndex_ = readyBufferIndex_.exchange(activeBufferIndex_, std::memory_order_acq_rel) & bufferIndexMask;
+
+  modifyActiveSolution(*activeBuffer().commandPtr, *activeBuffer().primalSolutionPtr);
+  return true;
 }
 
 /******************************************************************************************************/
@@ -196,16 +190,27 @@ void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::un
     throw std::runtime_error("[MRT_BASE::moveToBuffer] performanceIndicesPtr cannot be a null pointer!");
   }
 
-  std::lock_guard<std::mutex> lk(bufferMutex_);
+  std::lock_guard<std::mutex> lk(publishMutex_);
   // use swap such that the old objects are destroyed after releasing the lock.
-  bufferCommandPtr_.swap(commandDataPtr);
-  bufferPrimalSolutionPtr_.swap(primalSolutionPtr);
-  bufferPerformanceIndicesPtr_.swap(performanceIndicesPtr);
+  auto& buffer = policyBuffers_[publishBufferIndex_];
+  buffer.commandPtr.swap(commandDataPtr);
+  buffer.primalSolutionPtr.swap(primalSolutionPtr);
+  buffer.performanceIndicesPtr.swap(performanceIndicesPtr);
+
+  publishBuffer();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::publishBuffer() {
+  auto& buffer = policyBuffers_[publishBufferIndex_];
 
   // allow user to modify the buffer
-  modifyBufferedSolution(*bufferCommandPtr_, *bufferPrimalSolutionPtr_);
+  modifyBufferedSolution(*buffer.commandPtr, *buffer.primalSolutionPtr);
 
-  newPolicyInBuffer_ = true;
+  // The previous ready buffer is either an unused policy or the policy released by the MRT thread, both can be overwritten.
+  publishBufferIndex_ = readyBufferIndex_.exchange(publishBufferIndex_ | newPolicyFlag, std::memory_order_acq_rel) & bufferIndexMask;
   policyReceivedEver_ = true;
 }
 
@@ -0,0 +1,154 @@
+/******************************************************************************
+Copyright (c) 2024, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include <ocs2_mpc/MRT_BASE.h>
+
+using namespace ocs2;
+
+namespace {
+
+/** Exposes the publisher side of MRT_BASE. */
+class TestMrt final : public MRT_BASE {
+ public:
+  void resetMpcNode(const TargetTrajectories& initTargetTrajectories) override {}
+  void setCurrentObservation(const SystemObservation& observation) override {}
+
+  /** Publishes policy k by overwriting the objects of the publisher buffer. */
+  void fillPolicy(size_t k, size_t trajectoryLength) {
+    fillBuffer([&](CommandData& command, PrimalSolution& primalSolution, PerformanceIndex& performanceIndex) {
+      const auto value = static_cast<scalar_t>(k);
+      command.mpcInitObservation_.time = value;
+      primalSolution.timeTrajectory_.assign(trajectoryLength, value);
+      primalSolution.stateTrajectory_.assign(trajectoryLength, vector_t::Constant(2, value));
+      performanceIndex.merit = value;
+    });
+  }
+
+  /** Publishes policy k by moving newly allocated objects into the publisher buffer. */
+  void movePolicy(size_t k, size_t trajectoryLength) {
+    const auto value = static_cast<scalar_t>(k);
+    std::unique_ptr<CommandData> commandPtr(new CommandData);
+    commandPtr->mpcInitObservation_.time = value;
+    std::unique_ptr<PrimalSolution> primalSolutionPtr(new PrimalSolution);
+    primalSolutionPtr->timeTrajectory_.assign(trajectoryLength, value);
+    primalSolutionPtr->stateTrajectory_.assign(trajectoryLength, vector_t::Constant(2, value));
+    std::unique_ptr<PerformanceIndex> performanceIndexPtr(new PerformanceIndex);
+    performanceIndexPtr->merit = value;
+    moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndexPtr));
+  }
+};
+
+/** Returns the index of the active policy and checks that all of its objects belong to the same policy. */
+scalar_t checkActivePolicy(const TestMrt& mrt) {
+  const scalar_t k = mrt.getCommand().mpcInitObservation_.time;
+  EXPECT_EQ(mrt.getPerformanceIndices().merit, k);
+  const auto& primalSolution = mrt.getPolicy();
+  EXPECT_FALSE(primalSolution.timeTrajectory_.empty());
+  EXPECT_EQ(primalSolution.timeTrajectory_.size(), primalSolution.stateTrajectory_.size());
+  for (size_t i = 0; i < primalSolution.timeTrajectory_.size(); ++i) {
+    EXPECT_EQ(primalSolution.timeTrajectory_[i], k);
+    EXPECT_TRUE(primalSolution.stateTrajectory_[i].isApproxToConstant(k, 0.0));
+  }
+  return k;
+}
+
+}  // unnamed namespace
+
+TEST(testMrtBuffer, noPolicyBeforeUpdate) {
+  TestMrt mrt;
+  EXPECT_FALSE(mrt.updatePolicy());
+  EXPECT_FALSE(mrt.initialPolicyReceived());
+  EXPECT_ANY_THROW(mrt.getPolicy());
+
+  mrt.fillPolicy(1, 3);
+  EXPECT_TRUE(mrt.initialPolicyReceived());
+  ASSERT_TRUE(mrt.updatePolicy());
+  EXPECT_EQ(checkActivePolicy(mrt), 1.0);
+  EXPECT_FALSE(mrt.updatePolicy());
+}
+
+TEST(testMrtBuffer, latestPolicyIsPickedUp) {
+  TestMrt mrt;
+  for (size_t k = 1; k <= 10; ++k) {
+    // several publications between two updates, only the last one is used
+    mrt.fillPolicy(3 * k - 2, k);
+    mrt.movePolicy(3 * k - 1, k + 1);
+    mrt.fillPolicy(3 * k, k + 2);
+    ASSERT_TRUE(mrt.updatePolicy());
+    EXPECT_EQ(checkActivePolicy(mrt), static_cast<scalar_t>(3 * k));
+    EXPECT_FALSE(mrt.updatePolicy());
+    EXPECT_EQ(checkActivePolicy(mrt), static_cast<scalar_t>(3 * k));
+  }
+}
+
+TEST(testMrtBuffer, concurrentPublishAndUpdate) {
+  constexpr size_t numPolicies = 20000;
+  TestMrt mrt;
+  std::atomic_bool publisherDone{false};
+
+  std::thread publisher([&]() {
+    for (size_t k = 1; k <= numPolicies; ++k) {
+      // the trajectory length changes with k, such that a torn read would also show up as a size mismatch
+      const size_t trajectoryLength = 1 + k % 17;
+      if (k % 2 == 0) {
+        mrt.fillPolicy(k, trajectoryLength);
+      } else {
+        mrt.movePolicy(k, trajectoryLength);
+      }
+    }
+    publisherDone = true;
+  });
+
+  scalar_t lastPolicy = 0.0;
+  size_t numUpdates = 0;
+  while (!publisherDone) {
+    if (mrt.updatePolicy()) {
+      const scalar_t k = checkActivePolicy(mrt);
+      ASSERT_GT(k, lastPolicy);
+      lastPolicy = k;
+      ++numUpdates;
+    } else if (lastPolicy > 0.0) {
+      ASSERT_EQ(checkActivePolicy(mrt), lastPolicy);
+    }
+  }
+  publisher.join();
+
+  // the final policy is always picked up
+  if (lastPolicy < static_cast<scalar_t>(numPolicies)) {
+    ASSERT_TRUE(mrt.updatePolicy());
+  }
+  EXPECT_EQ(checkActivePolicy(mrt), static_cast<scalar_t>(numPolicies));
+  EXPECT_FALSE(mrt.updatePolicy());
+  EXPECT_GT(numUpdates, 0);
+}
@@ -54,4 +54,29 @@ void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticAppro
 void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px = matrix_t(),
                             const vector_t& u0 = vector_t());
 
+/** Temporaries of the out-of-place change of input variables of a quadratic approximation */
+struct ChangeOfInputVariablesWorkspace {
+  matrix_t P_plus_R_Px;
+  vector_t r_plus_R_u0;
+  matrix_t R_Pu;
+};
+
+/**
+ * Out-of-place variant of the change of input variables of a quadratic approximation. The result and the workspace are resized as
+ * needed, such that repeated calls with the same sizes do not allocate.
+ *
+ * @param [in] quadraticApproximation : Approximation to be adapted
+ * @param [in] Pu : Matrix defining the range of \tilde{\delta u}
+ * @param [in] Px : Matrix defining the range of \delta x
+ * @param [in] u0 : Input offset
+ * @param [out] result : The adapted approximation
+ * @param [in, out] workspace : Memory of the temporaries
+ */
+void changeOfInputVariables(const ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, ScalarFunctionQuadraticApproximation& result, ChangeOfInputVariablesWorkspace& workspace);
+
+/** Out-of-place variant of the change of input variables of a linear system, without temporaries */
+void changeOfInputVariables(const VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, VectorFunctionLinearApproximation& result);
+
 }  // namespace ocs2
\ No newline at end of file
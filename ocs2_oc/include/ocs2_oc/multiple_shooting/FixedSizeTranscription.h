@@ -0,0 +1,77 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include "ocs2_oc/multiple_shooting/Transcription.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+/**
+ * Apply the state-input equality constraint projection for a single intermediate node transcription with compile-time state and
+ * input dimensions. The constraint factorization and all intermediate products live in fixed-size (stack) storage, such that the
+ * small matrix products of the change of input variables can be unrolled and vectorized by Eigen. The result is the same as the
+ * one of projectTranscription.
+ *
+ * @tparam STATE_DIM : State dimension. It must match the dimension of the transcription.
+ * @tparam INPUT_DIM : Input dimension. It must match the dimension of the transcription.
+ * @param transcription : Transcription for a single intermediate node
+ * @param extractProjectionMultiplier : Whether to extract the projection multiplier.
+ */
+template <int STATE_DIM, int INPUT_DIM>
+void projectTranscriptionFixedSize(Transcription& transcription, bool extractProjectionMultiplier = false);
+
+/**
+ * Whether the transcription can be projected by a compiled fixed-size implementation, i.e., there is an instantiation for its
+ * state and input dimensions and the number of state-input equality constraints does not exceed the input dimension.
+ */
+bool hasFixedSizeProjection(const Transcription& transcription);
+
+/**
+ * Apply the state-input equality constraint projection for a single intermediate node transcription. Dispatches at runtime to the
+ * fixed-size implementation if hasFixedSizeProjection(transcription) holds, and falls back to projectTranscription otherwise.
+ *
+ * Fixed-size implementations are compiled for the state and input dimensions {12, 24} x {12, 24}.
+ *
+ * @param transcription : Transcription for a single intermediate node
+ * @param extractProjectionMultiplier : Whether to extract the projection multiplier.
+ */
+void projectTranscriptionFixedSize(Transcription& transcription, bool extractProjectionMultiplier = false);
+
+// Declaring explicit instantiations of the dispatched dimensions
+extern template void projectTranscriptionFixedSize<12, 12>(Transcription&, bool);
+extern template void projectTranscriptionFixedSize<12, 24>(Transcription&, bool);
+extern template void projectTranscriptionFixedSize<24, 12>(Transcription&, bool);
+extern template void projectTranscriptionFixedSize<24, 24>(Transcription&, bool);
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
+
+#include "implementation/FixedSizeTranscription.h"
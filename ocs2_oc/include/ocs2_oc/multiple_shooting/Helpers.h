@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <ocs2_core/Types.h>
+#include <ocs2_core/misc/VectorTrajectory.h>
 
 #include "ocs2_oc/oc_data/PerformanceIndex.h"
 #include "ocs2_oc/oc_data/PrimalSolution.h"
@@ -65,6 +66,26 @@ void incrementTrajectory(const std::vector<Type>& v, const std::vector<Type>& dv
   }
 }
 
+/** Compute 2-norm of the trajectory: sqrt(sum_i v[i]^2) */
+inline scalar_t trajectoryNorm(const VectorTrajectory& v) {
+  return v.flat().norm();
+}
+
+/**
+ * Increment the given trajectory as: vNew[i] = v[i] + alpha * dv[i]. v and dv must have the same layout and vNew is resized to
+ * it if necessary. The update is a single loop over the contiguous storage.
+ */
+inline void incrementTrajectory(const VectorTrajectory& v, const VectorTrajectory& dv, const scalar_t alpha, VectorTrajectory& vNew) {
+  if (!v.hasSameLayout(dv)) {
+    throw std::runtime_error("[incrementTrajectory] v and dv must have the same node dimensions!");
+  }
+  if (!vNew.hasSameLayout(v)) {
+    vNew.resize(v.sizes());
+  }
+
+  vNew.flat() = v.flat() + alpha * dv.flat();
+}
+
 /**
  * Re-map the projected input back to the original space.
  *
@@ -75,8 +96,26 @@ void incrementTrajectory(const std::vector<Type>& v, const std::vector<Type>& dv
 void remapProjectedInput(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection, const vector_array_t& deltaXSol,
                          vector_array_t& deltaUSol);
 
+/**
+ * Re-map the projected feedback gains back to the original space.
+ *
+ * @param [in] constraintsProjection: The constraints projection.
+ * @param [in, out] KMatrices: The feedback gains of the QP subproblem solution.
+ */
 void remapProjectedGain(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection, matrix_array_t& KMatrices);
 
+/**
+ * Re-map the projected feedback gains back to the original space, where the projection of each node selects the given free inputs by
+ * its leading columns (see projectTranscriptionStructured). The gains of the free inputs are copied by index and only the remaining
+ * null space columns are multiplied. Nodes without free inputs are remapped densely.
+ *
+ * @param [in] constraintsProjection: The constraints projection.
+ * @param [in] projectedFreeInputs: The free inputs selected by the projection at each node.
+ * @param [in, out] KMatrices: The feedback gains of the QP subproblem solution.
+ */
+void remapProjectedGain(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection,
+                        const std::vector<std::vector<int>>& projectedFreeInputs, matrix_array_t& KMatrices);
+
 /**
  * Constructs a primal solution (with a feedforward controller) based the LQ subproblem solution.
  *
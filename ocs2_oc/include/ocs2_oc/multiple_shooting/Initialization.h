@@ -94,5 +94,36 @@ void initializeStateInputTrajectories(const vector_t& initState, const std::vect
                                       const PrimalSolution& primalSolution, Initializer& initializer, vector_array_t& stateTrajectory,
                                       vector_array_t& inputTrajectory);
 
+/**
+ * Maps the nodes of a new time discretization to the nodes of the previous solution, such that per-node solver data (e.g. the QP
+ * iterates) can be shifted along with the horizon. The previous nodes are first aligned to the new mode schedule by trajectory
+ * spreading. Every new node is then matched to the last aligned node at or before its time, where post-event nodes are placed just
+ * after their event. The pre- and post-event nodes of an event are therefore matched to the pre- and post-event nodes of the same event.
+ *
+ * @param [in] previousSolution : The previous solution, before it is adjusted to the new mode schedule.
+ * @param [in] newModeSchedule : The mode schedule of the new time discretization.
+ * @param [in] timeDiscretization : The new annotated time trajectory.
+ * @return For every new node, the index of the previous node or -1 if the node lies beyond the previous solution.
+ */
+std::vector<int> getWarmStartNodeIndices(const PrimalSolution& previousSolution, const ModeSchedule& newModeSchedule,
+                                         const std::vector<AnnotatedTime>& timeDiscretization);
+
+/**
+ * Linear interpolation of the nodes of the previous solution at the nodes of a new time discretization, such that per-node data which
+ * varies along the horizon (e.g. the costates) can be shifted with it. The previous nodes are aligned to the new mode schedule as in
+ * getWarmStartNodeIndices(). A new node that coincides with an aligned node takes that node, and a new node between two consecutive
+ * aligned nodes is interpolated between them. Where trajectory spreading has removed or repeated nodes, the new node falls back to the
+ * node of getWarmStartNodeIndices().
+ *
+ * @param [in] previousSolution : The previous solution, before it is adjusted to the new mode schedule.
+ * @param [in] newModeSchedule : The mode schedule of the new time discretization.
+ * @param [in] timeDiscretization : The new annotated time trajectory.
+ * @return For every new node, the index of the previous node and its interpolation coefficient (alpha), i.e. the node is interpolated
+ * as alpha * data[index] + (1 - alpha) * data[index + 1]. The index is -1 if the node lies beyond the previous solution.
+ */
+std::vector<LinearInterpolation::index_alpha_t> getWarmStartNodeInterpolation(const PrimalSolution& previousSolution,
+                                                                              const ModeSchedule& newModeSchedule,
+                                                                              const std::vector<AnnotatedTime>& timeDiscretization);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
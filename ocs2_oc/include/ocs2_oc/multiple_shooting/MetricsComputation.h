@@ -46,6 +46,13 @@ namespace multiple_shooting {
  */
 Metrics computeMetrics(const Transcription& transcription);
 
+/**
+ * In-place variant of computeMetrics for a single intermediate node. The memory held by the given Metrics is reused.
+ * @param transcription: multiple shooting transcription.
+ * @param [out] metrics: Metrics for a single intermediate node.
+ */
+void computeMetrics(const Transcription& transcription, Metrics& metrics);
+
 /**
  * Compute the Metrics for the event node.
  * @param transcription: multiple shooting transcription for event node.
@@ -53,6 +60,13 @@ Metrics computeMetrics(const Transcription& transcription);
  */
 Metrics computeMetrics(const EventTranscription& transcription);
 
+/**
+ * In-place variant of computeMetrics for the event node. The memory held by the given Metrics is reused.
+ * @param transcription: multiple shooting transcription.
+ * @param [out] metrics: Metrics for the event node.
+ */
+void computeMetrics(const EventTranscription& transcription, Metrics& metrics);
+
 /**
  * Compute the Metrics for the terminal node.
  * @param transcription: multiple shooting transcription for terminal node.
@@ -60,6 +74,13 @@ Metrics computeMetrics(const EventTranscription& transcription);
  */
 Metrics computeMetrics(const TerminalTranscription& transcription);
 
+/**
+ * In-place variant of computeMetrics for the terminal node. The memory held by the given Metrics is reused.
+ * @param transcription: multiple shooting transcription.
+ * @param [out] metrics: Metrics for the terminal node.
+ */
+void computeMetrics(const TerminalTranscription& transcription, Metrics& metrics);
+
 /**
  * Compute the Metrics for a single intermediate node.
  * @param optimalControlProblem : Definition of the optimal control problem
@@ -74,6 +95,21 @@ Metrics computeMetrics(const TerminalTranscription& transcription);
 Metrics computeIntermediateMetrics(OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer, scalar_t t, scalar_t dt,
                                    const vector_t& x, const vector_t& x_next, const vector_t& u);
 
+/**
+ * In-place variant of computeIntermediateMetrics. The memory held by the given Metrics is reused, except for the constraint values which
+ * the constraint terms return by value.
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param discretizer : In-place integrator to use for creating the discrete dynamics.
+ * @param t : Start of the discrete interval
+ * @param dt : Duration of the interval
+ * @param x : State at start of the interval
+ * @param x_next : State at the end of the interval
+ * @param u : Input, taken to be constant across the interval.
+ * @param [out] metrics : Metrics for a single intermediate node.
+ */
+void computeIntermediateMetrics(OptimalControlProblem& optimalControlProblem, DynamicsDiscretizerInPlace& discretizer, scalar_t t,
+                                scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u, Metrics& metrics);
+
 /**
  * Compute the Metrics for the event node.
  * @param optimalControlProblem : Definition of the optimal control problem
@@ -84,6 +120,18 @@ Metrics computeIntermediateMetrics(OptimalControlProblem& optimalControlProblem,
  */
 Metrics computeEventMetrics(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next);
 
+/**
+ * In-place variant of computeEventMetrics. The memory held by the given Metrics is reused, except for the jump map and the constraint
+ * values which are returned by value.
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param t : Time at the event node
+ * @param x : Pre-event state
+ * @param x_next : Post-event state
+ * @param [out] metrics : Metrics for the event node.
+ */
+void computeEventMetrics(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                         Metrics& metrics);
+
 /**
  * Compute the Metrics for the terminal node.
  * @param optimalControlProblem : Definition of the optimal control problem
@@ -93,5 +141,15 @@ Metrics computeEventMetrics(OptimalControlProblem& optimalControlProblem, scalar
  */
 Metrics computeTerminalMetrics(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x);
 
+/**
+ * In-place variant of computeTerminalMetrics. The memory held by the given Metrics is reused, except for the constraint values which the
+ * constraint terms return by value.
+ * @param optimalControlProblem : Definition of the optimal control problem
+ * @param t : Time at the terminal node
+ * @param x : Terminal state
+ * @param [out] metrics : Metrics for the terminal node.
+ */
+void computeTerminalMetrics(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, Metrics& metrics);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
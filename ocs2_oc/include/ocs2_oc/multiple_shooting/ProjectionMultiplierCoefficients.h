@@ -54,6 +54,17 @@ struct ProjectionMultiplierCoefficients {
    */
   void compute(const ScalarFunctionQuadraticApproximation& cost, const VectorFunctionLinearApproximation& dynamics,
                const VectorFunctionLinearApproximation& constraintProjection, const matrix_t& pseudoInverse);
+
+  /**
+   * Allocation-free variant of compute() for repeated calls with the same sizes.
+   *
+   * @param [in, out] pseudoInverseTimesR : Memory of the product of the pseudo-inverse and the input Hessian of the cost.
+   */
+  void compute(const ScalarFunctionQuadraticApproximation& cost, const VectorFunctionLinearApproximation& dynamics,
+               const VectorFunctionLinearApproximation& constraintProjection, const matrix_t& pseudoInverse, matrix_t& pseudoInverseTimesR);
+
+  /** Resizes the coefficients to zero, which marks a node without state-input equality constraints. */
+  void clear();
 };
 
 }  // namespace multiple_shooting
@@ -0,0 +1,82 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include "ocs2_oc/multiple_shooting/Transcription.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+/**
+ * Sparsity structure of the input matrix D of the state-input equality constraints C*x + D*u + e = 0. The constraints and inputs are
+ * grouped into independent blocks, i.e., the connected components of the sparsity pattern of D, such that D is block-diagonal up to a
+ * permutation of its rows and columns. Inputs that appear in no constraint are free.
+ *
+ * A selection constraint such as a zero contact force forms a block of one constraint and one input.
+ */
+struct ConstraintJacobianStructure {
+  struct Block {
+    std::vector<int> constraints;
+    std::vector<int> inputs;
+  };
+
+  std::vector<int> freeInputs;
+  std::vector<int> constrainedInputs;  // The inputs of all blocks, in block order
+  std::vector<Block> blocks;
+
+  /** Whether each block has at least as many inputs as constraints, i.e., the blocks can be projected independently. */
+  bool isProjectable() const;
+
+  /** Whether the projection of the blocks is cheaper than the projection of the full matrix, i.e., there is more than one block. */
+  bool isSparse() const { return freeInputs.size() + blocks.size() > 1; }
+};
+
+/** Detects the block structure of D from its (exactly) non-zero entries. */
+ConstraintJacobianStructure getConstraintJacobianStructure(const matrix_t& D);
+
+/**
+ * Apply the state-input equality constraint projection for a single intermediate node transcription, exploiting the structure of the
+ * constraint input matrix. Each block of the constraints is projected separately: blocks of a single constraint and input by
+ * index, larger blocks by their own LU (or QR when extracting the projection multiplier) decomposition. The change of input variables
+ * of the dynamics, cost, and state-input inequality constraints only operates on the constrained inputs and copies the entries of the
+ * free inputs.
+ *
+ * The columns of the projection Pu first select the free inputs, followed by the null space of each block. The projected problem is
+ * therefore equivalent to the one of projectTranscription, up to the choice of the null space basis. The selected free inputs are
+ * stored in transcription.projectedFreeInputs, which is left empty if the constraints have no exploitable structure and it falls back
+ * to projectTranscription.
+ *
+ * @param transcription : Transcription for a single intermediate node
+ * @param extractProjectionMultiplier : Whether to extract the projection multiplier.
+ */
+void projectTranscriptionStructured(Transcription& transcription, bool extractProjectionMultiplier = false);
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
@@ -31,7 +31,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/misc/LinearAlgebra.h>
 
+#include "ocs2_oc/approximate_model/ChangeOfInputVariables.h"
 #include "ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h"
 #include "ocs2_oc/oc_problem/OptimalControlProblem.h"
 
@@ -60,6 +62,7 @@ struct Transcription {
   VectorFunctionLinearApproximation stateIneqConstraints;
   VectorFunctionLinearApproximation stateInputIneqConstraints;
   VectorFunctionLinearApproximation constraintsProjection;
+  std::vector<int> projectedFreeInputs;  // Inputs selected by the leading columns of constraintsProjection.dfdu, if structured
   ProjectionMultiplierCoefficients projectionMultiplierCoefficients;
 };
 
@@ -78,6 +81,15 @@ struct Transcription {
 Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u);
 
+/**
+ * In-place variant of setupIntermediateNode. The memory held by the given transcription is reused, such that a transcription which is
+ * kept per node does not allocate in the following iterations of a solver.
+ *
+ * @param [out] transcription : multiple shooting transcription for this node.
+ */
+void setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizerInPlace& sensitivityDiscretizer,
+                           scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u, Transcription& transcription);
+
 /**
  * Apply the state-input equality constraint projection for a single intermediate node transcription.
  *
@@ -86,6 +98,40 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
  */
 void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier = false);
 
+/**
+ * Destination of the out-of-place projection of an intermediate node. The members refer to the storage of the projected node, e.g. to the
+ * elements of the subproblem arrays of a solver.
+ */
+struct ProjectedTranscription {
+  ScalarFunctionQuadraticApproximation& cost;
+  VectorFunctionLinearApproximation& dynamics;
+  VectorFunctionLinearApproximation& stateInputIneqConstraints;
+  VectorFunctionLinearApproximation& constraintsProjection;
+  std::vector<int>& projectedFreeInputs;
+  ProjectionMultiplierCoefficients& projectionMultiplierCoefficients;
+};
+
+/** Memory of the intermediate results of the projection of an intermediate node */
+struct ProjectionWorkspace {
+  LinearAlgebra::ConstraintProjectionWorkspace constraintProjection;
+  matrix_t constraintPseudoInverse;
+  matrix_t pseudoInverseTimesR;
+  ChangeOfInputVariablesWorkspace changeOfInputVariables;
+};
+
+/**
+ * Out-of-place variant of projectTranscription. The transcription keeps the unprojected terms, such that neither the transcription nor
+ * the destination changes its size. Together with a workspace per node, repeated projections of a node therefore do not allocate. A node
+ * without state-input equality constraints is copied to the destination.
+ *
+ * @param [in] transcription : Transcription for a single intermediate node
+ * @param [out] projected : Destination of the projected node
+ * @param [in, out] workspace : Memory of the intermediate results
+ * @param [in] extractProjectionMultiplier : Whether to extract the projection multiplier.
+ */
+void projectTranscription(const Transcription& transcription, ProjectedTranscription& projected, ProjectionWorkspace& workspace,
+                          bool extractProjectionMultiplier = false);
+
 /**
  * Results of the transcription at a terminal node
  */
@@ -106,6 +152,13 @@ struct TerminalTranscription {
  */
 TerminalTranscription setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x);
 
+/**
+ * In-place variant of setupTerminalNode.
+ *
+ * @param [out] transcription : multiple shooting transcription for the terminal node.
+ */
+void setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, TerminalTranscription& transcription);
+
 /**
  * Results of the transcription at an event
  */
@@ -128,5 +181,13 @@ struct EventTranscription {
  */
 EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next);
 
+/**
+ * In-place variant of setupEventNode.
+ *
+ * @param [out] transcription : multiple shooting transcription for the event node.
+ */
+void setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                    EventTranscription& transcription);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
@@ -0,0 +1,182 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <cassert>
+#include <tuple>
+
+#include <Eigen/LU>
+
+#include <ocs2_core/misc/LinearAlgebra.h>
+
+#include "ocs2_oc/approximate_model/ChangeOfInputVariables.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+namespace fixed_size {
+
+/** Fixed-size types of the projection. The projected input dimension depends on the constraints, hence it is bounded by INPUT_DIM. */
+template <int STATE_DIM, int INPUT_DIM>
+struct ProjectionTypes {
+  using state_matrix_t = Eigen::Matrix<scalar_t, STATE_DIM, STATE_DIM>;
+  using state_vector_t = Eigen::Matrix<scalar_t, STATE_DIM, 1>;
+  using state_input_matrix_t = Eigen::Matrix<scalar_t, STATE_DIM, INPUT_DIM>;
+  using input_state_matrix_t = Eigen::Matrix<scalar_t, INPUT_DIM, STATE_DIM>;
+  using input_matrix_t = Eigen::Matrix<scalar_t, INPUT_DIM, INPUT_DIM>;
+  using input_vector_t = Eigen::Matrix<scalar_t, INPUT_DIM, 1>;
+
+  // Bounded dynamic sizes: at most INPUT_DIM constraints and INPUT_DIM projected inputs
+  using constraint_input_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, INPUT_DIM, Eigen::ColMajor, INPUT_DIM, INPUT_DIM>;
+  using constraint_state_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, STATE_DIM, Eigen::ColMajor, INPUT_DIM, STATE_DIM>;
+  using constraint_vector_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, 1, Eigen::ColMajor, INPUT_DIM, 1>;
+  using input_projected_matrix_t = Eigen::Matrix<scalar_t, INPUT_DIM, Eigen::Dynamic, Eigen::ColMajor, INPUT_DIM, INPUT_DIM>;
+  using state_projected_matrix_t = Eigen::Matrix<scalar_t, STATE_DIM, Eigen::Dynamic, Eigen::ColMajor, STATE_DIM, INPUT_DIM>;
+  using projected_state_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, STATE_DIM, Eigen::ColMajor, INPUT_DIM, STATE_DIM>;
+  using projected_matrix_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor, INPUT_DIM, INPUT_DIM>;
+  using projected_vector_t = Eigen::Matrix<scalar_t, Eigen::Dynamic, 1, Eigen::ColMajor, INPUT_DIM, 1>;
+};
+
+/** Fixed-size counterpart of changeOfInputVariables for the dynamics: A = A + B*Px, b = b + B*u0, B = B*Pu */
+template <int STATE_DIM, int INPUT_DIM>
+void changeOfInputVariables(VectorFunctionLinearApproximation& dynamics,
+                            const typename ProjectionTypes<STATE_DIM, INPUT_DIM>::input_projected_matrix_t& Pu,
+                            const typename ProjectionTypes<STATE_DIM, INPUT_DIM>::input_state_matrix_t& Px,
+                            const typename ProjectionTypes<STATE_DIM, INPUT_DIM>::input_vector_t& u0) {
+  using types = ProjectionTypes<STATE_DIM, INPUT_DIM>;
+  Eigen::Map<typename types::state_matrix_t> A(dynamics.dfdx.data());
+  Eigen::Map<typename types::state_vector_t> b(dynamics.f.data());
+  const typename types::state_input_matrix_t B = Eigen::Map<const typename types::state_input_matrix_t>(dynamics.dfdu.data());
+
+  A.noalias() += B * Px;
+  b.noalias() += B * u0;
+
+  const typename types::state_projected_matrix_t B_Pu = B * Pu;
+  dynamics.dfdu = B_Pu;
+}
+
+/** Fixed-size counterpart of changeOfInputVariables for the cost. See ChangeOfInputVariables.cpp for the derivation. */
+template <int STATE_DIM, int INPUT_DIM>
+void changeOfInputVariables(ScalarFunctionQuadraticApproximation& cost,
+                            const typename ProjectionTypes<STATE_DIM, INPUT_DIM>::input_projected_matrix_t& Pu,
+                            const typename ProjectionTypes<STATE_DIM, INPUT_DIM>::input_state_matrix_t& Px,
+                            const typename ProjectionTypes<STATE_DIM, INPUT_DIM>::input_vector_t& u0) {
+  using types = ProjectionTypes<STATE_DIM, INPUT_DIM>;
+  Eigen::Map<typename types::state_matrix_t> Q(cost.dfdxx.data());
+  Eigen::Map<typename types::state_vector_t> q(cost.dfdx.data());
+  const Eigen::Map<const typename types::input_state_matrix_t> P(cost.dfdux.data());
+  const Eigen::Map<const typename types::input_matrix_t> R(cost.dfduu.data());
+  const Eigen::Map<const typename types::input_vector_t> r(cost.dfdu.data());
+
+  // Shared terms
+  typename types::input_state_matrix_t P_plus_R_Px = P;
+  P_plus_R_Px.noalias() += R * Px;
+  typename types::input_vector_t r_plus_R_u0 = r;
+  r_plus_R_u0.noalias() += R * u0;
+
+  // Q = Q + P'*Px + Px'*(P + R*Px)
+  Q.noalias() += P.transpose() * Px;
+  Q.noalias() += Px.transpose() * P_plus_R_Px;
+
+  // q = q + P' * u0 + Px' (R*u0 + r)
+  q.noalias() += P.transpose() * u0;
+  q.noalias() += Px.transpose() * r_plus_R_u0;
+
+  // c = c + 1/2*u0'((R*u0 + r) + r)
+  cost.f += 0.5 * u0.dot(r_plus_R_u0 + r);
+
+  // Projected terms are computed before overwriting the (mapped) original terms
+  const typename types::input_projected_matrix_t R_Pu = R * Pu;
+  const typename types::projected_state_matrix_t Pu_P = Pu.transpose() * P_plus_R_Px;
+  const typename types::projected_matrix_t Pu_R_Pu = Pu.transpose() * R_Pu;
+  const typename types::projected_vector_t Pu_r = Pu.transpose() * r_plus_R_u0;
+
+  cost.dfdux = Pu_P;
+  cost.dfduu = Pu_R_Pu;
+  cost.dfdu = Pu_r;
+}
+
+}  // namespace fixed_size
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <int STATE_DIM, int INPUT_DIM>
+void projectTranscriptionFixedSize(Transcription& transcription, bool extractProjectionMultiplier) {
+  using types = fixed_size::ProjectionTypes<STATE_DIM, INPUT_DIM>;
+
+  auto& cost = transcription.cost;
+  auto& dynamics = transcription.dynamics;
+  auto& stateInputEqConstraints = transcription.stateInputEqConstraints;
+  auto& stateInputIneqConstraints = transcription.stateInputIneqConstraints;
+  auto& projection = transcription.constraintsProjection;
+  auto& projectionMultiplierCoefficients = transcription.projectionMultiplierCoefficients;
+
+  if (stateInputEqConstraints.f.size() > 0) {
+    assert(dynamics.dfdx.rows() == STATE_DIM && dynamics.dfdx.cols() == STATE_DIM);
+    assert(dynamics.dfdu.cols() == INPUT_DIM);
+    assert(stateInputEqConstraints.f.size() <= INPUT_DIM);
+
+    typename types::input_projected_matrix_t Pu;
+    typename types::input_state_matrix_t Px;
+    typename types::input_vector_t u0;
+
+    if (extractProjectionMultiplier) {
+      // The multiplier coefficients require the pseudo-inverse from the QR decomposition, computed on the dynamic-size data.
+      matrix_t constraintPseudoInverse;
+      std::tie(projection, constraintPseudoInverse) = LinearAlgebra::qrConstraintProjection(stateInputEqConstraints);
+      projectionMultiplierCoefficients.compute(cost, dynamics, projection, constraintPseudoInverse);
+      Pu = projection.dfdu;
+      Px = projection.dfdx;
+      u0 = projection.f;
+    } else {
+      const typename types::constraint_input_matrix_t D = stateInputEqConstraints.dfdu;
+      const typename types::constraint_state_matrix_t C = stateInputEqConstraints.dfdx;
+      const typename types::constraint_vector_t e = stateInputEqConstraints.f;
+      const Eigen::FullPivLU<typename types::constraint_input_matrix_t> lu(D);
+      Pu = lu.kernel();
+      Px.noalias() = -lu.solve(C);
+      u0.noalias() = -lu.solve(e);
+
+      projection.dfdu = Pu;
+      projection.dfdx = Px;
+      projection.f = u0;
+      projectionMultiplierCoefficients = ProjectionMultiplierCoefficients();
+    }
+    stateInputEqConstraints = VectorFunctionLinearApproximation();
+
+    // Adapt dynamics, cost, and state-input inequality constraints
+    fixed_size::changeOfInputVariables<STATE_DIM, INPUT_DIM>(dynamics, Pu, Px, u0);
+    fixed_size::changeOfInputVariables<STATE_DIM, INPUT_DIM>(cost, Pu, Px, u0);
+    if (stateInputIneqConstraints.f.size() > 0) {
+      ocs2::changeOfInputVariables(stateInputIneqConstraints, projection.dfdu, projection.dfdx, projection.f);
+    }
+  }
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
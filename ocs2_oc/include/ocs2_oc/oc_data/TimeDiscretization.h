@@ -92,6 +92,15 @@ scalar_array_t toTime(const std::vector<AnnotatedTime>& annotatedTime);
  */
 scalar_array_t toInterpolationTime(const std::vector<AnnotatedTime>& annotatedTime);
 
+/**
+ * Extracts the interval start of each node of the annotated time trajectory, i.e. the times at which the cost and constraint
+ * terms of the nodes are evaluated.
+ *
+ * @param annotatedTime : Annotated time trajectory.
+ * @return The time trajectory.
+ */
+scalar_array_t toIntervalStartTime(const std::vector<AnnotatedTime>& annotatedTime);
+
 /**
  * Extracts the array of indices indicating the post-event times from the annotated time trajectory.
  *
@@ -86,4 +86,16 @@ OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximat
                                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                 const std::vector<VectorFunctionLinearApproximation>* constraints);
 
+/**
+ * In-place variant of extractSizesFromProblem, which reuses the memory of the given OcpSize.
+ *
+ * @param dynamics : Linearized approximation of the discrete dynamics.
+ * @param cost : Quadratic approximation of the cost.
+ * @param constraints : Linearized approximation of constraints, all constraints are mapped to inequality constraints in HPIPM.
+ * @param [out] problemSize : Derived sizes
+ */
+void extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                             const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                             const std::vector<VectorFunctionLinearApproximation>* constraints, OcpSize& problemSize);
+
 }  // namespace ocs2
\ No newline at end of file
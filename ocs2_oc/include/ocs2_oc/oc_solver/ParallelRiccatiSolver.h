@@ -0,0 +1,155 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/oc_problem/OcpSize.h"
+
+namespace ocs2 {
+
+/**
+ * This class implements an exact parallel-in-time solver for unconstrained discrete linear quadratic optimal control problems:
+ *
+ * min  sum_k { 0.5 x_k' Q_k x_k + u_k' P_k x_k + 0.5 u_k' R_k u_k + q_k' x_k + r_k' u_k } + 0.5 x_N' Q_N x_N + q_N' x_N
+ * s.t. x_{k+1} = A_k x_k + B_k u_k + b_k,  x_0 given.
+ *
+ * The Riccati recursion is written as an associative scan over the stages (S. Sarkka and A. F. Garcia-Fernandez, "Temporal
+ * Parallelization of Dynamic Programming and Linear Quadratic Control", IEEE TAC, 2023). Every stage is mapped to an element
+ * (A, b, C, eta, J) of the conditional value function, which can be combined with its neighbours in any grouping. The horizon is split
+ * into contiguous partitions: each partition is reduced to a single element in parallel, the partition boundaries are resolved by a short
+ * sequential pass over these elements, and finally the classical Riccati recursion runs concurrently inside every partition. The result
+ * is identical to the sequential Riccati recursion up to floating point round-off. The reduction costs about twice the flops of the
+ * sequential recursion, it therefore pays off from three worker threads onward.
+ *
+ * The input Hessian R_k must be positive definite for all stages. The state and input dimensions may vary over the stages.
+ *
+ * The solver is used by the multiple shooting solvers (SQP, IPM), whose QPs have exactly this form, and by the first iteration of ILQR.
+ * In general, the constraint projection and the Hessian correction of a DDP node are computed from the Hamiltonian Hessian
+ * R_k + B_k' S_{k+1} B_k, i.e. from the cost-to-go of the next node, and the events add transversality jumps. ILQR therefore only uses
+ * this solver for problems without events and state-input equality constraints, and with a Hessian correction which does not depend on
+ * the cost-to-go.
+ */
+class ParallelRiccatiSolver {
+ public:
+  /**
+   * Constructor.
+   * @param [in] ocpSize : Size of the problem. The problem should not have any constraints.
+   */
+  explicit ParallelRiccatiSolver(OcpSize ocpSize = OcpSize());
+
+  /** Resize the problem. The problem should not have any constraints. */
+  void resize(const OcpSize& ocpSize);
+
+  /** Gets the size of the problem. */
+  const OcpSize& getOcpSize() const { return ocpSize_; }
+
+  /**
+   * Solves the linear quadratic optimal control problem. The solver needs to be resized to a consistent OcpSize before calling this
+   * function.
+   *
+   * @param [in] threadPool : The thread pool which is used for the parallel passes. The calling thread participates in the work.
+   * @param [in] x0 : Initial state (deviation).
+   * @param [in] dynamics : Linearized approximation of the discrete dynamics.
+   * @param [in] cost : Quadratic approximation of the cost.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @return true if the problem was solved, false if an input Hessian was not positive definite.
+   */
+  bool solve(ThreadPool& threadPool, const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+             const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& stateTrajectory,
+             vector_array_t& inputTrajectory);
+
+  /**
+   * Return the Riccati cost-to-go for the previously solved problem.
+   *
+   * Cost-to-go at a node is: V_k(x) = 0.5 * x' * dfdxx * x + x' * dfdx + f
+   * For the moment, the value for f is set to 0.0 because it is not needed by the multiple shooting solvers.
+   *
+   * @return Sequence of N+1 quadratic cost-to-go's.
+   */
+  std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo() const;
+
+  /** Return the sequence of N feedback matrices K of the optimal solution u = K x + k for the previously solved problem. */
+  const matrix_array_t& getRiccatiFeedback() const { return feedback_; }
+
+  /** Return the sequence of N feedforward vectors k of the optimal solution u = K x + k for the previously solved problem. */
+  const vector_array_t& getRiccatiFeedforward() const { return feedforward_; }
+
+ private:
+  /** Element of the associative scan: the value function of x_i conditioned on x_j is V(x_i | x_j) with the parameters below */
+  struct Element {
+    matrix_t A;
+    vector_t b;
+    matrix_t C;
+    vector_t eta;
+    matrix_t J;
+  };
+
+  /** Scratch memory of one partition, kept between the solves such that the passes do not allocate once the sizes are settled. */
+  struct Workspace {
+    Element element;
+    Eigen::LLT<matrix_t> llt;
+    Eigen::PartialPivLU<matrix_t> lu;
+    matrix_t SA, SB, H, G, ZA, ZC, JA, AZC, RinvP, RinvBT, IPlusM;
+    vector_t sPlusSb, g, Rinvr, etaMinusJb, bPlusCEta, ZbPlusCEta;
+  };
+
+  /** Maps a stage to its scan element. Returns false if the input Hessian is not positive definite. */
+  static bool stageElement(const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+                           Element& element, Workspace& workspace);
+
+  /** Combines an earlier element with a later one: earlier = earlier (x) later. */
+  static void combine(Element& earlier, const Element& later, Workspace& workspace);
+
+  /**
+   * Computes the Riccati gains of stage k from the cost-to-go at k+1. If updateCostToGo is true, the cost-to-go at k is updated as well.
+   * Returns false if the Hessian w.r.t. the input is not positive definite.
+   */
+  bool riccatiStep(int k, const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+                   bool updateCostToGo, Workspace& workspace);
+
+  /** Runs the Riccati recursion over the stages [first, last). The cost-to-go at first is only updated if updateFirstCostToGo is true. */
+  bool riccatiSweep(int first, int last, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                    const std::vector<ScalarFunctionQuadraticApproximation>& cost, bool updateFirstCostToGo, Workspace& workspace);
+
+  OcpSize ocpSize_;
+
+  std::vector<int> partitionStarts_;
+  std::vector<Element> partitionElements_;
+  std::vector<Workspace> workspaces_;  // one per partition
+  matrix_array_t S_;  // Riccati matrices, size N+1
+  vector_array_t s_;  // Riccati vectors, size N+1
+  matrix_array_t feedback_;
+  vector_array_t feedforward_;
+};
+
+}  // namespace ocs2
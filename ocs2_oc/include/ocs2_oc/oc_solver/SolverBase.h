@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/ControllerBase.h>
+#include <ocs2_core/misc/Tracing.h>
 
 #include "ocs2_oc/oc_data/DualSolution.h"
 #include "ocs2_oc/oc_data/PerformanceIndex.h"
@@ -110,6 +111,9 @@ class SolverBase {
       throw std::runtime_error("[SolverBase] ReferenceManager pointer cannot be a nullptr!");
     }
     referenceManagerPtr_ = std::move(referenceManagerPtr);
+    if (referenceTimeGrid_) {
+      referenceManagerPtr_->setReferenceTimeGrid(referenceTimeGrid_);
+    }
   }
 
   /*
@@ -245,6 +249,19 @@ class SolverBase {
    */
   virtual std::string getBenchmarkingInfo() const { return {}; }
 
+  /**
+   * Gets the latency histograms of the traced scopes. The trace buffers are shared by all solvers of the process and are only
+   * populated when compiled with OCS2_ENABLE_TRACING.
+   */
+  std::vector<tracing::LatencyHistogram> getLatencyHistograms() const { return tracing::getLatencyHistograms(); }
+
+  /**
+   * Writes the recorded trace events in the Chrome trace-event format (viewable in chrome://tracing or Perfetto).
+   *
+   * @param [in] fileName: The output file path.
+   */
+  void exportTrace(const std::string& fileName) const { tracing::exportChromeTrace(fileName); }
+
   /**
    * Prints to output.
    *
@@ -252,6 +269,16 @@ class SolverBase {
    */
   void printString(const std::string& text) const;
 
+ protected:
+  /**
+   * Sets the time grid of the solver on which the ReferenceManager samples the TargetTrajectories into its ReferenceCache.
+   * The function is forwarded to any ReferenceManager set later.
+   */
+  void setReferenceTimeGrid(ReferenceManagerInterface::TimeGridFunction timeGridFunction) {
+    referenceTimeGrid_ = std::move(timeGridFunction);
+    referenceManagerPtr_->setReferenceTimeGrid(referenceTimeGrid_);
+  }
+
  private:
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
@@ -268,6 +295,7 @@ class SolverBase {
    ***********/
   mutable std::mutex outputDisplayGuardMutex_;
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;  // this pointer cannot be nullptr
+  ReferenceManagerInterface::TimeGridFunction referenceTimeGrid_;
   std::vector<std::shared_ptr<SolverSynchronizedModule>> synchronizedModules_;
   std::vector<std::unique_ptr<SolverObserver>> solverObservers_;
 };
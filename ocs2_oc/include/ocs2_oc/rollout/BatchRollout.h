@@ -0,0 +1,125 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/ControllerBase.h>
+#include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/oc_data/PerformanceIndex.h"
+#include "ocs2_oc/oc_problem/OptimalControlProblem.h"
+#include "ocs2_oc/rollout/RolloutSettings.h"
+
+namespace ocs2 {
+
+/**
+ * Closed-loop rollout of a batch of trajectories of the same system and policy, e.g. for evaluating a policy from many perturbed
+ * initial states.
+ *
+ * The trajectories share the time grid, hence they are integrated in lockstep: the states of a block of trajectories are the
+ * columns of a matrix and the dynamics are evaluated with ControlledSystemBase::computeFlowMapBatch(). The blocks are
+ * distributed over a thread pool, where each thread works on its own copy of the optimal control problem.
+ *
+ * The integration uses constant EULER or RK4 steps of (at most) rollout::Settings::timeStep as in the fixed-step mode of
+ * TimeTriggeredRollout. Along each trajectory, the cost and constraints of the optimal control problem are integrated with the
+ * trapezoidal rule, and the pre-jump and final terms are added. Diverging trajectories are not interrupted; their performance
+ * index is then not finite.
+ */
+class BatchRollout {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param [in] optimalControlProblem: The optimal control problem that provides the dynamics and the evaluated cost and constraints.
+   *                                    Its targetTrajectoriesPtr should be set, the target trajectories are evaluated in run().
+   * @param [in] rolloutSettings: The rollout settings. The integrator type should be EULER or RK4.
+   * @param [in] nThreads: Number of threads used for the rollouts including the calling thread.
+   * @param [in] threadPriority: Priority of the worker threads.
+   */
+  BatchRollout(const OptimalControlProblem& optimalControlProblem, rollout::Settings rolloutSettings, size_t nThreads = 1,
+               int threadPriority = 0);
+
+  ~BatchRollout() = default;
+  BatchRollout(const BatchRollout&) = delete;
+  BatchRollout& operator=(const BatchRollout&) = delete;
+
+  /**
+   * Rolls out the trajectories that start from the columns of initStates.
+   *
+   * @param [in] initTime: The initial time.
+   * @param [in] initStates: The initial states, one trajectory per column.
+   * @param [in] finalTime: The final time.
+   * @param [in] controller: The control policy. Each thread evaluates its own clone.
+   * @param [in] modeSchedule: The mode schedule.
+   * @param [out] finalStatesPtr: If not null, the final states are stored in its columns.
+   * @return The performance index of each trajectory. The merit is left to the caller.
+   */
+  std::vector<PerformanceIndex> run(scalar_t initTime, const matrix_t& initStates, scalar_t finalTime, const ControllerBase& controller,
+                                    const ModeSchedule& modeSchedule, matrix_t* finalStatesPtr = nullptr);
+
+  /** Gets the rollout settings. */
+  const rollout::Settings& settings() const { return rolloutSettings_; }
+
+ private:
+  /** Data of one thread */
+  struct Worker {
+    explicit Worker(const OptimalControlProblem& problem) : ocpDefinition(problem) {}
+
+    OptimalControlProblem ocpDefinition;
+    std::unique_ptr<ControllerBase> controllerPtr;
+    matrix_t state, input;
+    matrix_t stageState, stageInput;
+    matrix_t k1, k2, k3, k4;
+    vector_t stateCol, inputCol;
+    std::vector<PerformanceIndex> previousIntermediates;
+  };
+
+  /** Rolls out the trajectories in columns [firstCol, firstCol + numCols) of initStates. */
+  void runBlock(Worker& worker, const std::vector<std::pair<scalar_t, scalar_t>>& timeIntervalArray, const matrix_t& initStates,
+                int firstCol, int numCols, std::vector<PerformanceIndex>& performanceIndices, matrix_t* finalStatesPtr);
+
+  /** Evaluates the controller for each column of state. */
+  void computeInputs(Worker& worker, scalar_t t, const matrix_t& state, matrix_t& input) const;
+
+  /** Advances worker.state by one EULER or RK4 step. worker.input should contain the input at t. */
+  void fixedStep(Worker& worker, scalar_t t, scalar_t dt) const;
+
+  const rollout::Settings rolloutSettings_;
+  const size_t nThreads_;
+  std::vector<Worker> workers_;
+  ThreadPool threadPool_;
+};
+
+}  // namespace ocs2
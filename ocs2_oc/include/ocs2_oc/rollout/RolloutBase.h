@@ -119,10 +119,14 @@ class RolloutBase {
   static void display(const scalar_array_t& timeTrajectory, const size_array_t& postEventIndices, const vector_array_t& stateTrajectory,
                       const vector_array_t* const inputTrajectory);
 
- protected:
   /** Extracts an array of the rollout's start and final times for each active mode. */
-  std::vector<std::pair<scalar_t, scalar_t>> findActiveModesTimeInterval(scalar_t initTime, scalar_t finalTime,
-                                                                         const scalar_array_t& eventTimes) const;
+  static std::vector<std::pair<scalar_t, scalar_t>> findActiveModesTimeInterval(scalar_t initTime, scalar_t finalTime,
+                                                                                const scalar_array_t& eventTimes);
+
+  /** Number of constant steps of at most timeStep for integrating over the given time interval (of a fixed-step rollout). */
+  static size_t numFixedSteps(const std::pair<scalar_t, scalar_t>& timeInterval, scalar_t timeStep);
+
+ protected:
 
   /** Checks for the numerical stability if rollout::Settings::checkNumericalStability is true. */
   void checkNumericalStability(const ControllerBase& controller, const scalar_array_t& timeTrajectory, const size_array_t& postEventIndices,
@@ -53,6 +53,9 @@ struct Settings {
   scalar_t timeStep = 1e-2;
   /** Rollout integration scheme type */
   IntegratorType integratorType = IntegratorType::ODE45;
+  /** Whether TimeTriggeredRollout integrates with constant steps of (at most) timeStep into the reused output trajectories
+   *  instead of the adaptive odeint integration. Only the EULER and RK4 integrator types are supported in this mode. */
+  bool useFixedStepRollout = false;
 
   /** Whether to check that the rollout is numerically stable */
   bool checkNumericalStability = false;
@@ -42,6 +42,11 @@ namespace ocs2 {
 
 /**
  * This class is an interface class for forward rollout of the system dynamics.
+ *
+ * If rollout::Settings::useFixedStepRollout is set, each mode is integrated with a constant number of EULER or RK4 steps
+ * which is known before the integration starts. The output trajectories are then resized once and their entries are
+ * overwritten in place, therefore repeated rollouts with the same horizon (e.g. the line search of DDP) reuse the memory of
+ * the previous rollout.
  */
 class TimeTriggeredRollout : public RolloutBase {
  public:
@@ -69,12 +74,26 @@ class TimeTriggeredRollout : public RolloutBase {
                vector_array_t& inputTrajectory) override;
 
  private:
+  /** Integrates the modes with constant steps into trajectories of numNodes nodes. */
+  void runFixedStep(const std::vector<std::pair<scalar_t, scalar_t>>& timeIntervalArray, size_t numNodes, const vector_t& initState,
+                    ControllerBase& controller, scalar_array_t& timeTrajectory, size_array_t& postEventIndices,
+                    vector_array_t& stateTrajectory, vector_array_t& inputTrajectory);
+
+  /** Computes x + dt * dx/dt of one EULER or RK4 step and stores it in nextState. */
+  void fixedStep(ControllerBase& controller, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt, vector_t& nextState);
+
   std::unique_ptr<PreComputation> preCompPtr_;
   std::unique_ptr<ControlledSystemBase> systemDynamicsPtr_;
 
   std::shared_ptr<SystemEventHandler> systemEventHandlersPtr_;
 
   std::unique_ptr<IntegratorBase> dynamicsIntegratorPtr_;
+
+  // fixed step rollout buffers
+  vector_t inputBuffer_;
+  vector_t stageState_;
+  vector_t stageInput_;
+  vector_t k1_, k2_, k3_, k4_;
 };
 
 }  // namespace ocs2
@@ -59,6 +59,9 @@ class ReferenceManager : public ReferenceManagerInterface {
     return targetTrajectories_.setBuffer(std::move(targetTrajectories));
   }
 
+  void setReferenceTimeGrid(TimeGridFunction timeGridFunction) override { timeGridFunction_ = std::move(timeGridFunction); }
+  const ReferenceCache* getReferenceCache() const override { return timeGridFunction_ ? &referenceCache_ : nullptr; }
+
  protected:
   /**
    * Modifies the active ModeSchedule and TargetTrajectories.
@@ -77,6 +80,8 @@ class ReferenceManager : public ReferenceManagerInterface {
  private:
   BufferedValue<ModeSchedule> modeSchedule_;
   BufferedValue<TargetTrajectories> targetTrajectories_;
+  TimeGridFunction timeGridFunction_;
+  ReferenceCache referenceCache_;
 };
 
 }  // namespace ocs2
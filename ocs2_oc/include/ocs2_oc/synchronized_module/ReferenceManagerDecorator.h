@@ -64,6 +64,11 @@ class ReferenceManagerDecorator : public ReferenceManagerInterface {
     referenceManagerPtr_->setTargetTrajectories(std::move(targetTrajectories));
   }
 
+  void setReferenceTimeGrid(TimeGridFunction timeGridFunction) override {
+    referenceManagerPtr_->setReferenceTimeGrid(std::move(timeGridFunction));
+  }
+  const ReferenceCache* getReferenceCache() const override { return referenceManagerPtr_->getReferenceCache(); }
+
  protected:
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;
 };
@@ -29,8 +29,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <functional>
+
 #include <ocs2_core/Types.h>
 #include <ocs2_core/reference/ModeSchedule.h>
+#include <ocs2_core/reference/ReferenceCache.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
 
 namespace ocs2 {
@@ -40,6 +43,9 @@ namespace ocs2 {
  */
 class ReferenceManagerInterface {
  public:
+  /** Returns the time grid of the solver for the given horizon and the active ModeSchedule. */
+  using TimeGridFunction = std::function<scalar_array_t(scalar_t initTime, scalar_t finalTime, const ModeSchedule& modeSchedule)>;
+
   /** Constructor */
   ReferenceManagerInterface() = default;
 
@@ -90,6 +96,15 @@ class ReferenceManagerInterface {
    * @note: This method must be thread safe.
    */
   virtual void setTargetTrajectories(TargetTrajectories&& targetTrajectories) = 0;
+
+  /**
+   * Sets the time grid of the solver on which the active TargetTrajectories are sampled into the ReferenceCache in preSolverRun().
+   * An empty function disables the cache. The default implementation does not provide a cache.
+   */
+  virtual void setReferenceTimeGrid(TimeGridFunction timeGridFunction) {}
+
+  /** Returns the ReferenceCache of the active TargetTrajectories, or nullptr if the cache is not provided. */
+  virtual const ReferenceCache* getReferenceCache() const { return nullptr; }
 };
 
 }  // namespace ocs2
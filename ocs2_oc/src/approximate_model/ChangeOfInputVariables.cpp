@@ -107,4 +107,73 @@ void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximati
   linearApproximation.dfdu = linearApproximation.dfdu * Pu;  // temporary matrix unavoidable
 }
 
+void changeOfInputVariables(const ScalarFunctionQuadraticApproximation& quadraticApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, ScalarFunctionQuadraticApproximation& result, ChangeOfInputVariablesWorkspace& workspace) {
+  // Same terms as the in-place variant, with the shared terms in the workspace
+  const bool hasPx(Px.size() > 0);
+  const bool hasu0(u0.size() > 0);
+
+  auto& P_plus_R_Px = workspace.P_plus_R_Px;
+  P_plus_R_Px = quadraticApproximation.dfdux;
+  if (hasPx) {
+    P_plus_R_Px.noalias() += quadraticApproximation.dfduu * Px;
+  }
+
+  auto& r_plus_R_u0 = workspace.r_plus_R_u0;
+  r_plus_R_u0 = quadraticApproximation.dfdu;
+  if (hasu0) {
+    r_plus_R_u0.noalias() += quadraticApproximation.dfduu * u0;
+  }
+
+  // Q = Q + P'*Px + Px'*(P + R*Px)
+  result.dfdxx = quadraticApproximation.dfdxx;
+  if (hasPx) {
+    result.dfdxx.noalias() += quadraticApproximation.dfdux.transpose() * Px;
+    result.dfdxx.noalias() += Px.transpose() * P_plus_R_Px;
+  }
+
+  // q = q + P' * u0 + Px' (R*u0 + r)
+  result.dfdx = quadraticApproximation.dfdx;
+  if (hasu0) {
+    result.dfdx.noalias() += quadraticApproximation.dfdux.transpose() * u0;
+  }
+  if (hasPx) {
+    result.dfdx.noalias() += Px.transpose() * r_plus_R_u0;
+  }
+
+  // c = c + 1/2*u0'((R*u0 + r) + r)
+  result.f = quadraticApproximation.f;
+  if (hasu0) {
+    result.f += 0.5 * u0.dot(r_plus_R_u0 + quadraticApproximation.dfdu);
+  }
+
+  // P = Pu'*(P + R*Px)
+  result.dfdux.noalias() = Pu.transpose() * P_plus_R_Px;
+
+  // R = Pu' * R * Pu
+  workspace.R_Pu.noalias() = quadraticApproximation.dfduu * Pu;
+  result.dfduu.noalias() = Pu.transpose() * workspace.R_Pu;
+
+  // r = Pu' * (R*u0 + r)
+  result.dfdu.noalias() = Pu.transpose() * r_plus_R_u0;
+}
+
+void changeOfInputVariables(const VectorFunctionLinearApproximation& linearApproximation, const matrix_t& Pu, const matrix_t& Px,
+                            const vector_t& u0, VectorFunctionLinearApproximation& result) {
+  // A = A + B*Px
+  result.dfdx = linearApproximation.dfdx;
+  if (Px.size() > 0) {
+    result.dfdx.noalias() += linearApproximation.dfdu * Px;
+  }
+
+  // b = b + B*u0
+  result.f = linearApproximation.f;
+  if (u0.size() > 0) {
+    result.f.noalias() += linearApproximation.dfdu * u0;
+  }
+
+  // B = B*Pu
+  result.dfdu.noalias() = linearApproximation.dfdu * Pu;
+}
+
 }  // namespace ocs2
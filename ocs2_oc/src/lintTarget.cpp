@@ -38,6 +38,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
 #include <ocs2_oc/multiple_shooting/PerformanceIndexComputation.h>
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
+#include <ocs2_oc/multiple_shooting/StructuredProjection.h>
 #include <ocs2_oc/multiple_shooting/Transcription.h>
 
 // oc_data
@@ -55,6 +56,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 
 // oc_solver
+#include <ocs2_oc/oc_solver/ParallelRiccatiSolver.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
 
 // precondition
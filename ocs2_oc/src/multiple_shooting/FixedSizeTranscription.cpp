@@ -0,0 +1,88 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/multiple_shooting/FixedSizeTranscription.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+namespace {
+bool isDispatchedDimension(Eigen::Index dim) {
+  return dim == 12 || dim == 24;
+}
+}  // unnamed namespace
+
+bool hasFixedSizeProjection(const Transcription& transcription) {
+  const auto& dynamics = transcription.dynamics;
+  const auto& cost = transcription.cost;
+  const auto& constraints = transcription.stateInputEqConstraints;
+  const auto stateDim = dynamics.dfdx.rows();
+  const auto inputDim = dynamics.dfdu.cols();
+  const auto numConstraints = constraints.f.size();
+
+  // all terms are mapped onto the fixed-size types, hence they need to have exactly the dimensions of the kernels
+  const bool consistentDynamics = dynamics.dfdx.cols() == stateDim && dynamics.dfdu.rows() == stateDim && dynamics.f.size() == stateDim;
+  const bool consistentCost = cost.dfdxx.rows() == stateDim && cost.dfdxx.cols() == stateDim && cost.dfdx.size() == stateDim &&
+                              cost.dfdux.rows() == inputDim && cost.dfdux.cols() == stateDim && cost.dfduu.rows() == inputDim &&
+                              cost.dfduu.cols() == inputDim && cost.dfdu.size() == inputDim;
+  const bool consistentConstraints = constraints.dfdx.rows() == numConstraints && constraints.dfdx.cols() == stateDim &&
+                                     constraints.dfdu.rows() == numConstraints && constraints.dfdu.cols() == inputDim;
+  const bool fewerConstraintsThanInputs = numConstraints <= inputDim;
+
+  return isDispatchedDimension(stateDim) && isDispatchedDimension(inputDim) && consistentDynamics && consistentCost &&
+         consistentConstraints && fewerConstraintsThanInputs;
+}
+
+void projectTranscriptionFixedSize(Transcription& transcription, bool extractProjectionMultiplier) {
+  if (transcription.stateInputEqConstraints.f.size() == 0 || !hasFixedSizeProjection(transcription)) {
+    projectTranscription(transcription, extractProjectionMultiplier);
+    return;
+  }
+
+  const auto stateDim = transcription.dynamics.dfdx.rows();
+  const auto inputDim = transcription.dynamics.dfdu.cols();
+  if (stateDim == 12 && inputDim == 12) {
+    projectTranscriptionFixedSize<12, 12>(transcription, extractProjectionMultiplier);
+  } else if (stateDim == 12 && inputDim == 24) {
+    projectTranscriptionFixedSize<12, 24>(transcription, extractProjectionMultiplier);
+  } else if (stateDim == 24 && inputDim == 12) {
+    projectTranscriptionFixedSize<24, 12>(transcription, extractProjectionMultiplier);
+  } else {
+    projectTranscriptionFixedSize<24, 24>(transcription, extractProjectionMultiplier);
+  }
+}
+
+// Explicit instantiations of the dispatched dimensions
+template void projectTranscriptionFixedSize<12, 12>(Transcription&, bool);
+template void projectTranscriptionFixedSize<12, 24>(Transcription&, bool);
+template void projectTranscriptionFixedSize<24, 12>(Transcription&, bool);
+template void projectTranscriptionFixedSize<24, 24>(Transcription&, bool);
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
@@ -57,6 +57,32 @@ void remapProjectedGain(const std::vector<VectorFunctionLinearApproximation>& co
   }
 }
 
+void remapProjectedGain(const std::vector<VectorFunctionLinearApproximation>& constraintsProjection,
+                        const std::vector<std::vector<int>>& projectedFreeInputs, matrix_array_t& KMatrices) {
+  matrix_t tmp;  // 1 temporary for re-use.
+  for (int i = 0; i < KMatrices.size(); ++i) {
+    const auto& Pu = constraintsProjection[i].dfdu;
+    const auto& Px = constraintsProjection[i].dfdx;
+    const auto& freeInputs = projectedFreeInputs[i];
+    if (constraintsProjection[i].f.size() > 0) {
+      if (freeInputs.empty()) {
+        tmp.noalias() = Pu * KMatrices[i];
+        KMatrices[i] = tmp + Px;
+      } else {
+        // The free input rows of Pu are unit rows of the leading columns, the constrained input rows only span the null space columns
+        const int numFreeInputs = freeInputs.size();
+        const int numNullSpace = Pu.cols() - numFreeInputs;
+        tmp = Px;
+        tmp.noalias() += Pu.rightCols(numNullSpace) * KMatrices[i].bottomRows(numNullSpace);
+        for (int j = 0; j < numFreeInputs; ++j) {
+          tmp.row(freeInputs[j]) += KMatrices[i].row(j);
+        }
+        std::swap(KMatrices[i], tmp);
+      }
+    }
+  }
+}
+
 PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, ModeSchedule&& modeSchedule, vector_array_t&& x,
                                 vector_array_t&& u) {
   // Correct for missing inputs at PreEvents and the terminal time
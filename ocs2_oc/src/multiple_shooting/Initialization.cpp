@@ -29,6 +29,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/multiple_shooting/Initialization.h"
 
+#include <algorithm>
+#include <numeric>
+
+#include <ocs2_core/NumericTraits.h>
+
+#include "ocs2_oc/trajectory_adjustment/TrajectorySpreading.h"
+
 namespace ocs2 {
 namespace multiple_shooting {
 
@@ -78,5 +85,99 @@ void initializeStateInputTrajectories(const vector_t& initState, const std::vect
   }
 }
 
+namespace {
+
+/**
+ * Aligns the previous nodes with the new mode schedule. Returns the times of the aligned nodes, where the post-event nodes are placed just
+ * after their event, and the index of the previous node of each aligned node.
+ */
+std::pair<scalar_array_t, std::vector<int>> getSpreadNodes(const PrimalSolution& previousSolution, const ModeSchedule& newModeSchedule) {
+  // Interpolation time of the previous nodes: the post-event nodes are placed just after their event.
+  scalar_array_t spreadTimeTrajectory = previousSolution.timeTrajectory_;
+  for (const auto postEventIndex : previousSolution.postEventIndices_) {
+    if (postEventIndex < spreadTimeTrajectory.size()) {
+      spreadTimeTrajectory[postEventIndex] += numeric_traits::limitEpsilon<scalar_t>();
+    }
+  }
+
+  // Align the previous nodes with the new mode schedule
+  TrajectorySpreading trajectorySpreading;
+  trajectorySpreading.set(previousSolution.modeSchedule_, newModeSchedule, spreadTimeTrajectory);
+  std::vector<int> spreadIndices(spreadTimeTrajectory.size());
+  std::iota(spreadIndices.begin(), spreadIndices.end(), 0);
+  trajectorySpreading.adjustTrajectory(spreadIndices);
+  trajectorySpreading.adjustTimeTrajectory(spreadTimeTrajectory);
+  return {std::move(spreadTimeTrajectory), std::move(spreadIndices)};
+}
+
+/** Time of a new node on the time axis of the aligned nodes */
+scalar_t getNodeTime(const AnnotatedTime& annotatedTime) {
+  return annotatedTime.event == AnnotatedTime::Event::PostEvent ? getInterpolationTime(annotatedTime) : annotatedTime.time;
+}
+
+}  // unnamed namespace
+
+std::vector<int> getWarmStartNodeIndices(const PrimalSolution& previousSolution, const ModeSchedule& newModeSchedule,
+                                         const std::vector<AnnotatedTime>& timeDiscretization) {
+  std::vector<int> nodeIndices(timeDiscretization.size(), -1);
+  if (previousSolution.timeTrajectory_.empty()) {
+    return nodeIndices;
+  }
+
+  const auto spreadNodes = getSpreadNodes(previousSolution, newModeSchedule);
+  const auto& spreadTimeTrajectory = spreadNodes.first;
+  const auto& spreadIndices = spreadNodes.second;
+  if (spreadTimeTrajectory.empty()) {
+    return nodeIndices;
+  }
+
+  for (size_t i = 0; i < timeDiscretization.size(); i++) {
+    const scalar_t time = getNodeTime(timeDiscretization[i]);
+    if (time > spreadTimeTrajectory.back()) {
+      break;
+    }
+    const auto it = std::upper_bound(spreadTimeTrajectory.cbegin(), spreadTimeTrajectory.cend(), time);
+    const auto index = std::max<std::ptrdiff_t>(std::distance(spreadTimeTrajectory.cbegin(), it) - 1, 0);
+    nodeIndices[i] = spreadIndices[index];
+  }
+  return nodeIndices;
+}
+
+std::vector<LinearInterpolation::index_alpha_t> getWarmStartNodeInterpolation(const PrimalSolution& previousSolution,
+                                                                              const ModeSchedule& newModeSchedule,
+                                                                              const std::vector<AnnotatedTime>& timeDiscretization) {
+  std::vector<LinearInterpolation::index_alpha_t> nodeInterpolation(timeDiscretization.size(), {-1, scalar_t(1.0)});
+  if (previousSolution.timeTrajectory_.empty()) {
+    return nodeInterpolation;
+  }
+
+  const auto spreadNodes = getSpreadNodes(previousSolution, newModeSchedule);
+  const auto& spreadTimeTrajectory = spreadNodes.first;
+  const auto& spreadIndices = spreadNodes.second;
+  if (spreadTimeTrajectory.empty()) {
+    return nodeInterpolation;
+  }
+
+  for (size_t i = 0; i < timeDiscretization.size(); i++) {
+    const scalar_t time = getNodeTime(timeDiscretization[i]);
+    if (time > spreadTimeTrajectory.back()) {
+      break;
+    }
+    const auto it = std::upper_bound(spreadTimeTrajectory.cbegin(), spreadTimeTrajectory.cend(), time);
+    const auto index = std::max<std::ptrdiff_t>(std::distance(spreadTimeTrajectory.cbegin(), it) - 1, 0);
+    const auto nextIndex = index + 1;
+
+    // interpolate between consecutive previous nodes only, otherwise hold the node at or before the new node
+    const bool isInterior = spreadTimeTrajectory[index] < time && nextIndex < static_cast<std::ptrdiff_t>(spreadTimeTrajectory.size());
+    if (isInterior && spreadIndices[nextIndex] == spreadIndices[index] + 1) {
+      const scalar_t alpha = (spreadTimeTrajectory[nextIndex] - time) / (spreadTimeTrajectory[nextIndex] - spreadTimeTrajectory[index]);
+      nodeInterpolation[i] = {spreadIndices[index], alpha};
+    } else {
+      nodeInterpolation[i] = {spreadIndices[index], scalar_t(1.0)};
+    }
+  }
+  return nodeInterpolation;
+}
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
@@ -34,10 +34,32 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace ocs2 {
 namespace multiple_shooting {
 
-Metrics computeMetrics(const Transcription& transcription) {
-  const auto& constraintsSize = transcription.constraintsSize;
+namespace {
+void clearLagrangians(Metrics& metrics) {
+  metrics.stateEqLagrangian.clear();
+  metrics.stateIneqLagrangian.clear();
+  metrics.stateInputEqLagrangian.clear();
+  metrics.stateInputIneqLagrangian.clear();
+}
+
+template <typename Collection, typename... Args>
+void evaluateConstraint(const Collection& collection, vector_array_t& value, Args&&... args) {
+  if (collection.empty()) {
+    value.clear();
+  } else {
+    value = collection.getValue(std::forward<Args>(args)...);
+  }
+}
+}  // unnamed namespace
 
+Metrics computeMetrics(const Transcription& transcription) {
   Metrics metrics;
+  computeMetrics(transcription, metrics);
+  return metrics;
+}
+
+void computeMetrics(const Transcription& transcription, Metrics& metrics) {
+  const auto& constraintsSize = transcription.constraintsSize;
 
   // Cost
   metrics.cost = transcription.cost.f;
@@ -46,20 +68,25 @@ Metrics computeMetrics(const Transcription& transcription) {
   metrics.dynamicsViolation = transcription.dynamics.f;
 
   // Equality constraints
-  metrics.stateEqConstraint = toConstraintArray(constraintsSize.stateEq, transcription.stateEqConstraints.f);
-  metrics.stateInputEqConstraint = toConstraintArray(constraintsSize.stateInputEq, transcription.stateInputEqConstraints.f);
+  toConstraintArray(constraintsSize.stateEq, transcription.stateEqConstraints.f, metrics.stateEqConstraint);
+  toConstraintArray(constraintsSize.stateInputEq, transcription.stateInputEqConstraints.f, metrics.stateInputEqConstraint);
 
   // Inequality constraints.
-  metrics.stateIneqConstraint = toConstraintArray(constraintsSize.stateIneq, transcription.stateIneqConstraints.f);
-  metrics.stateInputIneqConstraint = toConstraintArray(constraintsSize.stateInputIneq, transcription.stateInputIneqConstraints.f);
+  toConstraintArray(constraintsSize.stateIneq, transcription.stateIneqConstraints.f, metrics.stateIneqConstraint);
+  toConstraintArray(constraintsSize.stateInputIneq, transcription.stateInputIneqConstraints.f, metrics.stateInputIneqConstraint);
 
-  return metrics;
+  // Lagrangians are not part of the transcription
+  clearLagrangians(metrics);
 }
 
 Metrics computeMetrics(const EventTranscription& transcription) {
-  const auto& constraintsSize = transcription.constraintsSize;
-
   Metrics metrics;
+  computeMetrics(transcription, metrics);
+  return metrics;
+}
+
+void computeMetrics(const EventTranscription& transcription, Metrics& metrics) {
+  const auto& constraintsSize = transcription.constraintsSize;
 
   // Cost
   metrics.cost = transcription.cost.f;
@@ -68,29 +95,42 @@ Metrics computeMetrics(const EventTranscription& transcription) {
   metrics.dynamicsViolation = transcription.dynamics.f;
 
   // Equality constraints
-  metrics.stateEqConstraint = toConstraintArray(constraintsSize.stateEq, transcription.eqConstraints.f);
+  toConstraintArray(constraintsSize.stateEq, transcription.eqConstraints.f, metrics.stateEqConstraint);
+  metrics.stateInputEqConstraint.clear();
 
   // Inequality constraints.
-  metrics.stateIneqConstraint = toConstraintArray(constraintsSize.stateIneq, transcription.ineqConstraints.f);
+  toConstraintArray(constraintsSize.stateIneq, transcription.ineqConstraints.f, metrics.stateIneqConstraint);
+  metrics.stateInputIneqConstraint.clear();
 
-  return metrics;
+  // Lagrangians are not part of the transcription
+  clearLagrangians(metrics);
 }
 
 Metrics computeMetrics(const TerminalTranscription& transcription) {
-  const auto& constraintsSize = transcription.constraintsSize;
-
   Metrics metrics;
+  computeMetrics(transcription, metrics);
+  return metrics;
+}
+
+void computeMetrics(const TerminalTranscription& transcription, Metrics& metrics) {
+  const auto& constraintsSize = transcription.constraintsSize;
 
   // Cost
   metrics.cost = transcription.cost.f;
 
+  // Dynamics
+  metrics.dynamicsViolation.resize(0);
+
   // Equality constraints
-  metrics.stateEqConstraint = toConstraintArray(constraintsSize.stateEq, transcription.eqConstraints.f);
+  toConstraintArray(constraintsSize.stateEq, transcription.eqConstraints.f, metrics.stateEqConstraint);
+  metrics.stateInputEqConstraint.clear();
 
   // Inequality constraints.
-  metrics.stateIneqConstraint = toConstraintArray(constraintsSize.stateIneq, transcription.ineqConstraints.f);
+  toConstraintArray(constraintsSize.stateIneq, transcription.ineqConstraints.f, metrics.stateIneqConstraint);
+  metrics.stateInputIneqConstraint.clear();
 
-  return metrics;
+  // Lagrangians are not part of the transcription
+  clearLagrangians(metrics);
 }
 
 Metrics computeIntermediateMetrics(OptimalControlProblem& optimalControlProblem, DynamicsDiscretizer& discretizer, scalar_t t, scalar_t dt,
@@ -110,6 +150,31 @@ Metrics computeIntermediateMetrics(OptimalControlProblem& optimalControlProblem,
   return metrics;
 }
 
+void computeIntermediateMetrics(OptimalControlProblem& optimalControlProblem, DynamicsDiscretizerInPlace& discretizer, scalar_t t,
+                                scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u, Metrics& metrics) {
+  // Dynamics
+  discretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt, metrics.dynamicsViolation);
+  metrics.dynamicsViolation -= x_next;
+
+  // Precomputation
+  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
+  optimalControlProblem.preComputationPtr->request(request, t, x, u);
+  const auto& preComputation = *optimalControlProblem.preComputationPtr;
+
+  // Cost
+  metrics.cost = dt * computeCost(optimalControlProblem, t, x, u);
+
+  // Equality constraints
+  evaluateConstraint(*optimalControlProblem.stateEqualityConstraintPtr, metrics.stateEqConstraint, t, x, preComputation);
+  evaluateConstraint(*optimalControlProblem.equalityConstraintPtr, metrics.stateInputEqConstraint, t, x, u, preComputation);
+
+  // Inequality constraints
+  evaluateConstraint(*optimalControlProblem.stateInequalityConstraintPtr, metrics.stateIneqConstraint, t, x, preComputation);
+  evaluateConstraint(*optimalControlProblem.inequalityConstraintPtr, metrics.stateInputIneqConstraint, t, x, u, preComputation);
+
+  clearLagrangians(metrics);
+}
+
 Metrics computeTerminalMetrics(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
   // Precomputation
   constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
@@ -130,5 +195,53 @@ Metrics computeEventMetrics(OptimalControlProblem& optimalControlProblem, scalar
   return computePreJumpMetrics(optimalControlProblem, t, x, std::move(dynamicsViolation));
 }
 
+void computeTerminalMetrics(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, Metrics& metrics) {
+  // Precomputation
+  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint;
+  optimalControlProblem.preComputationPtr->requestFinal(request, t, x);
+  const auto& preComputation = *optimalControlProblem.preComputationPtr;
+
+  // Cost
+  metrics.cost = computeFinalCost(optimalControlProblem, t, x);
+
+  // Dynamics
+  metrics.dynamicsViolation.resize(0);
+
+  // Equality constraints
+  evaluateConstraint(*optimalControlProblem.finalEqualityConstraintPtr, metrics.stateEqConstraint, t, x, preComputation);
+  metrics.stateInputEqConstraint.clear();
+
+  // Inequality constraints
+  evaluateConstraint(*optimalControlProblem.finalInequalityConstraintPtr, metrics.stateIneqConstraint, t, x, preComputation);
+  metrics.stateInputIneqConstraint.clear();
+
+  clearLagrangians(metrics);
+}
+
+void computeEventMetrics(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                         Metrics& metrics) {
+  // Precomputation
+  constexpr auto request = Request::Cost + Request::SoftConstraint + Request::Constraint + Request::Dynamics;
+  optimalControlProblem.preComputationPtr->requestPreJump(request, t, x);
+  const auto& preComputation = *optimalControlProblem.preComputationPtr;
+
+  // Cost
+  metrics.cost = computeEventCost(optimalControlProblem, t, x);
+
+  // Dynamics
+  metrics.dynamicsViolation = optimalControlProblem.dynamicsPtr->computeJumpMap(t, x);
+  metrics.dynamicsViolation -= x_next;
+
+  // Equality constraints
+  evaluateConstraint(*optimalControlProblem.preJumpEqualityConstraintPtr, metrics.stateEqConstraint, t, x, preComputation);
+  metrics.stateInputEqConstraint.clear();
+
+  // Inequality constraints
+  evaluateConstraint(*optimalControlProblem.preJumpInequalityConstraintPtr, metrics.stateIneqConstraint, t, x, preComputation);
+  metrics.stateInputIneqConstraint.clear();
+
+  clearLagrangians(metrics);
+}
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
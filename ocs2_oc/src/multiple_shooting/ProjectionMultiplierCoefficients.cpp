@@ -36,18 +36,30 @@ void ProjectionMultiplierCoefficients::compute(const ScalarFunctionQuadraticAppr
                                                const VectorFunctionLinearApproximation& dynamics,
                                                const VectorFunctionLinearApproximation& constraintProjection,
                                                const matrix_t& pseudoInverse) {
-  vector_t semiprojectedCost_dfdu = cost.dfdu;
-  semiprojectedCost_dfdu.noalias() += cost.dfduu * constraintProjection.f;
-
-  matrix_t semiprojectedCost_dfdux = cost.dfdux;
-  semiprojectedCost_dfdux.noalias() += cost.dfduu * constraintProjection.dfdx;
+  matrix_t pseudoInverseTimesR;
+  compute(cost, dynamics, constraintProjection, pseudoInverse, pseudoInverseTimesR);
+}
 
-  const matrix_t semiprojectedCost_dfduu = cost.dfduu * constraintProjection.dfdu;
+void ProjectionMultiplierCoefficients::compute(const ScalarFunctionQuadraticApproximation& cost,
+                                               const VectorFunctionLinearApproximation& dynamics,
+                                               const VectorFunctionLinearApproximation& constraintProjection,
+                                               const matrix_t& pseudoInverse, matrix_t& pseudoInverseTimesR) {
+  // The semi-projected cost terms r + R*Pe, P + R*Px, and R*Pu are expanded, such that pseudoInverse * R is the only temporary
+  pseudoInverseTimesR.noalias() = pseudoInverse * cost.dfduu;
 
-  this->dfdx.noalias() = -pseudoInverse * semiprojectedCost_dfdux;
-  this->dfdu.noalias() = -pseudoInverse * semiprojectedCost_dfduu;
+  this->dfdx.noalias() = -pseudoInverse * cost.dfdux;
+  this->dfdx.noalias() -= pseudoInverseTimesR * constraintProjection.dfdx;
+  this->dfdu.noalias() = -pseudoInverseTimesR * constraintProjection.dfdu;
   this->dfdcostate.noalias() = -pseudoInverse * dynamics.dfdu.transpose();
-  this->f.noalias() = -pseudoInverse * semiprojectedCost_dfdu;
+  this->f.noalias() = -pseudoInverse * cost.dfdu;
+  this->f.noalias() -= pseudoInverseTimesR * constraintProjection.f;
+}
+
+void ProjectionMultiplierCoefficients::clear() {
+  dfdx.resize(0, 0);
+  dfdu.resize(0, 0);
+  dfdcostate.resize(0, 0);
+  f.resize(0);
 }
 
 }  // namespace multiple_shooting
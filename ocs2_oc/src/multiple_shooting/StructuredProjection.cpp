@@ -0,0 +1,356 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/multiple_shooting/StructuredProjection.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <ocs2_core/misc/LinearAlgebra.h>
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+namespace {
+
+/** Returns the root of the constraint in the union-find forest, with path halving */
+int findRoot(std::vector<int>& parent, int i) {
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+void gatherRows(const matrix_t& M, const std::vector<int>& rows, matrix_t& out) {
+  out.resize(rows.size(), M.cols());
+  for (int k = 0; k < rows.size(); ++k) {
+    out.row(k) = M.row(rows[k]);
+  }
+}
+
+void gatherCols(const matrix_t& M, const std::vector<int>& cols, matrix_t& out) {
+  out.resize(M.rows(), cols.size());
+  for (int k = 0; k < cols.size(); ++k) {
+    out.col(k) = M.col(cols[k]);
+  }
+}
+
+void gather(const vector_t& v, const std::vector<int>& indices, vector_t& out) {
+  out.resize(indices.size());
+  for (int k = 0; k < indices.size(); ++k) {
+    out(k) = v(indices[k]);
+  }
+}
+
+/**
+ * The projection u = Pu * \tilde{u} + Px * x + Pe restricted to the constrained inputs, the rows of Px and Pe of the free inputs are
+ * zero and the columns of Pu of the free inputs are unit vectors.
+ */
+struct ConstrainedProjection {
+  matrix_t PuC;  // constrained inputs x null space of the blocks, block-diagonal
+  matrix_t PxC;  // constrained inputs x states
+  vector_t PeC;  // constrained inputs
+};
+
+/** u = Pu * \tilde{u} + Px * x + Pe applied to a linear function with the structured projection, see changeOfInputVariables() */
+void changeOfInputVariables(VectorFunctionLinearApproximation& linearApproximation, const ConstraintJacobianStructure& structure,
+                            const ConstrainedProjection& projection) {
+  const auto& freeInputs = structure.freeInputs;
+  const int numFreeInputs = freeInputs.size();
+
+  matrix_t B_C;
+  gatherCols(linearApproximation.dfdu, structure.constrainedInputs, B_C);
+
+  // A = A + B*Px, b = b + B*u0
+  linearApproximation.dfdx.noalias() += B_C * projection.PxC;
+  linearApproximation.f.noalias() += B_C * projection.PeC;
+
+  // B = B*Pu
+  matrix_t B_Pu(linearApproximation.dfdu.rows(), numFreeInputs + projection.PuC.cols());
+  for (int j = 0; j < numFreeInputs; ++j) {
+    B_Pu.col(j) = linearApproximation.dfdu.col(freeInputs[j]);
+  }
+  B_Pu.rightCols(projection.PuC.cols()).noalias() = B_C * projection.PuC;
+  linearApproximation.dfdu = std::move(B_Pu);
+}
+
+/** u = Pu * \tilde{u} + Px * x + Pe applied to a quadratic function with the structured projection, see changeOfInputVariables() */
+void changeOfInputVariables(ScalarFunctionQuadraticApproximation& quadraticApproximation, const ConstraintJacobianStructure& structure,
+                            const ConstrainedProjection& projection) {
+  // dfdxx = Q, dfdux = P, dfduu = R, dfdx = q, dfdu = r, f = c. Only the rows of Px and u0 of the constrained inputs are non-zero.
+  const auto& freeInputs = structure.freeInputs;
+  const auto& constrainedInputs = structure.constrainedInputs;
+  const int numFreeInputs = freeInputs.size();
+  const int numNullSpace = projection.PuC.cols();
+  const auto& PxC = projection.PxC;
+  const auto& PeC = projection.PeC;
+
+  matrix_t R_C;
+  gatherCols(quadraticApproximation.dfduu, constrainedInputs, R_C);
+
+  // Shared terms P + R*Px and r + R*u0
+  matrix_t P_plus_R_Px = quadraticApproximation.dfdux;
+  P_plus_R_Px.noalias() += R_C * PxC;
+  vector_t r_plus_R_u0 = quadraticApproximation.dfdu;
+  r_plus_R_u0.noalias() += R_C * PeC;
+
+  matrix_t P_C, P_plus_R_Px_C;
+  gatherRows(quadraticApproximation.dfdux, constrainedInputs, P_C);
+  gatherRows(P_plus_R_Px, constrainedInputs, P_plus_R_Px_C);
+  vector_t r_C, r_plus_R_u0_C;
+  gather(quadraticApproximation.dfdu, constrainedInputs, r_C);
+  gather(r_plus_R_u0, constrainedInputs, r_plus_R_u0_C);
+
+  // Q = Q + P'*Px + Px'*(P + R*Px)
+  quadraticApproximation.dfdxx.noalias() += P_C.transpose() * PxC;
+  quadraticApproximation.dfdxx.noalias() += PxC.transpose() * P_plus_R_Px_C;
+
+  // q = q + P' * u0 + Px' (R*u0 + r)
+  quadraticApproximation.dfdx.noalias() += P_C.transpose() * PeC;
+  quadraticApproximation.dfdx.noalias() += PxC.transpose() * r_plus_R_u0_C;
+
+  // c = c + 1/2*u0'((R*u0 + r) + r)
+  quadraticApproximation.f += 0.5 * PeC.dot(r_plus_R_u0_C + r_C);
+
+  // P = Pu'*(P + R*Px)
+  quadraticApproximation.dfdux.resize(numFreeInputs + numNullSpace, P_plus_R_Px.cols());
+  for (int j = 0; j < numFreeInputs; ++j) {
+    quadraticApproximation.dfdux.row(j) = P_plus_R_Px.row(freeInputs[j]);
+  }
+  quadraticApproximation.dfdux.bottomRows(numNullSpace).noalias() = projection.PuC.transpose() * P_plus_R_Px_C;
+
+  // R = Pu' * R * Pu, with the free-free block selected and the free-null space block from R*Pu
+  const matrix_t R_Pu_C = R_C * projection.PuC;
+  matrix_t R_Pu_CC;
+  gatherRows(R_Pu_C, constrainedInputs, R_Pu_CC);
+  matrix_t R(numFreeInputs + numNullSpace, numFreeInputs + numNullSpace);
+  for (int j = 0; j < numFreeInputs; ++j) {
+    for (int k = 0; k < numFreeInputs; ++k) {
+      R(k, j) = quadraticApproximation.dfduu(freeInputs[k], freeInputs[j]);
+    }
+    R.block(numFreeInputs, j, numNullSpace, 1) = R_Pu_C.row(freeInputs[j]).transpose();
+    R.block(j, numFreeInputs, 1, numNullSpace) = R_Pu_C.row(freeInputs[j]);
+  }
+  R.bottomRightCorner(numNullSpace, numNullSpace).noalias() = projection.PuC.transpose() * R_Pu_CC;
+  quadraticApproximation.dfduu = std::move(R);
+
+  // r = Pu' * (R*u0 + r)
+  quadraticApproximation.dfdu.resize(numFreeInputs + numNullSpace);
+  for (int j = 0; j < numFreeInputs; ++j) {
+    quadraticApproximation.dfdu(j) = r_plus_R_u0(freeInputs[j]);
+  }
+  quadraticApproximation.dfdu.tail(numNullSpace).noalias() = projection.PuC.transpose() * r_plus_R_u0_C;
+}
+
+}  // unnamed namespace
+
+bool ConstraintJacobianStructure::isProjectable() const {
+  return std::all_of(blocks.begin(), blocks.end(), [](const Block& b) { return b.constraints.size() <= b.inputs.size(); });
+}
+
+ConstraintJacobianStructure getConstraintJacobianStructure(const matrix_t& D) {
+  const int numConstraints = D.rows();
+  const int numInputs = D.cols();
+
+  // Union the constraints that share an input
+  std::vector<int> parent(numConstraints);
+  std::iota(parent.begin(), parent.end(), 0);
+  std::vector<int> inputRoot(numInputs, -1);
+  for (int j = 0; j < numInputs; ++j) {
+    for (int i = 0; i < numConstraints; ++i) {
+      if (D(i, j) != 0.0) {
+        const int root = findRoot(parent, i);
+        if (inputRoot[j] < 0) {
+          inputRoot[j] = root;
+        } else {
+          const int inputRootNow = findRoot(parent, inputRoot[j]);
+          if (root != inputRootNow) {
+            parent[root] = inputRootNow;
+          }
+        }
+      }
+    }
+  }
+
+  // Collect the blocks in the order of their first constraint
+  ConstraintJacobianStructure structure;
+  std::vector<int> blockIndex(numConstraints, -1);
+  for (int i = 0; i < numConstraints; ++i) {
+    const int root = findRoot(parent, i);
+    if (blockIndex[root] < 0) {
+      blockIndex[root] = structure.blocks.size();
+      structure.blocks.emplace_back();
+    }
+    structure.blocks[blockIndex[root]].constraints.push_back(i);
+  }
+  for (int j = 0; j < numInputs; ++j) {
+    if (inputRoot[j] < 0) {
+      structure.freeInputs.push_back(j);
+    } else {
+      structure.blocks[blockIndex[findRoot(parent, inputRoot[j])]].inputs.push_back(j);
+    }
+  }
+  for (const auto& block : structure.blocks) {
+    structure.constrainedInputs.insert(structure.constrainedInputs.end(), block.inputs.begin(), block.inputs.end());
+  }
+
+  return structure;
+}
+
+void projectTranscriptionStructured(Transcription& transcription, bool extractProjectionMultiplier) {
+  auto& cost = transcription.cost;
+  auto& dynamics = transcription.dynamics;
+  auto& stateInputEqConstraints = transcription.stateInputEqConstraints;
+  auto& stateInputIneqConstraints = transcription.stateInputIneqConstraints;
+  auto& projection = transcription.constraintsProjection;
+  auto& projectionMultiplierCoefficients = transcription.projectionMultiplierCoefficients;
+
+  transcription.projectedFreeInputs.clear();
+  if (stateInputEqConstraints.f.size() == 0) {
+    return;
+  }
+
+  const auto structure = getConstraintJacobianStructure(stateInputEqConstraints.dfdu);
+  if (!structure.isSparse() || !structure.isProjectable()) {
+    projectTranscription(transcription, extractProjectionMultiplier);
+    return;
+  }
+  transcription.projectedFreeInputs = structure.freeInputs;
+
+  const int numConstraints = stateInputEqConstraints.f.size();
+  const int numStates = stateInputEqConstraints.dfdx.cols();
+  const int numInputs = stateInputEqConstraints.dfdu.cols();
+  const int numFreeInputs = structure.freeInputs.size();
+  const int numConstrainedInputs = structure.constrainedInputs.size();
+
+  // Project each block
+  ConstrainedProjection constrainedProjection;
+  constrainedProjection.PxC.resize(numConstrainedInputs, numStates);
+  constrainedProjection.PeC.resize(numConstrainedInputs);
+  matrix_t pseudoInverse;
+  if (extractProjectionMultiplier) {
+    pseudoInverse.setZero(numConstraints, numInputs);
+  }
+  std::vector<matrix_t> blockNullSpaces(structure.blocks.size());
+  int inputOffset = 0;
+  for (int b = 0; b < structure.blocks.size(); ++b) {
+    const auto& block = structure.blocks[b];
+    const int numBlockInputs = block.inputs.size();
+    if (block.constraints.size() == 1 && numBlockInputs == 1) {
+      // Selection of a single input: d * u_j + c' * x + e = 0
+      const int i = block.constraints.front();
+      const scalar_t d = stateInputEqConstraints.dfdu(i, block.inputs.front());
+      constrainedProjection.PxC.row(inputOffset) = -stateInputEqConstraints.dfdx.row(i) / d;
+      constrainedProjection.PeC(inputOffset) = -stateInputEqConstraints.f(i) / d;
+      if (extractProjectionMultiplier) {
+        pseudoInverse(i, block.inputs.front()) = 1.0 / d;
+      }
+    } else {
+      VectorFunctionLinearApproximation blockConstraint;
+      gatherRows(stateInputEqConstraints.dfdx, block.constraints, blockConstraint.dfdx);
+      gather(stateInputEqConstraints.f, block.constraints, blockConstraint.f);
+      matrix_t D_C;
+      gatherRows(stateInputEqConstraints.dfdu, block.constraints, D_C);
+      gatherCols(D_C, block.inputs, blockConstraint.dfdu);
+
+      VectorFunctionLinearApproximation blockProjection;
+      if (extractProjectionMultiplier) {
+        // The Moore-Penrose pseudo-inverse of a block-diagonal matrix is the one of its blocks, as in projectTranscription
+        matrix_t blockPseudoInverse;
+        std::tie(blockProjection, blockPseudoInverse) = LinearAlgebra::qrConstraintProjection(blockConstraint);
+        for (int k = 0; k < block.constraints.size(); ++k) {
+          for (int l = 0; l < numBlockInputs; ++l) {
+            pseudoInverse(block.constraints[k], block.inputs[l]) = blockPseudoInverse(k, l);
+          }
+        }
+      } else {
+        const Eigen::FullPivLU<matrix_t> lu(blockConstraint.dfdu);
+        if (lu.dimensionOfKernel() > 0) {
+          blockProjection.dfdu = lu.kernel();
+        } else {
+          blockProjection.dfdu.resize(numBlockInputs, 0);
+        }
+        blockProjection.dfdx.noalias() = -lu.solve(blockConstraint.dfdx);
+        blockProjection.f.noalias() = -lu.solve(blockConstraint.f);
+      }
+      constrainedProjection.PxC.middleRows(inputOffset, numBlockInputs) = blockProjection.dfdx;
+      constrainedProjection.PeC.segment(inputOffset, numBlockInputs) = blockProjection.f;
+      blockNullSpaces[b] = std::move(blockProjection.dfdu);
+    }
+    inputOffset += numBlockInputs;
+  }
+
+  // Assemble the block-diagonal null space of the constrained inputs
+  const int numNullSpace = std::accumulate(blockNullSpaces.begin(), blockNullSpaces.end(), 0,
+                                           [](int n, const matrix_t& nullSpace) { return n + static_cast<int>(nullSpace.cols()); });
+  constrainedProjection.PuC.setZero(numConstrainedInputs, numNullSpace);
+  inputOffset = 0;
+  int nullSpaceOffset = 0;
+  for (int b = 0; b < structure.blocks.size(); ++b) {
+    const int numBlockInputs = structure.blocks[b].inputs.size();
+    const int numBlockNullSpace = blockNullSpaces[b].cols();
+    if (numBlockNullSpace > 0) {
+      constrainedProjection.PuC.block(inputOffset, nullSpaceOffset, numBlockInputs, numBlockNullSpace) = blockNullSpaces[b];
+    }
+    inputOffset += numBlockInputs;
+    nullSpaceOffset += numBlockNullSpace;
+  }
+
+  // The full projection, used to remap the solution and to extract the multipliers
+  projection.dfdu.setZero(numInputs, numFreeInputs + numNullSpace);
+  projection.dfdx.setZero(numInputs, numStates);
+  projection.f.setZero(numInputs);
+  for (int j = 0; j < numFreeInputs; ++j) {
+    projection.dfdu(structure.freeInputs[j], j) = 1.0;
+  }
+  for (int k = 0; k < numConstrainedInputs; ++k) {
+    const int j = structure.constrainedInputs[k];
+    projection.dfdu.row(j).tail(numNullSpace) = constrainedProjection.PuC.row(k);
+    projection.dfdx.row(j) = constrainedProjection.PxC.row(k);
+    projection.f(j) = constrainedProjection.PeC(k);
+  }
+
+  if (extractProjectionMultiplier) {
+    projectionMultiplierCoefficients.compute(cost, dynamics, projection, pseudoInverse);
+  } else {
+    projectionMultiplierCoefficients.clear();
+  }
+  stateInputEqConstraints = VectorFunctionLinearApproximation();
+
+  // Adapt dynamics, cost, and state-input inequality constraints
+  changeOfInputVariables(dynamics, structure, constrainedProjection);
+  changeOfInputVariables(cost, structure, constrainedProjection);
+  if (stateInputIneqConstraints.f.size() > 0) {
+    changeOfInputVariables(stateInputIneqConstraints, structure, constrainedProjection);
+  }
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
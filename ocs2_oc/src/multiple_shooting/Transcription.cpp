@@ -39,8 +39,18 @@ namespace multiple_shooting {
 
 Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizer& sensitivityDiscretizer,
                                     scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u) {
-  // Results and short-hand notation
+  DynamicsSensitivityDiscretizerInPlace discretizer = [&](SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u,
+                                                          scalar_t dt, VectorFunctionLinearApproximation& dynamics) {
+    dynamics = sensitivityDiscretizer(system, t, x, u, dt);
+  };
   Transcription transcription;
+  setupIntermediateNode(optimalControlProblem, discretizer, t, dt, x, x_next, u, transcription);
+  return transcription;
+}
+
+void setupIntermediateNode(OptimalControlProblem& optimalControlProblem, DynamicsSensitivityDiscretizerInPlace& sensitivityDiscretizer,
+                           scalar_t t, scalar_t dt, const vector_t& x, const vector_t& x_next, const vector_t& u, Transcription& transcription) {
+  // Short-hand notation
   auto& cost = transcription.cost;
   auto& dynamics = transcription.dynamics;
   auto& constraintsSize = transcription.constraintsSize;
@@ -51,7 +61,7 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
 
   // Dynamics
   // Discretization returns x_{k+1} = A_{k} * dx_{k} + B_{k} * du_{k} + b_{k}
-  dynamics = sensitivityDiscretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt);
+  sensitivityDiscretizer(*optimalControlProblem.dynamicsPtr, t, x, u, dt, dynamics);
   dynamics.f -= x_next;  // make it dx_{k+1} = ...
 
   // Precomputation for other terms
@@ -64,67 +74,121 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
 
   // State equality constraints
   if (!optimalControlProblem.stateEqualityConstraintPtr->empty()) {
-    constraintsSize.stateEq = optimalControlProblem.stateEqualityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.stateEqualityConstraintPtr->getTermsSize(t, constraintsSize.stateEq);
     stateEqConstraints =
         optimalControlProblem.stateEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateEq.clear();
+    stateEqConstraints.resize(0, 0);
   }
 
   // State-input equality constraints
   if (!optimalControlProblem.equalityConstraintPtr->empty()) {
-    constraintsSize.stateInputEq = optimalControlProblem.equalityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.equalityConstraintPtr->getTermsSize(t, constraintsSize.stateInputEq);
     stateInputEqConstraints =
         optimalControlProblem.equalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateInputEq.clear();
+    stateInputEqConstraints.resize(0, 0);
   }
 
   // State inequality constraints.
   if (!optimalControlProblem.stateInequalityConstraintPtr->empty()) {
-    constraintsSize.stateIneq = optimalControlProblem.stateInequalityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.stateInequalityConstraintPtr->getTermsSize(t, constraintsSize.stateIneq);
     stateIneqConstraints =
         optimalControlProblem.stateInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateIneq.clear();
+    stateIneqConstraints.resize(0, 0);
   }
 
   // State-input inequality constraints.
   if (!optimalControlProblem.inequalityConstraintPtr->empty()) {
-    constraintsSize.stateInputIneq = optimalControlProblem.inequalityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.inequalityConstraintPtr->getTermsSize(t, constraintsSize.stateInputIneq);
     stateInputIneqConstraints =
         optimalControlProblem.inequalityConstraintPtr->getLinearApproximation(t, x, u, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateInputIneq.clear();
+    stateInputIneqConstraints.resize(0, 0);
   }
 
-  return transcription;
+  // The projection is only set by projectTranscription(). With state-input equality constraints the projection overwrites these buffers in
+  // place, so they are kept to not release the memory swapped in from the previous iteration.
+  if (stateInputEqConstraints.f.size() == 0) {
+    transcription.constraintsProjection.resize(0, 0);
+    transcription.projectedFreeInputs.clear();
+    transcription.projectionMultiplierCoefficients.clear();
+  }
 }
 
 void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier) {
-  auto& cost = transcription.cost;
-  auto& dynamics = transcription.dynamics;
-  auto& stateInputEqConstraints = transcription.stateInputEqConstraints;
-  auto& stateInputIneqConstraints = transcription.stateInputIneqConstraints;
-  auto& projection = transcription.constraintsProjection;
-  auto& projectionMultiplierCoefficients = transcription.projectionMultiplierCoefficients;
-
-  if (stateInputEqConstraints.f.size() > 0) {
-    // Projection stored instead of constraint, // TODO: benchmark between lu and qr method. LU seems slightly faster.
-    if (extractProjectionMultiplier) {
-      matrix_t constraintPseudoInverse;
-      std::tie(projection, constraintPseudoInverse) = LinearAlgebra::qrConstraintProjection(stateInputEqConstraints);
-      projectionMultiplierCoefficients.compute(cost, dynamics, projection, constraintPseudoInverse);
-    } else {
-      projection = LinearAlgebra::luConstraintProjection(stateInputEqConstraints).first;
-      projectionMultiplierCoefficients = ProjectionMultiplierCoefficients();
-    }
-    stateInputEqConstraints = VectorFunctionLinearApproximation();
-
-    // Adapt dynamics, cost, and state-input inequality constraints
-    changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f);
-    changeOfInputVariables(cost, projection.dfdu, projection.dfdx, projection.f);
-    if (stateInputIneqConstraints.f.size() > 0) {
-      changeOfInputVariables(stateInputIneqConstraints, projection.dfdu, projection.dfdx, projection.f);
-    }
+  if (transcription.stateInputEqConstraints.f.size() > 0) {
+    ScalarFunctionQuadraticApproximation cost;
+    VectorFunctionLinearApproximation dynamics;
+    VectorFunctionLinearApproximation stateInputIneqConstraints;
+    ProjectedTranscription projected{cost,
+                                     dynamics,
+                                     stateInputIneqConstraints,
+                                     transcription.constraintsProjection,
+                                     transcription.projectedFreeInputs,
+                                     transcription.projectionMultiplierCoefficients};
+    ProjectionWorkspace workspace;
+    projectTranscription(transcription, projected, workspace, extractProjectionMultiplier);
+
+    // Projection stored instead of constraint
+    transcription.cost = std::move(cost);
+    transcription.dynamics = std::move(dynamics);
+    transcription.stateInputIneqConstraints = std::move(stateInputIneqConstraints);
+    transcription.stateInputEqConstraints.resize(0, 0);
+  }
+}
+
+void projectTranscription(const Transcription& transcription, ProjectedTranscription& projected, ProjectionWorkspace& workspace,
+                          bool extractProjectionMultiplier) {
+  const auto& stateInputEqConstraints = transcription.stateInputEqConstraints;
+  const auto& stateInputIneqConstraints = transcription.stateInputIneqConstraints;
+  auto& projection = projected.constraintsProjection;
+  projected.projectedFreeInputs.clear();
+
+  if (stateInputEqConstraints.f.size() == 0) {
+    projected.cost = transcription.cost;
+    projected.dynamics = transcription.dynamics;
+    projected.stateInputIneqConstraints = stateInputIneqConstraints;
+    projection.resize(0, 0);
+    projected.projectionMultiplierCoefficients.clear();
+    return;
+  }
+
+  // TODO: benchmark between lu and qr method. LU seems slightly faster.
+  if (extractProjectionMultiplier) {
+    LinearAlgebra::qrConstraintProjection(stateInputEqConstraints, projection, workspace.constraintPseudoInverse,
+                                          workspace.constraintProjection);
+    projected.projectionMultiplierCoefficients.compute(transcription.cost, transcription.dynamics, projection,
+                                                       workspace.constraintPseudoInverse, workspace.pseudoInverseTimesR);
+  } else {
+    LinearAlgebra::luConstraintProjection(stateInputEqConstraints, projection, workspace.constraintProjection);
+    projected.projectionMultiplierCoefficients.clear();
+  }
+
+  // Adapt dynamics, cost, and state-input inequality constraints
+  changeOfInputVariables(transcription.dynamics, projection.dfdu, projection.dfdx, projection.f, projected.dynamics);
+  changeOfInputVariables(transcription.cost, projection.dfdu, projection.dfdx, projection.f, projected.cost,
+                         workspace.changeOfInputVariables);
+  if (stateInputIneqConstraints.f.size() > 0) {
+    changeOfInputVariables(stateInputIneqConstraints, projection.dfdu, projection.dfdx, projection.f, projected.stateInputIneqConstraints);
+  } else {
+    projected.stateInputIneqConstraints = stateInputIneqConstraints;
   }
 }
 
 TerminalTranscription setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
-  // Results and short-hand notation
   TerminalTranscription transcription;
+  setupTerminalNode(optimalControlProblem, t, x, transcription);
+  return transcription;
+}
+
+void setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, TerminalTranscription& transcription) {
+  // Short-hand notation
   auto& cost = transcription.cost;
   auto& constraintsSize = transcription.constraintsSize;
   auto& eqConstraints = transcription.eqConstraints;
@@ -138,24 +202,34 @@ TerminalTranscription setupTerminalNode(OptimalControlProblem& optimalControlPro
 
   // State equality constraints.
   if (!optimalControlProblem.finalEqualityConstraintPtr->empty()) {
-    constraintsSize.stateEq = optimalControlProblem.finalEqualityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.finalEqualityConstraintPtr->getTermsSize(t, constraintsSize.stateEq);
     eqConstraints =
         optimalControlProblem.finalEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateEq.clear();
+    eqConstraints.resize(0, 0);
   }
 
   // State inequality constraints.
   if (!optimalControlProblem.finalInequalityConstraintPtr->empty()) {
-    constraintsSize.stateIneq = optimalControlProblem.finalInequalityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.finalInequalityConstraintPtr->getTermsSize(t, constraintsSize.stateIneq);
     ineqConstraints =
         optimalControlProblem.finalInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateIneq.clear();
+    ineqConstraints.resize(0, 0);
   }
-
-  return transcription;
 }
 
 EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next) {
-  // Results and short-hand notation
   EventTranscription transcription;
+  setupEventNode(optimalControlProblem, t, x, x_next, transcription);
+  return transcription;
+}
+
+void setupEventNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x, const vector_t& x_next,
+                    EventTranscription& transcription) {
+  // Short-hand notation
   auto& cost = transcription.cost;
   auto& dynamics = transcription.dynamics;
   auto& constraintsSize = transcription.constraintsSize;
@@ -167,7 +241,7 @@ EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem,
 
   // Dynamics
   // jump map returns // x_{k+1} = A_{k} * dx_{k} + b_{k}
-  dynamics = optimalControlProblem.dynamicsPtr->jumpMapLinearApproximation(t, x);
+  optimalControlProblem.dynamicsPtr->jumpMapLinearApproximationInPlace(t, x, dynamics);
   dynamics.f -= x_next;                // make it dx_{k+1} = ...
   dynamics.dfdu.setZero(x.size(), 0);  // Overwrite derivative that shouldn't exist.
 
@@ -176,19 +250,23 @@ EventTranscription setupEventNode(OptimalControlProblem& optimalControlProblem,
 
   // State equality constraints.
   if (!optimalControlProblem.preJumpEqualityConstraintPtr->empty()) {
-    constraintsSize.stateEq = optimalControlProblem.preJumpEqualityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.preJumpEqualityConstraintPtr->getTermsSize(t, constraintsSize.stateEq);
     eqConstraints =
         optimalControlProblem.preJumpEqualityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateEq.clear();
+    eqConstraints.resize(0, 0);
   }
 
   // State inequality constraints.
   if (!optimalControlProblem.preJumpInequalityConstraintPtr->empty()) {
-    constraintsSize.stateIneq = optimalControlProblem.preJumpInequalityConstraintPtr->getTermsSize(t);
+    optimalControlProblem.preJumpInequalityConstraintPtr->getTermsSize(t, constraintsSize.stateIneq);
     ineqConstraints =
         optimalControlProblem.preJumpInequalityConstraintPtr->getLinearApproximation(t, x, *optimalControlProblem.preComputationPtr);
+  } else {
+    constraintsSize.stateIneq.clear();
+    ineqConstraints.resize(0, 0);
   }
-
-  return transcription;
 }
 
 }  // namespace multiple_shooting
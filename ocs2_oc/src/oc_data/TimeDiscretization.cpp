@@ -128,7 +128,7 @@ scalar_array_t toInterpolationTime(const std::vector<AnnotatedTime>& annotatedTi
   }
   scalar_array_t timeTrajectory;
   timeTrajectory.reserve(annotatedTime.size());
-  timeTrajectory.push_back(annotatedTime.back().time - numeric_traits::limitEpsilon<scalar_t>());
+  timeTrajectory.push_back(annotatedTime.front().time + numeric_traits::limitEpsilon<scalar_t>());
   for (int i = 1; i < annotatedTime.size() - 1; i++) {
     if (annotatedTime[i].event == AnnotatedTime::Event::PostEvent) {
       timeTrajectory.push_back(getInterpolationTime(annotatedTime[i]));
@@ -140,6 +140,15 @@ scalar_array_t toInterpolationTime(const std::vector<AnnotatedTime>& annotatedTi
   return timeTrajectory;
 }
 
+scalar_array_t toIntervalStartTime(const std::vector<AnnotatedTime>& annotatedTime) {
+  scalar_array_t timeTrajectory;
+  timeTrajectory.reserve(annotatedTime.size());
+  for (const auto& t : annotatedTime) {
+    timeTrajectory.push_back(getIntervalStart(t));
+  }
+  return timeTrajectory;
+}
+
 size_array_t toPostEventIndices(const std::vector<AnnotatedTime>& annotatedTime) {
   size_array_t postEventIndices;
   for (size_t i = 0; i < annotatedTime.size(); i++) {
@@ -47,9 +47,26 @@ bool operator==(const OcpSize& lhs, const OcpSize& rhs) noexcept {
 OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
                                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                 const std::vector<VectorFunctionLinearApproximation>* constraints) {
+  OcpSize problemSize;
+  extractSizesFromProblem(dynamics, cost, constraints, problemSize);
+  return problemSize;
+}
+
+void extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                             const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                             const std::vector<VectorFunctionLinearApproximation>* constraints, OcpSize& problemSize) {
   const int numStages = dynamics.size();
 
-  OcpSize problemSize(dynamics.size());
+  // Same as OcpSize(numStages), without releasing the memory of problemSize
+  problemSize.numStages = numStages;
+  problemSize.numStates.resize(numStages + 1);
+  problemSize.numInputs.resize(numStages + 1);
+  problemSize.numInputBoxConstraints.assign(numStages + 1, 0);
+  problemSize.numStateBoxConstraints.assign(numStages + 1, 0);
+  problemSize.numIneqConstraints.assign(numStages + 1, 0);
+  problemSize.numInputBoxSlack.assign(numStages + 1, 0);
+  problemSize.numStateBoxSlack.assign(numStages + 1, 0);
+  problemSize.numIneqSlack.assign(numStages + 1, 0);
 
   // State inputs
   for (int k = 0; k < numStages; k++) {
@@ -65,8 +82,6 @@ OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximat
       problemSize.numIneqConstraints[k] = (*constraints)[k].f.size();
     }
   }
-
-  return problemSize;
 }
 
 }  // namespace ocs2
\ No newline at end of file
@@ -0,0 +1,393 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/oc_solver/ParallelRiccatiSolver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+
+#include <ocs2_core/misc/Tracing.h>
+
+namespace ocs2 {
+
+namespace {
+
+/**
+ * Writes the first stage of each partition and N at the end. In the first pass, the last partition runs the Riccati recursion while the
+ * other partitions are reduced to a scan element which takes about twice as long. The last partition is therefore twice as long as the
+ * others.
+ */
+void partitionStages(int N, int numPartitions, std::vector<int>& partitionStarts) {
+  partitionStarts.resize(numPartitions + 1);
+  for (int p = 0; p < numPartitions; p++) {
+    partitionStarts[p] = (p * N) / (numPartitions + 1);
+  }
+  partitionStarts[numPartitions] = N;
+}
+
+/** Replaces a square matrix by its symmetric part without a temporary. */
+void symmetrize(matrix_t& m) {
+  for (int j = 0; j < m.cols(); j++) {
+    for (int i = j + 1; i < m.rows(); i++) {
+      m(i, j) = m(j, i) = 0.5 * (m(i, j) + m(j, i));
+    }
+  }
+}
+
+/** Writes I + lhs * rhs to the output. */
+void identityPlusProduct(const matrix_t& lhs, const matrix_t& rhs, matrix_t& out) {
+  out.noalias() = lhs * rhs;
+  out.diagonal().array() += 1.0;
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ParallelRiccatiSolver::ParallelRiccatiSolver(OcpSize ocpSize) {
+  resize(ocpSize);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ParallelRiccatiSolver::resize(const OcpSize& ocpSize) {
+  const auto hasConstraints = [](const std::vector<int>& sizes) {
+    return std::any_of(sizes.cbegin(), sizes.cend(), [](int n) { return n > 0; });
+  };
+  if (hasConstraints(ocpSize.numInputBoxConstraints) || hasConstraints(ocpSize.numStateBoxConstraints) ||
+      hasConstraints(ocpSize.numIneqConstraints)) {
+    throw std::runtime_error("[ParallelRiccatiSolver] The solver only supports unconstrained problems!");
+  }
+
+  ocpSize_ = ocpSize;  // copy-assignment keeps the memory of ocpSize_
+  const int N = ocpSize_.numStages;
+  S_.resize(N + 1);
+  s_.resize(N + 1);
+  feedback_.resize(N);
+  feedforward_.resize(N);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ParallelRiccatiSolver::solve(ThreadPool& threadPool, const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                  const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& stateTrajectory,
+                                  vector_array_t& inputTrajectory) {
+  OCS2_TRACE_SCOPE("ParallelRiccatiSolver", "solve");
+  const int N = ocpSize_.numStages;
+  if (dynamics.size() != static_cast<size_t>(N) || cost.size() != static_cast<size_t>(N + 1)) {
+    throw std::runtime_error("[ParallelRiccatiSolver] Inconsistent size of the provided problem.");
+  }
+
+  // Terminal cost-to-go
+  S_[N] = cost[N].dfdxx;
+  s_[N] = cost[N].dfdx;
+
+  // Below three partitions, the parallel passes do not shorten the critical path.
+  const int numPartitions = std::min(static_cast<int>(threadPool.numThreads()) + 1, N - 1);
+  if (numPartitions < 3) {
+    workspaces_.resize(std::max<size_t>(workspaces_.size(), 1));
+    if (!riccatiSweep(0, N, dynamics, cost, true, workspaces_[0])) {
+      return false;
+    }
+  } else {
+    partitionStages(N, numPartitions, partitionStarts_);
+    const auto& partitionStarts = partitionStarts_;
+    partitionElements_.resize(numPartitions);
+    workspaces_.resize(std::max<size_t>(workspaces_.size(), numPartitions));
+    std::atomic_bool success{true};
+
+    // First pass: the last partition runs the Riccati recursion from the terminal cost, the partitions in the middle are reduced to a
+    // single scan element. The first partition is not needed before the second pass.
+    {
+      OCS2_TRACE_SCOPE("ParallelRiccatiSolver", "reducePartitions");
+      std::atomic_int partitionIndex{1};
+      auto reduceTask = [&](int) {
+        int p;
+        while ((p = partitionIndex++) < numPartitions && success) {
+          const int first = partitionStarts[p];
+          const int last = partitionStarts[p + 1];
+          auto& workspace = workspaces_[p];
+          if (p == numPartitions - 1) {
+            success = success && riccatiSweep(first, last, dynamics, cost, true, workspace);
+          } else {
+            auto& partitionElement = partitionElements_[p];
+            bool valid = stageElement(dynamics[first], cost[first], partitionElement, workspace);
+            for (int k = first + 1; k < last && valid; k++) {
+              valid = stageElement(dynamics[k], cost[k], workspace.element, workspace);
+              if (valid) {
+                combine(partitionElement, workspace.element, workspace);
+              }
+            }
+            success = success && valid;
+          }
+        }
+      };
+      // std::ref keeps the std::function from copying the closure to the heap
+      threadPool.runParallel(std::ref(reduceTask), numPartitions - 1);
+      if (!success) {
+        return false;
+      }
+    }
+
+    // Propagate the cost-to-go over the partition boundaries with the reduced elements: (J, eta) = (S, -s).
+    {
+      OCS2_TRACE_SCOPE("ParallelRiccatiSolver", "propagateBoundaries");
+      auto& workspace = workspaces_[0];
+      for (int p = numPartitions - 2; p > 0; p--) {
+        const auto& element = partitionElements_[p];
+        const matrix_t& S = S_[partitionStarts[p + 1]];
+        const vector_t& s = s_[partitionStarts[p + 1]];
+        // (I + C S)^{-1} A
+        identityPlusProduct(element.C, S, workspace.IPlusM);
+        workspace.lu.compute(workspace.IPlusM);
+        workspace.ZA = workspace.lu.solve(element.A);
+
+        workspace.sPlusSb = s;
+        workspace.sPlusSb.noalias() += S * element.b;
+        workspace.SA.noalias() = S * element.A;
+        matrix_t& SBoundary = S_[partitionStarts[p]];
+        SBoundary = element.J;
+        SBoundary.noalias() += workspace.ZA.transpose() * workspace.SA;
+        symmetrize(SBoundary);
+        vector_t& sBoundary = s_[partitionStarts[p]];
+        sBoundary = -element.eta;
+        sBoundary.noalias() += workspace.ZA.transpose() * workspace.sPlusSb;
+      }
+    }
+
+    // Second pass: the Riccati recursion runs in all the remaining partitions. The cost-to-go at the start of each partition is already
+    // known and is left untouched since it is read concurrently by the preceding partition.
+    {
+      OCS2_TRACE_SCOPE("ParallelRiccatiSolver", "riccatiPartitions");
+      std::atomic_int partitionIndex{0};
+      auto sweepTask = [&](int) {
+        int p;
+        while ((p = partitionIndex++) < numPartitions - 1 && success) {
+          success = success && riccatiSweep(partitionStarts[p], partitionStarts[p + 1], dynamics, cost, p == 0, workspaces_[p]);
+        }
+      };
+      threadPool.runParallel(std::ref(sweepTask), numPartitions - 1);
+      if (!success) {
+        return false;
+      }
+    }
+  }
+
+  // Forward rollout of the optimal policy
+  OCS2_TRACE_SCOPE("ParallelRiccatiSolver", "forwardRollout");
+  stateTrajectory.resize(N + 1);
+  inputTrajectory.resize(N);
+  stateTrajectory[0] = x0;
+  for (int k = 0; k < N; k++) {
+    inputTrajectory[k] = feedforward_[k];
+    inputTrajectory[k].noalias() += feedback_[k] * stateTrajectory[k];
+    stateTrajectory[k + 1] = dynamics[k].f;
+    stateTrajectory[k + 1].noalias() += dynamics[k].dfdx * stateTrajectory[k];
+    stateTrajectory[k + 1].noalias() += dynamics[k].dfdu * inputTrajectory[k];
+  }
+
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<ScalarFunctionQuadraticApproximation> ParallelRiccatiSolver::getRiccatiCostToGo() const {
+  std::vector<ScalarFunctionQuadraticApproximation> costToGo(S_.size());
+  for (size_t k = 0; k < S_.size(); k++) {
+    costToGo[k].f = 0.0;
+    costToGo[k].dfdx = s_[k];
+    costToGo[k].dfdxx = S_[k];
+  }
+  return costToGo;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ParallelRiccatiSolver::stageElement(const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+                                         Element& element, Workspace& workspace) {
+  const auto& A = dynamics.dfdx;
+  const auto& B = dynamics.dfdu;
+
+  element.A = A;
+  element.b = dynamics.f;
+  element.J = cost.dfdxx;
+  element.eta = -cost.dfdx;
+
+  if (B.cols() > 0) {
+    // Eliminate the input: u = -R^{-1} (P x + r + B' lambda)
+    auto& RLlt = workspace.llt;
+    RLlt.compute(cost.dfduu);
+    if (RLlt.info() != Eigen::Success) {
+      return false;
+    }
+    workspace.RinvP = RLlt.solve(cost.dfdux);
+    workspace.Rinvr = RLlt.solve(cost.dfdu);
+    workspace.RinvBT = RLlt.solve(B.transpose());
+
+    element.A.noalias() -= B * workspace.RinvP;
+    element.b.noalias() -= B * workspace.Rinvr;
+    element.C.noalias() = B * workspace.RinvBT;
+    element.J.noalias() -= cost.dfdux.transpose() * workspace.RinvP;
+    element.eta.noalias() += cost.dfdux.transpose() * workspace.Rinvr;
+  } else {
+    element.C.setZero(A.rows(), A.rows());
+  }
+
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void ParallelRiccatiSolver::combine(Element& earlier, const Element& later, Workspace& workspace) {
+  // Z = (I + C_i J_j)^{-1}. Since C and J are symmetric, the transpose of Z is (I + J_j C_i)^{-1}.
+  auto& lu = workspace.lu;
+  identityPlusProduct(earlier.C, later.J, workspace.IPlusM);
+  lu.compute(workspace.IPlusM);
+  auto& ZA = workspace.ZA;
+  ZA = lu.solve(earlier.A);
+
+  // eta_ij = A_i' Z' (eta_j - J_j b_i) + eta_i
+  auto& etaMinusJb = workspace.etaMinusJb;
+  etaMinusJb = later.eta;
+  etaMinusJb.noalias() -= later.J * earlier.b;
+  earlier.eta.noalias() += ZA.transpose() * etaMinusJb;
+
+  // J_ij = A_i' Z' J_j A_i + J_i
+  auto& JA = workspace.JA;
+  JA.noalias() = later.J * earlier.A;
+  earlier.J.noalias() += ZA.transpose() * JA;
+  symmetrize(earlier.J);
+
+  // b_ij = A_j Z (b_i + C_i eta_j) + b_j
+  auto& bPlusCEta = workspace.bPlusCEta;
+  bPlusCEta = earlier.b;
+  bPlusCEta.noalias() += earlier.C * later.eta;
+  workspace.ZbPlusCEta = lu.solve(bPlusCEta);
+  earlier.b = later.b;
+  earlier.b.noalias() += later.A * workspace.ZbPlusCEta;
+
+  // C_ij = A_j Z C_i A_j' + C_j
+  workspace.ZC = lu.solve(earlier.C);
+  auto& AZC = workspace.AZC;
+  AZC.noalias() = later.A * workspace.ZC;
+  earlier.C = later.C;
+  earlier.C.noalias() += AZC * later.A.transpose();
+  symmetrize(earlier.C);
+
+  // A_ij = A_j Z A_i
+  earlier.A.noalias() = later.A * ZA;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ParallelRiccatiSolver::riccatiStep(int k, const VectorFunctionLinearApproximation& dynamics,
+                                        const ScalarFunctionQuadraticApproximation& cost, bool updateCostToGo, Workspace& workspace) {
+  const auto& A = dynamics.dfdx;
+  const auto& B = dynamics.dfdu;
+  const matrix_t& SNext = S_[k + 1];
+  const vector_t& sNext = s_[k + 1];
+
+  auto& SA = workspace.SA;
+  SA.noalias() = SNext * A;
+  auto& sPlusSb = workspace.sPlusSb;
+  sPlusSb = sNext;
+  sPlusSb.noalias() += SNext * dynamics.f;
+
+  matrix_t& K = feedback_[k];
+  vector_t& kff = feedforward_[k];
+  auto& G = workspace.G;  // P + B' S A
+  if (B.cols() > 0) {
+    auto& H = workspace.H;  // R + B' S B
+    H = cost.dfduu;
+    workspace.SB.noalias() = SNext * B;
+    H.noalias() += B.transpose() * workspace.SB;
+    G = cost.dfdux;
+    G.noalias() += B.transpose() * SA;
+    auto& g = workspace.g;  // r + B' (s + S b)
+    g = cost.dfdu;
+    g.noalias() += B.transpose() * sPlusSb;
+
+    auto& HLlt = workspace.llt;
+    HLlt.compute(H);
+    if (HLlt.info() != Eigen::Success) {
+      return false;
+    }
+    K = G;
+    HLlt.solveInPlace(K);
+    K *= -1.0;
+    kff = g;
+    HLlt.solveInPlace(kff);
+    kff *= -1.0;
+  } else {
+    K.setZero(0, A.cols());
+    kff.setZero(0);
+  }
+
+  if (updateCostToGo) {
+    // S = Q + A' S A + G' K,  s = q + A' (s + S b) + G' k
+    matrix_t& S = S_[k];
+    S = cost.dfdxx;
+    S.noalias() += A.transpose() * SA;
+    vector_t& s = s_[k];
+    s = cost.dfdx;
+    s.noalias() += A.transpose() * sPlusSb;
+    if (B.cols() > 0) {
+      S.noalias() += G.transpose() * K;
+      s.noalias() += G.transpose() * kff;
+    }
+    symmetrize(S);
+  }
+
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ParallelRiccatiSolver::riccatiSweep(int first, int last, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                         const std::vector<ScalarFunctionQuadraticApproximation>& cost, bool updateFirstCostToGo,
+                                         Workspace& workspace) {
+  for (int k = last - 1; k >= first; k--) {
+    if (!riccatiStep(k, dynamics[k], cost[k], k != first || updateFirstCostToGo, workspace)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace ocs2
@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/misc/LinearAlgebra.h>
 #include <ocs2_core/misc/Numerics.h>
+#include <ocs2_core/misc/Tracing.h>
 
 #include <ocs2_oc/oc_solver/SolverBase.h>
 #include <ocs2_oc/synchronized_module/ReferenceManager.h>
@@ -47,6 +48,7 @@ SolverBase::SolverBase() : referenceManagerPtr_(new ReferenceManager) {}
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_TRACE_SCOPE("SolverBase", "run");
   preRun(initTime, initState, finalTime);
   runImpl(initTime, initState, finalTime);
   postRun();
@@ -56,6 +58,7 @@ void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t fina
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const ControllerBase* externalControllerPtr) {
+  OCS2_TRACE_SCOPE("SolverBase", "run");
   preRun(initTime, initState, finalTime);
   runImpl(initTime, initState, finalTime, externalControllerPtr);
   postRun();
@@ -65,6 +68,7 @@ void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t fina
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) {
+  OCS2_TRACE_SCOPE("SolverBase", "run");
   preRun(initTime, initState, finalTime);
   runImpl(initTime, initState, finalTime, primalSolution);
   postRun();
@@ -91,6 +95,8 @@ void SolverBase::printString(const std::string& text) const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::preRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_TRACE_SCOPE("SolverBase", "preRun");
+
   referenceManagerPtr_->preSolverRun(initTime, finalTime, initState);
 
   for (auto& module : synchronizedModules_) {
@@ -102,6 +108,8 @@ void SolverBase::preRun(scalar_t initTime, const vector_t& initState, scalar_t f
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::postRun() {
+  OCS2_TRACE_SCOPE("SolverBase", "postRun");
+
   if (!synchronizedModules_.empty() || !solverObservers_.empty()) {
     const auto solution = primalSolution(getFinalTime());
     for (auto& module : synchronizedModules_) {
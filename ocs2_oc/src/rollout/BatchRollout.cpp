@@ -0,0 +1,219 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/rollout/BatchRollout.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "ocs2_oc/approximate_model/LinearQuadraticApproximator.h"
+#include "ocs2_oc/rollout/RolloutBase.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BatchRollout::BatchRollout(const OptimalControlProblem& optimalControlProblem, rollout::Settings rolloutSettings, size_t nThreads,
+                           int threadPriority)
+    : rolloutSettings_(std::move(rolloutSettings)),
+      nThreads_(std::max(nThreads, size_t(1))),
+      threadPool_(nThreads_ - 1, threadPriority) {
+  if (optimalControlProblem.dynamicsPtr == nullptr) {
+    throw std::runtime_error("[BatchRollout] The dynamics of the optimal control problem is not set!");
+  }
+  if (optimalControlProblem.targetTrajectoriesPtr == nullptr) {
+    throw std::runtime_error("[BatchRollout] The target trajectories of the optimal control problem are not set!");
+  }
+  if (rolloutSettings_.integratorType != IntegratorType::EULER && rolloutSettings_.integratorType != IntegratorType::RK4) {
+    throw std::runtime_error("[BatchRollout] Only the EULER and RK4 integrators are supported!");
+  }
+  if (rolloutSettings_.timeStep <= 0.0) {
+    throw std::runtime_error("[BatchRollout] The time step should be positive!");
+  }
+
+  workers_.reserve(nThreads_);
+  for (size_t i = 0; i < nThreads_; i++) {
+    workers_.emplace_back(optimalControlProblem);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<PerformanceIndex> BatchRollout::run(scalar_t initTime, const matrix_t& initStates, scalar_t finalTime,
+                                                const ControllerBase& controller, const ModeSchedule& modeSchedule,
+                                                matrix_t* finalStatesPtr) {
+  if (initTime > finalTime) {
+    throw std::runtime_error("[BatchRollout::run] The initial time should be less-equal to the final time!");
+  }
+
+  const auto timeIntervalArray = RolloutBase::findActiveModesTimeInterval(initTime, finalTime, modeSchedule.eventTimes);
+  const int numTrajectories = initStates.cols();
+  const int numBlocks = std::min(static_cast<int>(nThreads_), numTrajectories);
+
+  std::vector<PerformanceIndex> performanceIndices(numTrajectories);
+  if (finalStatesPtr != nullptr) {
+    finalStatesPtr->resize(initStates.rows(), numTrajectories);
+  }
+
+  // each block is a contiguous range of columns which is integrated in lockstep
+  std::atomic_int blockIndex{0};
+  auto task = [&](int workerIndex) {
+    auto& worker = workers_[workerIndex];
+    worker.controllerPtr.reset(controller.clone());
+
+    int b = blockIndex++;
+    while (b < numBlocks) {
+      const int firstCol = b * numTrajectories / numBlocks;
+      const int lastCol = (b + 1) * numTrajectories / numBlocks;
+      runBlock(worker, timeIntervalArray, initStates, firstCol, lastCol - firstCol, performanceIndices, finalStatesPtr);
+      b = blockIndex++;
+    }
+  };
+  threadPool_.runParallel(task, nThreads_);
+
+  return performanceIndices;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRollout::runBlock(Worker& worker, const std::vector<std::pair<scalar_t, scalar_t>>& timeIntervalArray,
+                            const matrix_t& initStates, int firstCol, int numCols, std::vector<PerformanceIndex>& performanceIndices,
+                            matrix_t* finalStatesPtr) {
+  constexpr auto request = Request::Cost + Request::Constraint + Request::SoftConstraint;
+  auto& problem = worker.ocpDefinition;
+  auto& state = worker.state;
+  auto& stateCol = worker.stateCol;
+  auto& inputCol = worker.inputCol;
+  auto performanceIndex = performanceIndices.begin() + firstCol;
+  auto& previousIntermediates = worker.previousIntermediates;
+  previousIntermediates.resize(numCols);
+
+  state = initStates.middleCols(firstCol, numCols);
+
+  const int numSubsystems = timeIntervalArray.size();
+  for (int i = 0; i < numSubsystems; i++) {
+    const auto& timeInterval = timeIntervalArray[i];
+    const size_t numSteps = RolloutBase::numFixedSteps(timeInterval, rolloutSettings_.timeStep);
+    const scalar_t dt = (numSteps > 0) ? (timeInterval.second - timeInterval.first) / numSteps : 0.0;
+
+    // a mode of zero length has no intermediate nodes
+    for (size_t j = 0; numSteps > 0 && j <= numSteps; j++) {
+      const scalar_t t = (j < numSteps) ? timeInterval.first + j * dt : timeInterval.second;
+      computeInputs(worker, t, state, worker.input);
+
+      // trapezoidal integration of the intermediate metrics
+      for (int c = 0; c < numCols; c++) {
+        stateCol = state.col(c);
+        inputCol = worker.input.col(c);
+        problem.preComputationPtr->request(request, t, stateCol, inputCol);
+        auto intermediate = toPerformanceIndex(computeIntermediateMetrics(problem, t, stateCol, inputCol));
+        if (j > 0) {
+          performanceIndex[c] += (0.5 * dt) * (previousIntermediates[c] + intermediate);
+        }
+        swap(previousIntermediates[c], intermediate);
+      }
+
+      if (j < numSteps) {
+        fixedStep(worker, t, dt);
+      }
+    }  // end of j loop
+
+    // a jump has taken place
+    if (i < numSubsystems - 1) {
+      const scalar_t t = timeInterval.second;
+      for (int c = 0; c < numCols; c++) {
+        stateCol = state.col(c);
+        problem.preComputationPtr->requestPreJump(request, t, stateCol);
+        performanceIndex[c] += toPerformanceIndex(computePreJumpMetrics(problem, t, stateCol));
+        state.col(c) = problem.dynamicsPtr->computeJumpMap(t, stateCol);
+      }
+    }
+  }  // end of i loop
+
+  const scalar_t finalTime = timeIntervalArray.back().second;
+  for (int c = 0; c < numCols; c++) {
+    stateCol = state.col(c);
+    problem.preComputationPtr->requestFinal(request, finalTime, stateCol);
+    performanceIndex[c] += toPerformanceIndex(computeFinalMetrics(problem, finalTime, stateCol));
+  }
+
+  if (finalStatesPtr != nullptr) {
+    finalStatesPtr->middleCols(firstCol, numCols) = state;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRollout::computeInputs(Worker& worker, scalar_t t, const matrix_t& state, matrix_t& input) const {
+  for (int c = 0; c < state.cols(); c++) {
+    worker.stateCol = state.col(c);
+    worker.controllerPtr->computeInputInPlace(t, worker.stateCol, worker.inputCol);
+    if (c == 0) {
+      input.resize(worker.inputCol.size(), state.cols());
+    }
+    input.col(c) = worker.inputCol;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchRollout::fixedStep(Worker& worker, scalar_t t, scalar_t dt) const {
+  auto& system = *worker.ocpDefinition.dynamicsPtr;
+
+  system.computeFlowMapBatch(t, worker.state, worker.input, worker.k1);
+
+  if (rolloutSettings_.integratorType == IntegratorType::EULER) {
+    worker.state += dt * worker.k1;
+    return;
+  }
+
+  // RK4, the controller is evaluated at the intermediate stages
+  const scalar_t halfDt = 0.5 * dt;
+
+  worker.stageState = worker.state + halfDt * worker.k1;
+  computeInputs(worker, t + halfDt, worker.stageState, worker.stageInput);
+  system.computeFlowMapBatch(t + halfDt, worker.stageState, worker.stageInput, worker.k2);
+
+  worker.stageState = worker.state + halfDt * worker.k2;
+  computeInputs(worker, t + halfDt, worker.stageState, worker.stageInput);
+  system.computeFlowMapBatch(t + halfDt, worker.stageState, worker.stageInput, worker.k3);
+
+  worker.stageState = worker.state + dt * worker.k3;
+  computeInputs(worker, t + dt, worker.stageState, worker.stageInput);
+  system.computeFlowMapBatch(t + dt, worker.stageState, worker.stageInput, worker.k4);
+
+  worker.state += (dt / 6.0) * (worker.k1 + 2.0 * worker.k2 + 2.0 * worker.k3 + worker.k4);
+}
+
+}  // namespace ocs2
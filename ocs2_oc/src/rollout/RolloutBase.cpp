@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_oc/rollout/RolloutBase.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 
@@ -42,7 +43,7 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::vector<std::pair<scalar_t, scalar_t>> RolloutBase::findActiveModesTimeInterval(scalar_t initTime, scalar_t finalTime,
-                                                                                    const scalar_array_t& eventTimes) const {
+                                                                                    const scalar_array_t& eventTimes) {
   // switching times
   const auto firstIndex = std::upper_bound(eventTimes.cbegin(), eventTimes.cend(), initTime);  // no event at initial time
   const auto lastIndex = std::upper_bound(eventTimes.cbegin(), eventTimes.cend(), finalTime);  // can be an event at final time
@@ -67,6 +68,19 @@ std::vector<std::pair<scalar_t, scalar_t>> RolloutBase::findActiveModesTimeInter
   return timeIntervalArray;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t RolloutBase::numFixedSteps(const std::pair<scalar_t, scalar_t>& timeInterval, scalar_t timeStep) {
+  const scalar_t duration = timeInterval.second - timeInterval.first;
+  if (duration <= 0.0) {
+    return 0;
+  }
+  // a remainder shorter than weakEpsilon of a step does not add a step
+  const scalar_t numSteps = std::ceil(duration / timeStep - numeric_traits::weakEpsilon<scalar_t>());
+  return std::max(static_cast<size_t>(numSteps), size_t(1));
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
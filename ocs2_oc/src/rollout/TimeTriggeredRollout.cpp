@@ -38,6 +38,15 @@ TimeTriggeredRollout::TimeTriggeredRollout(const ControlledSystemBase& systemDyn
     : RolloutBase(std::move(rolloutSettings)), systemDynamicsPtr_(systemDynamics.clone()), systemEventHandlersPtr_(new SystemEventHandler) {
   // construct dynamicsIntegratorsPtr
   dynamicsIntegratorPtr_ = std::move(newIntegrator(this->settings().integratorType, systemEventHandlersPtr_));
+
+  if (this->settings().useFixedStepRollout) {
+    if (this->settings().integratorType != IntegratorType::EULER && this->settings().integratorType != IntegratorType::RK4) {
+      throw std::runtime_error("[TimeTriggeredRollout] The fixed step rollout only supports the EULER and RK4 integrators!");
+    }
+    if (this->settings().timeStep <= 0.0) {
+      throw std::runtime_error("[TimeTriggeredRollout] The time step of the fixed step rollout should be positive!");
+    }
+  }
 }
 
 /******************************************************************************************************/
@@ -61,6 +70,29 @@ vector_t TimeTriggeredRollout::run(scalar_t initTime, const vector_t& initState,
   // max number of steps for integration
   const auto maxNumSteps = static_cast<size_t>(this->settings().maxNumStepsPerSecond * std::max(1.0, finalTime - initTime));
 
+  if (this->settings().useFixedStepRollout) {
+    // the number of nodes is known up front, check it before touching the output trajectories
+    size_t numNodes = 0;
+    for (const auto& timeInterval : timeIntervalArray) {
+      numNodes += numFixedSteps(timeInterval, this->settings().timeStep) + 1;
+    }
+    if (numNodes > maxNumSteps + numSubsystems) {
+      throw std::runtime_error("[TimeTriggeredRollout::run] The number of fixed steps exceeds the maximum number of steps!");
+    }
+
+    // set controller
+    systemDynamicsPtr_->setController(controller);
+    systemDynamicsPtr_->resetNumFunctionCalls();
+    systemEventHandlersPtr_->reset();
+
+    runFixedStep(timeIntervalArray, numNodes, initState, *controller, timeTrajectory, postEventIndices, stateTrajectory, inputTrajectory);
+
+    // check for the numerical stability
+    this->checkNumericalStability(*controller, timeTrajectory, postEventIndices, stateTrajectory, inputTrajectory);
+
+    return stateTrajectory.back();
+  }
+
   // clearing the output trajectories
   timeTrajectory.clear();
   timeTrajectory.reserve(maxNumSteps + 1);
@@ -115,4 +147,87 @@ vector_t TimeTriggeredRollout::run(scalar_t initTime, const vector_t& initState,
   return stateTrajectory.back();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TimeTriggeredRollout::runFixedStep(const std::vector<std::pair<scalar_t, scalar_t>>& timeIntervalArray, size_t numNodes,
+                                        const vector_t& initState, ControllerBase& controller, scalar_array_t& timeTrajectory,
+                                        size_array_t& postEventIndices, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
+  const bool reconstructInput = this->settings().reconstructInputTrajectory;
+  const int numSubsystems = timeIntervalArray.size();
+  const int numEvents = numSubsystems - 1;
+
+  // the entries that are kept by resize are overwritten below, hence their memory is reused
+  timeTrajectory.resize(numNodes);
+  stateTrajectory.resize(numNodes);
+  inputTrajectory.resize(reconstructInput ? numNodes : 0);
+  postEventIndices.clear();
+
+  size_t k = 0;  // node index
+  stateTrajectory[k] = initState;
+  for (int i = 0; i < numSubsystems; i++) {
+    const auto& timeInterval = timeIntervalArray[i];
+    const size_t numSteps = numFixedSteps(timeInterval, this->settings().timeStep);
+    const scalar_t dt = (numSteps > 0) ? (timeInterval.second - timeInterval.first) / numSteps : 0.0;
+
+    for (size_t j = 0; j <= numSteps; j++, k++) {
+      const scalar_t t = (j < numSteps) ? timeInterval.first + j * dt : timeInterval.second;
+      timeTrajectory[k] = t;
+      systemEventHandlersPtr_->handleEvent(*systemDynamicsPtr_, t, stateTrajectory[k]);
+
+      // the input at the node is also the input of the first stage of the step
+      vector_t& u = reconstructInput ? inputTrajectory[k] : inputBuffer_;
+      if (j < numSteps || reconstructInput) {
+        controller.computeInputInPlace(t, stateTrajectory[k], u);
+      }
+      if (j < numSteps) {
+        fixedStep(controller, t, stateTrajectory[k], u, dt, stateTrajectory[k + 1]);
+      }
+    }  // end of j loop
+
+    // a jump has taken place
+    if (i < numEvents) {
+      postEventIndices.push_back(k);
+      // jump map
+      stateTrajectory[k] = systemDynamicsPtr_->computeJumpMap(timeTrajectory[k - 1], stateTrajectory[k - 1]);
+    }
+  }  // end of i loop
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void TimeTriggeredRollout::fixedStep(ControllerBase& controller, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt,
+                                     vector_t& nextState) {
+  auto& system = *systemDynamicsPtr_;
+
+  system.incrementNumFunctionCalls();
+  system.computeFlowMapInPlace(t, x, u, k1_);
+
+  if (this->settings().integratorType == IntegratorType::EULER) {
+    nextState = x + dt * k1_;
+    return;
+  }
+
+  // RK4, the controller is evaluated at the intermediate stages as in the closed-loop adaptive integration
+  const scalar_t halfDt = 0.5 * dt;
+
+  stageState_ = x + halfDt * k1_;
+  controller.computeInputInPlace(t + halfDt, stageState_, stageInput_);
+  system.incrementNumFunctionCalls();
+  system.computeFlowMapInPlace(t + halfDt, stageState_, stageInput_, k2_);
+
+  stageState_ = x + halfDt * k2_;
+  controller.computeInputInPlace(t + halfDt, stageState_, stageInput_);
+  system.incrementNumFunctionCalls();
+  system.computeFlowMapInPlace(t + halfDt, stageState_, stageInput_, k3_);
+
+  stageState_ = x + dt * k3_;
+  controller.computeInputInPlace(t + dt, stageState_, stageInput_);
+  system.incrementNumFunctionCalls();
+  system.computeFlowMapInPlace(t + dt, stageState_, stageInput_, k4_);
+
+  nextState = x + (dt / 6.0) * (k1_ + 2.0 * k2_ + 2.0 * k3_ + k4_);
+}
+
 }  // namespace ocs2
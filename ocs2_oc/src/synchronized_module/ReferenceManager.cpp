@@ -44,6 +44,14 @@ void ReferenceManager::preSolverRun(scalar_t initTime, scalar_t finalTime, const
   targetTrajectories_.updateFromBuffer();
   modeSchedule_.updateFromBuffer();
   modifyReferences(initTime, finalTime, initState, targetTrajectories_.get(), modeSchedule_.get());
+
+  if (timeGridFunction_) {
+    if (targetTrajectories_.get().empty()) {
+      referenceCache_.clear();
+    } else {
+      referenceCache_.update(targetTrajectories_.get(), timeGridFunction_(initTime, finalTime, modeSchedule_.get()));
+    }
+  }
 }
 
 }  // namespace ocs2
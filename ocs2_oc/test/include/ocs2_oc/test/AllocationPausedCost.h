@@ -0,0 +1,90 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ocs2_core/cost/StateCost.h>
+#include <ocs2_core/cost/StateInputCost.h>
+#include <ocs2_core/test/AllocationCounter.h>
+
+namespace ocs2 {
+namespace test {
+
+/** Leaves the allocations of the wrapped cost out of the count, the cost terms return their approximation by value. */
+class AllocationPausedCost final : public StateInputCost {
+ public:
+  explicit AllocationPausedCost(std::unique_ptr<StateInputCost> costPtr) : costPtr_(std::move(costPtr)) {}
+  AllocationPausedCost* clone() const override { return new AllocationPausedCost(std::unique_ptr<StateInputCost>(costPtr_->clone())); }
+
+  scalar_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                    const PreComputation& preComp) const override {
+    ScopedAllocationPause allocationPause;
+    return costPtr_->getValue(time, state, input, targetTrajectories, preComp);
+  }
+
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComp) const override {
+    ScopedAllocationPause allocationPause;
+    return costPtr_->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+  }
+
+ private:
+  std::unique_ptr<StateInputCost> costPtr_;
+};
+
+/** State-only counterpart of AllocationPausedCost */
+class AllocationPausedStateCost final : public StateCost {
+ public:
+  explicit AllocationPausedStateCost(std::unique_ptr<StateCost> costPtr) : costPtr_(std::move(costPtr)) {}
+  AllocationPausedStateCost* clone() const override {
+    return new AllocationPausedStateCost(std::unique_ptr<StateCost>(costPtr_->clone()));
+  }
+
+  scalar_t getValue(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                    const PreComputation& preComp) const override {
+    ScopedAllocationPause allocationPause;
+    return costPtr_->getValue(time, state, targetTrajectories, preComp);
+  }
+
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComp) const override {
+    ScopedAllocationPause allocationPause;
+    return costPtr_->getQuadraticApproximation(time, state, targetTrajectories, preComp);
+  }
+
+ private:
+  std::unique_ptr<StateCost> costPtr_;
+};
+
+}  // namespace test
+}  // namespace ocs2
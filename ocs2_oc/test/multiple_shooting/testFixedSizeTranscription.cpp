@@ -0,0 +1,132 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <ocs2_oc/multiple_shooting/FixedSizeTranscription.h>
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+namespace {
+multiple_shooting::Transcription getRandomTranscription(int nx, int nu, int nc, int nineq) {
+  multiple_shooting::Transcription transcription;
+  transcription.cost = getRandomCost(nx, nu);
+  transcription.dynamics = getRandomDynamics(nx, nu);
+  transcription.stateInputEqConstraints = getRandomConstraints(nx, nu, nc);
+  if (nineq > 0) {
+    transcription.stateInputIneqConstraints = getRandomConstraints(nx, nu, nineq);
+  }
+  return transcription;
+}
+
+bool isApprox(const ScalarFunctionQuadraticApproximation& lhs, const ScalarFunctionQuadraticApproximation& rhs, scalar_t tol) {
+  return lhs.dfdxx.isApprox(rhs.dfdxx, tol) && lhs.dfdux.isApprox(rhs.dfdux, tol) && lhs.dfduu.isApprox(rhs.dfduu, tol) &&
+         lhs.dfdx.isApprox(rhs.dfdx, tol) && lhs.dfdu.isApprox(rhs.dfdu, tol) && std::abs(lhs.f - rhs.f) < tol * (1.0 + std::abs(rhs.f));
+}
+
+bool isApprox(const VectorFunctionLinearApproximation& lhs, const VectorFunctionLinearApproximation& rhs, scalar_t tol) {
+  return lhs.dfdx.isApprox(rhs.dfdx, tol) && lhs.dfdu.isApprox(rhs.dfdu, tol) && lhs.f.isApprox(rhs.f, tol);
+}
+
+void expectApprox(const multiple_shooting::Transcription& lhs, const multiple_shooting::Transcription& rhs) {
+  constexpr scalar_t tol = 1e-9;
+  EXPECT_TRUE(isApprox(lhs.cost, rhs.cost, tol));
+  EXPECT_TRUE(isApprox(lhs.dynamics, rhs.dynamics, tol));
+  EXPECT_TRUE(isApprox(lhs.constraintsProjection, rhs.constraintsProjection, tol));
+  EXPECT_TRUE(isApprox(lhs.stateInputIneqConstraints, rhs.stateInputIneqConstraints, tol));
+  EXPECT_EQ(lhs.stateInputEqConstraints.f.size(), 0);
+  EXPECT_TRUE(lhs.projectionMultiplierCoefficients.dfdx.isApprox(rhs.projectionMultiplierCoefficients.dfdx, tol));
+  EXPECT_TRUE(lhs.projectionMultiplierCoefficients.dfdu.isApprox(rhs.projectionMultiplierCoefficients.dfdu, tol));
+  EXPECT_TRUE(lhs.projectionMultiplierCoefficients.f.isApprox(rhs.projectionMultiplierCoefficients.f, tol));
+}
+}  // unnamed namespace
+
+class FixedSizeTranscriptionTest : public testing::TestWithParam<std::tuple<int, int, int, bool>> {};
+
+TEST_P(FixedSizeTranscriptionTest, sameAsDynamicProjection) {
+  const int nx = std::get<0>(GetParam());
+  const int nu = std::get<1>(GetParam());
+  const int nc = std::get<2>(GetParam());
+  const bool extractProjectionMultiplier = std::get<3>(GetParam());
+
+  for (const int nineq : {0, 5}) {
+    const auto transcription = getRandomTranscription(nx, nu, nc, nineq);
+    ASSERT_TRUE(multiple_shooting::hasFixedSizeProjection(transcription));
+
+    auto dynamicSize = transcription;
+    multiple_shooting::projectTranscription(dynamicSize, extractProjectionMultiplier);
+
+    auto fixedSize = transcription;
+    multiple_shooting::projectTranscriptionFixedSize(fixedSize, extractProjectionMultiplier);
+
+    expectApprox(fixedSize, dynamicSize);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(FixedSizeTranscriptionTestCase, FixedSizeTranscriptionTest,
+                         testing::Combine(testing::Values(12, 24), testing::Values(12, 24), testing::Values(1, 6, 12),
+                                          testing::Bool()));
+
+TEST(testFixedSizeTranscription, fallbackToDynamicSize) {
+  const auto transcription = getRandomTranscription(10, 7, 3, 2);
+  ASSERT_FALSE(multiple_shooting::hasFixedSizeProjection(transcription));
+
+  auto dynamicSize = transcription;
+  multiple_shooting::projectTranscription(dynamicSize);
+
+  auto dispatched = transcription;
+  multiple_shooting::projectTranscriptionFixedSize(dispatched);
+
+  expectApprox(dispatched, dynamicSize);
+}
+
+TEST(testFixedSizeTranscription, inconsistentDimensions) {
+  const auto transcription = getRandomTranscription(12, 12, 6, 0);
+  ASSERT_TRUE(multiple_shooting::hasFixedSizeProjection(transcription));
+
+  auto wrongCostStateInput = transcription;
+  wrongCostStateInput.cost.dfdux.setZero(12, 10);
+  EXPECT_FALSE(multiple_shooting::hasFixedSizeProjection(wrongCostStateInput));
+
+  auto wrongCostState = transcription;
+  wrongCostState.cost.dfdxx.setZero(12, 10);
+  EXPECT_FALSE(multiple_shooting::hasFixedSizeProjection(wrongCostState));
+
+  auto wrongConstraintState = transcription;
+  wrongConstraintState.stateInputEqConstraints.dfdx.setZero(6, 10);
+  EXPECT_FALSE(multiple_shooting::hasFixedSizeProjection(wrongConstraintState));
+
+  auto wrongConstraintInput = transcription;
+  wrongConstraintInput.stateInputEqConstraints.dfdu.setZero(5, 12);
+  EXPECT_FALSE(multiple_shooting::hasFixedSizeProjection(wrongConstraintInput));
+}
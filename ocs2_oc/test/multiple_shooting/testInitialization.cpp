@@ -0,0 +1,169 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_oc/multiple_shooting/Initialization.h>
+#include <ocs2_oc/oc_data/TimeDiscretization.h>
+
+using namespace ocs2;
+
+namespace {
+/** A previous solution with the given discretization. Only the time related members are set. */
+PrimalSolution getPreviousSolution(const std::vector<AnnotatedTime>& timeDiscretization, const ModeSchedule& modeSchedule) {
+  PrimalSolution primalSolution;
+  primalSolution.timeTrajectory_ = toTime(timeDiscretization);
+  primalSolution.postEventIndices_ = toPostEventIndices(timeDiscretization);
+  primalSolution.modeSchedule_ = modeSchedule;
+  return primalSolution;
+}
+}  // namespace
+
+TEST(testInitialization, warmStartNodeIndicesWithoutEvents) {
+  const ModeSchedule modeSchedule;
+  const auto previousSolution = getPreviousSolution(timeDiscretizationWithEvents(0.0, 1.0, 0.1, {}), modeSchedule);
+  const auto& oldTime = previousSolution.timeTrajectory_;
+  const auto newTimeDiscretization = timeDiscretizationWithEvents(0.25, 1.25, 0.1, {});
+
+  const auto nodeIndices = multiple_shooting::getWarmStartNodeIndices(previousSolution, modeSchedule, newTimeDiscretization);
+  ASSERT_EQ(nodeIndices.size(), newTimeDiscretization.size());
+  for (size_t i = 0; i < newTimeDiscretization.size(); i++) {
+    const scalar_t time = newTimeDiscretization[i].time;
+    if (time > oldTime.back()) {
+      EXPECT_EQ(nodeIndices[i], -1);
+    } else {
+      // last previous node at or before the new node
+      ASSERT_GE(nodeIndices[i], 0);
+      EXPECT_LE(oldTime[nodeIndices[i]], time);
+      EXPECT_GT(oldTime[nodeIndices[i] + 1], time);
+    }
+  }
+}
+
+TEST(testInitialization, warmStartNodeIndicesWithMovedEvent) {
+  const ModeSchedule oldModeSchedule({0.52}, {0, 1});
+  const ModeSchedule newModeSchedule({0.55}, {0, 1});
+  const auto oldTimeDiscretization = timeDiscretizationWithEvents(0.0, 1.0, 0.1, oldModeSchedule.eventTimes);
+  const auto previousSolution = getPreviousSolution(oldTimeDiscretization, oldModeSchedule);
+  const auto newTimeDiscretization = timeDiscretizationWithEvents(0.25, 1.25, 0.1, newModeSchedule.eventTimes);
+
+  const auto nodeIndices = multiple_shooting::getWarmStartNodeIndices(previousSolution, newModeSchedule, newTimeDiscretization);
+  ASSERT_EQ(nodeIndices.size(), newTimeDiscretization.size());
+
+  // The pre-event node is matched with the previous pre-event node even though the event has moved
+  int numEvents = 0;
+  for (size_t i = 0; i < newTimeDiscretization.size(); i++) {
+    if (newTimeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
+      ++numEvents;
+      ASSERT_GE(nodeIndices[i], 0);
+      EXPECT_EQ(oldTimeDiscretization[nodeIndices[i]].event, AnnotatedTime::Event::PreEvent);
+    }
+  }
+  EXPECT_EQ(numEvents, 1);
+
+  // The nodes are matched in order and within the same mode
+  for (size_t i = 1; i < newTimeDiscretization.size(); i++) {
+    if (nodeIndices[i] >= 0) {
+      EXPECT_GE(nodeIndices[i], nodeIndices[i - 1]);
+      const bool isNewBeforeEvent = newTimeDiscretization[i].time < newModeSchedule.eventTimes.front() ||
+                                    newTimeDiscretization[i].event == AnnotatedTime::Event::PreEvent;
+      const bool isOldBeforeEvent = nodeIndices[i] <= 6;  // nodes 0.0, ..., 0.5 and the pre-event node at 0.52
+      EXPECT_EQ(isNewBeforeEvent, isOldBeforeEvent) << "node " << i << " at time " << newTimeDiscretization[i].time;
+    }
+  }
+}
+
+TEST(testInitialization, warmStartNodeInterpolationWithoutEvents) {
+  const ModeSchedule modeSchedule;
+  const auto previousSolution = getPreviousSolution(timeDiscretizationWithEvents(0.0, 1.0, 0.1, {}), modeSchedule);
+  const auto& oldTime = previousSolution.timeTrajectory_;
+  const auto newTimeDiscretization = timeDiscretizationWithEvents(0.25, 1.25, 0.1, {});
+
+  const auto nodeInterpolation = multiple_shooting::getWarmStartNodeInterpolation(previousSolution, modeSchedule, newTimeDiscretization);
+  const auto nodeIndices = multiple_shooting::getWarmStartNodeIndices(previousSolution, modeSchedule, newTimeDiscretization);
+  ASSERT_EQ(nodeInterpolation.size(), newTimeDiscretization.size());
+  for (size_t i = 0; i < newTimeDiscretization.size(); i++) {
+    const scalar_t time = newTimeDiscretization[i].time;
+    const int index = nodeInterpolation[i].first;
+    const scalar_t alpha = nodeInterpolation[i].second;
+    EXPECT_EQ(index, nodeIndices[i]);
+    if (time > oldTime.back()) {
+      EXPECT_EQ(index, -1);
+    } else {
+      // the previous nodes interpolate to the time of the new node
+      ASSERT_GE(index, 0);
+      ASSERT_LT(index + 1, oldTime.size());
+      EXPECT_GT(alpha, 0.0);
+      EXPECT_LT(alpha, 1.0);
+      EXPECT_NEAR(alpha * oldTime[index] + (1.0 - alpha) * oldTime[index + 1], time, 1e-12);
+    }
+  }
+
+  // coinciding nodes are taken as they are
+  const auto sameNodeInterpolation =
+      multiple_shooting::getWarmStartNodeInterpolation(previousSolution, modeSchedule, timeDiscretizationWithEvents(0.0, 1.0, 0.1, {}));
+  for (size_t i = 0; i < sameNodeInterpolation.size(); i++) {
+    EXPECT_EQ(sameNodeInterpolation[i].first, i);
+    EXPECT_EQ(sameNodeInterpolation[i].second, 1.0);
+  }
+}
+
+TEST(testInitialization, warmStartNodeInterpolationWithMovedEvent) {
+  const ModeSchedule oldModeSchedule({0.52}, {0, 1});
+  const ModeSchedule newModeSchedule({0.55}, {0, 1});
+  const auto oldTimeDiscretization = timeDiscretizationWithEvents(0.0, 1.0, 0.1, oldModeSchedule.eventTimes);
+  const auto previousSolution = getPreviousSolution(oldTimeDiscretization, oldModeSchedule);
+  const auto newTimeDiscretization = timeDiscretizationWithEvents(0.25, 1.25, 0.1, newModeSchedule.eventTimes);
+
+  const auto nodeInterpolation = multiple_shooting::getWarmStartNodeInterpolation(previousSolution, newModeSchedule, newTimeDiscretization);
+  const auto nodeIndices = multiple_shooting::getWarmStartNodeIndices(previousSolution, newModeSchedule, newTimeDiscretization);
+  ASSERT_EQ(nodeInterpolation.size(), newTimeDiscretization.size());
+
+  for (size_t i = 0; i < newTimeDiscretization.size(); i++) {
+    const int index = nodeInterpolation[i].first;
+    const scalar_t alpha = nodeInterpolation[i].second;
+    // the node at or before the new node is the one of getWarmStartNodeIndices
+    EXPECT_EQ(index, nodeIndices[i]);
+    if (index < 0) {
+      continue;
+    }
+    EXPECT_GT(alpha, 0.0);
+    EXPECT_LE(alpha, 1.0);
+    if (newTimeDiscretization[i].event == AnnotatedTime::Event::PreEvent) {
+      // the pre-event node takes the previous pre-event node
+      EXPECT_EQ(oldTimeDiscretization[index].event, AnnotatedTime::Event::PreEvent);
+      EXPECT_EQ(alpha, 1.0);
+    }
+    if (alpha < 1.0) {
+      // never interpolated across the event
+      ASSERT_LT(index + 1, oldTimeDiscretization.size());
+      EXPECT_NE(oldTimeDiscretization[index].event, AnnotatedTime::Event::PreEvent);
+    }
+  }
+}
@@ -0,0 +1,174 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_oc/multiple_shooting/Helpers.h>
+#include <ocs2_oc/multiple_shooting/StructuredProjection.h>
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+namespace {
+constexpr int nx = 6;
+constexpr int nu = 8;
+constexpr scalar_t tol = 1e-9;
+
+/**
+ * Constraints with the blocks {constraint 0 : input 2}, {constraints 1, 2 : inputs 4, 5, 6}, {constraint 3 : inputs 0, 1}, and the
+ * free inputs 3 and 7.
+ */
+VectorFunctionLinearApproximation getStructuredConstraints() {
+  auto constraints = getRandomConstraints(nx, nu, 4);
+  constraints.dfdu.setZero();
+  constraints.dfdu(0, 2) = 2.0;
+  constraints.dfdu(1, 4) = 1.5;
+  constraints.dfdu(1, 5) = -0.5;
+  constraints.dfdu(2, 5) = 0.7;
+  constraints.dfdu(2, 6) = 1.2;
+  constraints.dfdu(3, 0) = -1.0;
+  constraints.dfdu(3, 1) = 0.3;
+  return constraints;
+}
+
+multiple_shooting::Transcription getStructuredTranscription() {
+  multiple_shooting::Transcription transcription;
+  transcription.cost = getRandomCost(nx, nu);
+  transcription.dynamics = getRandomDynamics(nx, nu);
+  transcription.stateInputEqConstraints = getStructuredConstraints();
+  transcription.stateInputIneqConstraints = getRandomConstraints(nx, nu, 3);
+  return transcription;
+}
+
+scalar_t evaluate(const ScalarFunctionQuadraticApproximation& cost, const vector_t& x, const vector_t& u) {
+  return 0.5 * x.dot(cost.dfdxx * x) + u.dot(cost.dfdux * x) + 0.5 * u.dot(cost.dfduu * u) + cost.dfdx.dot(x) + cost.dfdu.dot(u) + cost.f;
+}
+
+vector_t evaluate(const VectorFunctionLinearApproximation& function, const vector_t& x, const vector_t& u) {
+  return function.dfdx * x + function.dfdu * u + function.f;
+}
+}  // unnamed namespace
+
+TEST(testStructuredProjection, structure) {
+  const auto structure = multiple_shooting::getConstraintJacobianStructure(getStructuredConstraints().dfdu);
+
+  EXPECT_EQ(structure.freeInputs, std::vector<int>({3, 7}));
+  EXPECT_EQ(structure.constrainedInputs, std::vector<int>({2, 4, 5, 6, 0, 1}));
+  ASSERT_EQ(structure.blocks.size(), 3);
+  EXPECT_EQ(structure.blocks[0].constraints, std::vector<int>({0}));
+  EXPECT_EQ(structure.blocks[0].inputs, std::vector<int>({2}));
+  EXPECT_EQ(structure.blocks[1].constraints, std::vector<int>({1, 2}));
+  EXPECT_EQ(structure.blocks[1].inputs, std::vector<int>({4, 5, 6}));
+  EXPECT_EQ(structure.blocks[2].constraints, std::vector<int>({3}));
+  EXPECT_EQ(structure.blocks[2].inputs, std::vector<int>({0, 1}));
+  EXPECT_TRUE(structure.isSparse());
+  EXPECT_TRUE(structure.isProjectable());
+
+  // A dense matrix is a single block
+  const auto denseStructure = multiple_shooting::getConstraintJacobianStructure(matrix_t::Random(3, nu));
+  EXPECT_TRUE(denseStructure.freeInputs.empty());
+  EXPECT_FALSE(denseStructure.isSparse());
+}
+
+TEST(testStructuredProjection, changeOfInputVariables) {
+  for (const bool extractProjectionMultiplier : {false, true}) {
+    const auto transcription = getStructuredTranscription();
+    auto projected = transcription;
+    multiple_shooting::projectTranscriptionStructured(projected, extractProjectionMultiplier);
+    const auto& projection = projected.constraintsProjection;
+    ASSERT_EQ(projected.stateInputEqConstraints.f.size(), 0);
+
+    // 2 free inputs and a 1 dimensional null space for each of the two larger blocks
+    ASSERT_EQ(projection.dfdu.cols(), 4);
+
+    // Any projected input satisfies the constraints, and the projected functions evaluate as the original ones
+    for (int k = 0; k < 5; ++k) {
+      const vector_t x = vector_t::Random(nx);
+      const vector_t uTilde = vector_t::Random(projection.dfdu.cols());
+      const vector_t u = evaluate(projection, x, uTilde);
+      EXPECT_LT(evaluate(transcription.stateInputEqConstraints, x, u).norm(), tol);
+      EXPECT_NEAR(evaluate(projected.cost, x, uTilde), evaluate(transcription.cost, x, u), tol);
+      EXPECT_TRUE(evaluate(projected.dynamics, x, uTilde).isApprox(evaluate(transcription.dynamics, x, u), tol));
+      EXPECT_TRUE(
+          evaluate(projected.stateInputIneqConstraints, x, uTilde).isApprox(evaluate(transcription.stateInputIneqConstraints, x, u), tol));
+    }
+
+    // The multiplier coefficients that do not depend on the null space basis are the ones of the dense projection
+    if (extractProjectionMultiplier) {
+      auto denseProjected = transcription;
+      multiple_shooting::projectTranscription(denseProjected, true);
+      const auto& coefficients = projected.projectionMultiplierCoefficients;
+      const auto& denseCoefficients = denseProjected.projectionMultiplierCoefficients;
+      EXPECT_TRUE(projection.dfdx.isApprox(denseProjected.constraintsProjection.dfdx, tol));
+      EXPECT_TRUE(projection.f.isApprox(denseProjected.constraintsProjection.f, tol));
+      EXPECT_TRUE(coefficients.dfdx.isApprox(denseCoefficients.dfdx, tol));
+      EXPECT_TRUE(coefficients.dfdcostate.isApprox(denseCoefficients.dfdcostate, tol));
+      EXPECT_TRUE(coefficients.f.isApprox(denseCoefficients.f, tol));
+    }
+  }
+}
+
+TEST(testStructuredProjection, fallbackToDense) {
+  multiple_shooting::Transcription transcription;
+  transcription.cost = getRandomCost(nx, nu);
+  transcription.dynamics = getRandomDynamics(nx, nu);
+  transcription.stateInputEqConstraints = getRandomConstraints(nx, nu, 3);
+
+  auto dense = transcription;
+  multiple_shooting::projectTranscription(dense);
+
+  auto structured = transcription;
+  multiple_shooting::projectTranscriptionStructured(structured);
+
+  EXPECT_TRUE(structured.projectedFreeInputs.empty());
+  EXPECT_TRUE(structured.constraintsProjection.dfdu.isApprox(dense.constraintsProjection.dfdu, tol));
+  EXPECT_TRUE(structured.cost.dfduu.isApprox(dense.cost.dfduu, tol));
+  EXPECT_TRUE(structured.dynamics.dfdu.isApprox(dense.dynamics.dfdu, tol));
+}
+
+TEST(testStructuredProjection, remapProjectedGain) {
+  auto transcription = getStructuredTranscription();
+  multiple_shooting::projectTranscriptionStructured(transcription);
+  const auto& projection = transcription.constraintsProjection;
+
+  EXPECT_EQ(transcription.projectedFreeInputs, std::vector<int>({3, 7}));
+
+  const matrix_t K = matrix_t::Random(projection.dfdu.cols(), nx);
+  matrix_array_t KMatrices{K};
+  multiple_shooting::remapProjectedGain({projection}, {transcription.projectedFreeInputs}, KMatrices);
+
+  const matrix_t expected = projection.dfdx + projection.dfdu * K;
+  EXPECT_TRUE(KMatrices.front().isApprox(expected, tol));
+
+  // Without free inputs, the gain is remapped densely
+  matrix_array_t denseKMatrices{K};
+  multiple_shooting::remapProjectedGain({projection}, {std::vector<int>()}, denseKMatrices);
+  EXPECT_TRUE(denseKMatrices.front().isApprox(expected, tol));
+}
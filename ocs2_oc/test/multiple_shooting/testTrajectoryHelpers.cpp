@@ -0,0 +1,110 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_oc/multiple_shooting/Helpers.h>
+
+using namespace ocs2;
+
+namespace {
+/** A state or input trajectory with an event node at every 10th node */
+vector_array_t getRandomTrajectory(size_t numNodes, int dim) {
+  vector_array_t trajectory(numNodes);
+  for (size_t i = 0; i < numNodes; i++) {
+    trajectory[i] = (i % 10 == 5) ? vector_t() : vector_t::Random(dim);
+  }
+  return trajectory;
+}
+}  // namespace
+
+TEST(testTrajectoryHelpers, incrementAndNorm) {
+  const auto v = getRandomTrajectory(21, 7);
+  const auto dv = getRandomTrajectory(21, 7);
+  constexpr scalar_t alpha = 0.3;
+
+  vector_array_t vNew(v.size());
+  multiple_shooting::incrementTrajectory(v, dv, alpha, vNew);
+
+  const VectorTrajectory vContiguous(v);
+  const VectorTrajectory dvContiguous(dv);
+  VectorTrajectory vNewContiguous;
+  multiple_shooting::incrementTrajectory(vContiguous, dvContiguous, alpha, vNewContiguous);
+
+  ASSERT_EQ(vNewContiguous.size(), vNew.size());
+  for (size_t i = 0; i < vNew.size(); i++) {
+    EXPECT_TRUE(vNewContiguous[i].isApprox(vNew[i]));
+  }
+  EXPECT_NEAR(multiple_shooting::trajectoryNorm(vNewContiguous), multiple_shooting::trajectoryNorm(vNew), 1e-12);
+
+  // in-place increment
+  VectorTrajectory vInPlace(v);
+  multiple_shooting::incrementTrajectory(vInPlace, dvContiguous, alpha, vInPlace);
+  EXPECT_TRUE(vInPlace.flat() == vNewContiguous.flat());
+
+  EXPECT_ANY_THROW(multiple_shooting::incrementTrajectory(vContiguous, VectorTrajectory(std::vector<int>{7}), alpha, vNewContiguous));
+}
+
+/** Compares the cost of a linesearch trial step and the step norms on vector_array_t and VectorTrajectory. */
+TEST(testTrajectoryHelpers, linesearchBenchmark) {
+  constexpr size_t numNodes = 101;
+  constexpr int stateDim = 36;
+  constexpr int numRepeats = 200;
+  const auto x = getRandomTrajectory(numNodes, stateDim);
+  const auto dx = getRandomTrajectory(numNodes, stateDim);
+
+  benchmark::RepeatedTimer arrayTimer;
+  vector_array_t xNew(numNodes);
+  scalar_t arrayNorm = 0.0;
+  for (int k = 0; k < numRepeats; k++) {
+    arrayTimer.startTimer();
+    multiple_shooting::incrementTrajectory(x, dx, 0.5, xNew);
+    arrayNorm = multiple_shooting::trajectoryNorm(dx) + multiple_shooting::trajectoryNorm(xNew);
+    arrayTimer.endTimer();
+  }
+
+  benchmark::RepeatedTimer contiguousTimer;
+  const VectorTrajectory xContiguous(x);
+  const VectorTrajectory dxContiguous(dx);
+  VectorTrajectory xNewContiguous(xContiguous.sizes());
+  scalar_t contiguousNorm = 0.0;
+  for (int k = 0; k < numRepeats; k++) {
+    contiguousTimer.startTimer();
+    multiple_shooting::incrementTrajectory(xContiguous, dxContiguous, 0.5, xNewContiguous);
+    contiguousNorm = multiple_shooting::trajectoryNorm(dxContiguous) + multiple_shooting::trajectoryNorm(xNewContiguous);
+    contiguousTimer.endTimer();
+  }
+
+  EXPECT_NEAR(arrayNorm, contiguousNorm, 1e-9);
+  std::cerr << "[linesearchBenchmark] vector_array_t: " << 1e3 * arrayTimer.getAverageInMilliseconds()
+            << " [us], VectorTrajectory: " << 1e3 * contiguousTimer.getAverageInMilliseconds() << " [us]\n";
+}
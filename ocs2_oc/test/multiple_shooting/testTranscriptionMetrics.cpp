@@ -63,6 +63,13 @@ TEST(test_transcription_metrics, intermediate) {
   const auto metrics = multiple_shooting::computeIntermediateMetrics(problem, discretizer, t, dt, x, x_next, u);
 
   ASSERT_TRUE(metrics.isApprox(multiple_shooting::computeMetrics(transcription), 1e-12));
+
+  // in-place variant, writing over the metrics of another node
+  auto inPlaceDiscretizer = selectDynamicsDiscretizationInPlace(SensitivityIntegratorType::RK4);
+  Metrics inPlaceMetrics;
+  multiple_shooting::computeIntermediateMetrics(problem, inPlaceDiscretizer, t, dt, x_next, x, u, inPlaceMetrics);
+  multiple_shooting::computeIntermediateMetrics(problem, inPlaceDiscretizer, t, dt, x, x_next, u, inPlaceMetrics);
+  ASSERT_TRUE(inPlaceMetrics.isApprox(metrics, 1e-12));
 }
 
 TEST(test_transcription_metrics, event) {
@@ -93,6 +100,12 @@ TEST(test_transcription_metrics, event) {
   const auto metrics = multiple_shooting::computeEventMetrics(problem, t, x, x_next);
 
   ASSERT_TRUE(metrics.isApprox(multiple_shooting::computeMetrics(transcription), 1e-12));
+
+  // in-place variant, writing over the metrics of another node
+  Metrics inPlaceMetrics;
+  multiple_shooting::computeEventMetrics(problem, t, x_next, x, inPlaceMetrics);
+  multiple_shooting::computeEventMetrics(problem, t, x, x_next, inPlaceMetrics);
+  ASSERT_TRUE(inPlaceMetrics.isApprox(metrics, 1e-12));
 }
 
 TEST(test_transcription_metrics, terminal) {
@@ -118,4 +131,10 @@ TEST(test_transcription_metrics, terminal) {
   const auto metrics = multiple_shooting::computeTerminalMetrics(problem, t, x);
 
   ASSERT_TRUE(metrics.isApprox(multiple_shooting::computeMetrics(transcription), 1e-12));
+
+  // in-place variant, writing over the metrics of another node
+  Metrics inPlaceMetrics;
+  multiple_shooting::computeTerminalMetrics(problem, t, vector_t::Random(nx), inPlaceMetrics);
+  multiple_shooting::computeTerminalMetrics(problem, t, x, inPlaceMetrics);
+  ASSERT_TRUE(inPlaceMetrics.isApprox(metrics, 1e-12));
 }
@@ -0,0 +1,225 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/test/AllocationCounter.h>
+#include <ocs2_core/test/testTools.h>
+
+#include <ocs2_oc/multiple_shooting/Helpers.h>
+#include <ocs2_oc/multiple_shooting/MetricsComputation.h>
+#include <ocs2_oc/multiple_shooting/Transcription.h>
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+OCS2_DEFINE_ALLOCATION_COUNTER
+
+using namespace ocs2;
+
+namespace {
+constexpr int nx = 3;
+constexpr int nu = 2;
+const TargetTrajectories targetTrajectories({0.0}, {vector_t::Zero(nx)}, {vector_t::Zero(nu)});
+
+OptimalControlProblem getProblem(bool withConstraints) {
+  OptimalControlProblem problem;
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+  problem.dynamicsPtr = getOcs2Dynamics(getRandomDynamics(nx, nu));
+  problem.costPtr->add("cost", getOcs2Cost(getRandomCost(nx, nu)));
+  if (withConstraints) {
+    problem.equalityConstraintPtr->add("equalityConstraint", getOcs2Constraints(getRandomConstraints(nx, nu, 1)));
+    problem.stateEqualityConstraintPtr->add("stateEqualityConstraint", getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 1)));
+    problem.inequalityConstraintPtr->add("inequalityConstraint", getOcs2Constraints(getRandomConstraints(nx, nu, 3)));
+    problem.stateInequalityConstraintPtr->add("stateInequalityConstraint", getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 2)));
+  }
+  return problem;
+}
+}  // unnamed namespace
+
+TEST(test_workspace_allocations, counterIsActive) {
+  test::ScopedAllocationCounter allocationCounter;
+  vector_t v = vector_t::Random(100);
+  EXPECT_GT(allocationCounter.count(), 0);
+  EXPECT_EQ(v.size(), 100);
+}
+
+TEST(test_workspace_allocations, incrementTrajectory) {
+  constexpr size_t N = 10;
+  const vector_array_t v(N, vector_t::Random(nx));
+  const vector_array_t dv(N, vector_t::Random(nx));
+  vector_array_t vNew(N);
+
+  // warm-up
+  multiple_shooting::incrementTrajectory(v, dv, 1.0, vNew);
+
+  test::ScopedAllocationCounter allocationCounter;
+  multiple_shooting::incrementTrajectory(v, dv, 0.5, vNew);
+  EXPECT_EQ(allocationCounter.count(), 0);
+}
+
+TEST(test_workspace_allocations, toConstraintArray) {
+  const size_array_t termsSize{2, 0, 3};
+  const vector_t vec = vector_t::Random(5);
+  vector_array_t constraintArray;
+
+  // warm-up
+  toConstraintArray(termsSize, vec, constraintArray);
+
+  test::ScopedAllocationCounter allocationCounter;
+  toConstraintArray(termsSize, vec, constraintArray);
+  EXPECT_EQ(allocationCounter.count(), 0);
+
+  const auto expected = toConstraintArray(termsSize, vec);
+  ASSERT_EQ(constraintArray.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_TRUE(constraintArray[i].isApprox(expected[i]));
+  }
+}
+
+TEST(test_workspace_allocations, computeMetrics) {
+  auto problem = getProblem(true);
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK2);
+
+  const scalar_t t = 0.5;
+  const scalar_t dt = 0.1;
+  const vector_t x = vector_t::Random(nx);
+  const vector_t x_next = vector_t::Random(nx);
+  const vector_t u = vector_t::Random(nu);
+  const auto transcription = multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x, x_next, u);
+
+  // warm-up
+  Metrics metrics;
+  multiple_shooting::computeMetrics(transcription, metrics);
+
+  test::ScopedAllocationCounter allocationCounter;
+  multiple_shooting::computeMetrics(transcription, metrics);
+  EXPECT_EQ(allocationCounter.count(), 0);
+
+  EXPECT_TRUE(metrics.isApprox(multiple_shooting::computeMetrics(transcription), 1e-12));
+}
+
+TEST(test_workspace_allocations, reusedTranscription) {
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK2);
+  auto sensitivityDiscretizerInPlace = selectDynamicsSensitivityDiscretizationInPlace(SensitivityIntegratorType::RK2);
+  const scalar_t t = 0.5;
+  const scalar_t dt = 0.1;
+  const vector_t x = vector_t::Random(nx);
+  const vector_t x_next = vector_t::Random(nx);
+  const vector_t u = vector_t::Random(nu);
+
+  // Fill the workspace with a constrained and projected node
+  auto constrainedProblem = getProblem(true);
+  multiple_shooting::Transcription transcription;
+  multiple_shooting::setupIntermediateNode(constrainedProblem, sensitivityDiscretizerInPlace, t, dt, x, x_next, u, transcription);
+  multiple_shooting::projectTranscription(transcription, true);
+
+  // Reuse the workspace for an unconstrained node: nothing of the previous node should remain
+  auto unconstrainedProblem = getProblem(false);
+  multiple_shooting::setupIntermediateNode(unconstrainedProblem, sensitivityDiscretizerInPlace, t, dt, x, x_next, u, transcription);
+  const auto expected = multiple_shooting::setupIntermediateNode(unconstrainedProblem, sensitivityDiscretizer, t, dt, x, x_next, u);
+
+  EXPECT_TRUE(isApprox(transcription.cost, expected.cost));
+  EXPECT_TRUE(isApprox(transcription.dynamics, expected.dynamics));
+  EXPECT_TRUE(transcription.constraintsSize.stateEq.empty());
+  EXPECT_TRUE(transcription.constraintsSize.stateInputEq.empty());
+  EXPECT_TRUE(transcription.constraintsSize.stateIneq.empty());
+  EXPECT_TRUE(transcription.constraintsSize.stateInputIneq.empty());
+  EXPECT_EQ(transcription.stateEqConstraints.f.size(), 0);
+  EXPECT_EQ(transcription.stateInputEqConstraints.f.size(), 0);
+  EXPECT_EQ(transcription.stateIneqConstraints.f.size(), 0);
+  EXPECT_EQ(transcription.stateInputIneqConstraints.f.size(), 0);
+  EXPECT_EQ(transcription.constraintsProjection.f.size(), 0);
+  EXPECT_EQ(transcription.projectionMultiplierCoefficients.f.size(), 0);
+}
+
+TEST(test_workspace_allocations, sensitivityDiscretization) {
+  auto dynamicsPtr = getOcs2Dynamics(getRandomDynamics(nx, nu));
+  const scalar_t t = 0.5;
+  const scalar_t dt = 0.1;
+  const vector_t x = vector_t::Random(nx);
+  const vector_t u = vector_t::Random(nu);
+
+  for (const auto type : {SensitivityIntegratorType::EULER, SensitivityIntegratorType::RK2, SensitivityIntegratorType::RK4}) {
+    auto discretizer = selectDynamicsDiscretizationInPlace(type);
+    auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretizationInPlace(type);
+
+    // warm-up
+    vector_t xNext;
+    VectorFunctionLinearApproximation dynamics;
+    discretizer(*dynamicsPtr, t, x, u, dt, xNext);
+    sensitivityDiscretizer(*dynamicsPtr, t, x, u, dt, dynamics);
+
+    test::ScopedAllocationCounter allocationCounter;
+    discretizer(*dynamicsPtr, t, x, u, dt, xNext);
+    sensitivityDiscretizer(*dynamicsPtr, t, x, u, dt, dynamics);
+    EXPECT_EQ(allocationCounter.count(), 0);
+
+    EXPECT_TRUE(xNext.isApprox(selectDynamicsDiscretization(type)(*dynamicsPtr, t, x, u, dt)));
+    EXPECT_TRUE(isApprox(dynamics, selectDynamicsSensitivityDiscretization(type)(*dynamicsPtr, t, x, u, dt)));
+  }
+}
+
+TEST(test_workspace_allocations, projectTranscription) {
+  auto problem = getProblem(true);
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK2);
+  const scalar_t t = 0.5;
+  const scalar_t dt = 0.1;
+  const vector_t x = vector_t::Random(nx);
+  const vector_t x_next = vector_t::Random(nx);
+  const vector_t u = vector_t::Random(nu);
+  const auto transcription = multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x, x_next, u);
+
+  for (const bool extractProjectionMultiplier : {false, true}) {
+    ScalarFunctionQuadraticApproximation cost;
+    VectorFunctionLinearApproximation dynamics;
+    VectorFunctionLinearApproximation stateInputIneqConstraints;
+    VectorFunctionLinearApproximation constraintsProjection;
+    std::vector<int> projectedFreeInputs;
+    multiple_shooting::ProjectionMultiplierCoefficients projectionMultiplierCoefficients;
+    multiple_shooting::ProjectedTranscription projected{cost, dynamics, stateInputIneqConstraints, constraintsProjection, projectedFreeInputs,
+                                                        projectionMultiplierCoefficients};
+    multiple_shooting::ProjectionWorkspace workspace;
+
+    // warm-up
+    multiple_shooting::projectTranscription(transcription, projected, workspace, extractProjectionMultiplier);
+
+    test::ScopedAllocationCounter allocationCounter;
+    multiple_shooting::projectTranscription(transcription, projected, workspace, extractProjectionMultiplier);
+    EXPECT_EQ(allocationCounter.count(), 0);
+
+    auto expected = transcription;
+    multiple_shooting::projectTranscription(expected, extractProjectionMultiplier);
+    EXPECT_TRUE(isApprox(cost, expected.cost));
+    EXPECT_TRUE(isApprox(dynamics, expected.dynamics));
+    EXPECT_TRUE(isApprox(stateInputIneqConstraints, expected.stateInputIneqConstraints));
+    EXPECT_TRUE(isApprox(constraintsProjection, expected.constraintsProjection));
+    EXPECT_TRUE(projectionMultiplierCoefficients.f.isApprox(expected.projectionMultiplierCoefficients.f));
+    EXPECT_TRUE(projectionMultiplierCoefficients.dfdx.isApprox(expected.projectionMultiplierCoefficients.dfdx));
+  }
+}
@@ -0,0 +1,143 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/oc_problem/OcpToKkt.h"
+#include "ocs2_oc/oc_solver/ParallelRiccatiSolver.h"
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+class ParallelRiccatiSolverTest : public testing::TestWithParam<size_t> {
+ protected:
+  // x_0, x_1, ... x_{N - 1}, X_{N}
+  static constexpr int N_ = 30;  // numStages
+  static constexpr int nx_ = 4;
+  static constexpr int nu_ = 3;
+
+  ParallelRiccatiSolverTest() {
+    srand(0);
+
+    x0 = ocs2::vector_t::Random(nx_);
+    for (int i = 0; i < N_; i++) {
+      dynamicsArray.push_back(ocs2::getRandomDynamics(nx_, nu_));
+      // scale down to keep the open-loop propagation well conditioned over the horizon
+      dynamicsArray.back().dfdx *= 0.5;
+      costArray.push_back(ocs2::getRandomCost(nx_, nu_));
+      costArray.back().dfduu += ocs2::matrix_t::Identity(nu_, nu_);
+    }
+    costArray.push_back(ocs2::getRandomCost(nx_, 0));
+
+    ocpSize_ = ocs2::extractSizesFromProblem(dynamicsArray, costArray, nullptr);
+  }
+
+  ocs2::OcpSize ocpSize_;
+  ocs2::vector_t x0;
+  std::vector<ocs2::VectorFunctionLinearApproximation> dynamicsArray;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> costArray;
+};
+
+TEST_P(ParallelRiccatiSolverTest, sameAsDenseKkt) {
+  ocs2::ThreadPool threadPool(GetParam());
+  ocs2::ParallelRiccatiSolver solver(ocpSize_);
+  ocs2::vector_array_t X, U;
+  ASSERT_TRUE(solver.solve(threadPool, x0, dynamicsArray, costArray, X, U));
+
+  // Dense KKT system with Z = [u_{0}; x_{1}; ...; u_{N-1}; x_{N}]
+  ocs2::ScalarFunctionQuadraticApproximation costApproximation;
+  ocs2::VectorFunctionLinearApproximation constraintsApproximation;
+  ocs2::getCostMatrix(ocpSize_, x0, costArray, costApproximation);
+  ocs2::getConstraintMatrix(ocpSize_, x0, dynamicsArray, nullptr, nullptr, constraintsApproximation);
+  const auto& H = costApproximation.dfdxx;
+  const auto& G = constraintsApproximation.dfdx;
+  const auto numDecisionVariables = H.rows();
+  const auto numConstraints = G.rows();
+
+  ocs2::matrix_t kkt = ocs2::matrix_t::Zero(numDecisionVariables + numConstraints, numDecisionVariables + numConstraints);
+  kkt.topLeftCorner(numDecisionVariables, numDecisionVariables) = H;
+  kkt.topRightCorner(numDecisionVariables, numConstraints) = G.transpose();
+  kkt.bottomLeftCorner(numConstraints, numDecisionVariables) = G;
+  ocs2::vector_t rhs(numDecisionVariables + numConstraints);
+  rhs << -costApproximation.dfdx, constraintsApproximation.f;
+  const ocs2::vector_t solution = kkt.fullPivLu().solve(rhs);
+
+  ASSERT_TRUE(X.front().isApprox(x0));
+  for (int k = 0; k < N_; k++) {
+    EXPECT_TRUE(U[k].isApprox(solution.segment(k * (nx_ + nu_), nu_), 1e-8)) << "k = " << k;
+    EXPECT_TRUE(X[k + 1].isApprox(solution.segment(k * (nx_ + nu_) + nu_, nx_), 1e-8)) << "k = " << k;
+  }
+}
+
+TEST_P(ParallelRiccatiSolverTest, sameAsSequentialRiccati) {
+  ocs2::ThreadPool sequentialPool(0);
+  ocs2::ParallelRiccatiSolver sequentialSolver(ocpSize_);
+  ocs2::vector_array_t XSequential, USequential;
+  ASSERT_TRUE(sequentialSolver.solve(sequentialPool, x0, dynamicsArray, costArray, XSequential, USequential));
+
+  ocs2::ThreadPool threadPool(GetParam());
+  ocs2::ParallelRiccatiSolver solver(ocpSize_);
+  ocs2::vector_array_t X, U;
+  ASSERT_TRUE(solver.solve(threadPool, x0, dynamicsArray, costArray, X, U));
+
+  const auto costToGoSequential = sequentialSolver.getRiccatiCostToGo();
+  const auto costToGo = solver.getRiccatiCostToGo();
+  ASSERT_EQ(costToGo.size(), N_ + 1);
+  for (int k = 0; k <= N_; k++) {
+    EXPECT_TRUE(costToGo[k].dfdxx.isApprox(costToGoSequential[k].dfdxx, 1e-8)) << "k = " << k;
+    EXPECT_TRUE(costToGo[k].dfdx.isApprox(costToGoSequential[k].dfdx, 1e-8)) << "k = " << k;
+  }
+
+  ASSERT_EQ(solver.getRiccatiFeedback().size(), N_);
+  for (int k = 0; k < N_; k++) {
+    EXPECT_TRUE(solver.getRiccatiFeedback()[k].isApprox(sequentialSolver.getRiccatiFeedback()[k], 1e-8)) << "k = " << k;
+    EXPECT_TRUE(solver.getRiccatiFeedforward()[k].isApprox(sequentialSolver.getRiccatiFeedforward()[k], 1e-8)) << "k = " << k;
+    EXPECT_TRUE(U[k].isApprox(USequential[k], 1e-8)) << "k = " << k;
+  }
+}
+
+TEST(ParallelRiccatiSolver, rejectsIndefiniteInputHessian) {
+  constexpr int N = 10;
+  std::vector<ocs2::VectorFunctionLinearApproximation> dynamicsArray;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> costArray;
+  for (int i = 0; i < N; i++) {
+    dynamicsArray.push_back(ocs2::getRandomDynamics(2, 2));
+    costArray.push_back(ocs2::getRandomCost(2, 2));
+  }
+  costArray.push_back(ocs2::getRandomCost(2, 0));
+  costArray[N / 2].dfduu = -ocs2::matrix_t::Identity(2, 2);
+
+  ocs2::ThreadPool threadPool(4);
+  ocs2::ParallelRiccatiSolver solver(ocs2::extractSizesFromProblem(dynamicsArray, costArray, nullptr));
+  ocs2::vector_array_t X, U;
+  EXPECT_FALSE(solver.solve(threadPool, ocs2::vector_t::Zero(2), dynamicsArray, costArray, X, U));
+}
+
+INSTANTIATE_TEST_CASE_P(NumThreads, ParallelRiccatiSolverTest, testing::Values(0, 2, 3, 7, 28));
@@ -0,0 +1,206 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/dynamics/SystemDynamicsBase.h>
+#include <ocs2_core/misc/Benchmark.h>
+
+#include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
+#include <ocs2_oc/rollout/BatchRollout.h>
+#include <ocs2_oc/rollout/TimeTriggeredRollout.h>
+
+using namespace ocs2;
+
+/** A linear system that does not override computeFlowMapBatch(), hence its columns are evaluated one by one. */
+class ColumnwiseLinearSystemDynamics final : public SystemDynamicsBase {
+ public:
+  ColumnwiseLinearSystemDynamics(matrix_t A, matrix_t B) : A_(std::move(A)), B_(std::move(B)) {}
+  ~ColumnwiseLinearSystemDynamics() override = default;
+  ColumnwiseLinearSystemDynamics* clone() const override { return new ColumnwiseLinearSystemDynamics(*this); }
+
+  vector_t computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation&) override { return A_ * x + B_ * u; }
+
+  VectorFunctionLinearApproximation linearApproximation(scalar_t t, const vector_t& x, const vector_t& u,
+                                                        const PreComputation& preComp) override {
+    VectorFunctionLinearApproximation approximation;
+    approximation.dfdx = A_;
+    approximation.dfdu = B_;
+    approximation.f = computeFlowMap(t, x, u, preComp);
+    return approximation;
+  }
+
+ private:
+  matrix_t A_;
+  matrix_t B_;
+};
+
+class BatchRolloutTest : public ::testing::Test {
+ protected:
+  static constexpr size_t nx = 4;
+  static constexpr size_t nu = 2;
+  static constexpr size_t numTrajectories = 32;
+  static constexpr scalar_t initTime = 0.0;
+  static constexpr scalar_t finalTime = 2.0;
+
+  BatchRolloutTest() : modeSchedule({0.7}, {0, 1}), targetTrajectories({initTime}, {vector_t::Zero(nx)}, {vector_t::Zero(nu)}) {
+    srand(0);
+    A = -matrix_t::Identity(nx, nx) + 0.3 * matrix_t::Random(nx, nx);
+    B = matrix_t::Random(nx, nu);
+    problem.dynamicsPtr.reset(new LinearSystemDynamics(A, B));
+    problem.costPtr->add("cost", std::make_unique<QuadraticStateInputCost>(matrix_t::Identity(nx, nx), matrix_t::Identity(nu, nu)));
+    problem.finalCostPtr->add("finalCost", std::make_unique<QuadraticStateCost>(10.0 * matrix_t::Identity(nx, nx)));
+    problem.targetTrajectoriesPtr = &targetTrajectories;
+
+    controller = LinearController({initTime, finalTime}, vector_array_t(2, vector_t::Ones(nu)),
+                                  matrix_array_t(2, -0.5 * matrix_t::Ones(nu, nx)));
+
+    settings.integratorType = IntegratorType::RK4;
+    settings.timeStep = 1e-2;
+    settings.useFixedStepRollout = true;
+
+    initStates = matrix_t::Random(nx, numTrajectories);
+  }
+
+  /** Rolls out one trajectory with TimeTriggeredRollout and integrates its performance index with the trapezoidal rule. */
+  PerformanceIndex singleRollout(const vector_t& initState, vector_t& finalState) {
+    TimeTriggeredRollout rollout(*problem.dynamicsPtr, settings);
+    scalar_array_t timeTrajectory;
+    size_array_t postEventIndices;
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    LinearController controllerCopy(controller);
+    finalState = rollout.run(initTime, initState, finalTime, &controllerCopy, modeSchedule, timeTrajectory, postEventIndices,
+                             stateTrajectory, inputTrajectory);
+
+    PerformanceIndex performanceIndex = toPerformanceIndex(computeFinalMetrics(problem, finalTime, finalState));
+    for (const auto k : postEventIndices) {
+      performanceIndex += toPerformanceIndex(computePreJumpMetrics(problem, timeTrajectory[k - 1], stateTrajectory[k - 1]));
+    }
+    size_t eventIndex = 0;
+    for (size_t k = 0; k + 1 < timeTrajectory.size(); k++) {
+      if (eventIndex < postEventIndices.size() && k + 1 == postEventIndices[eventIndex]) {
+        eventIndex++;
+        continue;
+      }
+      const auto lhs = toPerformanceIndex(computeIntermediateMetrics(problem, timeTrajectory[k], stateTrajectory[k], inputTrajectory[k]));
+      const auto rhs =
+          toPerformanceIndex(computeIntermediateMetrics(problem, timeTrajectory[k + 1], stateTrajectory[k + 1], inputTrajectory[k + 1]));
+      performanceIndex += (0.5 * (timeTrajectory[k + 1] - timeTrajectory[k])) * (lhs + rhs);
+    }
+    return performanceIndex;
+  }
+
+  matrix_t A;
+  matrix_t B;
+  OptimalControlProblem problem;
+  ModeSchedule modeSchedule;
+  TargetTrajectories targetTrajectories;
+  LinearController controller;
+  rollout::Settings settings;
+  matrix_t initStates;
+};
+
+constexpr size_t BatchRolloutTest::nx;
+constexpr size_t BatchRolloutTest::nu;
+constexpr size_t BatchRolloutTest::numTrajectories;
+constexpr scalar_t BatchRolloutTest::initTime;
+constexpr scalar_t BatchRolloutTest::finalTime;
+
+TEST_F(BatchRolloutTest, compareWithSingleRollouts) {
+  BatchRollout batchRollout(problem, settings, 3);
+  matrix_t finalStates;
+  const auto performanceIndices = batchRollout.run(initTime, initStates, finalTime, controller, modeSchedule, &finalStates);
+
+  ASSERT_EQ(performanceIndices.size(), numTrajectories);
+  ASSERT_EQ(finalStates.cols(), numTrajectories);
+  for (size_t i = 0; i < numTrajectories; i++) {
+    vector_t finalState;
+    const auto performanceIndex = singleRollout(initStates.col(i), finalState);
+    EXPECT_TRUE(finalStates.col(i).isApprox(finalState, 1e-9)) << "trajectory " << i;
+    EXPECT_NEAR(performanceIndices[i].cost, performanceIndex.cost, 1e-6 * performanceIndex.cost) << "trajectory " << i;
+  }
+}
+
+TEST_F(BatchRolloutTest, threadInvariance) {
+  BatchRollout singleThreadRollout(problem, settings, 1);
+  BatchRollout multiThreadRollout(problem, settings, 4);
+
+  matrix_t singleThreadFinalStates;
+  matrix_t multiThreadFinalStates;
+  benchmark::RepeatedTimer singleThreadTimer;
+  benchmark::RepeatedTimer multiThreadTimer;
+  std::vector<PerformanceIndex> singleThreadIndices;
+  std::vector<PerformanceIndex> multiThreadIndices;
+  for (int i = 0; i < 10; i++) {
+    singleThreadTimer.startTimer();
+    singleThreadIndices = singleThreadRollout.run(initTime, initStates, finalTime, controller, modeSchedule, &singleThreadFinalStates);
+    singleThreadTimer.endTimer();
+    multiThreadTimer.startTimer();
+    multiThreadIndices = multiThreadRollout.run(initTime, initStates, finalTime, controller, modeSchedule, &multiThreadFinalStates);
+    multiThreadTimer.endTimer();
+  }
+  std::cerr << "[BatchRolloutTest] " << numTrajectories << " trajectories, 1 thread: " << singleThreadTimer.getAverageInMilliseconds()
+            << " [ms], 4 threads: " << multiThreadTimer.getAverageInMilliseconds() << " [ms]\n";
+
+  // the columns of a block do not interact, hence the partition does not change the result
+  EXPECT_TRUE(singleThreadFinalStates.isApprox(multiThreadFinalStates));
+  for (size_t i = 0; i < numTrajectories; i++) {
+    EXPECT_DOUBLE_EQ(singleThreadIndices[i].cost, multiThreadIndices[i].cost);
+  }
+}
+
+TEST_F(BatchRolloutTest, defaultBatchFlowMap) {
+  BatchRollout batchRollout(problem, settings, 2);
+  matrix_t finalStates;
+  const auto performanceIndices = batchRollout.run(initTime, initStates, finalTime, controller, modeSchedule, &finalStates);
+
+  OptimalControlProblem columnwiseProblem(problem);
+  columnwiseProblem.dynamicsPtr.reset(new ColumnwiseLinearSystemDynamics(A, B));
+  BatchRollout columnwiseRollout(columnwiseProblem, settings, 2);
+  matrix_t columnwiseFinalStates;
+  const auto columnwiseIndices = columnwiseRollout.run(initTime, initStates, finalTime, controller, modeSchedule, &columnwiseFinalStates);
+
+  EXPECT_TRUE(columnwiseFinalStates.isApprox(finalStates, 1e-12));
+  for (size_t i = 0; i < numTrajectories; i++) {
+    EXPECT_NEAR(columnwiseIndices[i].cost, performanceIndices[i].cost, 1e-9 * performanceIndices[i].cost) << "trajectory " << i;
+  }
+}
+
+TEST_F(BatchRolloutTest, missingTargetTrajectories) {
+  problem.targetTrajectoriesPtr = nullptr;
+  EXPECT_THROW(BatchRollout(problem, settings, 1), std::runtime_error);
+}
@@ -27,9 +27,9 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
-#include <iostream>
 #include <memory>
 
 #include <gtest/gtest.h>
@@ -37,8 +37,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/LinearController.h>
 #include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_core/test/AllocationCounter.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 
+OCS2_DEFINE_ALLOCATION_COUNTER
+
 using namespace ocs2;
 
 TEST(time_rollout_test, time_rollout_test) {
@@ -85,3 +88,150 @@ TEST(time_rollout_test, time_rollout_test) {
   ASSERT_EQ(totalSize, stateTrajectory.size());
   ASSERT_EQ(totalSize, inputTrajectory.size());
 }
+
+TEST(time_rollout_test, fixed_step_rollout_test) {
+  constexpr size_t nx = 2;
+  constexpr size_t nu = 1;
+  const scalar_t initTime = 0.0;
+  const scalar_t finalTime = 10.0;
+  const vector_t initState = vector_t::Ones(nx);
+
+  ModeSchedule modeSchedule({3.0, 4.0, 4.0}, {0, 1, 2, 3});
+
+  const matrix_t A = (matrix_t(nx, nx) << -2.0, -1.0, 1.0, 0.0).finished();
+  const matrix_t B = (matrix_t(nx, nu) << 1.0, 0.0).finished();
+  LinearSystemDynamics systemDynamics(A, B);
+
+  // time varying feedback controller
+  const scalar_array_t cntTimeStamp{initTime, 5.0, finalTime};
+  const vector_array_t uff{vector_t::Ones(nu), -vector_t::Ones(nu), vector_t::Ones(nu)};
+  const matrix_array_t k{matrix_t::Zero(nu, nx), -matrix_t::Ones(nu, nx), matrix_t::Zero(nu, nx)};
+  LinearController controller(cntTimeStamp, uff, k);
+
+  rollout::Settings adaptiveSettings;
+  adaptiveSettings.absTolODE = 1e-9;
+  adaptiveSettings.relTolODE = 1e-7;
+  adaptiveSettings.timeStep = 1e-3;
+  TimeTriggeredRollout adaptiveRollout(systemDynamics, adaptiveSettings);
+
+  rollout::Settings odeintStepSettings;
+  odeintStepSettings.integratorType = IntegratorType::RK4;
+  odeintStepSettings.timeStep = 1e-3;
+  TimeTriggeredRollout odeintStepRollout(systemDynamics, odeintStepSettings);
+
+  rollout::Settings fixedStepSettings = odeintStepSettings;
+  fixedStepSettings.useFixedStepRollout = true;
+  TimeTriggeredRollout fixedStepRollout(systemDynamics, fixedStepSettings);
+
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  vector_array_t stateTrajectory;
+  vector_array_t inputTrajectory;
+
+  const vector_t adaptiveFinalState = adaptiveRollout.run(initTime, initState, finalTime, &controller, modeSchedule, timeTrajectory,
+                                                          postEventIndices, stateTrajectory, inputTrajectory);
+  const vector_t odeintStepFinalState = odeintStepRollout.run(initTime, initState, finalTime, &controller, modeSchedule, timeTrajectory,
+                                                              postEventIndices, stateTrajectory, inputTrajectory);
+
+  vector_t fixedStepFinalState = fixedStepRollout.run(initTime, initState, finalTime, &controller, modeSchedule, timeTrajectory,
+                                                      postEventIndices, stateTrajectory, inputTrajectory);
+  const scalar_t* stateData = stateTrajectory.back().data();
+  fixedStepFinalState = fixedStepRollout.run(initTime, initState, finalTime, &controller, modeSchedule, timeTrajectory, postEventIndices,
+                                             stateTrajectory, inputTrajectory);
+
+  // sizes: 3 modes of 3000, 1000 and 6000 steps, and a zero length mode
+  constexpr size_t numNodes = 3001 + 1001 + 1 + 6001;
+  ASSERT_EQ(timeTrajectory.size(), numNodes);
+  ASSERT_EQ(stateTrajectory.size(), numNodes);
+  ASSERT_EQ(inputTrajectory.size(), numNodes);
+  ASSERT_EQ(postEventIndices.size(), 3);
+  EXPECT_EQ(postEventIndices[0], 3001);
+  EXPECT_DOUBLE_EQ(timeTrajectory[postEventIndices[0] - 1], 3.0);
+  EXPECT_DOUBLE_EQ(timeTrajectory.back(), finalTime);
+  EXPECT_TRUE(std::is_sorted(timeTrajectory.begin(), timeTrajectory.end()));
+
+  // the memory of the previous rollout is reused
+  EXPECT_EQ(stateTrajectory.back().data(), stateData);
+
+  EXPECT_TRUE(fixedStepFinalState.isApprox(adaptiveFinalState, 1e-6)) << "fixed step: " << fixedStepFinalState.transpose()
+                                                                       << "\nadaptive: " << adaptiveFinalState.transpose();
+  EXPECT_TRUE(fixedStepFinalState.isApprox(odeintStepFinalState, 1e-9)) << "fixed step: " << fixedStepFinalState.transpose()
+                                                                         << "\nodeint: " << odeintStepFinalState.transpose();
+  EXPECT_TRUE(inputTrajectory.back().isApprox(controller.computeInput(finalTime, fixedStepFinalState)));
+}
+
+TEST(time_rollout_test, fixed_step_rollout_allocations) {
+  constexpr size_t nx = 2;
+  constexpr size_t nu = 1;
+  const matrix_t A = (matrix_t(nx, nx) << -2.0, -1.0, 1.0, 0.0).finished();
+  const matrix_t B = (matrix_t(nx, nu) << 1.0, 0.0).finished();
+  LinearSystemDynamics systemDynamics(A, B);
+
+  // time varying feedback controller, such that the gain is interpolated in every stage
+  const scalar_array_t cntTimeStamp{0.0, 2.5, 5.0, 10.0};
+  const vector_array_t uff(4, vector_t::Ones(nu));
+  const matrix_array_t k{matrix_t::Zero(nu, nx), -matrix_t::Ones(nu, nx), matrix_t::Zero(nu, nx), -matrix_t::Ones(nu, nx)};
+  LinearController controller(cntTimeStamp, uff, k);
+
+  rollout::Settings settings;
+  settings.integratorType = IntegratorType::RK4;
+  settings.timeStep = 1e-2;
+  settings.useFixedStepRollout = true;
+  TimeTriggeredRollout rollout(systemDynamics, settings);
+
+  ModeSchedule modeSchedule;
+  const vector_t initState = vector_t::Ones(nx);
+  scalar_array_t timeTrajectory;
+  size_array_t postEventIndices;
+  vector_array_t stateTrajectory;
+  vector_array_t inputTrajectory;
+  const auto countRunAllocations = [&](scalar_t finalTime) {
+    test::ScopedAllocationCounter allocationCounter;
+    rollout.run(0.0, initState, finalTime, &controller, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory, inputTrajectory);
+    return allocationCounter.count();
+  };
+
+  // the first run sizes the trajectories and the workspaces
+  countRunAllocations(10.0);
+
+  // Per run, only the switching times and the time intervals of the modes (findActiveModesTimeInterval) and the returned final state
+  // are allocated. The steps, i.e. the controller and flow map evaluations of all RK4 stages, do not allocate.
+  constexpr size_t numRunAllocations = 4;
+  for (int i = 0; i < 5; i++) {
+    EXPECT_EQ(countRunAllocations(10.0), numRunAllocations);
+  }
+
+  // a shorter horizon only drops the trailing nodes. Note that a longer horizon afterwards has to allocate the nodes again.
+  EXPECT_EQ(countRunAllocations(1.0), numRunAllocations);
+  EXPECT_EQ(timeTrajectory.size(), 101);
+}
+
+TEST(time_rollout_test, fixed_step_rollout_max_num_steps) {
+  constexpr size_t nx = 2;
+  constexpr size_t nu = 1;
+  const matrix_t A = (matrix_t(nx, nx) << -2.0, -1.0, 1.0, 0.0).finished();
+  const matrix_t B = (matrix_t(nx, nu) << 1.0, 0.0).finished();
+  LinearSystemDynamics systemDynamics(A, B);
+  LinearController controller({0.0}, {vector_t::Ones(nu)}, {matrix_t::Zero(nu, nx)});
+
+  rollout::Settings settings;
+  settings.integratorType = IntegratorType::RK4;
+  settings.timeStep = 1e-3;
+  settings.maxNumStepsPerSecond = 100;
+  settings.useFixedStepRollout = true;
+  TimeTriggeredRollout rollout(systemDynamics, settings);
+
+  ModeSchedule modeSchedule;
+  scalar_array_t timeTrajectory{0.0};
+  size_array_t postEventIndices;
+  vector_array_t stateTrajectory{vector_t::Zero(nx)};
+  vector_array_t inputTrajectory{vector_t::Zero(nu)};
+
+  // the step count is checked before the output trajectories are modified
+  EXPECT_THROW(rollout.run(0.0, vector_t::Ones(nx), 1.0, &controller, modeSchedule, timeTrajectory, postEventIndices, stateTrajectory,
+                           inputTrajectory),
+               std::runtime_error);
+  EXPECT_EQ(timeTrajectory.size(), 1);
+  EXPECT_EQ(stateTrajectory.size(), 1);
+  EXPECT_EQ(inputTrajectory.size(), 1);
+}
@@ -0,0 +1,232 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_perceptive/distance_transform/DistanceTransformInterface.h"
+#include "ocs2_perceptive/distance_transform/VoxelDistanceTransform.h"
+
+namespace ocs2 {
+
+/**
+ * Euclidean signed distance field on a voxel grid which is updated incrementally as the occupancy of individual voxels changes.
+ *
+ * The distances are maintained with the dynamic brushfire algorithm of Lau et al., "Improved updating of Euclidean distance
+ * maps and Voronoi diagrams", IROS 2010. Each voxel keeps its closest site, i.e. the closest occupied voxel for the distance in
+ * free space and the closest free voxel for the distance inside the obstacles. When the occupancy of some voxels changes, a
+ * raise wave clears the voxels whose site disappeared and a lower wave propagates the new sites, both restricted to the voxels
+ * whose site changes. The resulting distances are exact up to rare quasi-Euclidean errors of the 26-neighbour propagation.
+ *
+ * The cost of the waves grows with the number of changed voxels, while a full pass does not. Hence, if more voxels change
+ * than the given threshold, update() recomputes the distance maps with the separable transform of VoxelDistanceTransform (which
+ * additionally keeps the closest sites) and rewrites the whole back field.
+ *
+ * The field is double buffered: the queries are answered from the active field (the same representation as
+ * VoxelDistanceTransform) while update() writes the changed voxels into the back field. The back field becomes active in
+ * swapBuffers(), which the solver calls at a point where it does not query the field, e.g. in
+ * SolverSynchronizedModule::preSolverRun(). This mirrors the BufferedValue pattern without copying the whole field on each
+ * update.
+ *
+ * Thread safety: setOccupancy() and update() are called from the map thread. swapBuffers() and the queries are called from the
+ * solver thread. The queries may run in parallel with each other but not with swapBuffers().
+ */
+class IncrementalVoxelDistanceTransform : public DistanceTransformInterface {
+ public:
+  using size3_t = VoxelDistanceTransform::size3_t;
+
+  /**
+   * Constructor. All voxels are initially free.
+   *
+   * @param [in] origin: The position of the center of the voxel (0, 0, 0).
+   * @param [in] resolution: The edge length of the voxels.
+   * @param [in] size: The number of voxels along x, y and z. Each should be at least 2 and at most 32767.
+   * @param [in] fullUpdateThreshold: The number of occupancy changes above which update() recomputes the whole field. The
+   *                                  default is about the break-even point of a 64x64x32 grid, see the updateLatency test.
+   */
+  IncrementalVoxelDistanceTransform(const vector3_t& origin, scalar_t resolution, const size3_t& size, size_t fullUpdateThreshold = 500);
+
+  ~IncrementalVoxelDistanceTransform() override = default;
+
+  /**
+   * Recomputes the field from scratch and writes it into both buffers. Discards the pending occupancy changes. This should not
+   * run in parallel with the queries.
+   *
+   * @param [in] occupancy: The occupancy of the voxels with the layout of VoxelDistanceTransform::update().
+   */
+  void reset(const std::vector<bool>& occupancy);
+
+  /** Sets the occupancy of voxel (ix, iy, iz). The change takes effect in the next update(). */
+  void setOccupancy(size_t ix, size_t iy, size_t iz, bool occupied);
+
+  /**
+   * Propagates the pending occupancy changes and writes the changed voxels into the back field, or recomputes the whole back
+   * field if there are more changes than the full update threshold. The active field is not modified.
+   *
+   * @return The number of voxels whose distance is recomputed.
+   */
+  size_t update();
+
+  /**
+   * Makes the back field active if update() has been called since the last swap. It does not wait for a running update().
+   *
+   * @return true if the buffers are swapped.
+   */
+  bool swapBuffers();
+
+  scalar_t getValue(const vector3_t& p) const override { return fields_[activeIndex_]->getValue(p); }
+  vector3_t getProjectedPoint(const vector3_t& p) const override { return fields_[activeIndex_]->getProjectedPoint(p); }
+  std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t& p) const override {
+    return fields_[activeIndex_]->getLinearApproximation(p);
+  }
+  void getValues(const std::vector<vector3_t>& points, scalar_array_t& values) const override {
+    fields_[activeIndex_]->getValues(points, values);
+  }
+  void getLinearApproximations(const std::vector<vector3_t>& points, scalar_array_t& values,
+                               std::vector<vector3_t>& gradients) const override {
+    fields_[activeIndex_]->getLinearApproximations(points, values, gradients);
+  }
+
+  /** Gets the active field. */
+  const VoxelDistanceTransform& getActiveField() const { return *fields_[activeIndex_]; }
+
+  /** Gets the occupancy of voxel (ix, iy, iz) including the pending changes. */
+  bool getOccupancy(size_t ix, size_t iy, size_t iz) const { return occupancy_[linearIndex(ix, iy, iz)]; }
+
+  const size3_t& getSize() const { return size_; }
+
+ private:
+  /**
+   * The squared distance (in voxels) of each voxel to its closest site. The sites are the occupied voxels for the distance
+   * outside the obstacles and the free voxels for the distance inside.
+   */
+  class DynamicDistanceMap {
+   public:
+    DynamicDistanceMap(const size3_t& size);
+
+    /** Removes all sites. */
+    void clear();
+
+    /** Discards the pending changes and recomputes the map from scratch. The sites are the voxels whose occupancy equals target. */
+    void rebuild(const std::vector<bool>& occupancy, bool target);
+
+    /** Makes the voxel a site. The change takes effect in propagate(). */
+    void setSite(int index);
+
+    /** Removes the site at the voxel. The change takes effect in propagate(). */
+    void removeSite(int index);
+
+    /** Runs the raise and lower waves of the pending changes. Appends the voxels whose distance changed to dirtyIndices. */
+    void propagate(std::vector<bool>& dirtyMask, std::vector<int>& dirtyIndices);
+
+    /** Gets the squared distance of the voxel to its closest site. */
+    int getSquaredDistance(int index) const { return cells_[index].squaredDistance; }
+
+    /** Whether the voxel is a site. */
+    bool isSite(int index) const { return cells_[index].site == index; }
+
+   private:
+    enum class QueueState : uint8_t { None, Queued, Raised, Lowered };
+
+    using coordinates_t = std::array<int16_t, 3>;
+
+    struct Cell {
+      int site;
+      int squaredDistance;
+      coordinates_t siteCoordinates;
+      QueueState queueState;
+      bool needsRaise;
+    };
+
+    coordinates_t getCoordinates(int index) const;
+
+    /** Calls callback(neighborIndex, neighborCoordinates) for the 26 neighbours of the voxel inside the grid. */
+    template <typename Callback>
+    void forEachNeighbor(int index, Callback&& callback) const;
+
+    void markDirty(int index, std::vector<bool>& dirtyMask, std::vector<int>& dirtyIndices) const;
+
+    using queue_entry_t = std::pair<int, int>;  // (squared distance, index)
+
+    size3_t size_;
+    int maxSquaredDistance_;
+    std::vector<Cell> cells_;
+    std::vector<int> addedSites_;
+    std::vector<int> removedSites_;
+    std::priority_queue<queue_entry_t, std::vector<queue_entry_t>, std::greater<queue_entry_t>> openQueue_;
+
+    // workspace of rebuild()
+    std::vector<float> lineValues_;
+    std::vector<int> lineSites_;
+    std::vector<size_t> vBuffer_;
+    std::vector<float> zBuffer_;
+  };
+
+  int linearIndex(size_t ix, size_t iy, size_t iz) const { return static_cast<int>(ix + size_[0] * (iy + size_[1] * iz)); }
+
+  /** Writes the signed distance of the voxel into the field. */
+  void writeVoxel(int index, VoxelDistanceTransform& field) const;
+
+  /** Writes the signed distances of all voxels into the field. */
+  void writeAllVoxels(VoxelDistanceTransform& field) const;
+
+  size3_t size_;
+  scalar_t resolution_;
+  size_t fullUpdateThreshold_;
+  std::vector<bool> occupancy_;
+  std::vector<int> pendingChanges_;
+  DynamicDistanceMap outsideMap_;
+  DynamicDistanceMap insideMap_;
+
+  // workspace of update()
+  std::vector<bool> dirtyMask_;
+  std::vector<int> dirtyIndices_;
+
+  std::array<std::unique_ptr<VoxelDistanceTransform>, 2> fields_;
+  // the voxels of each field which are older than the distance maps
+  std::array<std::vector<bool>, 2> staleMasks_;
+  std::array<std::vector<int>, 2> staleIndices_;
+  // whether all voxels of the field are older than the distance maps, after the other field is fully updated
+  std::array<bool, 2> isFieldStale_{{false, false}};
+
+  std::mutex backFieldMutex_;
+  size_t activeIndex_ = 0;
+  bool isBackFieldUpdated_ = false;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,163 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_perceptive/distance_transform/DistanceTransformInterface.h"
+
+namespace ocs2 {
+
+/**
+ * Euclidean signed distance field on a regular voxel grid. The field is positive in free space, negative inside obstacles, and it
+ * is interpolated tri-linearly between the voxel centers. Queries outside of the grid are clamped to its boundary.
+ *
+ * The voxel values are stored as floats in tiles of 8x8x8 voxels. Inside a tile, the voxels are in Morton (Z-order), such that
+ * each aligned 2x2x2 block of voxels occupies 32 contiguous bytes. The 8 corners of an interpolation cell therefore lie in the
+ * same 2 KB tile except at the tile borders, and in one or two cache lines when the cell starts at even indices.
+ *
+ * The field is computed from an occupancy grid with the separable Felzenszwalb transform (see computeDistanceTransform()),
+ * applied along x, y and z. The lines of each pass are distributed over a thread pool.
+ *
+ * The batched queries process the points in blocks: the corner values of the cells are gathered into a structure-of-arrays
+ * buffer, and the interpolation then runs as a SIMD loop over the points of the block.
+ */
+class VoxelDistanceTransform : public DistanceTransformInterface {
+ public:
+  using size3_t = std::array<size_t, 3>;
+
+  /** Edge length of a tile in voxels */
+  static constexpr size_t tileSize = 8;
+
+  /**
+   * Constructor. The field is initialized to zero.
+   *
+   * @param [in] origin: The position of the center of the voxel (0, 0, 0).
+   * @param [in] resolution: The edge length of the voxels.
+   * @param [in] size: The number of voxels along x, y and z. Each should be at least 2.
+   * @param [in] nThreads: The number of threads used for computing the field including the calling thread.
+   * @param [in] threadPriority: The priority of the worker threads.
+   */
+  VoxelDistanceTransform(const vector3_t& origin, scalar_t resolution, const size3_t& size, size_t nThreads = 1, int threadPriority = 0);
+
+  ~VoxelDistanceTransform() override = default;
+
+  /**
+   * Computes the field from an occupancy grid.
+   *
+   * @param [in] occupancy: The occupancy of the voxels with x being the fastest changing index, i.e. the voxel (ix, iy, iz) is at
+   *                        index ix + size[0] * (iy + size[1] * iz).
+   */
+  void update(const std::vector<bool>& occupancy);
+
+  scalar_t getValue(const vector3_t& p) const override;
+  vector3_t getProjectedPoint(const vector3_t& p) const override;
+  std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t& p) const override;
+  void getValues(const std::vector<vector3_t>& points, scalar_array_t& values) const override;
+  void getLinearApproximations(const std::vector<vector3_t>& points, scalar_array_t& values,
+                               std::vector<vector3_t>& gradients) const override;
+
+  /** Gets the signed distance at the center of voxel (ix, iy, iz). */
+  float getVoxelValue(size_t ix, size_t iy, size_t iz) const { return data_[voxelIndex(ix, iy, iz)]; }
+
+  /** Sets the signed distance at the center of voxel (ix, iy, iz), e.g. for updating a part of the field. */
+  void setVoxelValue(size_t ix, size_t iy, size_t iz, float value) { data_[voxelIndex(ix, iy, iz)] = value; }
+
+  /** Gets the position of the center of voxel (ix, iy, iz). */
+  vector3_t getVoxelPosition(size_t ix, size_t iy, size_t iz) const {
+    return origin_ + resolution_ * vector3_t(static_cast<scalar_t>(ix), static_cast<scalar_t>(iy), static_cast<scalar_t>(iz));
+  }
+
+  const vector3_t& getOrigin() const { return origin_; }
+  scalar_t getResolution() const { return resolution_; }
+  const size3_t& getSize() const { return size_; }
+
+ private:
+  /** Index of voxel (ix, iy, iz) in data_. */
+  size_t voxelIndex(size_t ix, size_t iy, size_t iz) const {
+    const size_t tileIndex = (ix / tileSize) + numTiles_[0] * ((iy / tileSize) + numTiles_[1] * (iz / tileSize));
+    return tileIndex * tileVolume_ + mortonIndex(ix % tileSize, iy % tileSize, iz % tileSize);
+  }
+
+  /** Morton index of a voxel inside a tile. */
+  static size_t mortonIndex(size_t x, size_t y, size_t z) { return spreadBits_[x] | (spreadBits_[y] << 1) | (spreadBits_[z] << 2); }
+
+  /** Finds the interpolation cell of the point clamped to the grid. Returns the clamped point. */
+  vector3_t findCell(const vector3_t& p, std::array<size_t, 3>& cornerIndex, vector3_t& cornerPosition) const;
+
+  /** Gets the values at the 8 corners of the cell in the order of trilinear_interpolation. */
+  std::array<scalar_t, 8> getCornerValues(const std::array<size_t, 3>& cornerIndex) const;
+
+  /** Number of points processed together by the batched queries */
+  static constexpr size_t queryBlockSize_ = 16;
+
+  /** The interpolation cells of a block of points in structure-of-arrays layout */
+  struct QueryBlock {
+    std::array<std::array<scalar_t, queryBlockSize_>, 8> cornerValues;
+    std::array<std::array<scalar_t, queryBlockSize_>, 3> offsets;  // the point inside the cell in units of the resolution
+  };
+
+  /** Gathers the interpolation cells of the points [start, start + numPoints) into the block. */
+  void gatherQueryBlock(const std::vector<vector3_t>& points, size_t start, size_t numPoints, QueryBlock& block) const;
+
+  /** Computes the squared distance (in voxels) of every voxel to the closest voxel whose occupancy equals target. */
+  void computeSquaredDistances(const std::vector<bool>& occupancy, bool target, std::vector<float>& squaredDistances);
+
+  /** Runs the 1D transform on all lines along the given axis. */
+  void transformLines(size_t axis, std::vector<float>& squaredDistances);
+
+  static constexpr size_t tileVolume_ = tileSize * tileSize * tileSize;
+  /** Bits of a 3-bit index spread to every third bit */
+  static constexpr std::array<size_t, tileSize> spreadBits_{{0, 1, 8, 9, 64, 65, 72, 73}};
+
+  vector3_t origin_;
+  scalar_t resolution_;
+  size3_t size_;
+  size3_t numTiles_;
+  std::vector<float> data_;
+
+  // workspace of update()
+  std::vector<float> outsideSquaredDistances_;
+  std::vector<float> insideSquaredDistances_;
+  struct LineBuffer {
+    std::vector<float> values;
+    std::vector<size_t> vBuffer;
+    std::vector<float> zBuffer;
+  };
+  std::vector<LineBuffer> lineBuffers_;
+  ThreadPool threadPool_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,430 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_perceptive/distance_transform/IncrementalVoxelDistanceTransform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ocs2_perceptive/distance_transform/ComputeDistanceTransform.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+IncrementalVoxelDistanceTransform::DynamicDistanceMap::DynamicDistanceMap(const size3_t& size)
+    : size_(size),
+      maxSquaredDistance_(static_cast<int>(size[0] * size[0] + size[1] * size[1] + size[2] * size[2] + 1)),
+      cells_(size[0] * size[1] * size[2]) {
+  clear();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalVoxelDistanceTransform::DynamicDistanceMap::clear() {
+  std::fill(cells_.begin(), cells_.end(), Cell{-1, maxSquaredDistance_, coordinates_t{{0, 0, 0}}, QueueState::None, false});
+  addedSites_.clear();
+  removedSites_.clear();
+  openQueue_ = decltype(openQueue_)();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalVoxelDistanceTransform::DynamicDistanceMap::rebuild(const std::vector<bool>& occupancy, bool target) {
+  clear();
+  const int numVoxels = static_cast<int>(cells_.size());
+  for (int i = 0; i < numVoxels; i++) {
+    if (occupancy[i] == target) {
+      cells_[i].site = i;
+      cells_[i].squaredDistance = 0;
+    }
+  }
+
+  // the separable transform of VoxelDistanceTransform, where each voxel additionally takes over the site of its image
+  const int sx = static_cast<int>(size_[0]);
+  const int sy = static_cast<int>(size_[1]);
+  for (size_t axis = 0; axis < 3; axis++) {
+    const int lineLength = static_cast<int>(size_[axis]);
+    const int numLines = numVoxels / lineLength;
+    const int stride = (axis == 0) ? 1 : (axis == 1) ? sx : sx * sy;
+    lineValues_.resize(lineLength);
+    lineSites_.resize(lineLength);
+
+    for (int l = 0; l < numLines; l++) {
+      const int lineStart = (axis == 0) ? l * sx : (axis == 1) ? (l % sx) + sx * sy * (l / sx) : l;
+      for (int q = 0; q < lineLength; q++) {
+        const Cell& cell = cells_[lineStart + q * stride];
+        lineValues_[q] = static_cast<float>(cell.squaredDistance);
+        lineSites_[q] = cell.site;
+      }
+      // the squared distance of the voxels without a site stays at maxSquaredDistance_
+      computeDistanceTransform(
+          lineLength, [&](size_t q) { return lineValues_[q]; },
+          [&](size_t q, float value) {
+            cells_[lineStart + q * stride].squaredDistance = std::min(static_cast<int>(value), maxSquaredDistance_);
+          },
+          [&](size_t q, size_t image) { cells_[lineStart + q * stride].site = lineSites_[image]; }, 0, lineLength, vBuffer_, zBuffer_);
+    }
+  }
+
+  for (auto& cell : cells_) {
+    if (cell.site >= 0) {
+      cell.siteCoordinates = getCoordinates(cell.site);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalVoxelDistanceTransform::DynamicDistanceMap::setSite(int index) {
+  if (!isSite(index)) {
+    cells_[index].site = index;
+    cells_[index].siteCoordinates = getCoordinates(index);
+    addedSites_.push_back(index);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalVoxelDistanceTransform::DynamicDistanceMap::removeSite(int index) {
+  if (isSite(index)) {
+    cells_[index].site = -1;
+    removedSites_.push_back(index);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalVoxelDistanceTransform::DynamicDistanceMap::propagate(std::vector<bool>& dirtyMask, std::vector<int>& dirtyIndices) {
+  // seed the lower waves at the new sites
+  for (const int index : addedSites_) {
+    Cell& cell = cells_[index];
+    if (isSite(index) && cell.queueState != QueueState::Queued) {
+      cell.squaredDistance = 0;
+      cell.queueState = QueueState::Queued;
+      openQueue_.emplace(0, index);
+      markDirty(index, dirtyMask, dirtyIndices);
+    }
+  }
+  addedSites_.clear();
+
+  // seed the raise waves at the removed sites
+  for (const int index : removedSites_) {
+    Cell& cell = cells_[index];
+    if (!isSite(index)) {  // it might have been set again
+      cell.squaredDistance = maxSquaredDistance_;
+      cell.needsRaise = true;
+      cell.queueState = QueueState::Queued;
+      openQueue_.emplace(0, index);
+      markDirty(index, dirtyMask, dirtyIndices);
+    }
+  }
+  removedSites_.clear();
+
+  while (!openQueue_.empty()) {
+    const int index = openQueue_.top().second;
+    openQueue_.pop();
+
+    Cell& cell = cells_[index];
+    if (cell.queueState == QueueState::Lowered) {
+      continue;  // outdated entry
+    }
+
+    if (cell.needsRaise) {
+      // clear the neighbours whose site is removed and queue the valid neighbours to fill the cleared region
+      forEachNeighbor(index, [&](int neighborIndex, const coordinates_t&) {
+        Cell& neighbor = cells_[neighborIndex];
+        if (neighbor.site < 0 || neighbor.needsRaise) {
+          return;
+        }
+        if (!isSite(neighbor.site)) {
+          openQueue_.emplace(neighbor.squaredDistance, neighborIndex);
+          neighbor.site = -1;
+          neighbor.squaredDistance = maxSquaredDistance_;
+          neighbor.needsRaise = true;
+          neighbor.queueState = QueueState::Queued;
+          markDirty(neighborIndex, dirtyMask, dirtyIndices);
+        } else if (neighbor.queueState != QueueState::Queued) {
+          openQueue_.emplace(neighbor.squaredDistance, neighborIndex);
+          neighbor.queueState = QueueState::Queued;
+        }
+      });
+      cell.needsRaise = false;
+      cell.queueState = QueueState::Raised;
+
+    } else if (cell.site >= 0 && isSite(cell.site)) {
+      // offer the site of this voxel to the neighbours
+      cell.queueState = QueueState::Lowered;
+      forEachNeighbor(index, [&](int neighborIndex, const coordinates_t& neighborCoordinates) {
+        Cell& neighbor = cells_[neighborIndex];
+        if (neighbor.needsRaise) {
+          return;
+        }
+        const int dx = neighborCoordinates[0] - cell.siteCoordinates[0];
+        const int dy = neighborCoordinates[1] - cell.siteCoordinates[1];
+        const int dz = neighborCoordinates[2] - cell.siteCoordinates[2];
+        const int newSquaredDistance = dx * dx + dy * dy + dz * dz;
+        bool overwrite = newSquaredDistance < neighbor.squaredDistance;
+        if (!overwrite && newSquaredDistance == neighbor.squaredDistance) {
+          overwrite = neighbor.site < 0 || !isSite(neighbor.site);
+        }
+        if (overwrite) {
+          openQueue_.emplace(newSquaredDistance, neighborIndex);
+          neighbor.site = cell.site;
+          neighbor.siteCoordinates = cell.siteCoordinates;
+          neighbor.squaredDistance = newSquaredDistance;
+          neighbor.queueState = QueueState::Queued;
+          markDirty(neighborIndex, dirtyMask, dirtyIndices);
+        }
+      });
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto IncrementalVoxelDistanceTransform::DynamicDistanceMap::getCoordinates(int index) const -> coordinates_t {
+  const int sx = static_cast<int>(size_[0]);
+  const int sy = static_cast<int>(size_[1]);
+  return {{static_cast<int16_t>(index % sx), static_cast<int16_t>((index / sx) % sy), static_cast<int16_t>(index / (sx * sy))}};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Callback>
+void IncrementalVoxelDistanceTransform::DynamicDistanceMap::forEachNeighbor(int index, Callback&& callback) const {
+  const int sx = static_cast<int>(size_[0]);
+  const int sy = static_cast<int>(size_[1]);
+  const int sz = static_cast<int>(size_[2]);
+  const coordinates_t coordinates = getCoordinates(index);
+
+  coordinates_t neighborCoordinates;
+  for (int dz = -1; dz <= 1; dz++) {
+    neighborCoordinates[2] = static_cast<int16_t>(coordinates[2] + dz);
+    if (neighborCoordinates[2] < 0 || neighborCoordinates[2] >= sz) {
+      continue;
+    }
+    for (int dy = -1; dy <= 1; dy++) {
+      neighborCoordinates[1] = static_cast<int16_t>(coordinates[1] + dy);
+      if (neighborCoordinates[1] < 0 || neighborCoordinates[1] >= sy) {
+        continue;
+      }
+      for (int dx = -1; dx <= 1; dx++) {
+        neighborCoordinates[0] = static_cast<int16_t>(coordinates[0] + dx);
+        if (neighborCoordinates[0] < 0 || neighborCoordinates[0] >= sx || (dx == 0 && dy == 0 && dz == 0)) {
+          continue;
+        }
+        callback(index + dx + sx * (dy + sy * dz), neighborCoordinates);
+      }
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalVoxelDistanceTransform::DynamicDistanceMap::markDirty(int index, std::vector<bool>& dirtyMask,
+                                                                      std::vector<int>& dirtyIndices) const {
+  if (!dirtyMask[index]) {
+    dirtyMask[index] = true;
+    dirtyIndices.push_back(index);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+IncrementalVoxelDistanceTransform::IncrementalVoxelDistanceTransform(const vector3_t& origin, scalar_t resolution, const size3_t& size,
+                                                                     size_t fullUpdateThreshold)
+    : size_(size),
+      resolution_(resolution),
+      fullUpdateThreshold_(fullUpdateThreshold),
+      occupancy_(size[0] * size[1] * size[2], false),
+      outsideMap_(size),
+      insideMap_(size),
+      dirtyMask_(occupancy_.size(), false),
+      staleMasks_{{dirtyMask_, dirtyMask_}} {
+  if (size_[0] > std::numeric_limits<int16_t>::max() || size_[1] > std::numeric_limits<int16_t>::max() ||
+      size_[2] > std::numeric_limits<int16_t>::max()) {
+    throw std::runtime_error("[IncrementalVoxelDistanceTransform] The grid should have at most 32767 voxels along each axis!");
+  }
+  fields_[0] = std::make_unique<VoxelDistanceTransform>(origin, resolution, size);
+  fields_[1] = std::make_unique<VoxelDistanceTransform>(origin, resolution, size);
+  reset(occupancy_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalVoxelDistanceTransform::reset(const std::vector<bool>& occupancy) {
+  if (occupancy.size() != occupancy_.size()) {
+    throw std::runtime_error("[IncrementalVoxelDistanceTransform::reset] The size of the occupancy grid does not match the grid size!");
+  }
+
+  occupancy_ = occupancy;
+  pendingChanges_.clear();
+  outsideMap_.rebuild(occupancy_, true);
+  insideMap_.rebuild(occupancy_, false);
+
+  std::lock_guard<std::mutex> lock(backFieldMutex_);
+  for (size_t k = 0; k < fields_.size(); k++) {
+    writeAllVoxels(*fields_[k]);
+    std::fill(staleMasks_[k].begin(), staleMasks_[k].end(), false);
+    staleIndices_[k].clear();
+    isFieldStale_[k] = false;
+  }
+  isBackFieldUpdated_ = false;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalVoxelDistanceTransform::setOccupancy(size_t ix, size_t iy, size_t iz, bool occupied) {
+  const int index = linearIndex(ix, iy, iz);
+  if (occupancy_[index] != occupied) {
+    occupancy_[index] = occupied;
+    pendingChanges_.push_back(index);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t IncrementalVoxelDistanceTransform::update() {
+  if (pendingChanges_.size() > fullUpdateThreshold_) {
+    pendingChanges_.clear();
+    outsideMap_.rebuild(occupancy_, true);
+    insideMap_.rebuild(occupancy_, false);
+
+    std::lock_guard<std::mutex> lock(backFieldMutex_);
+    const size_t backIndex = 1 - activeIndex_;
+    writeAllVoxels(*fields_[backIndex]);
+    for (size_t k = 0; k < fields_.size(); k++) {
+      std::fill(staleMasks_[k].begin(), staleMasks_[k].end(), false);
+      staleIndices_[k].clear();
+    }
+    isFieldStale_[backIndex] = false;
+    isFieldStale_[activeIndex_] = true;
+
+    isBackFieldUpdated_ = true;
+    return occupancy_.size();
+  }
+
+  for (const int index : pendingChanges_) {
+    if (occupancy_[index]) {
+      outsideMap_.setSite(index);
+      insideMap_.removeSite(index);
+    } else {
+      outsideMap_.removeSite(index);
+      insideMap_.setSite(index);
+    }
+  }
+  pendingChanges_.clear();
+  outsideMap_.propagate(dirtyMask_, dirtyIndices_);
+  insideMap_.propagate(dirtyMask_, dirtyIndices_);
+
+  std::lock_guard<std::mutex> lock(backFieldMutex_);
+  const size_t backIndex = 1 - activeIndex_;
+  auto& backField = *fields_[backIndex];
+
+  // catch up with the updates which went into the other field since the last swap
+  if (isFieldStale_[backIndex]) {
+    writeAllVoxels(backField);
+    isFieldStale_[backIndex] = false;
+  } else {
+    for (const int index : staleIndices_[backIndex]) {
+      staleMasks_[backIndex][index] = false;
+      writeVoxel(index, backField);
+    }
+    staleIndices_[backIndex].clear();
+  }
+
+  auto& activeStaleMask = staleMasks_[activeIndex_];
+  for (const int index : dirtyIndices_) {
+    dirtyMask_[index] = false;
+    writeVoxel(index, backField);
+    if (!isFieldStale_[activeIndex_] && !activeStaleMask[index]) {
+      activeStaleMask[index] = true;
+      staleIndices_[activeIndex_].push_back(index);
+    }
+  }
+  const size_t numDirtyVoxels = dirtyIndices_.size();
+  dirtyIndices_.clear();
+
+  isBackFieldUpdated_ = true;
+  return numDirtyVoxels;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool IncrementalVoxelDistanceTransform::swapBuffers() {
+  std::unique_lock<std::mutex> lock(backFieldMutex_, std::try_to_lock);
+  if (!lock.owns_lock() || !isBackFieldUpdated_) {
+    return false;
+  }
+  activeIndex_ = 1 - activeIndex_;
+  isBackFieldUpdated_ = false;
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalVoxelDistanceTransform::writeVoxel(int index, VoxelDistanceTransform& field) const {
+  const size_t i = static_cast<size_t>(index);
+  const size_t ix = i % size_[0];
+  const size_t iy = (i / size_[0]) % size_[1];
+  const size_t iz = i / (size_[0] * size_[1]);
+  const auto resolution = static_cast<float>(resolution_);
+  const float value = occupancy_[i] ? -resolution * std::sqrt(static_cast<float>(insideMap_.getSquaredDistance(index)))
+                                    : resolution * std::sqrt(static_cast<float>(outsideMap_.getSquaredDistance(index)));
+  field.setVoxelValue(ix, iy, iz, value);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void IncrementalVoxelDistanceTransform::writeAllVoxels(VoxelDistanceTransform& field) const {
+  const int numVoxels = static_cast<int>(occupancy_.size());
+  for (int i = 0; i < numVoxels; i++) {
+    writeVoxel(i, field);
+  }
+}
+
+}  // namespace ocs2
@@ -0,0 +1,343 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_perceptive/distance_transform/VoxelDistanceTransform.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include <ocs2_core/NumericTraits.h>
+
+#include "ocs2_perceptive/distance_transform/ComputeDistanceTransform.h"
+#include "ocs2_perceptive/interpolation/TrilinearInterpolation.h"
+
+namespace ocs2 {
+
+constexpr size_t VoxelDistanceTransform::tileSize;
+constexpr size_t VoxelDistanceTransform::tileVolume_;
+constexpr std::array<size_t, VoxelDistanceTransform::tileSize> VoxelDistanceTransform::spreadBits_;
+constexpr size_t VoxelDistanceTransform::queryBlockSize_;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VoxelDistanceTransform::VoxelDistanceTransform(const vector3_t& origin, scalar_t resolution, const size3_t& size, size_t nThreads,
+                                               int threadPriority)
+    : origin_(origin),
+      resolution_(resolution),
+      size_(size),
+      lineBuffers_(std::max(nThreads, size_t(1))),
+      threadPool_(lineBuffers_.size() - 1, threadPriority) {
+  if (resolution_ <= 0.0) {
+    throw std::runtime_error("[VoxelDistanceTransform] The resolution should be positive!");
+  }
+  if (size_[0] < 2 || size_[1] < 2 || size_[2] < 2) {
+    throw std::runtime_error("[VoxelDistanceTransform] The grid should have at least 2 voxels along each axis!");
+  }
+
+  for (size_t i = 0; i < 3; i++) {
+    numTiles_[i] = (size_[i] + tileSize - 1) / tileSize;
+  }
+  data_.assign(numTiles_[0] * numTiles_[1] * numTiles_[2] * tileVolume_, 0.0f);
+
+  const size_t maxLineLength = std::max({size_[0], size_[1], size_[2]});
+  for (auto& buffer : lineBuffers_) {
+    buffer.values.resize(maxLineLength);
+    buffer.vBuffer.resize(maxLineLength);
+    buffer.zBuffer.resize(maxLineLength + 1);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VoxelDistanceTransform::update(const std::vector<bool>& occupancy) {
+  const size_t numVoxels = size_[0] * size_[1] * size_[2];
+  if (occupancy.size() != numVoxels) {
+    throw std::runtime_error("[VoxelDistanceTransform::update] The size of the occupancy grid does not match the grid size!");
+  }
+
+  computeSquaredDistances(occupancy, true, outsideSquaredDistances_);  // free voxels to the closest occupied voxel
+  computeSquaredDistances(occupancy, false, insideSquaredDistances_);  // occupied voxels to the closest free voxel
+
+  // write the signed distances into the tiles, one xy-slice at a time
+  const auto resolution = static_cast<float>(resolution_);
+  std::atomic_size_t sliceIndex{0};
+  threadPool_.runParallel(
+      [&](int) {
+        size_t iz = sliceIndex++;
+        while (iz < size_[2]) {
+          for (size_t iy = 0; iy < size_[1]; iy++) {
+            size_t i = size_[0] * (iy + size_[1] * iz);
+            for (size_t ix = 0; ix < size_[0]; ix++, i++) {
+              data_[voxelIndex(ix, iy, iz)] =
+                  occupancy[i] ? -resolution * std::sqrt(insideSquaredDistances_[i]) : resolution * std::sqrt(outsideSquaredDistances_[i]);
+            }
+          }
+          iz = sliceIndex++;
+        }
+      },
+      lineBuffers_.size());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t VoxelDistanceTransform::getValue(const vector3_t& p) const {
+  std::array<size_t, 3> cornerIndex;
+  vector3_t cornerPosition;
+  const vector3_t clampedPoint = findCell(p, cornerIndex, cornerPosition);
+  return trilinear_interpolation::getValue(resolution_, cornerPosition, getCornerValues(cornerIndex), clampedPoint);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VoxelDistanceTransform::vector3_t VoxelDistanceTransform::getProjectedPoint(const vector3_t& p) const {
+  const auto valueGradient = getLinearApproximation(p);
+  const scalar_t gradientNorm = valueGradient.second.norm();
+  if (gradientNorm < numeric_traits::weakEpsilon<scalar_t>()) {
+    return p;
+  }
+  return p - (valueGradient.first / gradientNorm) * valueGradient.second;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::pair<scalar_t, VoxelDistanceTransform::vector3_t> VoxelDistanceTransform::getLinearApproximation(const vector3_t& p) const {
+  std::array<size_t, 3> cornerIndex;
+  vector3_t cornerPosition;
+  const vector3_t clampedPoint = findCell(p, cornerIndex, cornerPosition);
+  return trilinear_interpolation::getLinearApproximation(resolution_, cornerPosition, getCornerValues(cornerIndex), clampedPoint);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VoxelDistanceTransform::getValues(const std::vector<vector3_t>& points, scalar_array_t& values) const {
+  values.resize(points.size());
+
+  QueryBlock block;
+  for (size_t start = 0; start < points.size(); start += queryBlockSize_) {
+    const size_t numPoints = std::min(queryBlockSize_, points.size() - start);
+    gatherQueryBlock(points, start, numPoints, block);
+
+    const auto& c = block.cornerValues;
+    const auto& x = block.offsets[0];
+    const auto& y = block.offsets[1];
+    const auto& z = block.offsets[2];
+    scalar_t* blockValues = values.data() + start;
+#pragma omp simd
+    for (size_t k = 0; k < numPoints; k++) {
+      const scalar_t f00 = (1.0 - x[k]) * c[0][k] + x[k] * c[1][k];
+      const scalar_t f10 = (1.0 - x[k]) * c[2][k] + x[k] * c[3][k];
+      const scalar_t f01 = (1.0 - x[k]) * c[4][k] + x[k] * c[5][k];
+      const scalar_t f11 = (1.0 - x[k]) * c[6][k] + x[k] * c[7][k];
+      blockValues[k] = (1.0 - z[k]) * ((1.0 - y[k]) * f00 + y[k] * f10) + z[k] * ((1.0 - y[k]) * f01 + y[k] * f11);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VoxelDistanceTransform::getLinearApproximations(const std::vector<vector3_t>& points, scalar_array_t& values,
+                                                     std::vector<vector3_t>& gradients) const {
+  values.resize(points.size());
+  gradients.resize(points.size());
+
+  const scalar_t resolutionInv = 1.0 / resolution_;
+  QueryBlock block;
+  std::array<std::array<scalar_t, queryBlockSize_>, 3> blockGradients;
+  for (size_t start = 0; start < points.size(); start += queryBlockSize_) {
+    const size_t numPoints = std::min(queryBlockSize_, points.size() - start);
+    gatherQueryBlock(points, start, numPoints, block);
+
+    // the same expressions as trilinear_interpolation::getLinearApproximation()
+    const auto& c = block.cornerValues;
+    const auto& x = block.offsets[0];
+    const auto& y = block.offsets[1];
+    const auto& z = block.offsets[2];
+    scalar_t* blockValues = values.data() + start;
+#pragma omp simd
+    for (size_t k = 0; k < numPoints; k++) {
+      const scalar_t f00 = (1.0 - x[k]) * c[0][k] + x[k] * c[1][k];
+      const scalar_t f10 = (1.0 - x[k]) * c[2][k] + x[k] * c[3][k];
+      const scalar_t f01 = (1.0 - x[k]) * c[4][k] + x[k] * c[5][k];
+      const scalar_t f11 = (1.0 - x[k]) * c[6][k] + x[k] * c[7][k];
+      const scalar_t f0 = (1.0 - y[k]) * f00 + y[k] * f10;
+      const scalar_t f1 = (1.0 - y[k]) * f01 + y[k] * f11;
+      blockValues[k] = (1.0 - z[k]) * f0 + z[k] * f1;
+      blockGradients[0][k] = ((1.0 - z[k]) * (1.0 - y[k]) * (c[1][k] - c[0][k]) + (1.0 - z[k]) * y[k] * (c[3][k] - c[2][k]) +
+                              z[k] * (1.0 - y[k]) * (c[5][k] - c[4][k]) + z[k] * y[k] * (c[7][k] - c[6][k])) *
+                             resolutionInv;
+      blockGradients[1][k] = ((1.0 - z[k]) * (f10 - f00) + z[k] * (f11 - f01)) * resolutionInv;
+      blockGradients[2][k] = (f1 - f0) * resolutionInv;
+    }
+
+    for (size_t k = 0; k < numPoints; k++) {
+      gradients[start + k] << blockGradients[0][k], blockGradients[1][k], blockGradients[2][k];
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VoxelDistanceTransform::gatherQueryBlock(const std::vector<vector3_t>& points, size_t start, size_t numPoints,
+                                              QueryBlock& block) const {
+  const scalar_t resolutionInv = 1.0 / resolution_;
+  std::array<size_t, 3> cornerIndex;
+  for (size_t k = 0; k < numPoints; k++) {
+    const vector3_t& p = points[start + k];
+    for (size_t i = 0; i < 3; i++) {
+      const scalar_t maxCoordinate = static_cast<scalar_t>(size_[i] - 1);
+      const scalar_t coordinate = std::min(std::max((p[i] - origin_[i]) * resolutionInv, scalar_t(0.0)), maxCoordinate);
+      cornerIndex[i] = std::min(static_cast<size_t>(coordinate), size_[i] - 2);
+      block.offsets[i][k] = coordinate - static_cast<scalar_t>(cornerIndex[i]);
+    }
+
+    const auto cornerValues = getCornerValues(cornerIndex);
+    for (size_t j = 0; j < cornerValues.size(); j++) {
+      block.cornerValues[j][k] = cornerValues[j];
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VoxelDistanceTransform::vector3_t VoxelDistanceTransform::findCell(const vector3_t& p, std::array<size_t, 3>& cornerIndex,
+                                                                  vector3_t& cornerPosition) const {
+  vector3_t clampedPoint;
+  for (size_t i = 0; i < 3; i++) {
+    const scalar_t maxCoordinate = static_cast<scalar_t>(size_[i] - 1);
+    const scalar_t coordinate = std::min(std::max((p[i] - origin_[i]) / resolution_, scalar_t(0.0)), maxCoordinate);
+    cornerIndex[i] = std::min(static_cast<size_t>(coordinate), size_[i] - 2);
+    clampedPoint[i] = origin_[i] + coordinate * resolution_;
+    cornerPosition[i] = origin_[i] + static_cast<scalar_t>(cornerIndex[i]) * resolution_;
+  }
+  return clampedPoint;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::array<scalar_t, 8> VoxelDistanceTransform::getCornerValues(const std::array<size_t, 3>& cornerIndex) const {
+  const size_t ix = cornerIndex[0];
+  const size_t iy = cornerIndex[1];
+  const size_t iz = cornerIndex[2];
+  const size_t x = ix % tileSize;
+  const size_t y = iy % tileSize;
+  const size_t z = iz % tileSize;
+
+  if (x + 1 < tileSize && y + 1 < tileSize && z + 1 < tileSize) {
+    // all corners are in the same tile
+    const float* tile = data_.data() + (voxelIndex(ix, iy, iz) - mortonIndex(x, y, z));
+    const size_t x0 = spreadBits_[x];
+    const size_t x1 = spreadBits_[x + 1];
+    const size_t y0 = spreadBits_[y] << 1;
+    const size_t y1 = spreadBits_[y + 1] << 1;
+    const size_t z0 = spreadBits_[z] << 2;
+    const size_t z1 = spreadBits_[z + 1] << 2;
+    return {tile[x0 | y0 | z0], tile[x1 | y0 | z0], tile[x0 | y1 | z0], tile[x1 | y1 | z0],
+            tile[x0 | y0 | z1], tile[x1 | y0 | z1], tile[x0 | y1 | z1], tile[x1 | y1 | z1]};
+  }
+
+  return {getVoxelValue(ix, iy, iz),         getVoxelValue(ix + 1, iy, iz),     getVoxelValue(ix, iy + 1, iz),
+          getVoxelValue(ix + 1, iy + 1, iz), getVoxelValue(ix, iy, iz + 1),     getVoxelValue(ix + 1, iy, iz + 1),
+          getVoxelValue(ix, iy + 1, iz + 1), getVoxelValue(ix + 1, iy + 1, iz + 1)};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VoxelDistanceTransform::computeSquaredDistances(const std::vector<bool>& occupancy, bool target,
+                                                     std::vector<float>& squaredDistances) {
+  // larger than any squared distance in the grid, while the sums in the 1D transform stay exact in float
+  const auto infinity = static_cast<float>(size_[0] * size_[0] + size_[1] * size_[1] + size_[2] * size_[2] + 1);
+
+  squaredDistances.resize(occupancy.size());
+  for (size_t i = 0; i < occupancy.size(); i++) {
+    squaredDistances[i] = (occupancy[i] == target) ? 0.0f : infinity;
+  }
+
+  for (size_t axis = 0; axis < 3; axis++) {
+    transformLines(axis, squaredDistances);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VoxelDistanceTransform::transformLines(size_t axis, std::vector<float>& squaredDistances) {
+  // lines that are claimed at once; consecutive lines along y and z are neighbours in memory
+  constexpr size_t numLinesPerChunk = 16;
+
+  const size_t lineLength = size_[axis];
+  const size_t numLines = squaredDistances.size() / lineLength;
+  const size_t stride = (axis == 0) ? 1 : (axis == 1) ? size_[0] : size_[0] * size_[1];
+
+  // first index of the l-th line
+  auto lineStart = [&](size_t l) -> size_t {
+    switch (axis) {
+      case 0:
+        return l * size_[0];
+      case 1:
+        return (l % size_[0]) + size_[0] * size_[1] * (l / size_[0]);
+      default:
+        return l;
+    }
+  };
+
+  std::atomic_size_t chunkIndex{0};
+  threadPool_.runParallel(
+      [&](int workerIndex) {
+        auto& buffer = lineBuffers_[workerIndex];
+        size_t firstLine = numLinesPerChunk * chunkIndex++;
+        while (firstLine < numLines) {
+          const size_t lastLine = std::min(firstLine + numLinesPerChunk, numLines);
+          for (size_t l = firstLine; l < lastLine; l++) {
+            float* line = squaredDistances.data() + lineStart(l);
+            for (size_t i = 0; i < lineLength; i++) {
+              buffer.values[i] = line[i * stride];
+            }
+            computeDistanceTransform(
+                lineLength, [&](size_t i) { return buffer.values[i]; }, [&](size_t i, float value) { line[i * stride] = value; }, 0,
+                lineLength, buffer.vBuffer, buffer.zBuffer);
+          }
+          firstLine = numLinesPerChunk * chunkIndex++;
+        }
+      },
+      lineBuffers_.size());
+}
+
+}  // namespace ocs2
@@ -106,9 +106,16 @@ vector_t EndEffectorDistanceConstraintCppAd::getValue(scalar_t time, const vecto
   const auto eePositions = kinematicsModelPtr_->getFunctionValue(state);
   assert(eePositions.size() == 3 * numEEs);
 
+  std::vector<DistanceTransformInterface::vector3_t> points(numEEs);
+  for (size_t i = 0; i < numEEs; i++) {
+    points[i] = eePositions.segment<3>(3 * i);
+  }
+  scalar_array_t distances;
+  distanceTransformPtr_->getValues(points, distances);
+
   vector_t g(numEEs);
   for (size_t i = 0; i < numEEs; i++) {
-    g(i) = config_.weight * (distanceTransformPtr_->getValue(eePositions.segment<3>(3 * i)) - clearances_[i]);
+    g(i) = config_.weight * (distances[i] - clearances_[i]);
   }  // end of i loop
 
   return g;
@@ -127,11 +134,18 @@ VectorFunctionLinearApproximation EndEffectorDistanceConstraintCppAd::getLinearA
   assert(eeJacobians.rows() == 3 * numEEs);
   assert(eeJacobians.cols() == stateDim_);
 
+  std::vector<DistanceTransformInterface::vector3_t> points(numEEs);
+  for (size_t i = 0; i < numEEs; i++) {
+    points[i] = eePositions.segment<3>(3 * i);
+  }
+  scalar_array_t distances;
+  std::vector<DistanceTransformInterface::vector3_t> distanceGradients;
+  distanceTransformPtr_->getLinearApproximations(points, distances, distanceGradients);
+
   VectorFunctionLinearApproximation approx = VectorFunctionLinearApproximation::Zero(numEEs, stateDim_, inputDim_);
   for (size_t i = 0; i < numEEs; i++) {
-    const auto distanceValueGradient = distanceTransformPtr_->getLinearApproximation(eePositions.segment<3>(3 * i));
-    approx.f(i) = config_.weight * (distanceValueGradient.first - clearances_[i]);
-    approx.dfdx.row(i).noalias() = config_.weight * (distanceValueGradient.second.transpose() * eeJacobians.middleRows<3>(3 * i));
+    approx.f(i) = config_.weight * (distances[i] - clearances_[i]);
+    approx.dfdx.row(i).noalias() = config_.weight * (distanceGradients[i].transpose() * eeJacobians.middleRows<3>(3 * i));
   }  // end of i loop
 
   return approx;
@@ -0,0 +1,245 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+#include "ocs2_perceptive/distance_transform/IncrementalVoxelDistanceTransform.h"
+#include "ocs2_perceptive/distance_transform/VoxelDistanceTransform.h"
+
+namespace ocs2 {
+
+class TestIncrementalVoxelDistanceTransform : public ::testing::Test {
+ protected:
+  using vector3_t = VoxelDistanceTransform::vector3_t;
+  using size3_t = VoxelDistanceTransform::size3_t;
+
+  TestIncrementalVoxelDistanceTransform() : occupancy(size[0] * size[1] * size[2], false), generator(0) {
+    std::bernoulli_distribution obstacle(0.02);
+    for (size_t iz = 0; iz < size[2]; iz++) {
+      for (size_t iy = 0; iy < size[1]; iy++) {
+        for (size_t ix = 0; ix < size[0]; ix++) {
+          // a box and a few random voxels
+          const bool inBox = (ix >= 20 && ix < 40) && (iy >= 16 && iy < 36) && (iz >= 4 && iz < 16);
+          occupancy[index(ix, iy, iz)] = inBox || obstacle(generator);
+        }
+      }
+    }
+  }
+
+  size_t index(size_t ix, size_t iy, size_t iz) const { return ix + size[0] * (iy + size[1] * iz); }
+
+  /** Toggles the occupancy of random voxels in both the incremental field and the occupancy grid. */
+  void toggleRandomVoxels(size_t numVoxels, IncrementalVoxelDistanceTransform& distanceTransform) {
+    std::uniform_int_distribution<size_t> distribution(0, occupancy.size() - 1);
+    for (size_t k = 0; k < numVoxels; k++) {
+      const size_t i = distribution(generator);
+      const size_t ix = i % size[0];
+      const size_t iy = (i / size[0]) % size[1];
+      const size_t iz = i / (size[0] * size[1]);
+      occupancy[i] = !occupancy[i];
+      distanceTransform.setOccupancy(ix, iy, iz, occupancy[i]);
+    }
+  }
+
+  /** Sets the occupancy of all voxels of the incremental field to the occupancy grid. */
+  void setOccupancy(IncrementalVoxelDistanceTransform& distanceTransform) const {
+    for (size_t iz = 0; iz < size[2]; iz++) {
+      for (size_t iy = 0; iy < size[1]; iy++) {
+        for (size_t ix = 0; ix < size[0]; ix++) {
+          distanceTransform.setOccupancy(ix, iy, iz, occupancy[index(ix, iy, iz)]);
+        }
+      }
+    }
+  }
+
+  /** Maximum absolute difference of the voxel values */
+  scalar_t maxDifference(const VoxelDistanceTransform& lhs, const VoxelDistanceTransform& rhs) const {
+    scalar_t maxDiff = 0.0;
+    for (size_t iz = 0; iz < size[2]; iz++) {
+      for (size_t iy = 0; iy < size[1]; iy++) {
+        for (size_t ix = 0; ix < size[0]; ix++) {
+          maxDiff = std::max(maxDiff, static_cast<scalar_t>(std::abs(lhs.getVoxelValue(ix, iy, iz) - rhs.getVoxelValue(ix, iy, iz))));
+        }
+      }
+    }
+    return maxDiff;
+  }
+
+  // disables the full update of IncrementalVoxelDistanceTransform::update()
+  static constexpr size_t incrementalOnly = std::numeric_limits<size_t>::max();
+
+  const vector3_t origin{-1.0, 0.5, 0.2};
+  const scalar_t resolution = 0.05;
+  const size3_t size{{64, 64, 32}};
+  // the brushfire propagation over the 26-neighbourhood is not exact in rare configurations
+  const scalar_t tolerance = 0.2 * resolution;
+  std::vector<bool> occupancy;
+  std::mt19937 generator;
+};
+
+constexpr size_t TestIncrementalVoxelDistanceTransform::incrementalOnly;
+
+TEST_F(TestIncrementalVoxelDistanceTransform, compareWithFullUpdate) {
+  IncrementalVoxelDistanceTransform incrementalTransform(origin, resolution, size, incrementalOnly);
+  incrementalTransform.reset(occupancy);
+
+  VoxelDistanceTransform fullTransform(origin, resolution, size);
+  fullTransform.update(occupancy);
+  EXPECT_LE(maxDifference(incrementalTransform.getActiveField(), fullTransform), tolerance);
+
+  for (size_t numChanges : {1, 10, 100, 1000}) {
+    toggleRandomVoxels(numChanges, incrementalTransform);
+    EXPECT_GT(incrementalTransform.update(), 0);
+    ASSERT_TRUE(incrementalTransform.swapBuffers());
+
+    fullTransform.update(occupancy);
+    EXPECT_LE(maxDifference(incrementalTransform.getActiveField(), fullTransform), tolerance) << "numChanges: " << numChanges;
+  }
+}
+
+TEST_F(TestIncrementalVoxelDistanceTransform, doubleBuffering) {
+  IncrementalVoxelDistanceTransform incrementalTransform(origin, resolution, size);
+  incrementalTransform.reset(occupancy);
+
+  VoxelDistanceTransform previousField(origin, resolution, size);
+  previousField.update(occupancy);
+  VoxelDistanceTransform fullTransform(origin, resolution, size);
+
+  // the active field does not change until the swap
+  EXPECT_FALSE(incrementalTransform.swapBuffers());
+  toggleRandomVoxels(100, incrementalTransform);
+  incrementalTransform.update();
+  EXPECT_LE(maxDifference(incrementalTransform.getActiveField(), previousField), tolerance);
+  EXPECT_TRUE(incrementalTransform.swapBuffers());
+  EXPECT_FALSE(incrementalTransform.swapBuffers());
+  fullTransform.update(occupancy);
+  EXPECT_LE(maxDifference(incrementalTransform.getActiveField(), fullTransform), tolerance);
+
+  // several updates between the swaps; the back field should catch up with the changes which went into the other field
+  for (size_t i = 0; i < 3; i++) {
+    previousField.update(occupancy);
+    for (size_t j = 0; j <= i; j++) {
+      toggleRandomVoxels(50, incrementalTransform);
+      incrementalTransform.update();
+    }
+    EXPECT_LE(maxDifference(incrementalTransform.getActiveField(), previousField), tolerance);
+    EXPECT_TRUE(incrementalTransform.swapBuffers());
+    fullTransform.update(occupancy);
+    EXPECT_LE(maxDifference(incrementalTransform.getActiveField(), fullTransform), tolerance);
+  }
+}
+
+TEST_F(TestIncrementalVoxelDistanceTransform, fullUpdateThreshold) {
+  constexpr size_t fullUpdateThreshold = 200;
+  IncrementalVoxelDistanceTransform incrementalTransform(origin, resolution, size, fullUpdateThreshold);
+  incrementalTransform.reset(occupancy);
+  VoxelDistanceTransform fullTransform(origin, resolution, size);
+
+  // the incremental branch only recomputes the voxels around the changes
+  toggleRandomVoxels(fullUpdateThreshold / 2, incrementalTransform);
+  EXPECT_LT(incrementalTransform.update(), occupancy.size());
+  ASSERT_TRUE(incrementalTransform.swapBuffers());
+  fullTransform.update(occupancy);
+  EXPECT_LE(maxDifference(incrementalTransform.getActiveField(), fullTransform), tolerance);
+
+  // the full branch recomputes all voxels and leaves the active field untouched until the swap
+  VoxelDistanceTransform previousField(origin, resolution, size);
+  previousField.update(occupancy);
+  toggleRandomVoxels(2 * fullUpdateThreshold, incrementalTransform);
+  EXPECT_EQ(incrementalTransform.update(), occupancy.size());
+  EXPECT_LE(maxDifference(incrementalTransform.getActiveField(), previousField), tolerance);
+  ASSERT_TRUE(incrementalTransform.swapBuffers());
+  fullTransform.update(occupancy);
+  EXPECT_LE(maxDifference(incrementalTransform.getActiveField(), fullTransform), tolerance);
+
+  // the incremental updates continue from the recomputed distances, and the field which missed the full update catches up
+  for (size_t i = 0; i < 2; i++) {
+    toggleRandomVoxels(fullUpdateThreshold / 4, incrementalTransform);
+    EXPECT_LT(incrementalTransform.update(), occupancy.size());
+    ASSERT_TRUE(incrementalTransform.swapBuffers());
+    fullTransform.update(occupancy);
+    EXPECT_LE(maxDifference(incrementalTransform.getActiveField(), fullTransform), tolerance) << "update: " << i;
+  }
+}
+
+TEST_F(TestIncrementalVoxelDistanceTransform, updateLatency) {
+  constexpr size_t numRepetitions = 20;
+
+  VoxelDistanceTransform fullTransform(origin, resolution, size);
+  benchmark::RepeatedTimer fullUpdateTimer;
+  for (size_t i = 0; i < numRepetitions; i++) {
+    fullUpdateTimer.startTimer();
+    fullTransform.update(occupancy);
+    fullUpdateTimer.endTimer();
+  }
+  std::cerr << "[TestIncrementalVoxelDistanceTransform] full update of " << occupancy.size()
+            << " voxels: " << fullUpdateTimer.getAverageInMilliseconds() << " [ms]\n";
+
+  // the incremental branch and the full branch of update(), for choosing the full update threshold
+  IncrementalVoxelDistanceTransform incrementalTransform(origin, resolution, size, incrementalOnly);
+  incrementalTransform.reset(occupancy);
+  IncrementalVoxelDistanceTransform fullUpdateTransform(origin, resolution, size, 0);
+  fullUpdateTransform.reset(occupancy);
+  for (size_t numChanges : {1, 10, 100, 1000}) {
+    benchmark::RepeatedTimer updateTimer;
+    benchmark::RepeatedTimer fullBranchTimer;
+    size_t numDirtyVoxels = 0;
+    for (size_t i = 0; i < numRepetitions; i++) {
+      toggleRandomVoxels(numChanges, incrementalTransform);
+      updateTimer.startTimer();
+      numDirtyVoxels += incrementalTransform.update();
+      incrementalTransform.swapBuffers();
+      updateTimer.endTimer();
+
+      setOccupancy(fullUpdateTransform);
+      fullBranchTimer.startTimer();
+      fullUpdateTransform.update();
+      fullUpdateTransform.swapBuffers();
+      fullBranchTimer.endTimer();
+    }
+    std::cerr << "[TestIncrementalVoxelDistanceTransform] incremental update of " << numChanges
+              << " changed voxels: " << updateTimer.getAverageInMilliseconds() << " [ms], "
+              << numDirtyVoxels / numRepetitions << " recomputed voxels, full branch: " << fullBranchTimer.getAverageInMilliseconds()
+              << " [ms]\n";
+  }
+
+  fullTransform.update(occupancy);
+  EXPECT_LE(maxDifference(incrementalTransform.getActiveField(), fullTransform), tolerance);
+  EXPECT_LE(maxDifference(fullUpdateTransform.getActiveField(), fullTransform), tolerance);
+}
+
+}  // namespace ocs2
@@ -0,0 +1,274 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+#include "ocs2_perceptive/distance_transform/VoxelDistanceTransform.h"
+#include "ocs2_perceptive/end_effector/EndEffectorDistanceConstraint.h"
+
+namespace ocs2 {
+
+namespace {
+/** Kinematics of a single end-effector whose position is the head of the state. */
+class PointKinematics final : public EndEffectorKinematics<scalar_t> {
+ public:
+  PointKinematics() = default;
+  ~PointKinematics() override = default;
+  PointKinematics* clone() const override { return new PointKinematics(*this); }
+
+  const std::vector<std::string>& getIds() const override { return ids_; }
+
+  std::vector<vector3_t> getPosition(const vector_t& state) const override { return {state.head<3>()}; }
+
+  std::vector<VectorFunctionLinearApproximation> getPositionLinearApproximation(const vector_t& state) const override {
+    VectorFunctionLinearApproximation approx = VectorFunctionLinearApproximation::Zero(3, state.size(), 0);
+    approx.f = state.head<3>();
+    approx.dfdx.leftCols<3>().setIdentity();
+    return {approx};
+  }
+
+  std::vector<vector3_t> getVelocity(const vector_t&, const vector_t&) const override { throw std::runtime_error("not implemented"); }
+  std::vector<vector3_t> getOrientationError(const vector_t&, const std::vector<quaternion_t>&) const override {
+    throw std::runtime_error("not implemented");
+  }
+  std::vector<VectorFunctionLinearApproximation> getVelocityLinearApproximation(const vector_t&, const vector_t&) const override {
+    throw std::runtime_error("not implemented");
+  }
+  std::vector<VectorFunctionLinearApproximation> getOrientationErrorLinearApproximation(
+      const vector_t&, const std::vector<quaternion_t>&) const override {
+    throw std::runtime_error("not implemented");
+  }
+
+ private:
+  PointKinematics(const PointKinematics&) = default;
+
+  const std::vector<std::string> ids_{"point"};
+};
+}  // unnamed namespace
+
+class TestVoxelDistanceTransform : public ::testing::Test {
+ protected:
+  using vector3_t = VoxelDistanceTransform::vector3_t;
+  using size3_t = VoxelDistanceTransform::size3_t;
+
+  TestVoxelDistanceTransform() : occupancy(size[0] * size[1] * size[2], false) {
+    std::mt19937 generator(0);
+    std::bernoulli_distribution obstacle(0.02);
+    for (size_t iz = 0; iz < size[2]; iz++) {
+      for (size_t iy = 0; iy < size[1]; iy++) {
+        for (size_t ix = 0; ix < size[0]; ix++) {
+          // a box and a few random voxels
+          const bool inBox = (ix >= 5 && ix < 12) && (iy >= 4 && iy < 10) && (iz >= 3 && iz < 9);
+          occupancy[index(ix, iy, iz)] = inBox || obstacle(generator);
+        }
+      }
+    }
+  }
+
+  size_t index(size_t ix, size_t iy, size_t iz) const { return ix + size[0] * (iy + size[1] * iz); }
+
+  /** Brute force signed distance of voxel (ix, iy, iz) */
+  scalar_t bruteForceDistance(size_t ix, size_t iy, size_t iz) const {
+    const bool occupied = occupancy[index(ix, iy, iz)];
+    scalar_t minSquaredDistance = std::numeric_limits<scalar_t>::max();
+    for (size_t jz = 0; jz < size[2]; jz++) {
+      for (size_t jy = 0; jy < size[1]; jy++) {
+        for (size_t jx = 0; jx < size[0]; jx++) {
+          if (occupancy[index(jx, jy, jz)] != occupied) {
+            const scalar_t dx = scalar_t(ix) - scalar_t(jx);
+            const scalar_t dy = scalar_t(iy) - scalar_t(jy);
+            const scalar_t dz = scalar_t(iz) - scalar_t(jz);
+            minSquaredDistance = std::min(minSquaredDistance, dx * dx + dy * dy + dz * dz);
+          }
+        }
+      }
+    }
+    const scalar_t distance = resolution * std::sqrt(minSquaredDistance);
+    return occupied ? -distance : distance;
+  }
+
+  vector3_t randomPointInGrid() const {
+    const vector3_t extent(resolution * (size[0] - 1), resolution * (size[1] - 1), resolution * (size[2] - 1));
+    return origin + 0.5 * (vector3_t::Random() + vector3_t::Ones()).cwiseProduct(extent);
+  }
+
+  const vector3_t origin{-1.0, 0.5, 0.2};
+  const scalar_t resolution = 0.05;
+  const size3_t size{{21, 17, 13}};
+  std::vector<bool> occupancy;
+};
+
+TEST_F(TestVoxelDistanceTransform, compareWithBruteForce) {
+  VoxelDistanceTransform distanceTransform(origin, resolution, size, 3);
+  distanceTransform.update(occupancy);
+
+  for (size_t iz = 0; iz < size[2]; iz++) {
+    for (size_t iy = 0; iy < size[1]; iy++) {
+      for (size_t ix = 0; ix < size[0]; ix++) {
+        ASSERT_NEAR(distanceTransform.getVoxelValue(ix, iy, iz), bruteForceDistance(ix, iy, iz), 1e-5)
+            << "voxel (" << ix << ", " << iy << ", " << iz << ")";
+        const vector3_t voxelPosition = distanceTransform.getVoxelPosition(ix, iy, iz);
+        ASSERT_NEAR(distanceTransform.getValue(voxelPosition), distanceTransform.getVoxelValue(ix, iy, iz), 1e-5);
+      }
+    }
+  }
+}
+
+TEST_F(TestVoxelDistanceTransform, threadInvariance) {
+  VoxelDistanceTransform singleThread(origin, resolution, size, 1);
+  VoxelDistanceTransform multiThread(origin, resolution, size, 4);
+  singleThread.update(occupancy);
+  multiThread.update(occupancy);
+
+  for (size_t iz = 0; iz < size[2]; iz++) {
+    for (size_t iy = 0; iy < size[1]; iy++) {
+      for (size_t ix = 0; ix < size[0]; ix++) {
+        ASSERT_EQ(singleThread.getVoxelValue(ix, iy, iz), multiThread.getVoxelValue(ix, iy, iz));
+      }
+    }
+  }
+}
+
+TEST_F(TestVoxelDistanceTransform, linearApproximation) {
+  VoxelDistanceTransform distanceTransform(origin, resolution, size);
+  distanceTransform.update(occupancy);
+
+  constexpr scalar_t eps = 1e-6;
+  for (size_t i = 0; i < 1000; i++) {
+    const vector3_t p = randomPointInGrid();
+    const auto valueGradient = distanceTransform.getLinearApproximation(p);
+    EXPECT_NEAR(valueGradient.first, distanceTransform.getValue(p), 1e-9);
+
+    vector3_t finiteDifference;
+    for (size_t j = 0; j < 3; j++) {
+      const vector3_t delta = eps * vector3_t::Unit(j);
+      finiteDifference[j] = (distanceTransform.getValue(p + delta) - distanceTransform.getValue(p - delta)) / (2.0 * eps);
+    }
+    EXPECT_TRUE(valueGradient.second.isApprox(finiteDifference, 1e-4)) << "gradient: " << valueGradient.second.transpose()
+                                                                       << "\nfinite difference: " << finiteDifference.transpose();
+  }
+
+  // outside points are clamped to the grid
+  const vector3_t outside = origin - vector3_t::Ones();
+  EXPECT_DOUBLE_EQ(distanceTransform.getValue(outside), distanceTransform.getVoxelValue(0, 0, 0));
+}
+
+TEST_F(TestVoxelDistanceTransform, batchedQueries) {
+  constexpr size_t numPoints = 10000;
+  constexpr size_t numRepetitions = 20;
+
+  VoxelDistanceTransform distanceTransform(origin, resolution, size);
+  distanceTransform.update(occupancy);
+
+  // include points outside of the grid and a number of points which is not a multiple of the block size
+  std::vector<vector3_t> points(numPoints + 3);
+  for (auto& p : points) {
+    p = randomPointInGrid();
+  }
+  points[0] = origin - vector3_t::Ones();
+  points[1] = origin + vector3_t(1.0, 1.0, 1.0) * 10.0;
+
+  scalar_array_t values, defaultValues, approxValues, defaultApproxValues;
+  std::vector<vector3_t> gradients, defaultGradients;
+  benchmark::RepeatedTimer batchedTimer;
+  benchmark::RepeatedTimer defaultTimer;
+  for (size_t i = 0; i < numRepetitions; i++) {
+    batchedTimer.startTimer();
+    distanceTransform.getLinearApproximations(points, approxValues, gradients);
+    batchedTimer.endTimer();
+    // the default implementation of the interface, i.e. one virtual query per point
+    defaultTimer.startTimer();
+    distanceTransform.DistanceTransformInterface::getLinearApproximations(points, defaultApproxValues, defaultGradients);
+    defaultTimer.endTimer();
+  }
+  distanceTransform.getValues(points, values);
+  distanceTransform.DistanceTransformInterface::getValues(points, defaultValues);
+
+  ASSERT_EQ(values.size(), points.size());
+  ASSERT_EQ(gradients.size(), points.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    ASSERT_NEAR(values[i], defaultValues[i], 1e-9);
+    ASSERT_NEAR(approxValues[i], defaultApproxValues[i], 1e-9);
+    ASSERT_TRUE(gradients[i].isApprox(defaultGradients[i], 1e-9)) << "point: " << points[i].transpose();
+  }
+
+  std::cerr << "[TestVoxelDistanceTransform] linear approximation of " << points.size()
+            << " points, batched: " << batchedTimer.getAverageInMilliseconds()
+            << " [ms], per point: " << defaultTimer.getAverageInMilliseconds() << " [ms]\n";
+}
+
+TEST_F(TestVoxelDistanceTransform, endEffectorDistanceConstraint) {
+  constexpr size_t stateDim = 6;
+  constexpr size_t numNodes = 100;
+  constexpr size_t numRepetitions = 100;
+
+  VoxelDistanceTransform distanceTransform(origin, resolution, size);
+  benchmark::RepeatedTimer updateTimer;
+  for (size_t i = 0; i < 10; i++) {
+    updateTimer.startTimer();
+    distanceTransform.update(occupancy);
+    updateTimer.endTimer();
+  }
+
+  EndEffectorDistanceConstraint constraint(stateDim, 1.0, std::make_unique<PointKinematics>());
+  constraint.set(0.1, distanceTransform);
+
+  vector_array_t states(numNodes, vector_t::Zero(stateDim));
+  for (auto& x : states) {
+    x.head<3>() = randomPointInGrid();
+  }
+
+  PreComputation preComputation;
+  benchmark::RepeatedTimer constraintTimer;
+  for (size_t i = 0; i < numRepetitions; i++) {
+    constraintTimer.startTimer();
+    for (size_t k = 0; k < numNodes; k++) {
+      const auto approx = constraint.getLinearApproximation(0.0, states[k], preComputation);
+      ASSERT_NEAR(approx.f(0), distanceTransform.getValue(states[k].head<3>()) - 0.1, 1e-9);
+    }
+    constraintTimer.endTimer();
+  }
+
+  std::cerr << "[TestVoxelDistanceTransform] update of " << size[0] * size[1] * size[2]
+            << " voxels: " << updateTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cerr << "[TestVoxelDistanceTransform] EndEffectorDistanceConstraint linear approximation over " << numNodes
+            << " nodes: " << constraintTimer.getAverageInMilliseconds() << " [ms]\n";
+}
+
+}  // namespace ocs2
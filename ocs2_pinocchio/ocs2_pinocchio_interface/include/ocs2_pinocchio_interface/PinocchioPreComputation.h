@@ -0,0 +1,123 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include <ocs2_core/PreComputation.h>
+#include <ocs2_pinocchio_interface/PinocchioInterface.h>
+#include <ocs2_pinocchio_interface/PinocchioStateInputMapping.h>
+
+namespace ocs2 {
+
+/**
+ * PreComputation that runs the Pinocchio algorithms shared by the dynamics, cost and constraint terms at most once per
+ * configuration. It keeps the joint position of the last update and the set of quantities evaluated for it. A request at the same
+ * configuration only runs the algorithms of the quantities that are not yet available in pinocchio::Data, e.g. the joint
+ * Jacobians after a value request, and a request with no missing quantity costs a single vector comparison.
+ *
+ * Only cost and constraint requests update the data, such that the intermediate stages of the dynamics discretization do not
+ * trigger kinematics that no term reads. The terms read the updated pinocchio::Data through getPinocchioInterface().
+ *
+ * @note The solvers issue a single cost and constraint request per node, and consecutive requests of a worker are at different nodes.
+ *       The memoization therefore does not reduce the work of an LQ approximation. It saves work when the same configuration is
+ *       requested repeatedly on the same instance, e.g., by terms or user code that request the data themselves.
+ *
+ * User pre-computations are composed by deriving from this class and calling PinocchioPreComputation::request() (and the
+ * pre-jump and final variants) before their own updates.
+ *
+ * Example:
+ *   PinocchioPreComputation preComputation(pinocchioInterface, mapping, PinocchioPreComputation::FramePlacements,
+ *                                          PinocchioPreComputation::FramePlacements | PinocchioPreComputation::JointJacobians);
+ *   preComputation.request(Request::Cost + Request::Approximation, t, x, u);
+ *   kinematics.setPinocchioInterface(preComputation.getPinocchioInterface());
+ */
+class PinocchioPreComputation : public PreComputation {
+ public:
+  /** The Pinocchio quantities which can be requested, combined as a bit mask. */
+  enum Quantity : unsigned {
+    None = 0,
+    Kinematics = 1 << 0,       // pinocchio::forwardKinematics(model, data, q)
+    FramePlacements = 1 << 1,  // pinocchio::updateFramePlacements(model, data)
+    JointJacobians = 1 << 2,   // pinocchio::computeJointJacobians(model, data)
+    CenterOfMass = 1 << 3,     // pinocchio::centerOfMass(model, data, pinocchio::POSITION, false)
+    CentroidalMap = 1 << 4,    // pinocchio::computeCentroidalMap(model, data, q)
+  };
+
+  /**
+   * Constructor
+   * @param [in] pinocchioInterface: pinocchio interface on which the algorithms are evaluated.
+   * @param [in] mapping: mapping from OCS2 to pinocchio state.
+   * @param [in] valueQuantities: The quantities required by the terms for a value request.
+   * @param [in] approximationQuantities: The quantities required by the terms for an approximation request.
+   */
+  PinocchioPreComputation(PinocchioInterface pinocchioInterface, const PinocchioStateInputMapping<scalar_t>& mapping,
+                          unsigned valueQuantities, unsigned approximationQuantities);
+
+  ~PinocchioPreComputation() override = default;
+  PinocchioPreComputation* clone() const override;
+
+  void request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) override;
+  void requestPreJump(RequestSet request, scalar_t t, const vector_t& x) override;
+  void requestFinal(RequestSet request, scalar_t t, const vector_t& x) override;
+
+  /**
+   * Updates pinocchio::Data with the given quantities at the configuration of the state. Only the quantities that are not yet
+   * evaluated at this configuration are computed.
+   *
+   * @param [in] x: The state.
+   * @param [in] quantities: The requested quantities as a bit mask of Quantity.
+   */
+  void update(const vector_t& x, unsigned quantities);
+
+  /** Forgets the evaluated quantities. Must be called after pinocchio::Data is modified outside of update(). */
+  void invalidate() { evaluatedQuantities_ = None; }
+
+  /** Returns the bit mask of the quantities which are evaluated at the configuration of the last update. */
+  unsigned getEvaluatedQuantities() const { return evaluatedQuantities_; }
+
+  /** Gets the pinocchio interface. Call invalidate() after modifying its data. */
+  PinocchioInterface& getPinocchioInterface() { return pinocchioInterface_; }
+  const PinocchioInterface& getPinocchioInterface() const { return pinocchioInterface_; }
+
+ protected:
+  PinocchioPreComputation(const PinocchioPreComputation& rhs);
+
+ private:
+  PinocchioInterface pinocchioInterface_;
+  std::unique_ptr<PinocchioStateInputMapping<scalar_t>> mappingPtr_;
+  const unsigned valueQuantities_;
+  const unsigned approximationQuantities_;
+
+  vector_t q_;
+  unsigned evaluatedQuantities_ = None;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,151 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/center-of-mass.hpp>
+#include <pinocchio/algorithm/centroidal.hpp>
+#include <pinocchio/algorithm/frames.hpp>
+#include <pinocchio/algorithm/jacobian.hpp>
+#include <pinocchio/algorithm/kinematics.hpp>
+
+#include <ocs2_pinocchio_interface/PinocchioPreComputation.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PinocchioPreComputation::PinocchioPreComputation(PinocchioInterface pinocchioInterface, const PinocchioStateInputMapping<scalar_t>& mapping,
+                                                 unsigned valueQuantities, unsigned approximationQuantities)
+    : pinocchioInterface_(std::move(pinocchioInterface)),
+      mappingPtr_(mapping.clone()),
+      valueQuantities_(valueQuantities),
+      approximationQuantities_(approximationQuantities) {
+  mappingPtr_->setPinocchioInterface(pinocchioInterface_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PinocchioPreComputation::PinocchioPreComputation(const PinocchioPreComputation& rhs)
+    : PreComputation(rhs),
+      pinocchioInterface_(rhs.pinocchioInterface_),
+      mappingPtr_(rhs.mappingPtr_->clone()),
+      valueQuantities_(rhs.valueQuantities_),
+      approximationQuantities_(rhs.approximationQuantities_),
+      q_(rhs.q_),
+      evaluatedQuantities_(rhs.evaluatedQuantities_) {
+  mappingPtr_->setPinocchioInterface(pinocchioInterface_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PinocchioPreComputation* PinocchioPreComputation::clone() const {
+  return new PinocchioPreComputation(*this);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::request(RequestSet request, scalar_t t, const vector_t& x, const vector_t& u) {
+  if (request.containsAny(Request::Cost + Request::Constraint + Request::SoftConstraint)) {
+    update(x, request.contains(Request::Approximation) ? approximationQuantities_ : valueQuantities_);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::requestPreJump(RequestSet request, scalar_t t, const vector_t& x) {
+  if (request.containsAny(Request::Cost + Request::Constraint + Request::SoftConstraint)) {
+    update(x, request.contains(Request::Approximation) ? approximationQuantities_ : valueQuantities_);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::requestFinal(RequestSet request, scalar_t t, const vector_t& x) {
+  if (request.containsAny(Request::Cost + Request::Constraint + Request::SoftConstraint)) {
+    update(x, request.contains(Request::Approximation) ? approximationQuantities_ : valueQuantities_);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PinocchioPreComputation::update(const vector_t& x, unsigned quantities) {
+  if (quantities == None) {
+    return;
+  }
+
+  const vector_t q = mappingPtr_->getPinocchioJointPosition(x);
+  if (q.size() != q_.size() || q != q_) {
+    q_ = q;
+    evaluatedQuantities_ = None;
+  }
+
+  // all other quantities are computed from the joint placements
+  quantities |= Kinematics;
+  const unsigned missingQuantities = quantities & ~evaluatedQuantities_;
+  if (missingQuantities == None) {
+    return;
+  }
+
+  const auto& model = pinocchioInterface_.getModel();
+  auto& data = pinocchioInterface_.getData();
+
+  if ((missingQuantities & CentroidalMap) != 0) {
+    // the forward pass of the centroidal map also updates the joint placements
+    pinocchio::computeCentroidalMap(model, data, q_);
+    evaluatedQuantities_ |= CentroidalMap | Kinematics;
+  } else if ((missingQuantities & Kinematics) != 0) {
+    pinocchio::forwardKinematics(model, data, q_);
+    evaluatedQuantities_ |= Kinematics;
+  }
+
+  if ((missingQuantities & FramePlacements) != 0) {
+    pinocchio::updateFramePlacements(model, data);
+    evaluatedQuantities_ |= FramePlacements;
+  }
+
+  if ((missingQuantities & JointJacobians) != 0) {
+    pinocchio::computeJointJacobians(model, data);
+    evaluatedQuantities_ |= JointJacobians;
+  }
+
+  if ((missingQuantities & CenterOfMass) != 0) {
+    pinocchio::centerOfMass(model, data, pinocchio::POSITION, false);
+    evaluatedQuantities_ |= CenterOfMass;
+  }
+}
+
+}  // namespace ocs2
@@ -0,0 +1,152 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <pinocchio/algorithm/frames.hpp>
+#include <pinocchio/algorithm/jacobian.hpp>
+#include <pinocchio/algorithm/kinematics.hpp>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_pinocchio_interface/PinocchioPreComputation.h>
+#include <ocs2_pinocchio_interface/urdf.h>
+
+#include "ManipulatorArmUrdf.h"
+
+using namespace ocs2;
+
+namespace {
+class IdentityMapping final : public PinocchioStateInputMapping<scalar_t> {
+ public:
+  IdentityMapping* clone() const override { return new IdentityMapping(*this); }
+  vector_t getPinocchioJointPosition(const vector_t& state) const override { return state; }
+  vector_t getPinocchioJointVelocity(const vector_t& state, const vector_t& input) const override { return input; }
+  std::pair<matrix_t, matrix_t> getOcs2Jacobian(const vector_t& state, const matrix_t& Jq, const matrix_t& Jv) const override {
+    return {Jq, Jv};
+  }
+};
+}  // unnamed namespace
+
+class TestPinocchioPreComputation : public ::testing::Test {
+ public:
+  using Quantity = PinocchioPreComputation::Quantity;
+
+  TestPinocchioPreComputation()
+      : pinocchioInterface(getPinocchioInterfaceFromUrdfString(manipulatorArmUrdf)),
+        preComputation(pinocchioInterface, IdentityMapping(), Quantity::FramePlacements,
+                       Quantity::FramePlacements | Quantity::JointJacobians),
+        frameId(pinocchioInterface.getModel().getBodyId("WRIST_2")) {
+    x.resize(6);
+    x << 2.5, -1.0, 1.5, 0.0, 1.0, 0.0;
+    u.setOnes(6);
+  }
+
+  /** Frame position and Jacobian evaluated directly on a separate pinocchio interface */
+  std::pair<vector_t, matrix_t> getReferenceKinematics(const vector_t& q) {
+    const auto& model = pinocchioInterface.getModel();
+    auto& data = pinocchioInterface.getData();
+    pinocchio::forwardKinematics(model, data, q);
+    pinocchio::updateFramePlacements(model, data);
+    pinocchio::computeJointJacobians(model, data);
+    matrix_t J = matrix_t::Zero(6, model.nv);
+    pinocchio::getFrameJacobian(model, data, frameId, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, J);
+    return {data.oMf[frameId].translation(), J};
+  }
+
+  std::pair<vector_t, matrix_t> getPreComputedKinematics() {
+    const auto& model = preComputation.getPinocchioInterface().getModel();
+    auto data = preComputation.getPinocchioInterface().getData();
+    matrix_t J = matrix_t::Zero(6, model.nv);
+    pinocchio::getFrameJacobian(model, data, frameId, pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED, J);
+    return {data.oMf[frameId].translation(), J};
+  }
+
+  PinocchioInterface pinocchioInterface;
+  PinocchioPreComputation preComputation;
+  const size_t frameId;
+  vector_t x;
+  vector_t u;
+};
+
+TEST_F(TestPinocchioPreComputation, requestedQuantities) {
+  EXPECT_EQ(preComputation.getEvaluatedQuantities(), Quantity::None);
+
+  // no kinematics for dynamics requests
+  preComputation.request(Request::Dynamics + Request::Approximation, 0.0, x, u);
+  EXPECT_EQ(preComputation.getEvaluatedQuantities(), Quantity::None);
+
+  preComputation.request(Request::Cost, 0.0, x, u);
+  EXPECT_EQ(preComputation.getEvaluatedQuantities(), Quantity::Kinematics | Quantity::FramePlacements);
+
+  // the approximation at the same state only adds the Jacobians
+  preComputation.request(Request::Constraint + Request::Approximation, 0.0, x, u);
+  EXPECT_EQ(preComputation.getEvaluatedQuantities(), Quantity::Kinematics | Quantity::FramePlacements | Quantity::JointJacobians);
+
+  const auto reference = getReferenceKinematics(x);
+  const auto preComputed = getPreComputedKinematics();
+  EXPECT_TRUE(preComputed.first.isApprox(reference.first));
+  EXPECT_TRUE(preComputed.second.isApprox(reference.second));
+
+  // a new state resets the evaluated quantities
+  const vector_t xNew = x + vector_t::Constant(6, 0.1);
+  preComputation.requestFinal(Request::Cost, 1.0, xNew);
+  EXPECT_EQ(preComputation.getEvaluatedQuantities(), Quantity::Kinematics | Quantity::FramePlacements);
+  EXPECT_TRUE(getPreComputedKinematics().first.isApprox(getReferenceKinematics(xNew).first));
+}
+
+TEST_F(TestPinocchioPreComputation, memoization) {
+  preComputation.request(Request::Cost + Request::Approximation, 0.0, x, u);
+  const vector_t position = getPreComputedKinematics().first;
+
+  // a request at the same state must not run the algorithms again
+  auto& data = preComputation.getPinocchioInterface().getData();
+  data.oMf[frameId].translation().setZero();
+  preComputation.request(Request::Cost + Request::Approximation, 0.0, x, u);
+  preComputation.request(Request::Constraint, 0.0, x, u);
+  EXPECT_TRUE(data.oMf[frameId].translation().isZero());
+
+  // unless the data is invalidated
+  preComputation.invalidate();
+  preComputation.request(Request::Cost, 0.0, x, u);
+  EXPECT_TRUE(data.oMf[frameId].translation().isApprox(position));
+}
+
+TEST_F(TestPinocchioPreComputation, clone) {
+  preComputation.request(Request::Cost + Request::Approximation, 0.0, x, u);
+  std::unique_ptr<PinocchioPreComputation> clonePtr(preComputation.clone());
+  EXPECT_EQ(clonePtr->getEvaluatedQuantities(), preComputation.getEvaluatedQuantities());
+
+  // the clone owns its data
+  const vector_t xNew = x + vector_t::Constant(6, 0.1);
+  clonePtr->request(Request::Cost, 0.0, xNew, u);
+  EXPECT_TRUE(getPreComputedKinematics().first.isApprox(getReferenceKinematics(x).first));
+  const auto& cloneData = clonePtr->getPinocchioInterface().getData();
+  EXPECT_TRUE(cloneData.oMf[frameId].translation().isApprox(getReferenceKinematics(xNew).first));
+}
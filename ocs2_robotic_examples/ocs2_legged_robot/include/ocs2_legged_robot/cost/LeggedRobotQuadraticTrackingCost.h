@@ -54,11 +54,17 @@ class LeggedRobotStateInputQuadraticCost final : public QuadraticStateInputCost
  private:
   LeggedRobotStateInputQuadraticCost(const LeggedRobotStateInputQuadraticCost& rhs) = default;
 
+  using QuadraticStateInputCost::getStateInputDeviation;
   std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
-                                                       const TargetTrajectories& targetTrajectories) const override {
+                                                       const TargetTrajectories& targetTrajectories,
+                                                       const PreComputation& preComp) const override {
     const auto contactFlags = referenceManagerPtr_->getContactFlags(time);
-    const vector_t xNominal = targetTrajectories.getDesiredState(time);
     const vector_t uNominal = weightCompensatingInput(info_, contactFlags);
+    const vector_t* xNominalPtr = preComp.getCachedDesiredState(time);
+    if (xNominalPtr != nullptr) {
+      return {state - *xNominalPtr, input - uNominal};
+    }
+    const vector_t xNominal = targetTrajectories.getDesiredState(time);
     return {state - xNominal, input - uNominal};
   }
 
@@ -80,8 +86,13 @@ class LeggedRobotStateQuadraticCost final : public QuadraticStateCost {
  private:
   LeggedRobotStateQuadraticCost(const LeggedRobotStateQuadraticCost& rhs) = default;
 
-  vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const override {
-    const auto contactFlags = referenceManagerPtr_->getContactFlags(time);
+  using QuadraticStateCost::getStateDeviation;
+  vector_t getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                             const PreComputation& preComp) const override {
+    const vector_t* xNominalPtr = preComp.getCachedDesiredState(time);
+    if (xNominalPtr != nullptr) {
+      return state - *xNominalPtr;
+    }
     const vector_t xNominal = targetTrajectories.getDesiredState(time);
     return state - xNominal;
   }
@@ -0,0 +1,65 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>  // forward declarations must be included first.
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <ocs2_core/automatic_differentiation/CppAdModelBuilder.h>
+
+#include "ocs2_legged_robot/LeggedRobotInterface.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+/**
+ * Generates and compiles all auto-differentiated models of the legged robot ahead of time. The outdated libraries are
+ * compiled in parallel, such that the MPC nodes only have to load them.
+ */
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    std::cerr << "Usage: " << argv[0] << " <taskFile> <urdfFile> <referenceFile> [nThreads]" << std::endl;
+    return 1;
+  }
+  const std::string taskFile = argv[1];
+  const std::string urdfFile = argv[2];
+  const std::string referenceFile = argv[3];
+  const size_t nThreads = (argc > 4) ? std::stoul(argv[4]) : std::max(std::thread::hardware_concurrency(), 1U);
+
+  CppAdModelBuilder modelBuilder(nThreads);
+  modelBuilder.startCollecting();
+  LeggedRobotInterface interface(taskFile, urdfFile, referenceFile);
+  const size_t numCompiledModels = modelBuilder.build();
+
+  std::cerr << "[LeggedRobotGenerateModels] Compiled " << numCompiledModels << " libraries" << std::endl;
+  return 0;
+}
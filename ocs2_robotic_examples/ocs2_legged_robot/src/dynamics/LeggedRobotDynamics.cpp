@@ -0,0 +1,83 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_legged_robot/dynamics/LeggedRobotDynamics.h"
+
+#include <ocs2_centroidal_model/ModelHelperFunctions.h>
+
+namespace ocs2 {
+namespace legged_robot {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LeggedRobotDynamics::LeggedRobotDynamics(const PinocchioInterface& pinocchioInterface, const CentroidalModelInfo& info)
+    : pinocchioInterface_(pinocchioInterface), mapping_(info), pinocchioCentroidalDynamics_(info) {
+  mapping_.setPinocchioInterface(pinocchioInterface_);
+  pinocchioCentroidalDynamics_.setPinocchioInterface(pinocchioInterface_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LeggedRobotDynamics::LeggedRobotDynamics(const LeggedRobotDynamics& rhs)
+    : SystemDynamicsBase(rhs),
+      pinocchioInterface_(rhs.pinocchioInterface_),
+      mapping_(rhs.mapping_.getCentroidalModelInfo()),
+      pinocchioCentroidalDynamics_(rhs.pinocchioCentroidalDynamics_) {
+  mapping_.setPinocchioInterface(pinocchioInterface_);
+  pinocchioCentroidalDynamics_.setPinocchioInterface(pinocchioInterface_);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t LeggedRobotDynamics::computeFlowMap(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComp) {
+  const auto& info = mapping_.getCentroidalModelInfo();
+  const vector_t q = mapping_.getPinocchioJointPosition(state);
+  updateCentroidalDynamics(pinocchioInterface_, info, q);
+  return pinocchioCentroidalDynamics_.getValue(time, state, input);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation LeggedRobotDynamics::linearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                           const PreComputation& preComp) {
+  const auto& info = mapping_.getCentroidalModelInfo();
+  const vector_t q = mapping_.getPinocchioJointPosition(state);
+  // the joint velocities are mapped through the centroidal momentum matrix of the updated data
+  updateCentroidalDynamics(pinocchioInterface_, info, q);
+  const vector_t v = mapping_.getPinocchioJointVelocity(state, input);
+  updateCentroidalDynamicsDerivatives(pinocchioInterface_, info, q, v);
+  return pinocchioCentroidalDynamics_.getLinearApproximation(time, state, input);
+}
+
+}  // namespace legged_robot
+}  // namespace ocs2
@@ -0,0 +1,184 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include <boost/property_tree/info_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_robotic_assets/package_path.h>
+
+#include "ocs2_legged_robot/LeggedRobotInterface.h"
+#include "ocs2_legged_robot/common/ModelSettings.h"
+#include "ocs2_legged_robot/common/Types.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotDynamics.h"
+#include "ocs2_legged_robot/dynamics/LeggedRobotDynamicsAD.h"
+#include "ocs2_legged_robot/package_path.h"
+#include "ocs2_legged_robot/test/AnymalFactoryFunctions.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+namespace {
+const std::string URDF_FILE = ocs2::robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+const std::string TASK_FILE = ocs2::legged_robot::getPath() + "/config/mpc/" + "task.info";
+const std::string REFERENCE_FILE = ocs2::legged_robot::getPath() + "/config/command/" + "reference.info";
+}  // unnamed namespace
+
+class TestLeggedRobotDynamics : public ::testing::TestWithParam<CentroidalModelType> {
+ public:
+  TestLeggedRobotDynamics()
+      : pinocchioInterfacePtr(createAnymalPinocchioInterface()),
+        centroidalModelInfo(createAnymalCentroidalModelInfo(*pinocchioInterfacePtr, GetParam())),
+        dynamics(*pinocchioInterfacePtr, centroidalModelInfo),
+        dynamicsAd(*pinocchioInterfacePtr, centroidalModelInfo, "testLeggedRobotDynamics_" + toString(GetParam()), modelSettings) {}
+
+  static constexpr bool verbose = true;
+  static constexpr size_t numTests = 100;
+  static constexpr size_t numBenchmarkRuns = 10000;
+  static constexpr scalar_t tol = 1e-6;
+
+  const ModelSettings modelSettings;
+  std::unique_ptr<PinocchioInterface> pinocchioInterfacePtr;
+  const CentroidalModelInfo centroidalModelInfo;
+  LeggedRobotDynamics dynamics;
+  LeggedRobotDynamicsAD dynamicsAd;
+  PreComputation preComputation;
+};
+
+constexpr bool TestLeggedRobotDynamics::verbose;
+constexpr size_t TestLeggedRobotDynamics::numTests;
+constexpr size_t TestLeggedRobotDynamics::numBenchmarkRuns;
+constexpr scalar_t TestLeggedRobotDynamics::tol;
+
+TEST_P(TestLeggedRobotDynamics, compareWithAutoDiff) {
+  for (size_t i = 0; i < numTests; i++) {
+    const scalar_t t = 0.0;
+    const vector_t x = vector_t::Random(centroidalModelInfo.stateDim);
+    const vector_t u = vector_t::Random(centroidalModelInfo.inputDim);
+
+    const vector_t value = dynamics.computeFlowMap(t, x, u, preComputation);
+    const vector_t valueAd = dynamicsAd.computeFlowMap(t, x, u, preComputation);
+    EXPECT_TRUE(value.isApprox(valueAd, tol));
+
+    const auto approx = dynamics.linearApproximation(t, x, u, preComputation);
+    const auto approxAd = dynamicsAd.linearApproximation(t, x, u, preComputation);
+    EXPECT_TRUE(approx.f.isApprox(approxAd.f, tol));
+    EXPECT_TRUE(approx.dfdx.isApprox(approxAd.dfdx, tol));
+    EXPECT_TRUE(approx.dfdu.isApprox(approxAd.dfdu, tol));
+  }
+}
+
+/** Times the linear approximation of both dynamics on the same states and inputs, which is what the solvers call per node. */
+TEST_P(TestLeggedRobotDynamics, linearApproximationBenchmark) {
+  const scalar_t t = 0.0;
+  const vector_t x0 = vector_t::Random(centroidalModelInfo.stateDim);
+  const vector_t u0 = vector_t::Random(centroidalModelInfo.inputDim);
+
+  benchmark::RepeatedTimer analyticalTimer;
+  benchmark::RepeatedTimer autoDiffTimer;
+  scalar_t checkSum = 0.0;
+  for (size_t i = 0; i < numBenchmarkRuns; i++) {
+    // a different point in every run, such that no evaluation can be reused
+    const vector_t x = x0 + (1e-3 * i) * vector_t::Ones(centroidalModelInfo.stateDim);
+
+    analyticalTimer.startTimer();
+    const auto approx = dynamics.linearApproximation(t, x, u0, preComputation);
+    analyticalTimer.endTimer();
+
+    autoDiffTimer.startTimer();
+    const auto approxAd = dynamicsAd.linearApproximation(t, x, u0, preComputation);
+    autoDiffTimer.endTimer();
+
+    checkSum += approx.dfdx.sum() - approxAd.dfdx.sum();
+  }
+  EXPECT_TRUE(std::isfinite(checkSum));
+
+  if (verbose) {
+    std::cerr << "[TestLeggedRobotDynamics] " << toString(GetParam()) << ", linearApproximation over " << numBenchmarkRuns << " runs:\n"
+              << "  analytical: " << analyticalTimer.getAverageInMilliseconds() << " [ms] average, "
+              << analyticalTimer.getMaxIntervalInMilliseconds() << " [ms] max\n"
+              << "  auto-diff:  " << autoDiffTimer.getAverageInMilliseconds() << " [ms] average, "
+              << autoDiffTimer.getMaxIntervalInMilliseconds() << " [ms] max\n";
+  }
+}
+
+TEST_P(TestLeggedRobotDynamics, clone) {
+  std::unique_ptr<LeggedRobotDynamics> dynamicsPtr(dynamics.clone());
+
+  const scalar_t t = 0.0;
+  const vector_t x = vector_t::Random(centroidalModelInfo.stateDim);
+  const vector_t u = vector_t::Random(centroidalModelInfo.inputDim);
+
+  const auto approx = dynamics.linearApproximation(t, x, u, preComputation);
+  const auto cloneApprox = dynamicsPtr->linearApproximation(t, x, u, preComputation);
+
+  EXPECT_TRUE(approx.f.isApprox(cloneApprox.f));
+  EXPECT_TRUE(approx.dfdx.isApprox(cloneApprox.dfdx));
+  EXPECT_TRUE(approx.dfdu.isApprox(cloneApprox.dfdu));
+}
+
+INSTANTIATE_TEST_CASE_P(TestLeggedRobotDynamicsWithParam, TestLeggedRobotDynamics,
+                        testing::ValuesIn({CentroidalModelType::FullCentroidalDynamics, CentroidalModelType::SingleRigidBodyDynamics}),
+                        [](const testing::TestParamInfo<TestLeggedRobotDynamics::ParamType>& info) { return toString(info.param); });
+
+TEST(TestLeggedRobotInterfaceDynamics, analyticalGradients) {
+  // the task file with the analytical dynamics switched on
+  boost::property_tree::ptree pt;
+  boost::property_tree::read_info(TASK_FILE, pt);
+  pt.put("legged_robot_interface.useAnalyticalGradientsDynamics", true);
+  const std::string analyticalTaskFile = "/tmp/testLeggedRobotDynamics_task.info";
+  boost::property_tree::write_info(analyticalTaskFile, pt);
+
+  LeggedRobotInterface autoDiffInterface(TASK_FILE, URDF_FILE, REFERENCE_FILE);
+  LeggedRobotInterface analyticalInterface(analyticalTaskFile, URDF_FILE, REFERENCE_FILE);
+  auto& autoDiffDynamics = *autoDiffInterface.getOptimalControlProblem().dynamicsPtr;
+  auto& analyticalDynamics = *analyticalInterface.getOptimalControlProblem().dynamicsPtr;
+  ASSERT_NE(dynamic_cast<LeggedRobotDynamics*>(&analyticalDynamics), nullptr);
+  ASSERT_NE(dynamic_cast<LeggedRobotDynamicsAD*>(&autoDiffDynamics), nullptr);
+
+  constexpr scalar_t tol = 1e-6;
+  const auto& info = analyticalInterface.getCentroidalModelInfo();
+  const PreComputation preComputation;
+  for (size_t i = 0; i < 10; i++) {
+    const scalar_t t = 0.0;
+    const vector_t x = analyticalInterface.getInitialState() + 0.1 * vector_t::Random(info.stateDim);
+    const vector_t u = vector_t::Random(info.inputDim);
+
+    const auto approx = analyticalDynamics.linearApproximation(t, x, u, preComputation);
+    const auto approxAd = autoDiffDynamics.linearApproximation(t, x, u, preComputation);
+    EXPECT_TRUE(approx.f.isApprox(approxAd.f, tol));
+    EXPECT_TRUE(approx.dfdx.isApprox(approxAd.dfdx, tol));
+    EXPECT_TRUE(approx.dfdu.isApprox(approxAd.dfdu, tol));
+  }
+}
@@ -0,0 +1,150 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <string>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_ipm/IpmSolver.h>
+#include <ocs2_robotic_assets/package_path.h>
+#include <ocs2_sqp/SqpSolver.h>
+
+#include "ocs2_legged_robot/LeggedRobotInterface.h"
+#include "ocs2_legged_robot/package_path.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+namespace {
+const std::string URDF_FILE = ocs2::robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+const std::string TASK_FILE = ocs2::legged_robot::getPath() + "/config/mpc/" + "task.info";
+const std::string REFERENCE_FILE = ocs2::legged_robot::getPath() + "/config/command/" + "reference.info";
+}  // unnamed namespace
+
+/**
+ * Compares the dense projection of the state-input equality constraints with the structured one (see structuredProjection in the
+ * solver settings) on the MPC of the legged robot. Both solvers follow the same closed-loop sequence of MPC calls, the solutions have
+ * to agree and the average wall time per call is printed.
+ */
+class TestProjectionBenchmark : public ::testing::Test {
+ protected:
+  static constexpr bool verbose = true;
+  static constexpr size_t numMpcCalls = 50;
+  static constexpr scalar_t mpcTimeStep = 0.01;
+  static constexpr scalar_t tolerance = 1e-6;
+
+  TestProjectionBenchmark() : interface(TASK_FILE, URDF_FILE, REFERENCE_FILE) {
+    const vector_t initialState = interface.getInitialState();
+    const vector_t zeroInput = vector_t::Zero(interface.getCentroidalModelInfo().inputDim);
+    interface.getReferenceManagerPtr()->setTargetTrajectories(TargetTrajectories({0.0}, {initialState}, {zeroInput}));
+  }
+
+  /** Runs both solvers on the same sequence of MPC problems, which follows the prediction of the dense solver. */
+  template <typename Solver>
+  void runMpc(Solver& denseSolver, Solver& structuredSolver, const std::string& name) {
+    benchmark::RepeatedTimer denseTimer;
+    benchmark::RepeatedTimer structuredTimer;
+    const scalar_t timeHorizon = interface.mpcSettings().timeHorizon_;
+    vector_t state = interface.getInitialState();
+    for (size_t i = 0; i < numMpcCalls; i++) {
+      const scalar_t time = i * mpcTimeStep;
+      const scalar_t finalTime = time + timeHorizon;
+
+      denseTimer.startTimer();
+      denseSolver.run(time, state, finalTime);
+      denseTimer.endTimer();
+
+      structuredTimer.startTimer();
+      structuredSolver.run(time, state, finalTime);
+      structuredTimer.endTimer();
+
+      const auto& denseSolution = denseSolver.primalSolution(finalTime);
+      const auto& structuredSolution = structuredSolver.primalSolution(finalTime);
+      ASSERT_EQ(denseSolution.stateTrajectory_.size(), structuredSolution.stateTrajectory_.size());
+      for (size_t k = 0; k < denseSolution.stateTrajectory_.size(); k++) {
+        ASSERT_TRUE(denseSolution.stateTrajectory_[k].isApprox(structuredSolution.stateTrajectory_[k], tolerance)) << "MPC call " << i;
+        ASSERT_TRUE(denseSolution.inputTrajectory_[k].isApprox(structuredSolution.inputTrajectory_[k], tolerance)) << "MPC call " << i;
+      }
+
+      // follow the prediction of the MPC
+      state = LinearInterpolation::interpolate(time + mpcTimeStep, denseSolution.timeTrajectory_, denseSolution.stateTrajectory_);
+    }
+
+    if (verbose) {
+      std::cerr << "[TestProjectionBenchmark] " << name << " over " << numMpcCalls << " MPC calls:\n"
+                << "  dense projection:      " << denseTimer.getAverageInMilliseconds() << " [ms] per call\n"
+                << "  structured projection: " << structuredTimer.getAverageInMilliseconds() << " [ms] per call\n";
+    }
+  }
+
+  LeggedRobotInterface interface;
+};
+
+constexpr bool TestProjectionBenchmark::verbose;
+constexpr size_t TestProjectionBenchmark::numMpcCalls;
+constexpr scalar_t TestProjectionBenchmark::mpcTimeStep;
+constexpr scalar_t TestProjectionBenchmark::tolerance;
+
+TEST_F(TestProjectionBenchmark, sqp) {
+  auto settings = interface.sqpSettings();
+  settings.threadPriority = 0;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  settings.structuredProjection = false;
+  SqpSolver denseSolver(settings, interface.getOptimalControlProblem(), interface.getInitializer());
+  denseSolver.setReferenceManager(interface.getReferenceManagerPtr());
+
+  settings.structuredProjection = true;
+  SqpSolver structuredSolver(settings, interface.getOptimalControlProblem(), interface.getInitializer());
+  structuredSolver.setReferenceManager(interface.getReferenceManagerPtr());
+
+  runMpc(denseSolver, structuredSolver, "SQP");
+}
+
+TEST_F(TestProjectionBenchmark, ipm) {
+  auto settings = interface.ipmSettings();
+  settings.threadPriority = 0;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  settings.structuredProjection = false;
+  IpmSolver denseSolver(settings, interface.getOptimalControlProblem(), interface.getInitializer());
+  denseSolver.setReferenceManager(interface.getReferenceManagerPtr());
+
+  settings.structuredProjection = true;
+  IpmSolver structuredSolver(settings, interface.getOptimalControlProblem(), interface.getInitializer());
+  structuredSolver.setReferenceManager(interface.getReferenceManagerPtr());
+
+  runMpc(denseSolver, structuredSolver, "IPM");
+}
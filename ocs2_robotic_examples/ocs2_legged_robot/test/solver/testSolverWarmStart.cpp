@@ -0,0 +1,158 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <string>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_ipm/IpmSolver.h>
+#include <ocs2_robotic_assets/package_path.h>
+#include <ocs2_sqp/SqpSolver.h>
+
+#include "ocs2_legged_robot/LeggedRobotInterface.h"
+#include "ocs2_legged_robot/package_path.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+namespace {
+const std::string URDF_FILE = ocs2::robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+const std::string TASK_FILE = ocs2::legged_robot::getPath() + "/config/mpc/" + "task.info";
+const std::string REFERENCE_FILE = ocs2::legged_robot::getPath() + "/config/command/" + "reference.info";
+
+/** Statistics of a sequence of MPC calls */
+struct MpcStatistics {
+  size_t numIterations = 0;
+  scalar_t merit = 0.0;  // sum of the merit of the returned solutions
+  benchmark::RepeatedTimer timer;
+};
+}  // unnamed namespace
+
+/**
+ * Runs the MPC in closed loop, once solving every problem from scratch and once warm-started from the previous solution (shifted iterate
+ * and multipliers). Both solvers get the same iteration cap and solve the same sequence of problems, which follows the prediction of the
+ * cold-started solver. The warm-started solver has to reach a solution of at least the same quality, i.e. a lower or equal merit, with at
+ * most as many iterations.
+ */
+class TestSolverWarmStart : public ::testing::Test {
+ protected:
+  static constexpr bool verbose = true;
+  static constexpr size_t numMpcCalls = 50;
+  static constexpr size_t maxNumIterations = 3;
+  static constexpr scalar_t mpcTimeStep = 0.01;
+
+  TestSolverWarmStart() : interface(TASK_FILE, URDF_FILE, REFERENCE_FILE) {
+    const vector_t initialState = interface.getInitialState();
+    const vector_t zeroInput = vector_t::Zero(interface.getCentroidalModelInfo().inputDim);
+    interface.getReferenceManagerPtr()->setTargetTrajectories(TargetTrajectories({0.0}, {initialState}, {zeroInput}));
+  }
+
+  template <typename Solver>
+  void runMpc(Solver& coldStartSolver, Solver& warmStartSolver, const std::string& name) {
+    MpcStatistics coldStart;
+    MpcStatistics warmStart;
+    const auto solve = [](Solver& solver, scalar_t time, const vector_t& state, scalar_t finalTime, MpcStatistics& statistics) {
+      statistics.timer.startTimer();
+      solver.run(time, state, finalTime);
+      statistics.timer.endTimer();
+      statistics.numIterations += solver.getIterationsLog().size();
+      statistics.merit += solver.getPerformanceIndeces().merit;
+    };
+
+    const scalar_t timeHorizon = interface.mpcSettings().timeHorizon_;
+    vector_t state = interface.getInitialState();
+    for (size_t i = 0; i < numMpcCalls; i++) {
+      const scalar_t time = i * mpcTimeStep;
+      coldStartSolver.reset();
+      solve(coldStartSolver, time, state, time + timeHorizon, coldStart);
+      solve(warmStartSolver, time, state, time + timeHorizon, warmStart);
+
+      // follow the prediction of the MPC
+      const auto& primalSolution = coldStartSolver.primalSolution(time + timeHorizon);
+      state = LinearInterpolation::interpolate(time + mpcTimeStep, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+    }
+
+    if (verbose) {
+      std::cerr << "[TestSolverWarmStart] " << name << " over " << numMpcCalls << " MPC calls, at most " << maxNumIterations
+                << " iterations per call:\n"
+                << "  without warm start: " << coldStart.numIterations << " iterations, merit " << coldStart.merit << ", "
+                << coldStart.timer.getAverageInMilliseconds() << " [ms] per call\n"
+                << "  with warm start:    " << warmStart.numIterations << " iterations, merit " << warmStart.merit << ", "
+                << warmStart.timer.getAverageInMilliseconds() << " [ms] per call\n";
+    }
+    EXPECT_LE(warmStart.numIterations, coldStart.numIterations);
+    EXPECT_LE(warmStart.merit, coldStart.merit);
+  }
+
+  LeggedRobotInterface interface;
+};
+
+constexpr bool TestSolverWarmStart::verbose;
+constexpr size_t TestSolverWarmStart::numMpcCalls;
+constexpr size_t TestSolverWarmStart::maxNumIterations;
+constexpr scalar_t TestSolverWarmStart::mpcTimeStep;
+
+TEST_F(TestSolverWarmStart, sqp) {
+  auto settings = interface.sqpSettings();
+  settings.sqpIteration = maxNumIterations;
+  settings.warmStartSqpIteration = maxNumIterations;
+  settings.threadPriority = 0;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  SqpSolver coldStartSolver(settings, interface.getOptimalControlProblem(), interface.getInitializer());
+  coldStartSolver.setReferenceManager(interface.getReferenceManagerPtr());
+
+  settings.hpipmSettings.warm_start = 1;
+  SqpSolver warmStartSolver(settings, interface.getOptimalControlProblem(), interface.getInitializer());
+  warmStartSolver.setReferenceManager(interface.getReferenceManagerPtr());
+
+  runMpc(coldStartSolver, warmStartSolver, "SQP");
+}
+
+TEST_F(TestSolverWarmStart, ipm) {
+  auto settings = interface.ipmSettings();
+  settings.ipmIteration = maxNumIterations;
+  settings.warmStartIpmIteration = maxNumIterations;
+  settings.threadPriority = 0;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  IpmSolver coldStartSolver(settings, interface.getOptimalControlProblem(), interface.getInitializer());
+  coldStartSolver.setReferenceManager(interface.getReferenceManagerPtr());
+
+  IpmSolver warmStartSolver(settings, interface.getOptimalControlProblem(), interface.getInitializer());
+  warmStartSolver.setReferenceManager(interface.getReferenceManagerPtr());
+
+  runMpc(coldStartSolver, warmStartSolver, "IPM");
+}
@@ -44,8 +44,14 @@ class QuadraticInputCost final : public QuadraticStateInputCost {
   QuadraticInputCost(const QuadraticInputCost& rhs) = default;
   QuadraticInputCost* clone() const override { return new QuadraticInputCost(*this); }
 
+  using QuadraticStateInputCost::getStateInputDeviation;
   std::pair<vector_t, vector_t> getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
-                                                       const TargetTrajectories& targetTrajectories) const override {
+                                                       const TargetTrajectories& targetTrajectories,
+                                                       const PreComputation& preComp) const override {
+    const vector_t* uNominalPtr = preComp.getCachedDesiredInput(time);
+    if (uNominalPtr != nullptr) {
+      return {vector_t::Zero(stateDim_), input - *uNominalPtr};
+    }
     const vector_t inputDeviation = input - targetTrajectories.getDesiredInput(time);
     return {vector_t::Zero(stateDim_), inputDeviation};
   }
@@ -189,13 +189,10 @@ void MRT_ROS_Interface::readPolicyMsg(const ocs2_msgs::mpc_flattened_controller&
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_ROS_Interface::mpcPolicyCallback(const ocs2_msgs::mpc_flattened_controller::ConstPtr& msg) {
-  // read new policy and command from msg
-  auto commandPtr = std::make_unique<CommandData>();
-  auto primalSolutionPtr = std::make_unique<PrimalSolution>();
-  auto performanceIndicesPtr = std::make_unique<PerformanceIndex>();
-  readPolicyMsg(*msg, *commandPtr, *primalSolutionPtr, *performanceIndicesPtr);
-
-  this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+  // read new policy and command from msg into the recycled buffer of an older policy
+  this->fillBuffer([&](CommandData& commandData, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices) {
+    readPolicyMsg(*msg, commandData, primalSolution, performanceIndices);
+  });
 }
 
 /******************************************************************************************************/
@@ -73,6 +73,8 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  bool threadPoolWorkStealing = false;  // Use the work-stealing thread pool with allocation-free parallel tasks
+  size_t threadSpinDuration = 0;        // [us] Time idle threads busy-wait for work before sleeping (work-stealing only)
 
   // LP subproblem solver settings
   pipg::Settings pipgSettings = pipg::Settings();
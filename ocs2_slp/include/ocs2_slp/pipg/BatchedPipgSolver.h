@@ -0,0 +1,126 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_oc/oc_problem/OcpSize.h>
+
+#include "ocs2_slp/pipg/PipgBounds.h"
+#include "ocs2_slp/pipg/PipgSettings.h"
+#include "ocs2_slp/pipg/PipgSolverStatus.h"
+
+namespace ocs2 {
+
+/**
+ * Solves a batch of optimal control problems with the same structure (OcpSize) but different numerical data. It runs the same PIPG
+ * iterations as PipgSolver for all problems at once.
+ *
+ * The data of the problems is interleaved, i.e. the problem index is the innermost dimension: the element (i, j) of a matrix is stored
+ * contiguously for all problems. Each matrix-vector product of the PIPG update thus becomes a sequence of element-wise multiply-adds over
+ * the problems, which Eigen vectorizes with the available SIMD instruction set (e.g. AVX2 or AVX-512 with -march=native). The problems are
+ * processed in blocks of 16 lanes, so the batch size is best a multiple of 16.
+ *
+ * Every problem (lane) has its own step sizes and termination check. A lane that has converged is masked: its solution is extracted at
+ * the iteration in which it converged, so its result is the same as the one of PipgSolver (up to round-off). The iterations stop when
+ * all lanes have converged or the maximum number of iterations is reached.
+ */
+class BatchedPipgSolver {
+ public:
+  /**
+   * Constructor.
+   * @param[in] Settings: PIPG setting
+   */
+  explicit BatchedPipgSolver(pipg::Settings settings);
+
+  /**
+   * Solves the batch of problems. The arguments have the same meaning as in PipgSolver::solve, with one entry per problem.
+   *
+   * @param [in] x0 : Initial states.
+   * @param [in] dynamics : Dynamics arrays.
+   * @param [in] cost : Cost arrays.
+   * @param [in] scalingVectors : Scaling vectors of the dynamics.
+   * @param [in] EInv : Inverse of the scaling factors E. Pass nullptr if the problems are not scaled.
+   * @param [in] pipgBounds : The PipgBounds of the problems.
+   * @param [out] xTrajectories : The optimized state trajectories.
+   * @param [out] uTrajectories : The optimized input trajectories.
+   * @return The solver status of every problem.
+   */
+  std::vector<pipg::SolverStatus> solve(const vector_array_t& x0, const std::vector<std::vector<VectorFunctionLinearApproximation>>& dynamics,
+                                        const std::vector<std::vector<ScalarFunctionQuadraticApproximation>>& cost,
+                                        const std::vector<vector_array_t>& scalingVectors, const std::vector<vector_array_t>* EInv,
+                                        const std::vector<pipg::PipgBounds>& pipgBounds, std::vector<vector_array_t>& xTrajectories,
+                                        std::vector<vector_array_t>& uTrajectories);
+
+  /**
+   * Sets the structure of the problems and the batch size.
+   *
+   * @param [in] size : The size of every problem of the batch.
+   * @param [in] batchSize : The number of problems.
+   */
+  void resize(const OcpSize& size, size_t batchSize);
+
+  /** The number of iterations of every problem of the last solve. */
+  const std::vector<size_t>& getNumIterations() const { return numIterations_; }
+
+  const OcpSize& size() const { return ocpSize_; }
+  size_t batchSize() const { return batchSize_; }
+  const pipg::Settings& settings() const { return settings_; }
+
+ private:
+  void packProblems(const vector_array_t& x0, const std::vector<std::vector<VectorFunctionLinearApproximation>>& dynamics,
+                    const std::vector<std::vector<ScalarFunctionQuadraticApproximation>>& cost,
+                    const std::vector<vector_array_t>& scalingVectors, const std::vector<vector_array_t>* EInv);
+
+  void unpackSolution(size_t lane, vector_array_t& xTrajectory, vector_array_t& uTrajectory) const;
+
+  // Settings
+  const pipg::Settings settings_;
+
+  // Problem size
+  OcpSize ocpSize_;
+  size_t batchSize_ = 0;
+
+  // Interleaved problem data. A vector of size n is stored as a (batchSize x n) matrix and a (rows x cols) matrix as a
+  // (batchSize x rows * cols) matrix, in which the column (i + j * rows) holds the element (i, j) of all problems.
+  matrix_array_t A_, B_, b_, C_, EInv_;
+  matrix_array_t Q_, R_, P_, q_, r_;
+  matrix_t x0_;
+
+  // Interleaved iterates
+  matrix_array_t X_, U_, W_, V_;
+  matrix_array_t XNew_, UNew_, WNew_;
+  matrix_array_t primalResidual_;
+
+  std::vector<size_t> numIterations_;
+};
+
+}  // namespace ocs2
@@ -46,6 +46,12 @@ struct Settings {
   scalar_t lowerBoundH = 5e-6;
   /** This value determines to display the a summary log. */
   bool displayShortSummary = false;
+  /**
+   * Iteration engine. If false, the threads claim the stages one by one and wait for the end of an iteration on a condition variable.
+   * If true, every thread owns a contiguous block of stages, balanced by their computational cost, and the iterations are synchronized
+   * by a spin barrier. The latter has a lower synchronization overhead but requires the threads of the pool to be free during the solve.
+   */
+  bool useSpinBarrier = false;
 };
 
 /**
@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/VectorTrajectory.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
 
@@ -103,8 +104,8 @@ class PipgSolver {
   int numDynamicsConstraints_;
 
   // Data buffer for parallelized PIPG
-  vector_array_t X_, W_, V_, U_;
-  vector_array_t XNew_, UNew_, WNew_;
+  VectorTrajectory X_, W_, V_, U_;
+  VectorTrajectory XNew_, UNew_, WNew_;
 };
 
 }  // namespace ocs2
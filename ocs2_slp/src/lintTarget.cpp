@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <ocs2_slp/pipg/BatchedPipgSolver.h>
 #include <ocs2_slp/pipg/PipgBounds.h>
 #include <ocs2_slp/pipg/PipgSettings.h>
 #include <ocs2_slp/pipg/PipgSolver.h>
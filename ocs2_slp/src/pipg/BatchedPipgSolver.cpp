@@ -0,0 +1,367 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_slp/pipg/BatchedPipgSolver.h"
+
+#include <stdexcept>
+
+namespace ocs2 {
+
+namespace {
+
+/** Number of lanes that are processed together. Their partial sums stay in SIMD registers. */
+constexpr Eigen::Index laneBlockSize = 16;
+
+/**
+ * y += sign * M * x (or M^T * x if Transposed) for the lanes [firstLane, firstLane + NumLanes), where M is an interleaved matrix, and x
+ * and y are interleaved vectors. Every term is an element-wise multiply-add over the contiguous lanes.
+ */
+template <bool Transposed, int NumLanes>
+void addProductBlock(const matrix_t& M, const matrix_t& x, scalar_t sign, Eigen::Index firstLane, matrix_t& y) {
+  using lane_array_t = Eigen::Array<scalar_t, NumLanes, 1>;
+  const Eigen::Index numRowsM = Transposed ? x.cols() : y.cols();
+  for (Eigen::Index i = 0; i < y.cols(); i++) {
+    lane_array_t sum = lane_array_t::Zero();
+    for (Eigen::Index j = 0; j < x.cols(); j++) {
+      const Eigen::Index element = Transposed ? j + i * numRowsM : i + j * numRowsM;
+      sum += M.col(element).template segment<NumLanes>(firstLane).array() * x.col(j).template segment<NumLanes>(firstLane).array();
+    }
+    y.col(i).template segment<NumLanes>(firstLane).array() += sign * sum;
+  }
+}
+
+/** y += sign * M * x for all lanes, where M is an interleaved (y.cols() x x.cols()) matrix, and x and y are interleaved vectors. */
+void addProduct(const matrix_t& M, const matrix_t& x, scalar_t sign, matrix_t& y) {
+  Eigen::Index lane = 0;
+  for (; lane + laneBlockSize <= y.rows(); lane += laneBlockSize) {
+    addProductBlock<false, laneBlockSize>(M, x, sign, lane, y);
+  }
+  for (; lane < y.rows(); lane++) {
+    addProductBlock<false, 1>(M, x, sign, lane, y);
+  }
+}
+
+/** y += sign * M^T * x for all lanes, where M is an interleaved (x.cols() x y.cols()) matrix, and x and y are interleaved vectors. */
+void addTransposedProduct(const matrix_t& M, const matrix_t& x, scalar_t sign, matrix_t& y) {
+  Eigen::Index lane = 0;
+  for (; lane + laneBlockSize <= y.rows(); lane += laneBlockSize) {
+    addProductBlock<true, laneBlockSize>(M, x, sign, lane, y);
+  }
+  for (; lane < y.rows(); lane++) {
+    addProductBlock<true, 1>(M, x, sign, lane, y);
+  }
+}
+
+/** Copies a matrix (or vector) of a problem into the given lane of its interleaved representation. */
+void packLane(const matrix_t& M, size_t lane, matrix_t& interleaved) {
+  if (interleaved.cols() != M.size()) {
+    throw std::runtime_error("[BatchedPipgSolver] Inconsistent dimensions of problem " + std::to_string(lane) +
+                             ". Call resize() with the size of the problems.");
+  }
+  interleaved.row(lane) = Eigen::Map<const vector_t>(M.data(), M.size()).transpose();
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BatchedPipgSolver::BatchedPipgSolver(pipg::Settings settings) : settings_(std::move(settings)) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<pipg::SolverStatus> BatchedPipgSolver::solve(const vector_array_t& x0,
+                                                         const std::vector<std::vector<VectorFunctionLinearApproximation>>& dynamics,
+                                                         const std::vector<std::vector<ScalarFunctionQuadraticApproximation>>& cost,
+                                                         const std::vector<vector_array_t>& scalingVectors,
+                                                         const std::vector<vector_array_t>* EInv,
+                                                         const std::vector<pipg::PipgBounds>& pipgBounds,
+                                                         std::vector<vector_array_t>& xTrajectories,
+                                                         std::vector<vector_array_t>& uTrajectories) {
+  const int N = ocpSize_.numStages;
+  const size_t numLanes = batchSize_;
+  if (N < 1) {
+    throw std::runtime_error("[BatchedPipgSolver::solve] The number of stages cannot be less than 1.");
+  }
+  if (pipgBounds.size() != numLanes) {
+    throw std::runtime_error("[BatchedPipgSolver::solve] The size of pipgBounds doesn't match the batch size.");
+  }
+  packProblems(x0, dynamics, cost, scalingVectors, EInv);
+
+  // cold start
+  for (int t = 0; t < N; t++) {
+    X_[t + 1].setZero();
+    U_[t].setZero();
+    W_[t].setZero();
+    // WNew_ will NOT be filled, but will be swapped to W_ in iteration 0. Thus, initialize WNew_ here.
+    WNew_[t].setZero();
+  }
+  // initial state
+  X_[0] = x0_;
+  XNew_[0] = x0_;
+
+  // step sizes of every lane
+  vector_t alpha(numLanes), beta(numLanes), betaLast = vector_t::Zero(numLanes), betaSum(numLanes);
+  for (size_t l = 0; l < numLanes; l++) {
+    alpha(l) = pipgBounds[l].primalStepSize(0);
+    beta(l) = pipgBounds[l].primalStepSize(0);
+  }
+
+  // termination of every lane
+  vector_t constraintsViolationInfNorm(numLanes), solutionSSE(numLanes), solutionSquaredNorm(numLanes);
+  std::vector<pipg::SolverStatus> status(numLanes, pipg::SolverStatus::UNDEFINED);
+  numIterations_.assign(numLanes, 0);
+  xTrajectories.resize(numLanes);
+  uTrajectories.resize(numLanes);
+
+  size_t k = 0;
+  size_t numActiveLanes = numLanes;
+  while (numActiveLanes > 0) {
+    const bool checkTermination = k != 0 && k % settings().checkTerminationInterval == 0;
+    if (checkTermination) {
+      constraintsViolationInfNorm.setZero();
+      solutionSSE.setZero();
+      solutionSquaredNorm.setZero();
+    }
+    betaSum = beta + betaLast;
+
+    // Primal residual of the iterate k - 1, dual update of the iteration k - 1 and the dual extrapolation V.
+    for (int t = 1; t <= N; t++) {
+      // primalResidual = C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b;
+      auto& primalResidual = primalResidual_[t - 1];
+      primalResidual = C_[t - 1].cwiseProduct(X_[t]) - b_[t - 1];
+      addProduct(A_[t - 1], X_[t - 1], -1.0, primalResidual);
+      addProduct(B_[t - 1], U_[t - 1], -1.0, primalResidual);
+
+      if (k != 0) {
+        // WNew_[t - 1] = W_[t - 1] + betaLast * primalResidual
+        WNew_[t - 1] = W_[t - 1] + (primalResidual.array().colwise() * betaLast.array()).matrix();
+
+        if (checkTermination) {
+          if (!EInv_.empty()) {
+            constraintsViolationInfNorm =
+                constraintsViolationInfNorm.cwiseMax(EInv_[t - 1].cwiseProduct(primalResidual).cwiseAbs().rowwise().maxCoeff());
+          } else {
+            constraintsViolationInfNorm = constraintsViolationInfNorm.cwiseMax(primalResidual.cwiseAbs().rowwise().maxCoeff());
+          }
+          // What stored in UNew and XNew is the solution of iteration k - 2 and what stored in U and X is the solution of iteration k - 1.
+          solutionSSE += (UNew_[t - 1] - U_[t - 1]).rowwise().squaredNorm() + (XNew_[t] - X_[t]).rowwise().squaredNorm();
+          solutionSquaredNorm += U_[t - 1].rowwise().squaredNorm() + X_[t].rowwise().squaredNorm();
+        }
+      }
+
+      // V_[t - 1] = W_[t - 1] + (beta + betaLast) * primalResidual;
+      V_[t - 1] = W_[t - 1] + (primalResidual.array().colwise() * betaSum.array()).matrix();
+    }
+
+    // Primal update of the iteration k
+    for (int t = 1; t <= N; t++) {
+      // UNew_[t - 1] = U_[t - 1] - alpha * (R * U_[t - 1] + P * X_[t - 1] + r - B.transpose() * V_[t - 1]);
+      auto& UNew = UNew_[t - 1];
+      UNew = r_[t - 1];
+      addProduct(R_[t - 1], U_[t - 1], 1.0, UNew);
+      addProduct(P_[t - 1], X_[t - 1], 1.0, UNew);
+      addTransposedProduct(B_[t - 1], V_[t - 1], -1.0, UNew);
+      UNew.array().colwise() *= -alpha.array();
+      UNew += U_[t - 1];
+
+      // XNew_[t] = X_[t] - alpha * (Q * X_[t] + q + C * V_[t - 1] - ANext.transpose() * V_[t] + PNext.transpose() * U_[t]);
+      auto& XNew = XNew_[t];
+      XNew = q_[t] + C_[t - 1].cwiseProduct(V_[t - 1]);
+      addProduct(Q_[t], X_[t], 1.0, XNew);
+      if (t != N) {
+        addTransposedProduct(A_[t], V_[t], -1.0, XNew);
+        addTransposedProduct(P_[t], U_[t], 1.0, XNew);
+      }
+      XNew.array().colwise() *= -alpha.array();
+      XNew += X_[t];
+    }
+
+    betaLast = beta;
+    // Adaptive step size
+    for (size_t l = 0; l < numLanes; l++) {
+      beta(l) = pipgBounds[l].dualStepSize(k);
+      alpha(l) = pipgBounds[l].primalStepSize(k);
+    }
+
+    // Convergence mask: the lanes that terminate in this iteration
+    std::vector<size_t> terminatedLanes;
+    if (checkTermination) {
+      for (size_t l = 0; l < numLanes; l++) {
+        if (status[l] != pipg::SolverStatus::UNDEFINED) {
+          continue;
+        }
+        const bool isConverged = constraintsViolationInfNorm(l) <= settings().absoluteTolerance &&
+                                 (solutionSSE(l) <= settings().relativeTolerance * settings().relativeTolerance * solutionSquaredNorm(l) ||
+                                  solutionSSE(l) <= settings().absoluteTolerance);
+        if (isConverged || k >= settings().maxNumIterations) {
+          status[l] = isConverged ? pipg::SolverStatus::SUCCESS : pipg::SolverStatus::MAX_ITER;
+          terminatedLanes.push_back(l);
+        }
+      }
+    }
+
+    X_.swap(XNew_);
+    U_.swap(UNew_);
+    W_.swap(WNew_);
+    ++k;
+
+    for (const auto l : terminatedLanes) {
+      numIterations_[l] = k;
+      unpackSolution(l, xTrajectories[l], uTrajectories[l]);
+    }
+    numActiveLanes -= terminatedLanes.size();
+  }
+
+  return status;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchedPipgSolver::resize(const OcpSize& ocpSize, size_t batchSize) {
+  if (ocpSize_ == ocpSize && batchSize_ == batchSize) {
+    return;
+  }
+
+  ocpSize_ = ocpSize;
+  batchSize_ = batchSize;
+  const int N = ocpSize_.numStages;
+  const auto& nx = ocpSize_.numStates;
+  const auto& nu = ocpSize_.numInputs;
+  const auto numLanes = static_cast<Eigen::Index>(batchSize_);
+
+  A_.resize(N);
+  B_.resize(N);
+  b_.resize(N);
+  C_.resize(N);
+  R_.resize(N);
+  P_.resize(N);
+  r_.resize(N);
+  Q_.resize(N + 1);
+  q_.resize(N + 1);
+  x0_.resize(numLanes, nx[0]);
+
+  X_.resize(N + 1);
+  XNew_.resize(N + 1);
+  U_.resize(N);
+  UNew_.resize(N);
+  W_.resize(N);
+  WNew_.resize(N);
+  V_.resize(N);
+  primalResidual_.resize(N);
+
+  for (int t = 0; t < N; t++) {
+    A_[t].resize(numLanes, nx[t + 1] * nx[t]);
+    B_[t].resize(numLanes, nx[t + 1] * nu[t]);
+    b_[t].resize(numLanes, nx[t + 1]);
+    C_[t].resize(numLanes, nx[t + 1]);
+    R_[t].resize(numLanes, nu[t] * nu[t]);
+    P_[t].resize(numLanes, nu[t] * nx[t]);
+    r_[t].resize(numLanes, nu[t]);
+
+    U_[t].setZero(numLanes, nu[t]);
+    UNew_[t].setZero(numLanes, nu[t]);
+    W_[t].setZero(numLanes, nx[t + 1]);
+    WNew_[t].setZero(numLanes, nx[t + 1]);
+    V_[t].setZero(numLanes, nx[t + 1]);
+    primalResidual_[t].setZero(numLanes, nx[t + 1]);
+  }
+  for (int t = 0; t <= N; t++) {
+    Q_[t].resize(numLanes, nx[t] * nx[t]);
+    q_[t].resize(numLanes, nx[t]);
+    X_[t].setZero(numLanes, nx[t]);
+    XNew_[t].setZero(numLanes, nx[t]);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchedPipgSolver::packProblems(const vector_array_t& x0, const std::vector<std::vector<VectorFunctionLinearApproximation>>& dynamics,
+                                     const std::vector<std::vector<ScalarFunctionQuadraticApproximation>>& cost,
+                                     const std::vector<vector_array_t>& scalingVectors, const std::vector<vector_array_t>* EInv) {
+  const size_t N = ocpSize_.numStages;
+  if (x0.size() != batchSize_ || dynamics.size() != batchSize_ || cost.size() != batchSize_ || scalingVectors.size() != batchSize_ ||
+      (EInv != nullptr && EInv->size() != batchSize_)) {
+    throw std::runtime_error("[BatchedPipgSolver::packProblems] The number of problems doesn't match the batch size: " +
+                             std::to_string(batchSize_));
+  }
+
+  if (EInv != nullptr) {
+    EInv_.resize(N);
+    for (size_t t = 0; t < N; t++) {
+      EInv_[t].resize(batchSize_, ocpSize_.numStates[t + 1]);
+    }
+  } else {
+    EInv_.clear();
+  }
+
+  for (size_t l = 0; l < batchSize_; l++) {
+    if (dynamics[l].size() != N || cost[l].size() != N + 1 || scalingVectors[l].size() != N ||
+        (EInv != nullptr && (*EInv)[l].size() != N)) {
+      throw std::runtime_error("[BatchedPipgSolver::packProblems] Inconsistent number of stages of problem " + std::to_string(l) + ".");
+    }
+
+    packLane(x0[l], l, x0_);
+    for (size_t t = 0; t < N; t++) {
+      packLane(dynamics[l][t].dfdx, l, A_[t]);
+      packLane(dynamics[l][t].dfdu, l, B_[t]);
+      packLane(dynamics[l][t].f, l, b_[t]);
+      packLane(scalingVectors[l][t], l, C_[t]);
+      packLane(cost[l][t].dfduu, l, R_[t]);
+      packLane(cost[l][t].dfdux, l, P_[t]);
+      packLane(cost[l][t].dfdu, l, r_[t]);
+      if (EInv != nullptr) {
+        packLane((*EInv)[l][t], l, EInv_[t]);
+      }
+    }
+    for (size_t t = 0; t <= N; t++) {
+      packLane(cost[l][t].dfdxx, l, Q_[t]);
+      packLane(cost[l][t].dfdx, l, q_[t]);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void BatchedPipgSolver::unpackSolution(size_t lane, vector_array_t& xTrajectory, vector_array_t& uTrajectory) const {
+  xTrajectory.resize(X_.size());
+  for (size_t t = 0; t < X_.size(); t++) {
+    xTrajectory[t] = X_[t].row(lane).transpose();
+  }
+  uTrajectory.resize(U_.size());
+  for (size_t t = 0; t < U_.size(); t++) {
+    uTrajectory[t] = U_[t].row(lane).transpose();
+  }
+}
+
+}  // namespace ocs2
@@ -57,6 +57,7 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.checkTerminationInterval, fieldName + ".checkTerminationInterval", verbose);
   loadData::loadPtreeValue(pt, settings.displayShortSummary, fieldName + ".displayShortSummary", verbose);
+  loadData::loadPtreeValue(pt, settings.useSpinBarrier, fieldName + ".useSpinBarrier", verbose);
 
   if (verbose) {
     std::cerr << " #### }\n";
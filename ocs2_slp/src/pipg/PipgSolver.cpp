@@ -29,13 +29,55 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_slp/pipg/PipgSolver.h"
 
+#include <algorithm>
 #include <condition_variable>
 #include <iostream>
 #include <mutex>
 #include <numeric>
 
+#include <ocs2_core/thread_support/SpinBarrier.h>
+
 namespace ocs2 {
 
+namespace {
+
+/**
+ * Partitions the stages 1, ..., N into contiguous blocks of similar computational cost.
+ *
+ * @return The first stage of every block followed by N + 1, i.e. the block i holds the stages in [boundaries[i], boundaries[i + 1]).
+ */
+std::vector<int> partitionStages(const OcpSize& ocpSize, int numBlocks) {
+  const int N = ocpSize.numStages;
+  const auto& nx = ocpSize.numStates;
+  const auto& nu = ocpSize.numInputs;
+
+  // cumulativeCost[t]: number of multiply-adds of the stages 1, ..., t
+  std::vector<scalar_t> cumulativeCost(N + 1, 0.0);
+  for (int t = 1; t <= N; t++) {
+    scalar_t stageCost = 2 * nx[t] * (nx[t - 1] + nu[t - 1]) + nu[t - 1] * (nu[t - 1] + nx[t - 1]) + nx[t] * nx[t];
+    if (t != N) {
+      stageCost += 2 * nx[t + 1] * (nx[t] + nu[t]) + nx[t] * nu[t];
+    }
+    cumulativeCost[t] = cumulativeCost[t - 1] + stageCost;
+  }
+
+  std::vector<int> boundaries(numBlocks + 1);
+  boundaries[0] = 1;
+  boundaries[numBlocks] = N + 1;
+  for (int i = 1; i < numBlocks; i++) {
+    // every block holds at least one stage
+    const scalar_t targetCost = cumulativeCost[N] * i / numBlocks;
+    int t = boundaries[i - 1] + 1;
+    while (t < N + 1 - (numBlocks - i) && cumulativeCost[t - 1] < targetCost) {
+      t++;
+    }
+    boundaries[i] = t;
+  }
+  return boundaries;
+}
+
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -71,167 +113,203 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
   scalar_array_t solutionSEArray(N);
   scalar_array_t solutionSquaredNormArray(N);
 
+  // cold start
+  X_.setZero();
+  U_.setZero();
+  W_.setZero();
+  // WNew_ will NOT be filled, but will be swapped to W_ in iteration 0. Thus, initialize WNew_ here.
+  WNew_.setZero();
   // initial state
   X_[0] = x0;
   XNew_[0] = x0;
-  // cold start
-  for (int t = 0; t < N; t++) {
-    X_[t + 1].setZero(dynamics[t].dfdx.rows());
-    U_[t].setZero(dynamics[t].dfdu.cols());
-    W_[t].setZero(dynamics[t].dfdx.rows());
-    // WNew_ will NOT be filled, but will be swapped to W_ in iteration 0. Thus, initialize WNew_ here.
-    WNew_[t].setZero(dynamics[t].dfdx.rows());
-  }
 
   scalar_t alpha = pipgBounds.primalStepSize(0);
   scalar_t beta = pipgBounds.primalStepSize(0);
   scalar_t betaLast = 0;
 
   size_t k = 0;
-  std::atomic_int timeIndex{1}, finishedTaskCounter{0};
-  std::atomic_bool keepRunning{true}, shouldWait{true};
+  std::atomic_bool keepRunning{true};
   bool isConverged = false;
 
-  std::mutex mux;
-  std::condition_variable iterationFinished;
   std::vector<int> threadsWorkloadCounter(threadPool.numThreads() + 1U, 0);
 
-  auto updateVariablesTask = [&](int workerId) {
-    int t;
-    int workerOrder;
-
-    while (keepRunning) {
-      // Reset workerOrder in case all tasks have been assigned and some workers cannot enter the following while loop, keeping the
-      // workerOrder from previous iterations.
-      workerOrder = 0;
-      while ((t = timeIndex++) <= N) {
-        if (t == N) {
-          std::lock_guard<std::mutex> lk(mux);
-          shouldWait = true;
-        }
-        // Multi-thread performance analysis
-        ++threadsWorkloadCounter[workerId];
-
-        // PIPG algorithm
-        const auto& A = dynamics[t - 1].dfdx;
-        const auto& B = dynamics[t - 1].dfdu;
-        const auto& C = scalingVectors[t - 1];
-        const auto& b = dynamics[t - 1].f;
-
-        const auto& R = cost[t - 1].dfduu;
-        const auto& Q = cost[t].dfdxx;
-        const auto& P = cost[t - 1].dfdux;
-        const auto& q = cost[t].dfdx;
-        const auto& r = cost[t - 1].dfdu;
-
-        if (k != 0) {
-          // Update W of the iteration k - 1. Move the update of W to the front of the calculation of V to prevent data race.
-          // vector_t primalResidual = C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b;
-          primalResidualArray[t - 1] = -b;
-          primalResidualArray[t - 1].array() += C.array() * X_[t].array();
-          primalResidualArray[t - 1].noalias() -= A * X_[t - 1];
-          primalResidualArray[t - 1].noalias() -= B * U_[t - 1];
-          if (EInv != nullptr) {
-            constraintsViolationInfNormArray[t - 1] = (*EInv)[t - 1].cwiseProduct(primalResidualArray[t - 1]).lpNorm<Eigen::Infinity>();
-          } else {
-            constraintsViolationInfNormArray[t - 1] = primalResidualArray[t - 1].lpNorm<Eigen::Infinity>();
-          }
+  // Updates the stage t of the iteration k. It only writes the variables of stage t and only reads the variables of the previous iteration
+  // (X_, U_, W_), thus the stages of an iteration can be updated in any order.
+  auto updateStage = [&](int t) {
+    const auto& A = dynamics[t - 1].dfdx;
+    const auto& B = dynamics[t - 1].dfdu;
+    const auto& C = scalingVectors[t - 1];
+    const auto& b = dynamics[t - 1].f;
+
+    const auto& R = cost[t - 1].dfduu;
+    const auto& Q = cost[t].dfdxx;
+    const auto& P = cost[t - 1].dfdux;
+    const auto& q = cost[t].dfdx;
+    const auto& r = cost[t - 1].dfdu;
+
+    if (k != 0) {
+      // Update W of the iteration k - 1. Move the update of W to the front of the calculation of V to prevent data race.
+      // vector_t primalResidual = C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b;
+      primalResidualArray[t - 1] = -b;
+      primalResidualArray[t - 1].array() += C.array() * X_[t].array();
+      primalResidualArray[t - 1].noalias() -= A * X_[t - 1];
+      primalResidualArray[t - 1].noalias() -= B * U_[t - 1];
+      if (EInv != nullptr) {
+        constraintsViolationInfNormArray[t - 1] = (*EInv)[t - 1].cwiseProduct(primalResidualArray[t - 1]).lpNorm<Eigen::Infinity>();
+      } else {
+        constraintsViolationInfNormArray[t - 1] = primalResidualArray[t - 1].lpNorm<Eigen::Infinity>();
+      }
 
-          WNew_[t - 1] = W_[t - 1] + betaLast * primalResidualArray[t - 1];
+      WNew_[t - 1] = W_[t - 1] + betaLast * primalResidualArray[t - 1];
 
-          // What stored in UNew and XNew is the solution of iteration k - 2 and what stored in U and X is the solution of iteration k
-          // - 1. By convention, iteration starts from 0 and the solution of iteration -1 is the initial value. Reuse UNew and XNew
-          // memory to store the difference between the last solution and the one before last solution.
-          UNew_[t - 1] -= U_[t - 1];
-          XNew_[t] -= X_[t];
+      // What stored in UNew and XNew is the solution of iteration k - 2 and what stored in U and X is the solution of iteration k
+      // - 1. By convention, iteration starts from 0 and the solution of iteration -1 is the initial value. Reuse UNew and XNew
+      // memory to store the difference between the last solution and the one before last solution.
+      UNew_[t - 1] -= U_[t - 1];
+      XNew_[t] -= X_[t];
 
-          solutionSEArray[t - 1] = UNew_[t - 1].squaredNorm() + XNew_[t].squaredNorm();
-          solutionSquaredNormArray[t - 1] = U_[t - 1].squaredNorm() + X_[t].squaredNorm();
-        }
+      solutionSEArray[t - 1] = UNew_[t - 1].squaredNorm() + XNew_[t].squaredNorm();
+      solutionSquaredNormArray[t - 1] = U_[t - 1].squaredNorm() + X_[t].squaredNorm();
+    }
 
-        // V_[t - 1] = W_[t - 1] + (beta + betaLast) * (C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b);
-        V_[t - 1] = W_[t - 1] - (beta + betaLast) * b;
-        V_[t - 1].array() += (beta + betaLast) * C.array() * X_[t].array();
-        V_[t - 1].noalias() -= (beta + betaLast) * (A * X_[t - 1]);
-        V_[t - 1].noalias() -= (beta + betaLast) * (B * U_[t - 1]);
-
-        // UNew_[t - 1] = U_[t - 1] - alpha * (R * U_[t - 1] + P * X_[t - 1] + r - B.transpose() * V_[t - 1]);
-        UNew_[t - 1] = U_[t - 1] - alpha * r;
-        UNew_[t - 1].noalias() -= alpha * (R * U_[t - 1]);
-        UNew_[t - 1].noalias() -= alpha * (P * X_[t - 1]);
-        UNew_[t - 1].noalias() += alpha * (B.transpose() * V_[t - 1]);
-
-        // XNew_[t] = X_[t] - alpha * (Q * X_[t] + q + C * V_[t - 1]);
-        XNew_[t] = X_[t] - alpha * q;
-        XNew_[t].array() -= alpha * C.array() * V_[t - 1].array();
-        XNew_[t].noalias() -= alpha * (Q * X_[t]);
-
-        if (t != N) {
-          const auto& ANext = dynamics[t].dfdx;
-          const auto& BNext = dynamics[t].dfdu;
-          const auto& CNext = scalingVectors[t];
-          const auto& bNext = dynamics[t].f;
-
-          // dfdux
-          const auto& PNext = cost[t].dfdux;
-
-          // vector_t VNext = W_[t] + (beta + betaLast) * (CNext * X_[t + 1] - ANext * X_[t] - BNext * U_[t] - bNext);
-          vector_t VNext = W_[t] - (beta + betaLast) * bNext;
-          VNext.array() += (beta + betaLast) * CNext.array() * X_[t + 1].array();
-          VNext.noalias() -= (beta + betaLast) * (ANext * X_[t]);
-          VNext.noalias() -= (beta + betaLast) * (BNext * U_[t]);
-
-          XNew_[t].noalias() += alpha * (ANext.transpose() * VNext);
-          // Add dfdxu * du if it is not the final state.
-          XNew_[t].noalias() -= alpha * (PNext.transpose() * U_[t]);
-        }
+    // V_[t - 1] = W_[t - 1] + (beta + betaLast) * (C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b);
+    V_[t - 1] = W_[t - 1] - (beta + betaLast) * b;
+    V_[t - 1].array() += (beta + betaLast) * C.array() * X_[t].array();
+    V_[t - 1].noalias() -= (beta + betaLast) * (A * X_[t - 1]);
+    V_[t - 1].noalias() -= (beta + betaLast) * (B * U_[t - 1]);
+
+    // UNew_[t - 1] = U_[t - 1] - alpha * (R * U_[t - 1] + P * X_[t - 1] + r - B.transpose() * V_[t - 1]);
+    UNew_[t - 1] = U_[t - 1] - alpha * r;
+    UNew_[t - 1].noalias() -= alpha * (R * U_[t - 1]);
+    UNew_[t - 1].noalias() -= alpha * (P * X_[t - 1]);
+    UNew_[t - 1].noalias() += alpha * (B.transpose() * V_[t - 1]);
+
+    // XNew_[t] = X_[t] - alpha * (Q * X_[t] + q + C * V_[t - 1]);
+    XNew_[t] = X_[t] - alpha * q;
+    XNew_[t].array() -= alpha * C.array() * V_[t - 1].array();
+    XNew_[t].noalias() -= alpha * (Q * X_[t]);
+
+    if (t != N) {
+      const auto& ANext = dynamics[t].dfdx;
+      const auto& BNext = dynamics[t].dfdu;
+      const auto& CNext = scalingVectors[t];
+      const auto& bNext = dynamics[t].f;
+
+      // dfdux
+      const auto& PNext = cost[t].dfdux;
+
+      // vector_t VNext = W_[t] + (beta + betaLast) * (CNext * X_[t + 1] - ANext * X_[t] - BNext * U_[t] - bNext);
+      vector_t VNext = W_[t] - (beta + betaLast) * bNext;
+      VNext.array() += (beta + betaLast) * CNext.array() * X_[t + 1].array();
+      VNext.noalias() -= (beta + betaLast) * (ANext * X_[t]);
+      VNext.noalias() -= (beta + betaLast) * (BNext * U_[t]);
+
+      XNew_[t].noalias() += alpha * (ANext.transpose() * VNext);
+      // Add dfdxu * du if it is not the final state.
+      XNew_[t].noalias() -= alpha * (PNext.transpose() * U_[t]);
+    }
+  };
 
-        workerOrder = ++finishedTaskCounter;
-      }
+  // Runs by a single thread after all stages of the iteration k are updated.
+  auto finishIteration = [&]() {
+    betaLast = beta;
+    // Adaptive step size
+    beta = pipgBounds.dualStepSize(k);
+    alpha = pipgBounds.primalStepSize(k);
 
-      if (workerOrder != N) {
-        std::unique_lock<std::mutex> lk(mux);
-        iterationFinished.wait(lk, [&shouldWait] { return !shouldWait; });
-        lk.unlock();
-      } else {
-        betaLast = beta;
-        // Adaptive step size
-        beta = pipgBounds.dualStepSize(k);
-        alpha = pipgBounds.primalStepSize(k);
+    if (k != 0 && k % settings().checkTerminationInterval == 0) {
+      constraintsViolationInfNorm = *(std::max_element(constraintsViolationInfNormArray.begin(), constraintsViolationInfNormArray.end()));
+
+      solutionSSE = std::accumulate(solutionSEArray.begin(), solutionSEArray.end(), 0.0);
+      solutionSquaredNorm = std::accumulate(solutionSquaredNormArray.begin(), solutionSquaredNormArray.end(), 0.0);
 
-        if (k != 0 && k % settings().checkTerminationInterval == 0) {
-          constraintsViolationInfNorm =
-              *(std::max_element(constraintsViolationInfNormArray.begin(), constraintsViolationInfNormArray.end()));
+      isConverged = constraintsViolationInfNorm <= settings().absoluteTolerance &&
+                    (solutionSSE <= settings().relativeTolerance * settings().relativeTolerance * solutionSquaredNorm ||
+                     solutionSSE <= settings().absoluteTolerance);
 
-          solutionSSE = std::accumulate(solutionSEArray.begin(), solutionSEArray.end(), 0.0);
-          solutionSquaredNorm = std::accumulate(solutionSquaredNormArray.begin(), solutionSquaredNormArray.end(), 0.0);
+      keepRunning = k < settings().maxNumIterations && !isConverged;
+    }
+
+    XNew_.swap(X_);
+    UNew_.swap(U_);
+    WNew_.swap(W_);
 
-          isConverged = constraintsViolationInfNorm <= settings().absoluteTolerance &&
-                        (solutionSSE <= settings().relativeTolerance * settings().relativeTolerance * solutionSquaredNorm ||
-                         solutionSSE <= settings().absoluteTolerance);
+    ++k;
+  };
 
-          keepRunning = k < settings().maxNumIterations && !isConverged;
+  if (settings().useSpinBarrier) {
+    // Every worker owns a contiguous block of stages for all iterations, such that its matrices stay in the cache of its core. The
+    // neighbouring blocks only share the boundary variables of the previous iteration. The last worker arriving at the barrier finishes the
+    // iteration.
+    const int numBlocks = std::min(static_cast<int>(threadPool.numThreads()) + 1, N);
+    const auto blockBoundaries = partitionStages(ocpSize_, numBlocks);
+    SpinBarrier barrier(numBlocks);
+    std::atomic_int blockIndex{0};
+
+    auto updateBlockTask = [&](int) {
+      const int blockId = blockIndex++;
+      while (keepRunning) {
+        for (int t = blockBoundaries[blockId]; t < blockBoundaries[blockId + 1]; t++) {
+          updateStage(t);
         }
+        // Multi-thread performance analysis
+        threadsWorkloadCounter[blockId] += blockBoundaries[blockId + 1] - blockBoundaries[blockId];
+
+        barrier.arriveAndWait(finishIteration);
+      }
+    };
+    threadPool.runParallel(std::move(updateBlockTask), numBlocks);
+
+  } else {
+    std::atomic_int timeIndex{1}, finishedTaskCounter{0};
+    std::atomic_bool shouldWait{true};
+    std::mutex mux;
+    std::condition_variable iterationFinished;
+
+    auto updateVariablesTask = [&](int workerId) {
+      int t;
+      int workerOrder;
+
+      while (keepRunning) {
+        // Reset workerOrder in case all tasks have been assigned and some workers cannot enter the following while loop, keeping the
+        // workerOrder from previous iterations.
+        workerOrder = 0;
+        while ((t = timeIndex++) <= N) {
+          if (t == N) {
+            std::lock_guard<std::mutex> lk(mux);
+            shouldWait = true;
+          }
+          // Multi-thread performance analysis
+          ++threadsWorkloadCounter[workerId];
 
-        XNew_.swap(X_);
-        UNew_.swap(U_);
-        WNew_.swap(W_);
+          // PIPG algorithm
+          updateStage(t);
 
-        ++k;
-        finishedTaskCounter = 0;
-        timeIndex = 1;
-        {
-          std::lock_guard<std::mutex> lk(mux);
-          shouldWait = false;
+          workerOrder = ++finishedTaskCounter;
+        }
+
+        if (workerOrder != N) {
+          std::unique_lock<std::mutex> lk(mux);
+          iterationFinished.wait(lk, [&shouldWait] { return !shouldWait; });
+          lk.unlock();
+        } else {
+          finishIteration();
+
+          finishedTaskCounter = 0;
+          timeIndex = 1;
+          {
+            std::lock_guard<std::mutex> lk(mux);
+            shouldWait = false;
+          }
+          iterationFinished.notify_all();
         }
-        iterationFinished.notify_all();
       }
-    }
-  };
-  threadPool.runParallel(std::move(updateVariablesTask), threadPool.numThreads() + 1U);
+    };
+    threadPool.runParallel(std::move(updateVariablesTask), threadPool.numThreads() + 1U);
+  }
 
-  xTrajectory = X_;
-  uTrajectory = U_;
+  X_.toArray(xTrajectory);
+  U_.toArray(uTrajectory);
   const auto status = isConverged ? pipg::SolverStatus::SUCCESS : pipg::SolverStatus::MAX_ITER;
 
   if (settings().displayShortSummary) {
@@ -271,13 +349,17 @@ void PipgSolver::resize(const OcpSize& ocpSize) {
   numDecisionVariables_ += std::accumulate(ocpSize_.numInputs.begin(), ocpSize_.numInputs.end(), 0);
   numDynamicsConstraints_ = std::accumulate(std::next(ocpSize_.numStates.begin()), ocpSize_.numStates.end(), 0);
 
-  X_.resize(N + 1);
-  W_.resize(N);
-  V_.resize(N);
-  U_.resize(N);
-  XNew_.resize(N + 1);
-  UNew_.resize(N);
-  WNew_.resize(N);
+  const std::vector<int> stateSizes(ocpSize_.numStates.begin(), ocpSize_.numStates.end());
+  const std::vector<int> inputSizes(ocpSize_.numInputs.begin(), ocpSize_.numInputs.begin() + N);
+  const std::vector<int> dynamicsSizes(ocpSize_.numStates.begin() + 1, ocpSize_.numStates.end());
+
+  X_.resize(stateSizes);
+  W_.resize(dynamicsSizes);
+  V_.resize(dynamicsSizes);
+  U_.resize(inputSizes);
+  XNew_.resize(stateSizes);
+  UNew_.resize(inputSizes);
+  WNew_.resize(dynamicsSizes);
 }
 
 /******************************************************************************************************/
@@ -290,6 +372,13 @@ void PipgSolver::verifySizes(const std::vector<VectorFunctionLinearApproximation
     throw std::runtime_error("[PipgSolver::verifySizes] Inconsistent size of dynamics: " + std::to_string(dynamics.size()) + " with " +
                              std::to_string(ocpSize_.numStages) + " number of stages.");
   }
+  for (int t = 0; t < ocpSize_.numStages; t++) {
+    if (dynamics[t].dfdx.cols() != ocpSize_.numStates[t] || dynamics[t].dfdx.rows() != ocpSize_.numStates[t + 1] ||
+        dynamics[t].dfdu.cols() != ocpSize_.numInputs[t]) {
+      throw std::runtime_error("[PipgSolver::verifySizes] Inconsistent dimensions of dynamics at stage " + std::to_string(t) +
+                               ". Call resize() with the size of the problem.");
+    }
+  }
   if (cost.size() != ocpSize_.numStages + 1) {
     throw std::runtime_error("[PipgSolver::verifySizes] Inconsistent size of cost: " + std::to_string(cost.size()) + " with " +
                              std::to_string(ocpSize_.numStages + 1) + " nodes.");
@@ -0,0 +1,153 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+#include "ocs2_slp/pipg/BatchedPipgSolver.h"
+#include "ocs2_slp/pipg/PipgSolver.h"
+
+namespace {
+
+struct ProblemBatch {
+  ocs2::vector_array_t x0;
+  std::vector<std::vector<ocs2::VectorFunctionLinearApproximation>> dynamics;
+  std::vector<std::vector<ocs2::ScalarFunctionQuadraticApproximation>> cost;
+  std::vector<ocs2::vector_array_t> scalingVectors;
+  std::vector<ocs2::pipg::PipgBounds> pipgBounds;
+};
+
+ProblemBatch getRandomProblems(size_t batchSize, size_t N, size_t nx, size_t nu) {
+  ProblemBatch batch;
+  for (size_t l = 0; l < batchSize; l++) {
+    batch.x0.push_back(ocs2::vector_t::Random(nx));
+    batch.dynamics.emplace_back();
+    batch.cost.emplace_back();
+    for (size_t i = 0; i < N; i++) {
+      batch.dynamics.back().push_back(ocs2::getRandomDynamics(nx, nu));
+      batch.cost.back().push_back(ocs2::getRandomCost(nx, nu));
+    }
+    batch.cost.back().push_back(ocs2::getRandomCost(nx, nu));
+    batch.scalingVectors.emplace_back(N, ocs2::vector_t::Ones(nx) + 0.1 * ocs2::vector_t::Random(nx));
+    // different step sizes per problem
+    batch.pipgBounds.emplace_back(1e-3 * (1.0 + l), 1e3, 1e2);
+  }
+  return batch;
+}
+
+ocs2::pipg::Settings getSettings(size_t maxNumIterations, ocs2::scalar_t tolerance) {
+  ocs2::pipg::Settings settings;
+  settings.maxNumIterations = maxNumIterations;
+  settings.absoluteTolerance = tolerance;
+  settings.relativeTolerance = tolerance;
+  settings.checkTerminationInterval = 10;
+  settings.displayShortSummary = false;
+  return settings;
+}
+
+}  // namespace
+
+TEST(testBatchedPipgSolver, sameAsPipgSolver) {
+  constexpr size_t batchSize = 5;
+  constexpr size_t N = 10;
+  constexpr size_t nx = 4;
+  constexpr size_t nu = 3;
+  srand(0);
+  const auto batch = getRandomProblems(batchSize, N, nx, nu);
+
+  // the lanes terminate at different iterations
+  const auto settings = getSettings(500, 1e-3);
+  ocs2::BatchedPipgSolver batchedSolver(settings);
+  batchedSolver.resize(ocs2::extractSizesFromProblem(batch.dynamics[0], batch.cost[0], nullptr), batchSize);
+  std::vector<ocs2::vector_array_t> XBatch, UBatch;
+  const auto statusBatch =
+      batchedSolver.solve(batch.x0, batch.dynamics, batch.cost, batch.scalingVectors, nullptr, batch.pipgBounds, XBatch, UBatch);
+  ASSERT_EQ(statusBatch.size(), batchSize);
+
+  ocs2::PipgSolver solver(settings);
+  ocs2::ThreadPool threadPool(0);
+  for (size_t l = 0; l < batchSize; l++) {
+    auto dynamics = batch.dynamics[l];
+    solver.resize(ocs2::extractSizesFromProblem(dynamics, batch.cost[l], nullptr));
+    ocs2::vector_array_t X, U;
+    const auto status =
+        solver.solve(threadPool, batch.x0[l], dynamics, batch.cost[l], nullptr, batch.scalingVectors[l], nullptr, batch.pipgBounds[l], X, U);
+
+    EXPECT_EQ(status, statusBatch[l]) << "problem: " << l;
+    ASSERT_EQ(X.size(), XBatch[l].size());
+    ASSERT_EQ(U.size(), UBatch[l].size());
+    for (size_t i = 0; i < X.size(); i++) {
+      EXPECT_TRUE(X[i].isApprox(XBatch[l][i], 1e-9)) << "problem: " << l << ", node: " << i;
+    }
+    for (size_t i = 0; i < U.size(); i++) {
+      EXPECT_TRUE(U[i].isApprox(UBatch[l][i], 1e-9)) << "problem: " << l << ", node: " << i;
+    }
+  }
+}
+
+TEST(testBatchedPipgSolver, benchmark) {
+  constexpr size_t batchSize = 32;
+  constexpr size_t N = 20;
+  constexpr size_t nx = 12;
+  constexpr size_t nu = 6;
+  constexpr size_t numIterations = 50;
+  srand(0);
+  auto batch = getRandomProblems(batchSize, N, nx, nu);
+  const auto ocpSize = ocs2::extractSizesFromProblem(batch.dynamics[0], batch.cost[0], nullptr);
+
+  // zero tolerances to run a fixed number of iterations
+  const auto settings = getSettings(numIterations, 0.0);
+  ocs2::PipgSolver solver(settings);
+  solver.resize(ocpSize);
+  ocs2::BatchedPipgSolver batchedSolver(settings);
+  batchedSolver.resize(ocpSize, batchSize);
+  ocs2::ThreadPool threadPool(0);
+
+  ocs2::benchmark::RepeatedTimer loopTimer, batchedTimer;
+  for (int k = 0; k < 5; k++) {
+    loopTimer.startTimer();
+    for (size_t l = 0; l < batchSize; l++) {
+      ocs2::vector_array_t X, U;
+      solver.solve(threadPool, batch.x0[l], batch.dynamics[l], batch.cost[l], nullptr, batch.scalingVectors[l], nullptr,
+                   batch.pipgBounds[l], X, U);
+    }
+    loopTimer.endTimer();
+
+    batchedTimer.startTimer();
+    std::vector<ocs2::vector_array_t> XBatch, UBatch;
+    batchedSolver.solve(batch.x0, batch.dynamics, batch.cost, batch.scalingVectors, nullptr, batch.pipgBounds, XBatch, UBatch);
+    batchedTimer.endTimer();
+  }
+
+  std::cerr << "[BatchedPipgSolver] " << batchSize << " problems, " << numIterations << " iterations:\n";
+  std::cerr << "  Loop over PipgSolver: " << loopTimer.getAverageInMilliseconds() << " [ms]\n";
+  std::cerr << "  BatchedPipgSolver:    " << batchedTimer.getAverageInMilliseconds() << " [ms]\n";
+}
@@ -183,4 +183,77 @@ TEST_F(PIPGSolverTest, correctness) {
   ASSERT_TRUE(std::abs(PIPGConstraintViolation) < solver.settings().absoluteTolerance);
   EXPECT_TRUE(std::abs(QPConstraintViolation - PIPGConstraintViolation) < solver.settings().absoluteTolerance * 10.0);
   EXPECT_TRUE(std::abs(PIPGParallelCConstraintViolation - PIPGConstraintViolation) < solver.settings().absoluteTolerance * 10.0);
-}
\ No newline at end of file
+}
+TEST_F(PIPGSolverTest, spinBarrierEngine) {
+  const ocs2::pipg::PipgBounds pipgBounds{1e-3, 1e3, 1e2};
+  const ocs2::vector_array_t scalingVectors(N_, ocs2::vector_t::Ones(nx_));
+
+  auto settings = configurePipg(200, 1e-10, 1e-3, false);
+  ocs2::PipgSolver referenceSolver(settings);
+  referenceSolver.resize(solver.size());
+  ocs2::vector_array_t X, U;
+  const auto status = referenceSolver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
+
+  // The stage updates and the reductions are the same in both engines
+  settings.useSpinBarrier = true;
+  for (const size_t numThreads : std::vector<size_t>{1, 3, numThreads_, 2 * N_}) {
+    ocs2::PipgSolver spinBarrierSolver(settings);
+    spinBarrierSolver.resize(solver.size());
+    ocs2::ThreadPool spinBarrierThreadPool{numThreads - 1u, 50};
+
+    ocs2::vector_array_t XSpin, USpin;
+    const auto statusSpin = spinBarrierSolver.solve(spinBarrierThreadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr,
+                                                    pipgBounds, XSpin, USpin);
+    EXPECT_EQ(status, statusSpin) << "numThreads: " << numThreads;
+    ASSERT_EQ(X.size(), XSpin.size());
+    ASSERT_EQ(U.size(), USpin.size());
+    for (size_t i = 0; i < X.size(); i++) {
+      EXPECT_TRUE(X[i].isApprox(XSpin[i], 1e-12)) << "numThreads: " << numThreads << ", node: " << i;
+    }
+    for (size_t i = 0; i < U.size(); i++) {
+      EXPECT_TRUE(U[i].isApprox(USpin[i], 1e-12)) << "numThreads: " << numThreads << ", node: " << i;
+    }
+  }
+}
+
+TEST(PIPGSolverBenchmark, iterationTime) {
+  constexpr size_t N = 50;
+  constexpr size_t nx = 24;
+  constexpr size_t nu = 12;
+  constexpr size_t numIterations = 100;
+  srand(0);
+
+  std::vector<ocs2::VectorFunctionLinearApproximation> dynamicsArray;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> costArray;
+  const ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  for (size_t i = 0; i < N; i++) {
+    dynamicsArray.push_back(ocs2::getRandomDynamics(nx, nu));
+    costArray.push_back(ocs2::getRandomCost(nx, nu));
+  }
+  costArray.push_back(ocs2::getRandomCost(nx, nu));
+
+  const ocs2::pipg::PipgBounds pipgBounds{1e-3, 1e3, 1e2};
+  const ocs2::vector_array_t scalingVectors(N, ocs2::vector_t::Ones(nx));
+  ocs2::ThreadPool threadPool{3u, 50};
+
+  for (const bool useSpinBarrier : {false, true}) {
+    // zero tolerances to run a fixed number of iterations
+    auto settings = configurePipg(numIterations, 0.0, 0.0, false);
+    settings.useSpinBarrier = useSpinBarrier;
+    ocs2::PipgSolver solver(settings);
+    solver.resize(ocs2::extractSizesFromProblem(dynamicsArray, costArray, nullptr));
+    ocs2::vector_array_t X, U;
+
+    ocs2::benchmark::RepeatedTimer timer;
+    for (int k = 0; k < 5; k++) {
+      timer.startTimer();
+      const auto status = solver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
+      timer.endTimer();
+      EXPECT_EQ(status, ocs2::pipg::SolverStatus::MAX_ITER);
+    }
+    ASSERT_EQ(X.size(), N + 1);
+    ASSERT_EQ(U.size(), N);
+    std::cerr << "[PIPGSolverBenchmark] " << (useSpinBarrier ? "Spin barrier" : "Condition variable")
+              << " engine, average time per iteration: " << 1e3 * timer.getAverageInMilliseconds() / numIterations << " [us]\n";
+  }
+}
@@ -86,6 +86,41 @@ class HpipmInterface {
                      std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
                      vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
 
+  /**
+   * Packs the data of a single stage into the problem data of HPIPM. Together with solvePackedProblem(), this is an alternative to
+   * solve() where different stages can be packed concurrently from different threads, instead of packing the whole problem serially
+   * in solve(). HPIPM keeps its problem data in the panel-major format of BLASFEO, hence the stage data is copied into it as in solve().
+   * The interface needs to be resized to a consistent OcpSize before packing.
+   *
+   * Stage 0 is packed by solvePackedProblem() because it absorbs the initial state.
+   *
+   * @note The result is the same as solve(). Whether it is faster depends on the problem size and the number of threads, the test
+   *       packedProblem in testHpipmInterface prints the time of both paths.
+   *
+   * @param stage : The stage k to pack, 1 <= k <= N.
+   * @param dynamics : The discrete dynamics x[k+1] = A x[k] + B u[k] + b of the stage. Ignored and can be nullptr for k = N.
+   * @param cost : Quadratic approximation of the cost (Q, R, S, q, r) of the stage.
+   * @param constraints : Linearized constraints (C, D, e) of the stage. Ignored and can be nullptr if the stage has no constraints.
+   */
+  void packStage(int stage, const VectorFunctionLinearApproximation* dynamics, const ScalarFunctionQuadraticApproximation& cost,
+                  const VectorFunctionLinearApproximation* constraints);
+
+  /**
+   * Solves the problem of which stages 1 to N are packed by packStage(). See solve() for the arguments of stage 0.
+   *
+   * @param x0 : Initial state (deviation).
+   * @param dynamics0 : Linearized approximation of the discrete dynamics at k = 0.
+   * @param cost0 : Quadratic approximation of the cost at k = 0.
+   * @param constraints0 : Linearized approximation of the constraints at k = 0, can be nullptr if there are none.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @param verbose : Prints the HPIPM iteration statistics if true.
+   * @return HPIPM returned with flag hpipm_status, see solve().
+   */
+  hpipm_status solvePackedProblem(const vector_t& x0, const VectorFunctionLinearApproximation& dynamics0,
+                                   const ScalarFunctionQuadraticApproximation& cost0, const VectorFunctionLinearApproximation* constraints0,
+                                   vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
+
   /**
    * Return the Riccati cost-to-go for the previously solved problem.
    * Extra information about the initial stage is needed to complete calculation.
@@ -121,6 +156,16 @@ class HpipmInterface {
   vector_array_t getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
                                        const ScalarFunctionQuadraticApproximation& cost0);
 
+  /**
+   * Shifts the primal-dual iterate of the previously solved problem to the nodes of the next problem, such that HPIPM is warm-started
+   * from it when warm_start is enabled in the settings. The iterate is only kept when warm_start is enabled. Call this function after
+   * resize() for the next problem.
+   *
+   * @param previousNodeIndices : For every node of the next problem, the node of the previous problem to take the iterate from, or -1 to
+   *                              keep the current values. Nodes with different sizes are skipped as well.
+   */
+  void shiftSolution(const std::vector<int>& previousNodeIndices);
+
  private:
   class Impl;
   std::unique_ptr<Impl> pImpl_;
@@ -281,7 +281,83 @@ class HpipmInterface::Impl {
     // === Set and solve ===
     d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), hidxbx, hlbx, hubx, hidxbu,
                      hlbu, hubu, CC.data(), DD.data(), llg.data(), uug.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
+    return solveQp(x0, stateTrajectory, inputTrajectory, verbose);
+  }
+
+  void packStage(int k, const VectorFunctionLinearApproximation* dynamics, const ScalarFunctionQuadraticApproximation& cost,
+                  const VectorFunctionLinearApproximation* constraints) {
+    const int N = ocpSize_.numStages;
+    if (k < 1 || k > N) {
+      throw std::runtime_error("[HpipmInterface] Stage " + std::to_string(k) + " can not be packed, the stages 1 to " +
+                               std::to_string(N) + " are packed and stage 0 is set by solvePackedProblem().");
+    }
+    if (cost.dfdxx.rows() != ocpSize_.numStates[k] || (k < N && dynamics->dfdu.cols() != ocpSize_.numInputs[k])) {
+      throw std::runtime_error("[HpipmInterface] Inconsistent size of stage " + std::to_string(k) + ", resize the interface first.");
+    }
+    if (ocpSize_.numIneqConstraints[k] > 0 && constraints == nullptr) {
+      throw std::runtime_error("[HpipmInterface] Stage " + std::to_string(k) +
+                               " has constraints, but no constraint approximation is given.");
+    }
+
+    // HPIPM packs the data into its own storage and does not modify it
+    if (k < N) {
+      d_ocp_qp_set_A(k, const_cast<scalar_t*>(dynamics->dfdx.data()), &qp_);
+      d_ocp_qp_set_B(k, const_cast<scalar_t*>(dynamics->dfdu.data()), &qp_);
+      d_ocp_qp_set_b(k, const_cast<scalar_t*>(dynamics->f.data()), &qp_);
+      d_ocp_qp_set_R(k, const_cast<scalar_t*>(cost.dfduu.data()), &qp_);
+      d_ocp_qp_set_S(k, const_cast<scalar_t*>(cost.dfdux.data()), &qp_);
+      d_ocp_qp_set_r(k, const_cast<scalar_t*>(cost.dfdu.data()), &qp_);
+    }
+    d_ocp_qp_set_Q(k, const_cast<scalar_t*>(cost.dfdxx.data()), &qp_);
+    d_ocp_qp_set_q(k, const_cast<scalar_t*>(cost.dfdx.data()), &qp_);
+
+    // for ocs2 --> C*dx + D*du + e = 0, for hpipm --> ug >= C*dx + D*du >= lg
+    if (ocpSize_.numIneqConstraints[k] > 0) {
+      vector_t bound = -constraints->f;
+      d_ocp_qp_set_C(k, const_cast<scalar_t*>(constraints->dfdx.data()), &qp_);
+      if (k < N) {
+        d_ocp_qp_set_D(k, const_cast<scalar_t*>(constraints->dfdu.data()), &qp_);
+      }
+      d_ocp_qp_set_lg(k, bound.data(), &qp_);
+      d_ocp_qp_set_ug(k, bound.data(), &qp_);
+    }
+  }
+
+  hpipm_status solvePackedProblem(const vector_t& x0, const VectorFunctionLinearApproximation& dynamics0,
+                                   const ScalarFunctionQuadraticApproximation& cost0, const VectorFunctionLinearApproximation* constraints0,
+                                   vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose) {
+    if (ocpSize_.numIneqConstraints[0] > 0 && constraints0 == nullptr) {
+      throw std::runtime_error("[HpipmInterface] Stage 0 has constraints, but no constraint approximation is given.");
+    }
+
+    // k = 0. The initial state is removed from the decision variables, see solve()
+    vector_t b0 = dynamics0.f;
+    b0.noalias() += dynamics0.dfdx * x0;
+    d_ocp_qp_set_B(0, const_cast<scalar_t*>(dynamics0.dfdu.data()), &qp_);
+    d_ocp_qp_set_b(0, b0.data(), &qp_);
+
+    vector_t r0 = cost0.dfdu;
+    r0.noalias() += cost0.dfdux * x0;
+    d_ocp_qp_set_R(0, const_cast<scalar_t*>(cost0.dfduu.data()), &qp_);
+    d_ocp_qp_set_r(0, r0.data(), &qp_);
+
+    if (ocpSize_.numIneqConstraints[0] > 0) {
+      vector_t bound0 = -constraints0->f;
+      bound0.noalias() -= constraints0->dfdx * x0;
+      d_ocp_qp_set_D(0, const_cast<scalar_t*>(constraints0->dfdu.data()), &qp_);
+      d_ocp_qp_set_lg(0, bound0.data(), &qp_);
+      d_ocp_qp_set_ug(0, bound0.data(), &qp_);
+    }
+
+    return solveQp(x0, stateTrajectory, inputTrajectory, verbose);
+  }
+
+  /** Solves the QP that is set in qp_ and extracts the solution */
+  hpipm_status solveQp(const vector_t& x0, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose) {
     d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
+    if (settings_.warm_start != 0) {
+      storeSolution();
+    }
 
     if (verbose) {
       printStatus();
@@ -300,6 +376,49 @@ class HpipmInterface::Impl {
     return hpipm_status(hpipmStatus);
   }
 
+  void storeSolution() {
+    const int N = ocpSize_.numStages;
+    const auto toVector = [](const blasfeo_dvec& v) -> vector_t { return Eigen::Map<const vector_t>(v.pa, v.m); };
+    previousSolution_.ux.resize(N + 1);
+    previousSolution_.pi.resize(N);
+    previousSolution_.lam.resize(N + 1);
+    previousSolution_.t.resize(N + 1);
+    for (int k = 0; k <= N; ++k) {
+      previousSolution_.ux[k] = toVector(qpSol_.ux[k]);
+      previousSolution_.lam[k] = toVector(qpSol_.lam[k]);
+      previousSolution_.t[k] = toVector(qpSol_.t[k]);
+      if (k < N) {
+        previousSolution_.pi[k] = toVector(qpSol_.pi[k]);
+      }
+    }
+  }
+
+  void shiftSolution(const std::vector<int>& previousNodeIndices) {
+    const int N = ocpSize_.numStages;
+    const int previousN = static_cast<int>(previousSolution_.pi.size());
+    if (previousSolution_.ux.empty() || previousNodeIndices.size() != static_cast<size_t>(N + 1)) {
+      return;
+    }
+
+    const auto copyIfSameSize = [](const vector_t& from, blasfeo_dvec& to) {
+      if (from.size() == to.m) {
+        Eigen::Map<vector_t>(to.pa, to.m) = from;
+      }
+    };
+    for (int k = 0; k <= N; ++k) {
+      const int previousK = previousNodeIndices[k];
+      if (previousK < 0 || previousK > previousN) {
+        continue;
+      }
+      copyIfSameSize(previousSolution_.ux[previousK], qpSol_.ux[k]);
+      copyIfSameSize(previousSolution_.lam[previousK], qpSol_.lam[k]);
+      copyIfSameSize(previousSolution_.t[previousK], qpSol_.t[k]);
+      if (k < N && previousK < previousN) {
+        copyIfSameSize(previousSolution_.pi[previousK], qpSol_.pi[k]);
+      }
+    }
+  }
+
   bool getStateSolution(const vector_t& x0, vector_array_t& stateTrajectory) {
     stateTrajectory.resize(ocpSize_.numStages + 1);
     stateTrajectory.front() = x0;
@@ -515,6 +634,14 @@ class HpipmInterface::Impl {
   MemoryBlock qpSolMem_;
   d_ocp_qp_sol qpSol_;
 
+  // Primal-dual iterate of the last solve, kept for warm starting
+  struct {
+    vector_array_t ux;
+    vector_array_t pi;
+    vector_array_t lam;
+    vector_array_t t;
+  } previousSolution_;
+
   MemoryBlock ipmArgMem_;
   d_ocp_qp_ipm_arg arg_;
 
@@ -551,4 +678,20 @@ vector_array_t HpipmInterface::getRiccatiFeedforward(const VectorFunctionLinearA
   return pImpl_->getRiccatiFeedforward(dynamics0, cost0);
 }
 
+void HpipmInterface::packStage(int stage, const VectorFunctionLinearApproximation* dynamics,
+                                const ScalarFunctionQuadraticApproximation& cost, const VectorFunctionLinearApproximation* constraints) {
+  pImpl_->packStage(stage, dynamics, cost, constraints);
+}
+
+hpipm_status HpipmInterface::solvePackedProblem(const vector_t& x0, const VectorFunctionLinearApproximation& dynamics0,
+                                                 const ScalarFunctionQuadraticApproximation& cost0,
+                                                 const VectorFunctionLinearApproximation* constraints0, vector_array_t& stateTrajectory,
+                                                 vector_array_t& inputTrajectory, bool verbose) {
+  return pImpl_->solvePackedProblem(x0, dynamics0, cost0, constraints0, stateTrajectory, inputTrajectory, verbose);
+}
+
+void HpipmInterface::shiftSolution(const std::vector<int>& previousNodeIndices) {
+  pImpl_->shiftSolution(previousNodeIndices);
+}
+
 }  // namespace ocs2
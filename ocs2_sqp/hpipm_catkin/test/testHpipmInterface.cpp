@@ -338,3 +338,54 @@ TEST(test_hpiphm_interface, retrieveRiccati) {
     ASSERT_TRUE(uSol[k].isApprox(KSol[k] * xSol[k] + kSol[k]));
   }
 }
+
+/** Compares the solution of solve() with the solution of the stages packed by packStage(). */
+TEST(test_hpiphm_interface, packedProblem) {
+  constexpr int nx = 24;
+  constexpr int nu = 24;
+  constexpr int nc = 6;
+  constexpr int N = 50;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  constraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nc));
+
+  ocs2::OcpSize ocpSize(N, nx, nu);
+  std::fill(ocpSize.numIneqConstraints.begin(), ocpSize.numIneqConstraints.end(), nc);
+
+  // Solve with the full problem
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  const auto status = hpipmInterface.solve(x0, system, cost, &constraints, xSol, uSol);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+
+  // Solve with the packed stages
+  ocs2::HpipmInterface packedInterface(ocpSize);
+  std::vector<ocs2::vector_t> xSolPacked;
+  std::vector<ocs2::vector_t> uSolPacked;
+  for (int k = 1; k <= N; k++) {
+    packedInterface.packStage(k, k < N ? &system[k] : nullptr, cost[k], &constraints[k]);
+  }
+  const auto packedStatus = packedInterface.solvePackedProblem(x0, system[0], cost[0], &constraints[0], xSolPacked, uSolPacked);
+  ASSERT_EQ(packedStatus, hpipm_status::SUCCESS);
+
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(xSolPacked[k].isApprox(xSol[k], 1e-9));
+    ASSERT_TRUE(uSolPacked[k].isApprox(uSol[k], 1e-9));
+  }
+  ASSERT_TRUE(xSolPacked[N].isApprox(xSol[N], 1e-9));
+
+  // the stages with constraints need the constraint approximation
+  ASSERT_THROW(packedInterface.packStage(1, &system[1], cost[1], nullptr), std::runtime_error);
+  ASSERT_THROW(packedInterface.solvePackedProblem(x0, system[0], cost[0], nullptr, xSolPacked, uSolPacked), std::runtime_error);
+}
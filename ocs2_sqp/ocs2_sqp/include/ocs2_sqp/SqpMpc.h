@@ -65,6 +65,11 @@ class SqpMpc final : public MPC_BASE {
     solverPtr_->run(initTime, initState, finalTime);
   }
 
+  bool prepareController(scalar_t initTime, scalar_t finalTime) override {
+    // a cold start discards the prepared problem
+    return !settings().coldStart_ && solverPtr_->prepare(initTime, finalTime);
+  }
+
  private:
   std::unique_ptr<SqpSolver> solverPtr_;
 };
@@ -39,13 +39,15 @@ namespace sqp {
 
 struct Settings {
   // Sqp settings
-  size_t sqpIteration = 10;  // Maximum number of SQP iterations
+  size_t sqpIteration = 10;          // Maximum number of SQP iterations
+  size_t warmStartSqpIteration = 0;  // Maximum number of SQP iterations when warm-started from the previous solution, 0 uses sqpIteration
   scalar_t deltaTol = 1e-6;  // Termination condition : RMS update of x(t) and u(t) are both below this value
   scalar_t costTol = 1e-4;   // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
 
   // Linesearch - step size rules
-  scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
-  scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
+  scalar_t alpha_decay = 0.5;   // multiply the step size by this factor every time a linesearch step is rejected.
+  scalar_t alpha_min = 1e-4;    // terminate linesearch if the attempted step size is below this threshold
+  size_t linesearchTrials = 1;  // number of step sizes evaluated concurrently in the linesearch. 1 is the sequential backtracking.
 
   // Linesearch - step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
@@ -59,10 +61,14 @@ struct Settings {
 
   // QP subproblem solver settings
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
+  bool useParallelRiccatiSolver = false;  // Solve unconstrained (or projected) QP subproblems with the parallel-in-time Riccati solver
+  bool packQpStagesInParallel = false;    // Pack the QP stages into HPIPM from all threads, instead of the full QP at once in the solve.
+                                          // Same result, the speedup depends on the problem, see HpipmInterface::packStage()
 
   // Discretization method
   scalar_t dt = 0.01;  // user-defined time discretization
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
+  bool cacheReferenceOnTimeGrid = false;  // Sample the TargetTrajectories once per run on the time discretization for the cost terms
 
   // Inequality penalty relaxed barrier parameters
   scalar_t inequalityConstraintMu = 0.0;
@@ -70,6 +76,10 @@ struct Settings {
 
   bool projectStateInputEqualityConstraints = true;  // Use a projection method to resolve the state-input constraint Cx+Du+e
   bool extractProjectionMultiplier = false;          // Extract the Lagrange multiplier of the projected state-input constraint Cx+Du+e
+  bool fixedSizeProjection = false;   // Use the fixed-size projection kernels when they are compiled for the state and input dimensions
+  // Project the blocks of sparse (e.g. selection) constraint input matrices separately. Mutually exclusive with fixedSizeProjection,
+  // loadSettings rejects enabling both. If both are set directly, the structured projection is used.
+  bool structuredProjection = false;
 
   // Printing
   bool printSolverStatus = false;      // Print HPIPM status after solving the QP subproblem
@@ -79,6 +89,8 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  bool threadPoolWorkStealing = false;  // Use the work-stealing thread pool with allocation-free parallel tasks
+  size_t threadSpinDuration = 0;        // [us] Time idle threads busy-wait for work before sleeping (work-stealing only)
 };
 
 /**
@@ -35,8 +35,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
+#include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
+#include <ocs2_oc/oc_solver/ParallelRiccatiSolver.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
 #include <ocs2_oc/search_strategy/FilterLinesearch.h>
 
@@ -90,6 +92,24 @@ class SqpSolver : public SolverBase {
     throw std::runtime_error("[SqpSolver] getIntermediateDualSolution() not available yet.");
   }
 
+  /**
+   * Preparation phase of a real-time iteration (RTI). Linearizes the problem around the previous solution shifted to the horizon
+   * [initTime, finalTime], with the initial state predicted by the previous solution, before the state at initTime is measured.
+   * The next run() then only embeds the measured initial state, solves the prepared QP and takes a full step (feedback phase).
+   * The prepared QP is discarded, and run() performs regular SQP iterations instead, if the mode schedule, the target trajectories or
+   * the horizon length (finalTime - initTime) changed in between, if the measured time does not lie in the first interval of the prepared
+   * time discretization, or if the solution of the prepared QP is not finite. The feedback phase keeps the prepared time discretization,
+   * i.e., the solution starts at the prepared initTime.
+   *
+   * @note The feedback phase does not evaluate the nonlinear problem after the step. The single entry of getIterationsLog() after a
+   * feedback phase is therefore the performance of the prepared linearization point, i.e., measured before the step.
+   *
+   * @param [in] initTime: The expected initial time of the next run().
+   * @param [in] finalTime: The final time of the next run().
+   * @return Whether the QP is prepared. It is not when there is no previous solution that covers initTime.
+   */
+  bool prepare(scalar_t initTime, scalar_t finalTime);
+
  private:
   void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override;
 
@@ -108,9 +128,19 @@ class SqpSolver : public SolverBase {
     primalSolution_.inputTrajectory_ = primalSolution.inputTrajectory_;
     primalSolution_.postEventIndices_ = primalSolution.postEventIndices_;
     primalSolution_.modeSchedule_ = primalSolution.modeSchedule_;
+    rtiPreparation_.isPrepared = false;  // the prepared QP does not linearize around the given solution
     runImpl(initTime, initState, finalTime);
   }
 
+  /**
+   * Feedback phase of a real-time iteration: solves the prepared QP for the measured initial state and takes a full step.
+   * @return Whether the step was taken. It is not if the QP solution is not finite, the previous solution is then left untouched.
+   */
+  bool runFeedback(const vector_t& initState);
+
+  /** Whether the QP prepared by prepare() can be used for a run on [initTime, finalTime] */
+  bool isPreparedFor(scalar_t initTime, scalar_t finalTime) const;
+
   /** Run a task in parallel with settings.nThreads */
   void runParallel(std::function<void(int)> taskFunction);
 
@@ -121,17 +151,40 @@ class SqpSolver : public SolverBase {
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                             const vector_array_t& u, std::vector<Metrics>& metrics);
 
-  /** Computes only the performance metrics at the current {t, x(t), u(t)} */
-  PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                      const vector_array_t& u, std::vector<Metrics>& metrics);
+  /** A trial step of the linesearch: the step size, the resulting {x(t), u(t)}, and its performance metrics */
+  struct LinesearchTrial {
+    scalar_t alpha = 0.0;
+    vector_array_t x;
+    vector_array_t u;
+    std::vector<Metrics> metrics;
+    std::vector<PerformanceIndex> nodePerformance;
+    PerformanceIndex performance;
+  };
 
-  /** Returns solution of the QP subproblem in delta coordinates: */
+  /**
+   * Computes only the performance metrics of the first numTrials linesearch trials. The nodes of all trials are distributed over the
+   * threads together, while the performance of each trial is summed in node order. The result is therefore independent of the number
+   * of trials and threads.
+   */
+  void computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, size_t numTrials);
+
+  /** Returns solution of the QP subproblem in delta coordinates. The solution is held by the solver and valid until the next call. */
   struct OcpSubproblemSolution {
     vector_array_t deltaXSol;      // delta_x(t)
     vector_array_t deltaUSol;      // delta_u(t)
     scalar_t armijoDescentMetric;  // inner product of the cost gradient and decision variable step
   };
-  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
+  const OcpSubproblemSolution& getOCPSolution(const vector_t& delta_x0);
+
+  /** Solves the QP subproblem with HPIPM, where the stages are optionally packed into HPIPM by all threads */
+  hpipm_status solveWithHpipm(const vector_t& delta_x0, std::vector<VectorFunctionLinearApproximation>* constraints,
+                              vector_array_t& deltaXSol, vector_array_t& deltaUSol);
+
+  /** Shifts the HPIPM iterate of the previous run to the new horizon before the first QP of a warm-started run */
+  void shiftHpipmSolution();
+
+  /** Whether the QP subproblem is unconstrained and solved by the parallel Riccati solver instead of HPIPM */
+  bool useParallelRiccatiSolver() const;
 
   /** Extract the value function based on the last solved QP */
   void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x);
@@ -145,22 +198,39 @@ class SqpSolver : public SolverBase {
                          std::vector<Metrics>& metrics);
 
   /** Determine convergence after a step */
-  sqp::Convergence checkConvergence(int iteration, const PerformanceIndex& baseline, const sqp::StepInfo& stepInfo) const;
+  sqp::Convergence checkConvergence(int iteration, size_t maxNumIterations, const PerformanceIndex& baseline,
+                                    const sqp::StepInfo& stepInfo) const;
 
   // Problem definition
   const sqp::Settings settings_;
-  DynamicsDiscretizer discretizer_;
-  DynamicsSensitivityDiscretizer sensitivityDiscretizer_;
+  DynamicsDiscretizerInPlace discretizer_;
+  DynamicsSensitivityDiscretizerInPlace sensitivityDiscretizer_;
   std::vector<OptimalControlProblem> ocpDefinitions_;
   std::unique_ptr<Initializer> initializerPtr_;
   FilterLinesearch filterLinesearch_;
 
   // Solver interface
   HpipmInterface hpipmInterface_;
+  ParallelRiccatiSolver parallelRiccatiSolver_;
+  std::vector<int> hpipmWarmStartNodeIndices_;  // previous node of each node, to shift the HPIPM iterate before the first QP of a run
 
   // Threading
   ThreadPool threadPool_;
 
+  // Real-time iteration: the linearization point of the QP that is held in the LQ approximation after prepare()
+  struct RtiPreparation {
+    bool isPrepared = false;
+    scalar_t finalTime = 0.0;
+    ModeSchedule modeSchedule;
+    TargetTrajectories targetTrajectories;
+    std::vector<AnnotatedTime> timeDiscretization;
+    vector_array_t x;
+    vector_array_t u;
+    std::vector<Metrics> metrics;
+    PerformanceIndex performance;
+  };
+  RtiPreparation rtiPreparation_;
+
   // Solution
   PrimalSolution primalSolution_;
 
@@ -174,10 +244,22 @@ class SqpSolver : public SolverBase {
   std::vector<VectorFunctionLinearApproximation> stateIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> stateInputIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
+  std::vector<std::vector<int>> projectedFreeInputs_;
 
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
 
+  // Workspace which persists across iterations and MPC calls. The buffers are swapped in and out instead of reallocated.
+  std::vector<multiple_shooting::Transcription> workerTranscription_;
+  std::vector<multiple_shooting::EventTranscription> workerEventTranscription_;
+  multiple_shooting::TerminalTranscription terminalTranscription_;
+  std::vector<multiple_shooting::ProjectionWorkspace> projectionWorkspace_;  // one per node
+  std::vector<PerformanceIndex> nodePerformance_;
+  std::vector<LinesearchTrial> linesearchTrials_;
+  OcpSize ocpSize_;
+  OcpSubproblemSolution subproblemSolution_;
+  vector_t delta_x0_;
+
   // Iteration performance log
   std::vector<PerformanceIndex> performanceIndeces_;
 
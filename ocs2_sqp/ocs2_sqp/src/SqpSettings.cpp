@@ -34,6 +34,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/misc/LoadData.h>
 
+#include <stdexcept>
+
 namespace ocs2 {
 namespace sqp {
 
@@ -49,15 +51,18 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   }
 
   loadData::loadPtreeValue(pt, settings.sqpIteration, fieldName + ".sqpIteration", verbose);
+  loadData::loadPtreeValue(pt, settings.warmStartSqpIteration, fieldName + ".warmStartSqpIteration", verbose);
   loadData::loadPtreeValue(pt, settings.deltaTol, fieldName + ".deltaTol", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_decay, fieldName + ".alpha_decay", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_min, fieldName + ".alpha_min", verbose);
+  loadData::loadPtreeValue(pt, settings.linesearchTrials, fieldName + ".linesearchTrials", verbose);
   loadData::loadPtreeValue(pt, settings.gamma_c, fieldName + ".gamma_c", verbose);
   loadData::loadPtreeValue(pt, settings.g_max, fieldName + ".g_max", verbose);
   loadData::loadPtreeValue(pt, settings.g_min, fieldName + ".g_min", verbose);
   loadData::loadPtreeValue(pt, settings.armijoFactor, fieldName + ".armijoFactor", verbose);
   loadData::loadPtreeValue(pt, settings.costTol, fieldName + ".costTol", verbose);
   loadData::loadPtreeValue(pt, settings.dt, fieldName + ".dt", verbose);
+  loadData::loadPtreeValue(pt, settings.cacheReferenceOnTimeGrid, fieldName + ".cacheReferenceOnTimeGrid", verbose);
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy, fieldName + ".useFeedbackPolicy", verbose);
   loadData::loadPtreeValue(pt, settings.createValueFunction, fieldName + ".createValueFunction", verbose);
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
@@ -67,11 +72,21 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.inequalityConstraintDelta, fieldName + ".inequalityConstraintDelta", verbose);
   loadData::loadPtreeValue(pt, settings.projectStateInputEqualityConstraints, fieldName + ".projectStateInputEqualityConstraints", verbose);
   loadData::loadPtreeValue(pt, settings.extractProjectionMultiplier, fieldName + ".extractProjectionMultiplier", verbose);
+  loadData::loadPtreeValue(pt, settings.fixedSizeProjection, fieldName + ".fixedSizeProjection", verbose);
+  loadData::loadPtreeValue(pt, settings.structuredProjection, fieldName + ".structuredProjection", verbose);
+  loadData::loadPtreeValue(pt, settings.useParallelRiccatiSolver, fieldName + ".useParallelRiccatiSolver", verbose);
+  loadData::loadPtreeValue(pt, settings.packQpStagesInParallel, fieldName + ".packQpStagesInParallel", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatus, fieldName + ".printSolverStatus", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatistics, fieldName + ".printSolverStatistics", verbose);
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
+  loadData::loadPtreeValue(pt, settings.threadPoolWorkStealing, fieldName + ".threadPoolWorkStealing", verbose);
+  loadData::loadPtreeValue(pt, settings.threadSpinDuration, fieldName + ".threadSpinDuration", verbose);
+
+  if (settings.structuredProjection && settings.fixedSizeProjection) {
+    throw std::runtime_error("[MultipleShootingSqpSettings] structuredProjection and fixedSizeProjection cannot be enabled together!");
+  }
 
   if (verbose) {
     std::cerr << settings.hpipmSettings;
@@ -29,14 +29,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/SqpSolver.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
 
+#include <ocs2_core/NumericTraits.h>
+#include <ocs2_core/misc/Numerics.h>
+#include <ocs2_core/misc/Tracing.h>
+#include <ocs2_oc/multiple_shooting/FixedSizeTranscription.h>
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
 #include <ocs2_oc/multiple_shooting/PerformanceIndexComputation.h>
+#include <ocs2_oc/multiple_shooting/StructuredProjection.h>
 #include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
 #include <ocs2_oc/trajectory_adjustment/TrajectorySpreadingHelperFunctions.h>
@@ -56,22 +62,34 @@ sqp::Settings rectifySettings(const OptimalControlProblem& ocp, sqp::Settings&&
 SqpSolver::SqpSolver(sqp::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(rectifySettings(optimalControlProblem, std::move(settings))),
       hpipmInterface_(OcpSize(), settings_.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority, settings_.threadPoolWorkStealing,
+                  std::chrono::microseconds(settings_.threadSpinDuration)) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
   // Dynamics discretization
-  discretizer_ = selectDynamicsDiscretization(settings_.integratorType);
-  sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings_.integratorType);
+  discretizer_ = selectDynamicsDiscretizationInPlace(settings_.integratorType);
+  sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretizationInPlace(settings_.integratorType);
 
   // Clone objects to have one for each worker
   for (int w = 0; w < settings_.nThreads; w++) {
     ocpDefinitions_.push_back(optimalControlProblem);
   }
+  workerTranscription_.resize(settings_.nThreads);
+  workerEventTranscription_.resize(settings_.nThreads);
+  linesearchTrials_.resize(std::max(settings_.linesearchTrials, size_t(1)));
 
   // Operating points
   initializerPtr_.reset(initializer.clone());
 
+  // Sample the references on the nodes of the time discretization, see setupQuadraticSubproblem()
+  if (settings_.cacheReferenceOnTimeGrid) {
+    const scalar_t dt = settings_.dt;
+    setReferenceTimeGrid([dt](scalar_t initTime, scalar_t finalTime, const ModeSchedule& modeSchedule) {
+      return toIntervalStartTime(timeDiscretizationWithEvents(initTime, finalTime, dt, modeSchedule.eventTimes));
+    });
+  }
+
   // Linesearch
   filterLinesearch_.g_max = settings_.g_max;
   filterLinesearch_.g_min = settings_.g_min;
@@ -89,6 +107,8 @@ void SqpSolver::reset() {
   // Clear solution
   primalSolution_ = PrimalSolution();
   valueFunction_.clear();
+  hpipmWarmStartNodeIndices_.clear();
+  rtiPreparation_.isPrepared = false;
   performanceIndeces_.clear();
 
   // reset timers
@@ -161,6 +181,12 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
   }
 
+  // Feedback phase of a real-time iteration, the QP was prepared before the initial state was measured
+  if (isPreparedFor(initTime, finalTime) && runFeedback(initState)) {
+    return;
+  }
+  rtiPreparation_.isPrepared = false;
+
   // Determine time discretization, taking into account event times.
   const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
   const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
@@ -169,10 +195,18 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   for (auto& ocpDefinition : ocpDefinitions_) {
     const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
     ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+    ocpDefinition.preComputationPtr->setReferenceCache(this->getReferenceManager().getReferenceCache());
+  }
+
+  // Shift the QP iterate along with the horizon, matching the nodes before primalSolution_ is adjusted to the new mode schedule
+  const bool isWarmStarted = !primalSolution_.timeTrajectory_.empty();
+  if (isWarmStarted && settings_.hpipmSettings.warm_start != 0) {
+    hpipmWarmStartNodeIndices_ =
+        multiple_shooting::getWarmStartNodeIndices(primalSolution_, this->getReferenceManager().getModeSchedule(), timeDiscretization);
   }
 
   // Trajectory spread of primalSolution_
-  if (!primalSolution_.timeTrajectory_.empty()) {
+  if (isWarmStarted) {
     std::ignore = trajectorySpread(primalSolution_.modeSchedule_, this->getReferenceManager().getModeSchedule(), primalSolution_);
   }
 
@@ -184,6 +218,10 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   performanceIndeces_.clear();
   std::vector<Metrics> metrics;
 
+  // Warm-started runs can be capped to fewer iterations (real-time iteration)
+  const size_t maxNumIterations =
+      (isWarmStarted && settings_.warmStartSqpIteration > 0) ? settings_.warmStartSqpIteration : settings_.sqpIteration;
+
   int iter = 0;
   sqp::Convergence convergence = sqp::Convergence::FALSE;
   while (convergence == sqp::Convergence::FALSE) {
@@ -197,8 +235,8 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
     // Solve QP
     solveQpTimer_.startTimer();
-    const vector_t delta_x0 = initState - x[0];
-    const auto deltaSolution = getOCPSolution(delta_x0);
+    delta_x0_ = initState - x[0];
+    const auto& deltaSolution = getOCPSolution(delta_x0_);
     extractValueFunction(timeDiscretization, x);
     solveQpTimer_.endTimer();
 
@@ -209,7 +247,7 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     linesearchTimer_.endTimer();
 
     // Check convergence
-    convergence = checkConvergence(iter, baselinePerformance, stepInfo);
+    convergence = checkConvergence(iter, maxNumIterations, baselinePerformance, stepInfo);
 
     // Next iteration
     ++iter;
@@ -229,27 +267,154 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 }
 
+bool SqpSolver::prepare(scalar_t initTime, scalar_t finalTime) {
+  OCS2_TRACE_SCOPE("SqpSolver", "prepare");
+  rtiPreparation_.isPrepared = false;
+
+  // The initial state is predicted by the previous solution
+  if (primalSolution_.timeTrajectory_.empty() || initTime >= primalSolution_.timeTrajectory_.back()) {
+    return false;
+  }
+
+  // Determine time discretization, taking into account event times.
+  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
+  auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, modeSchedule.eventTimes);
+
+  // Initialize references
+  for (auto& ocpDefinition : ocpDefinitions_) {
+    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
+    ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+    ocpDefinition.preComputationPtr->setReferenceCache(this->getReferenceManager().getReferenceCache());
+  }
+
+  // Shift the previous solution to the new horizon, see runImpl()
+  if (settings_.hpipmSettings.warm_start != 0) {
+    hpipmWarmStartNodeIndices_ = multiple_shooting::getWarmStartNodeIndices(primalSolution_, modeSchedule, timeDiscretization);
+  }
+  std::ignore = trajectorySpread(primalSolution_.modeSchedule_, modeSchedule, primalSolution_);
+
+  // Initialize the state and input, x[0] is the state of the previous solution at initTime
+  vector_array_t x, u;
+  const vector_t predictedState =
+      LinearInterpolation::interpolate(initTime, primalSolution_.timeTrajectory_, primalSolution_.stateTrajectory_);
+  multiple_shooting::initializeStateInputTrajectories(predictedState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+
+  // Make QP approximation
+  linearQuadraticApproximationTimer_.startTimer();
+  std::vector<Metrics> metrics;
+  rtiPreparation_.performance = setupQuadraticSubproblem(timeDiscretization, x.front(), x, u, metrics);
+  linearQuadraticApproximationTimer_.endTimer();
+
+  rtiPreparation_.finalTime = finalTime;
+  rtiPreparation_.modeSchedule = modeSchedule;
+  rtiPreparation_.targetTrajectories = this->getReferenceManager().getTargetTrajectories();
+  rtiPreparation_.timeDiscretization = std::move(timeDiscretization);
+  rtiPreparation_.x = std::move(x);
+  rtiPreparation_.u = std::move(u);
+  rtiPreparation_.metrics = std::move(metrics);
+  rtiPreparation_.isPrepared = true;
+  return true;
+}
+
+bool SqpSolver::isPreparedFor(scalar_t initTime, scalar_t finalTime) const {
+  if (!rtiPreparation_.isPrepared) {
+    return false;
+  }
+
+  // The measured time has to lie in the first interval of the prepared time discretization
+  const auto& time = rtiPreparation_.timeDiscretization;
+  if (initTime < time[0].time || initTime >= time[1].time) {
+    return false;
+  }
+
+  // The final time moves with the measured time, hence only the horizon length has to match the prepared one
+  const scalar_t preparedHorizon = rtiPreparation_.finalTime - time[0].time;
+  if (!numerics::almost_eq(finalTime - initTime, preparedHorizon, numeric_traits::weakEpsilon<scalar_t>())) {
+    return false;
+  }
+
+  // The prepared QP is only valid for the same references
+  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
+  return modeSchedule.eventTimes == rtiPreparation_.modeSchedule.eventTimes &&
+         modeSchedule.modeSequence == rtiPreparation_.modeSchedule.modeSequence &&
+         this->getReferenceManager().getTargetTrajectories() == rtiPreparation_.targetTrajectories;
+}
+
+bool SqpSolver::runFeedback(const vector_t& initState) {
+  OCS2_TRACE_SCOPE("SqpSolver", "runFeedback");
+  rtiPreparation_.isPrepared = false;
+  const auto& timeDiscretization = rtiPreparation_.timeDiscretization;
+  auto& x = rtiPreparation_.x;
+  auto& u = rtiPreparation_.u;
+
+  // Solve QP with the measured initial state embedded
+  solveQpTimer_.startTimer();
+  delta_x0_ = initState - x[0];
+  const auto& deltaSolution = getOCPSolution(delta_x0_);
+  extractValueFunction(timeDiscretization, x);
+  solveQpTimer_.endTimer();
+
+  // Without a linesearch, a failed QP solve would be committed to the solution
+  const auto isFinite = [](const vector_t& v) { return v.allFinite(); };
+  if (!std::all_of(deltaSolution.deltaXSol.begin(), deltaSolution.deltaXSol.end(), isFinite) ||
+      !std::all_of(deltaSolution.deltaUSol.begin(), deltaSolution.deltaUSol.end(), isFinite)) {
+    if (settings_.printSolverStatus || settings_.printLinesearch) {
+      std::cerr << "\nSQP real-time iteration: the prepared QP has no finite solution, falling back to SQP iterations\n";
+    }
+    return false;
+  }
+
+  // Apply a full step, evaluating the nonlinear problem for a linesearch would defeat the purpose of the split
+  linesearchTimer_.startTimer();
+  multiple_shooting::incrementTrajectory(u, deltaSolution.deltaUSol, 1.0, u);
+  multiple_shooting::incrementTrajectory(x, deltaSolution.deltaXSol, 1.0, x);
+  // The performance is the one of the prepared linearization point, the problem is not evaluated after the step
+  performanceIndeces_.clear();
+  performanceIndeces_.push_back(rtiPreparation_.performance);
+  linesearchTimer_.endTimer();
+  ++totalNumIterations_;
+
+  computeControllerTimer_.startTimer();
+  primalSolution_ = toPrimalSolution(timeDiscretization, std::move(x), std::move(u));
+  problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(rtiPreparation_.metrics));
+  computeControllerTimer_.endTimer();
+
+  if (settings_.printSolverStatus || settings_.printLinesearch) {
+    std::cerr << "\nSQP real-time iteration: feedback step applied, performance before the step:\n";
+    std::cerr << rtiPreparation_.performance << "\n";
+  }
+  return true;
+}
+
 void SqpSolver::runParallel(std::function<void(int)> taskFunction) {
   threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
 }
 
-SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta_x0) {
-  // Solve the QP
-  OcpSubproblemSolution solution;
+const SqpSolver::OcpSubproblemSolution& SqpSolver::getOCPSolution(const vector_t& delta_x0) {
+  OCS2_TRACE_SCOPE("SqpSolver", "getOCPSolution");
+  // Solve the QP, reusing the memory of the previous solution
+  auto& solution = subproblemSolution_;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
-  hpipm_status status;
+  bool success;
   const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
-  if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
+  if (useParallelRiccatiSolver()) {  // unconstrained QP solved with the parallel-in-time Riccati recursion
+    extractSizesFromProblem(dynamics_, cost_, nullptr, ocpSize_);
+    parallelRiccatiSolver_.resize(ocpSize_);
+    success = parallelRiccatiSolver_.solve(threadPool_, delta_x0, dynamics_, cost_, deltaXSol, deltaUSol);
+  } else if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
     hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, &stateInputEqConstraints_));
-    status =
-        hpipmInterface_.solve(delta_x0, dynamics_, cost_, &stateInputEqConstraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    shiftHpipmSolution();
+    const auto status = solveWithHpipm(delta_x0, &stateInputEqConstraints_, deltaXSol, deltaUSol);
+    success = status == hpipm_status::SUCCESS;
   } else {  // without constraints, or when using projection, we have an unconstrained QP.
     hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, nullptr));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    shiftHpipmSolution();
+    const auto status = solveWithHpipm(delta_x0, nullptr, deltaXSol, deltaUSol);
+    success = status == hpipm_status::SUCCESS;
   }
 
-  if (status != hpipm_status::SUCCESS) {
+  if (!success) {
     throw std::runtime_error("[SqpSolver] Failed to solve QP");
   }
 
@@ -264,9 +429,45 @@ SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta
   return solution;
 }
 
+hpipm_status SqpSolver::solveWithHpipm(const vector_t& delta_x0, std::vector<VectorFunctionLinearApproximation>* constraints,
+                                       vector_array_t& deltaXSol, vector_array_t& deltaUSol) {
+  if (!settings_.packQpStagesInParallel) {
+    return hpipmInterface_.solve(delta_x0, dynamics_, cost_, constraints, deltaXSol, deltaUSol, settings_.printSolverStatus);
+  }
+
+  // Stages 1 to N are packed by the workers, stage 0 absorbs delta_x0 in the solve
+  const int N = static_cast<int>(dynamics_.size());
+  std::atomic_int stageIndex{1};
+  runParallel([&](int) {
+    int k = stageIndex++;
+    while (k <= N) {
+      const auto* stageConstraints = (constraints != nullptr) ? &(*constraints)[k] : nullptr;
+      hpipmInterface_.packStage(k, (k < N) ? &dynamics_[k] : nullptr, cost_[k], stageConstraints);
+      k = stageIndex++;
+    }
+  });
+  const auto* constraints0 = (constraints != nullptr) ? &constraints->front() : nullptr;
+  return hpipmInterface_.solvePackedProblem(delta_x0, dynamics_[0], cost_[0], constraints0, deltaXSol, deltaUSol,
+                                             settings_.printSolverStatus);
+}
+
+void SqpSolver::shiftHpipmSolution() {
+  // Only the first QP of a run is shifted, the following ones continue from the iterate of the same horizon.
+  if (!hpipmWarmStartNodeIndices_.empty()) {
+    hpipmInterface_.shiftSolution(hpipmWarmStartNodeIndices_);
+    hpipmWarmStartNodeIndices_.clear();
+  }
+}
+
+bool SqpSolver::useParallelRiccatiSolver() const {
+  const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
+  return settings_.useParallelRiccatiSolver && (!hasStateInputConstraints || settings_.projectStateInputEqualityConstraints);
+}
+
 void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x) {
   if (settings_.createValueFunction) {
-    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
+    valueFunction_ = useParallelRiccatiSolver() ? parallelRiccatiSolver_.getRiccatiCostToGo()
+                                                : hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
     // Correct for linearization state
     for (int i = 0; i < time.size(); ++i) {
       valueFunction_[i].dfdx.noalias() -= valueFunction_[i].dfdxx * x[i];
@@ -275,11 +476,17 @@ void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, con
 }
 
 PrimalSolution SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
+  OCS2_TRACE_SCOPE("SqpSolver", "toPrimalSolution");
   if (settings_.useFeedbackPolicy) {
     ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    matrix_array_t KMatrices = useParallelRiccatiSolver() ? parallelRiccatiSolver_.getRiccatiFeedback()
+                                                          : hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
     if (settings_.projectStateInputEqualityConstraints) {
-      multiple_shooting::remapProjectedGain(constraintsProjection_, KMatrices);
+      if (settings_.structuredProjection) {
+        multiple_shooting::remapProjectedGain(constraintsProjection_, projectedFreeInputs_, KMatrices);
+      } else {
+        multiple_shooting::remapProjectedGain(constraintsProjection_, KMatrices);
+      }
     }
     return multiple_shooting::toPrimalSolution(time, std::move(modeSchedule), std::move(x), std::move(u), std::move(KMatrices));
 
@@ -291,56 +498,84 @@ PrimalSolution SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& tim
 
 PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState,
                                                      const vector_array_t& x, const vector_array_t& u, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_SCOPE("SqpSolver", "setupQuadraticSubproblem");
+
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
+  nodePerformance_.resize(N + 1);
   cost_.resize(N + 1);
   dynamics_.resize(N);
   stateInputEqConstraints_.resize(N + 1);  // +1 because of HpipmInterface size check
   stateIneqConstraints_.resize(N + 1);
   stateInputIneqConstraints_.resize(N);
   constraintsProjection_.resize(N);
+  projectedFreeInputs_.resize(N);
   projectionMultiplierCoefficients_.resize(N);
+  projectionWorkspace_.resize(N);
   metrics.resize(N + 1);
 
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
-    PerformanceIndex workerPerformance;  // Accumulate performance in local variable
 
     int i = timeIndex++;
     while (i < N) {
+      OCS2_TRACE_SCOPE_INDEX("SqpSolver", "setupNode", i);
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result);
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
+        auto& result = workerEventTranscription_[workerId];
+        multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1], result);
+        multiple_shooting::computeMetrics(result, metrics[i]);
+        nodePerformance_[i] = multiple_shooting::computePerformanceIndex(result);
+        std::swap(cost_[i], result.cost);
+        std::swap(dynamics_[i], result.dynamics);
         stateInputEqConstraints_[i].resize(0, x[i].size());
-        stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+        std::swap(stateIneqConstraints_[i], result.ineqConstraints);
         stateInputIneqConstraints_[i].resize(0, x[i].size());
         constraintsProjection_[i].resize(0, x[i].size());
-        projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
+        projectedFreeInputs_[i].clear();
+        projectionMultiplierCoefficients_[i].clear();
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
-        if (settings_.projectStateInputEqualityConstraints) {
-          multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
+        auto& result = workerTranscription_[workerId];
+        multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i], result);
+        multiple_shooting::computeMetrics(result, metrics[i]);
+        nodePerformance_[i] = multiple_shooting::computePerformanceIndex(result, dt);
+        const bool projectIntoNode =
+            settings_.projectStateInputEqualityConstraints && !settings_.structuredProjection && !settings_.fixedSizeProjection;
+        if (projectIntoNode) {
+          // The projected terms are written to the node, such that neither the node nor the worker's transcription changes its size
+          multiple_shooting::ProjectedTranscription projected{cost_[i],
+                                                              dynamics_[i],
+                                                              stateInputIneqConstraints_[i],
+                                                              constraintsProjection_[i],
+                                                              projectedFreeInputs_[i],
+                                                              projectionMultiplierCoefficients_[i]};
+          multiple_shooting::projectTranscription(result, projected, projectionWorkspace_[i], settings_.extractProjectionMultiplier);
+          stateInputEqConstraints_[i].resize(0, x[i].size());
+          std::swap(stateIneqConstraints_[i], result.stateIneqConstraints);
+        } else {
+          if (settings_.projectStateInputEqualityConstraints) {
+            if (settings_.structuredProjection) {
+              multiple_shooting::projectTranscriptionStructured(result, settings_.extractProjectionMultiplier);
+            } else {
+              multiple_shooting::projectTranscriptionFixedSize(result, settings_.extractProjectionMultiplier);
+            }
+          }
+          // Swap, such that the worker's transcription takes over the buffers of the previous iteration
+          std::swap(cost_[i], result.cost);
+          std::swap(dynamics_[i], result.dynamics);
+          std::swap(stateInputEqConstraints_[i], result.stateInputEqConstraints);
+          std::swap(stateIneqConstraints_[i], result.stateIneqConstraints);
+          std::swap(stateInputIneqConstraints_[i], result.stateInputIneqConstraints);
+          std::swap(constraintsProjection_[i], result.constraintsProjection);
+          std::swap(projectedFreeInputs_[i], result.projectedFreeInputs);
+          std::swap(projectionMultiplierCoefficients_[i], result.projectionMultiplierCoefficients);
         }
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
       }
 
       i = timeIndex++;
@@ -348,82 +583,94 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
 
     if (i == N) {  // Only one worker will execute this
       const scalar_t tN = getIntervalStart(time[N]);
-      auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
-      metrics[i] = multiple_shooting::computeMetrics(result);
-      workerPerformance += multiple_shooting::computePerformanceIndex(result);
-      cost_[i] = std::move(result.cost);
+      auto& result = terminalTranscription_;
+      multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N], result);
+      multiple_shooting::computeMetrics(result, metrics[i]);
+      nodePerformance_[i] = multiple_shooting::computePerformanceIndex(result);
+      std::swap(cost_[i], result.cost);
       stateInputEqConstraints_[i].resize(0, x[i].size());
-      stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+      std::swap(stateIneqConstraints_[i], result.ineqConstraints);
     }
-
-    // Accumulate! Same worker might run multiple tasks
-    performance[workerId] += workerPerformance;
   };
-  runParallel(std::move(parallelTask));
+  runParallel(std::ref(parallelTask));
 
-  // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  // Sum performance of the nodes in a fixed order, such that the result does not depend on the thread scheduling
+  PerformanceIndex totalPerformance = std::accumulate(nodePerformance_.begin(), nodePerformance_.end(), PerformanceIndex());
 
-  // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
+  // Account for initial state in performance
+  metrics.front().dynamicsViolation += initState - x.front();
+  totalPerformance.dynamicsViolationSSE += (initState - x.front()).squaredNorm();
   totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
 
   return totalPerformance;
 }
 
-PerformanceIndex SqpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                               const vector_array_t& u, std::vector<Metrics>& metrics) {
+void SqpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, size_t numTrials) {
+  OCS2_TRACE_SCOPE("SqpSolver", "computePerformance");
+
   // Problem size
   const int N = static_cast<int>(time.size()) - 1;
-  metrics.resize(N + 1);
+  const int numTasks = static_cast<int>(numTrials) * (N + 1);
+  for (size_t k = 0; k < numTrials; k++) {
+    linesearchTrials_[k].metrics.resize(N + 1);
+    linesearchTrials_[k].nodePerformance.resize(N + 1);
+  }
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
+  std::atomic_int taskIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    int j = taskIndex++;
+    while (j < numTasks) {
+      // The nodes of a trial are consecutive tasks
+      auto& trial = linesearchTrials_[j / (N + 1)];
+      const auto& x = trial.x;
+      const auto& u = trial.u;
+      const int i = j % (N + 1);
+      OCS2_TRACE_SCOPE_INDEX("SqpSolver", "computeNodePerformance", i);
+
+      if (i == N) {
+        // Terminal node
+        const scalar_t tN = getIntervalStart(time[N]);
+        multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N], trial.metrics[N]);
+        trial.nodePerformance[N] = toPerformanceIndex(trial.metrics[N]);
+      } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += toPerformanceIndex(metrics[i]);
+        multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1], trial.metrics[i]);
+        trial.nodePerformance[i] = toPerformanceIndex(trial.metrics[i]);
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        performance[workerId] += toPerformanceIndex(metrics[i], dt);
+        multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i], trial.metrics[i]);
+        trial.nodePerformance[i] = toPerformanceIndex(trial.metrics[i], dt);
       }
 
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += toPerformanceIndex(metrics[N]);
+      j = taskIndex++;
     }
   };
-  runParallel(std::move(parallelTask));
+  runParallel(std::ref(parallelTask));
 
-  // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  for (size_t k = 0; k < numTrials; k++) {
+    auto& trial = linesearchTrials_[k];
 
-  // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
-  totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
-  return totalPerformance;
+    // Sum performance of the nodes in a fixed order, such that the result does not depend on the thread scheduling
+    PerformanceIndex totalPerformance = std::accumulate(trial.nodePerformance.begin(), trial.nodePerformance.end(), PerformanceIndex());
+
+    // Account for initial state in performance
+    trial.metrics.front().dynamicsViolation += initState - trial.x.front();
+    totalPerformance.dynamicsViolationSSE += (initState - trial.x.front()).squaredNorm();
+
+    totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
+    trial.performance = totalPerformance;
+  }
 }
 
 sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
                                   const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
                                   vector_array_t& u, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_SCOPE("SqpSolver", "takeStep");
   using StepType = FilterLinesearch::StepType;
 
   /*
@@ -445,60 +692,88 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
   const auto& du = subproblemSolution.deltaUSol;
   const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
   const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
+  auto isStepTooSmall = [&](scalar_t stepSize) {
+    return stepSize * deltaXnorm < settings_.deltaTol && stepSize * deltaUnorm < settings_.deltaTol;
+  };
 
   scalar_t alpha = 1.0;
-  vector_array_t xNew(x.size());
-  vector_array_t uNew(u.size());
-  std::vector<Metrics> metricsNew(metrics.size());
-  do {
+  bool terminate = false;
+  while (!terminate) {
+    // Collect the next step sizes of the backtracking, which are evaluated together
+    size_t numTrials = 0;
+    scalar_t trialAlpha = alpha;
+    do {
+      linesearchTrials_[numTrials++].alpha = trialAlpha;
+      trialAlpha *= settings_.alpha_decay;
+    } while (numTrials < linesearchTrials_.size() && !isStepTooSmall(trialAlpha) && trialAlpha >= settings_.alpha_min);
+
     // Compute step
-    multiple_shooting::incrementTrajectory(u, du, alpha, uNew);
-    multiple_shooting::incrementTrajectory(x, dx, alpha, xNew);
+    for (size_t k = 0; k < numTrials; k++) {
+      auto& trial = linesearchTrials_[k];
+      trial.x.resize(x.size());
+      trial.u.resize(u.size());
+      multiple_shooting::incrementTrajectory(u, du, trial.alpha, trial.u);
+      multiple_shooting::incrementTrajectory(x, dx, trial.alpha, trial.x);
+    }
 
     // Compute cost and constraints
-    const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew, metricsNew);
-
-    // Step acceptance and record step type
-    bool stepAccepted;
-    StepType stepType;
-    std::tie(stepAccepted, stepType) =
-        filterLinesearch_.acceptStep(baseline, performanceNew, alpha * subproblemSolution.armijoDescentMetric);
-
-    if (settings_.printLinesearch) {
-      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
-                << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
-      std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
-      std::cerr << performanceNew << "\n";
-    }
+    computePerformance(timeDiscretization, initState, numTrials);
+
+    // Check the trials in the order of the sequential backtracking
+    for (size_t k = 0; k < numTrials; k++) {
+      auto& trial = linesearchTrials_[k];
+      alpha = trial.alpha;
+      const PerformanceIndex& performanceNew = trial.performance;
+
+      // Step acceptance and record step type
+      bool stepAccepted;
+      StepType stepType;
+      std::tie(stepAccepted, stepType) =
+          filterLinesearch_.acceptStep(baseline, performanceNew, alpha * subproblemSolution.armijoDescentMetric);
+
+      if (settings_.printLinesearch) {
+        std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
+                  << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+        std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
+        std::cerr << performanceNew << "\n";
+      }
 
-    if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
-      metrics = std::move(metricsNew);
-
-      // Prepare step info
-      sqp::StepInfo stepInfo;
-      stepInfo.stepSize = alpha;
-      stepInfo.stepType = stepType;
-      stepInfo.dx_norm = alpha * deltaXnorm;
-      stepInfo.du_norm = alpha * deltaUnorm;
-      stepInfo.performanceAfterStep = performanceNew;
-      stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
-      return stepInfo;
-
-    } else {  // Try smaller step
-      alpha *= settings_.alpha_decay;
-
-      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
-      if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
-        if (settings_.printLinesearch) {
-          std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
-                    << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
+      if (stepAccepted) {  // Return if step accepted
+        // Swap, such that the workspace keeps the previous buffers for the next linesearch
+        x.swap(trial.x);
+        u.swap(trial.u);
+        metrics.swap(trial.metrics);
+
+        // Prepare step info
+        sqp::StepInfo stepInfo;
+        stepInfo.stepSize = alpha;
+        stepInfo.stepType = stepType;
+        stepInfo.dx_norm = alpha * deltaXnorm;
+        stepInfo.du_norm = alpha * deltaUnorm;
+        stepInfo.performanceAfterStep = performanceNew;
+        stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
+        return stepInfo;
+
+      } else {  // Try smaller step
+        alpha *= settings_.alpha_decay;
+
+        // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
+        if (isStepTooSmall(alpha)) {
+          if (settings_.printLinesearch) {
+            std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
+                      << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
+          }
+          terminate = true;
+          break;
+        }
+
+        if (alpha < settings_.alpha_min) {
+          terminate = true;
+          break;
         }
-        break;
       }
     }
-  } while (alpha >= settings_.alpha_min);
+  }
 
   // Alpha_min reached -> Don't take a step
   sqp::StepInfo stepInfo;
@@ -516,9 +791,10 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
   return stepInfo;
 }
 
-sqp::Convergence SqpSolver::checkConvergence(int iteration, const PerformanceIndex& baseline, const sqp::StepInfo& stepInfo) const {
+sqp::Convergence SqpSolver::checkConvergence(int iteration, size_t maxNumIterations, const PerformanceIndex& baseline,
+                                             const sqp::StepInfo& stepInfo) const {
   using Convergence = sqp::Convergence;
-  if ((iteration + 1) >= settings_.sqpIteration) {
+  if ((iteration + 1) >= maxNumIterations) {
     // Converged because the next iteration would exceed the specified number of iterations
     return Convergence::ITERATIONS;
   } else if (stepInfo.stepSize < settings_.alpha_min) {
@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_sqp/SqpSolver.h"
 
 #include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 
 #include <ocs2_oc/test/circular_kinematics.h>
 
@@ -141,3 +142,106 @@ TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
     ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
   }
 }
+
+TEST(test_circular_kinematics, solve_parallelLinesearchTrials) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  auto solve = [&](size_t linesearchTrials, size_t nThreads) {
+    ocs2::sqp::Settings settings;
+    settings.dt = 0.01;
+    settings.sqpIteration = 20;
+    settings.projectStateInputEqualityConstraints = true;
+    settings.linesearchTrials = linesearchTrials;
+    settings.nThreads = nThreads;
+
+    ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+    solver.run(startTime, initState, finalTime);
+    return std::make_pair(solver.primalSolution(finalTime), solver.getIterationsLog());
+  };
+
+  // The concurrent trials must not change the result of the sequential backtracking
+  const auto sequential = solve(1, 1);
+  const auto concurrent = solve(4, 3);
+
+  const auto& sequentialLog = sequential.second;
+  const auto& concurrentLog = concurrent.second;
+  ASSERT_EQ(sequentialLog.size(), concurrentLog.size());
+  for (int i = 0; i < sequentialLog.size(); i++) {
+    EXPECT_EQ(sequentialLog[i].merit, concurrentLog[i].merit);
+    EXPECT_EQ(sequentialLog[i].cost, concurrentLog[i].cost);
+    EXPECT_EQ(sequentialLog[i].dynamicsViolationSSE, concurrentLog[i].dynamicsViolationSSE);
+    EXPECT_EQ(sequentialLog[i].equalityConstraintsSSE, concurrentLog[i].equalityConstraintsSSE);
+  }
+
+  const auto& sequentialSolution = sequential.first;
+  const auto& concurrentSolution = concurrent.first;
+  ASSERT_EQ(sequentialSolution.stateTrajectory_.size(), concurrentSolution.stateTrajectory_.size());
+  for (int i = 0; i < sequentialSolution.stateTrajectory_.size(); i++) {
+    EXPECT_TRUE(sequentialSolution.stateTrajectory_[i] == concurrentSolution.stateTrajectory_[i]);
+    EXPECT_TRUE(sequentialSolution.inputTrajectory_[i] == concurrentSolution.inputTrajectory_[i]);
+  }
+}
+
+TEST(test_circular_kinematics, warmStartedMpcLoop) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useParallelRiccatiSolver = true;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  // Additional problem definitions
+  const ocs2::scalar_t timeHorizon = 1.0;
+  const ocs2::scalar_t mpcTimeStep = 0.05;
+  constexpr size_t numMpcSteps = 10;
+
+  // Receding horizon along the previous solution, either warm-started or solved from scratch
+  auto runMpcLoop = [&](bool isWarmStarted) {
+    ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+    ocs2::vector_t state = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+    std::vector<size_t> numIterations;
+    for (size_t i = 0; i < numMpcSteps; i++) {
+      const ocs2::scalar_t initTime = i * mpcTimeStep;
+      if (!isWarmStarted) {
+        solver.reset();
+      }
+      solver.run(initTime, state, initTime + timeHorizon);
+      numIterations.push_back(solver.getIterationsLog().size());
+      const auto primalSolution = solver.primalSolution(initTime + timeHorizon);
+      state = ocs2::LinearInterpolation::interpolate(initTime + mpcTimeStep, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+    }
+    return numIterations;
+  };
+
+  const auto coldStartIterations = runMpcLoop(false);
+  const auto warmStartIterations = runMpcLoop(true);
+
+  std::cerr << "[warmStartedMpcLoop] SQP iterations per MPC step\n";
+  for (size_t i = 0; i < numMpcSteps; i++) {
+    std::cerr << "  step " << i << ": cold " << coldStartIterations[i] << ", warm " << warmStartIterations[i] << "\n";
+  }
+
+  // The first run is cold in both loops, afterwards the shifted solution is a better initial guess
+  EXPECT_EQ(warmStartIterations.front(), coldStartIterations.front());
+  for (size_t i = 1; i < numMpcSteps; i++) {
+    EXPECT_LE(warmStartIterations[i], coldStartIterations[i]);
+  }
+}
@@ -29,10 +29,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include "ocs2_sqp/SqpMpc.h"
 #include "ocs2_sqp/SqpSolver.h"
 
 #include <ocs2_core/initialization/DefaultInitializer.h>
 
+#include <ocs2_mpc/MPC_MRT_Interface.h>
+
 #include <ocs2_oc/synchronized_module/ReferenceManager.h>
 #include <ocs2_oc/test/testProblemsGeneration.h>
 
@@ -160,3 +163,181 @@ TEST(test_unconstrained, noFeedback) {
         withEmptyConstraint.controllerPtr_->computeInput(t, x).isApprox(withNullConstraint.controllerPtr_->computeInput(t, x), tol));
   }
 }
+
+TEST(test_unconstrained, realTimeIteration) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr = ocs2::getOcs2Dynamics(dynamics);
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(costs));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(costs));
+
+  ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+  auto referenceManagerPtr = std::make_shared<ocs2::ReferenceManager>(targetTrajectories);
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+  ocs2::DefaultInitializer zeroInitializer(m);
+
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = 10;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  const ocs2::scalar_t timeHorizon = 1.0;
+  const ocs2::scalar_t nextTime = 0.1;
+  const ocs2::vector_t nextState = ocs2::vector_t::Random(n);
+
+  // Regular solve at the next time
+  ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+  solver.setReferenceManager(referenceManagerPtr);
+  solver.run(nextTime, nextState, nextTime + timeHorizon);
+  const auto solution = solver.primalSolution(nextTime + timeHorizon);
+
+  // Real-time iteration: prepare the next problem with the previous solution, then embed the measured state
+  ocs2::SqpSolver rtiSolver(settings, problem, zeroInitializer);
+  rtiSolver.setReferenceManager(referenceManagerPtr);
+  rtiSolver.run(0.0, ocs2::vector_t::Ones(n), timeHorizon);
+  ASSERT_TRUE(rtiSolver.prepare(nextTime, nextTime + timeHorizon));
+  rtiSolver.run(nextTime, nextState, nextTime + timeHorizon);
+  const auto rtiSolution = rtiSolver.primalSolution(nextTime + timeHorizon);
+
+  // A single feedback step solves the linear quadratic problem
+  ASSERT_EQ(rtiSolver.getIterationsLog().size(), 1);
+  ASSERT_EQ(rtiSolution.timeTrajectory_.size(), solution.timeTrajectory_.size());
+  for (int i = 0; i < solution.timeTrajectory_.size(); i++) {
+    ASSERT_DOUBLE_EQ(rtiSolution.timeTrajectory_[i], solution.timeTrajectory_[i]);
+    ASSERT_TRUE(rtiSolution.stateTrajectory_[i].isApprox(solution.stateTrajectory_[i], tol));
+    ASSERT_TRUE(rtiSolution.inputTrajectory_[i].isApprox(solution.inputTrajectory_[i], tol));
+  }
+}
+
+TEST(test_unconstrained, realTimeIterationWithChangedReferences) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr = ocs2::getOcs2Dynamics(dynamics);
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(costs));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(costs));
+
+  const ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+  const ocs2::TargetTrajectories newTargetTrajectories({0.0}, {-ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Zero(m)});
+  auto referenceManagerPtr = std::make_shared<ocs2::ReferenceManager>(targetTrajectories);
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+  ocs2::DefaultInitializer zeroInitializer(m);
+
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = 10;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  const ocs2::scalar_t timeHorizon = 1.0;
+  const ocs2::scalar_t nextTime = 0.1;
+  const ocs2::vector_t nextState = ocs2::vector_t::Random(n);
+
+  // Regular solve, the solutions after a discarded preparation have to match it
+  auto solveRegular = [&](const ocs2::TargetTrajectories& target, ocs2::scalar_t finalTime) {
+    referenceManagerPtr->setTargetTrajectories(target);
+    ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+    solver.setReferenceManager(referenceManagerPtr);
+    solver.run(nextTime, nextState, finalTime);
+    return solver.primalSolution(finalTime);
+  };
+
+  // Prepares a real-time iteration with the original references, then runs with the given ones
+  auto solvePrepared = [&](const ocs2::TargetTrajectories& target, ocs2::scalar_t finalTime) {
+    referenceManagerPtr->setTargetTrajectories(targetTrajectories);
+    ocs2::SqpSolver rtiSolver(settings, problem, zeroInitializer);
+    rtiSolver.setReferenceManager(referenceManagerPtr);
+    rtiSolver.run(0.0, ocs2::vector_t::Ones(n), timeHorizon);
+    EXPECT_TRUE(rtiSolver.prepare(nextTime, nextTime + timeHorizon));
+    referenceManagerPtr->setTargetTrajectories(target);
+    rtiSolver.run(nextTime, nextState, finalTime);
+    return rtiSolver.primalSolution(finalTime);
+  };
+
+  auto expectEqualSolutions = [&](const ocs2::PrimalSolution& lhs, const ocs2::PrimalSolution& rhs) {
+    ASSERT_EQ(lhs.timeTrajectory_.size(), rhs.timeTrajectory_.size());
+    for (int i = 0; i < lhs.timeTrajectory_.size(); i++) {
+      EXPECT_DOUBLE_EQ(lhs.timeTrajectory_[i], rhs.timeTrajectory_[i]);
+      EXPECT_TRUE(lhs.stateTrajectory_[i].isApprox(rhs.stateTrajectory_[i], tol));
+      EXPECT_TRUE(lhs.inputTrajectory_[i].isApprox(rhs.inputTrajectory_[i], tol));
+    }
+  };
+
+  // The target trajectories changed after the preparation
+  expectEqualSolutions(solvePrepared(newTargetTrajectories, nextTime + timeHorizon),
+                       solveRegular(newTargetTrajectories, nextTime + timeHorizon));
+
+  // The final time changed after the preparation
+  const ocs2::scalar_t longerFinalTime = nextTime + timeHorizon + 0.2;
+  expectEqualSolutions(solvePrepared(targetTrajectories, longerFinalTime), solveRegular(targetTrajectories, longerFinalTime));
+}
+
+TEST(test_unconstrained, realTimeIterationThroughMpcMrtInterface) {
+  int n = 3;
+  int m = 2;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+
+  ocs2::OptimalControlProblem problem;
+  problem.dynamicsPtr = ocs2::getOcs2Dynamics(dynamics);
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(costs));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(costs));
+
+  ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+  auto referenceManagerPtr = std::make_shared<ocs2::ReferenceManager>(targetTrajectories);
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+  ocs2::DefaultInitializer zeroInitializer(m);
+
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = 10;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+
+  ocs2::mpc::Settings mpcSettings;
+  mpcSettings.timeHorizon_ = 1.0;
+
+  ocs2::SqpMpc mpc(mpcSettings, settings, problem, zeroInitializer);
+  mpc.getSolverPtr()->setReferenceManager(referenceManagerPtr);
+  ocs2::MPC_MRT_Interface mpcMrtInterface(mpc);
+
+  // Regular MPC iteration
+  ocs2::SystemObservation observation;
+  observation.time = 0.0;
+  observation.state = ocs2::vector_t::Ones(n);
+  observation.input = ocs2::vector_t::Zero(m);
+  mpcMrtInterface.setCurrentObservation(observation);
+  mpcMrtInterface.advanceMpc();
+
+  // Prepare the next iteration. The observation arrives later than expected, i.e., the final time of the MPC run moves with it.
+  const ocs2::scalar_t nextTime = 0.1;
+  ASSERT_TRUE(mpcMrtInterface.prepareMpc(nextTime));
+  observation.time = nextTime + 0.5 * settings.dt;
+  observation.state = ocs2::vector_t::Random(n);
+  mpcMrtInterface.setCurrentObservation(observation);
+  mpcMrtInterface.advanceMpc();
+
+  // The feedback phase took a single step on the prepared time discretization
+  ASSERT_EQ(mpc.getSolverPtr()->getIterationsLog().size(), 1);
+  ASSERT_TRUE(mpcMrtInterface.updatePolicy());
+  const auto& policy = mpcMrtInterface.getPolicy();
+  EXPECT_DOUBLE_EQ(policy.timeTrajectory_.front(), nextTime);
+  EXPECT_DOUBLE_EQ(policy.timeTrajectory_.back(), nextTime + mpcSettings.timeHorizon_);
+  EXPECT_TRUE(policy.stateTrajectory_.front().isApprox(observation.state));
+}
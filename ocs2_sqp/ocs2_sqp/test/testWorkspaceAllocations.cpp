@@ -0,0 +1,146 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_sqp/SqpSolver.h"
+
+#include <ocs2_core/cost/QuadraticStateCost.h>
+#include <ocs2_core/test/AllocationCounter.h>
+
+#include <ocs2_oc/test/AllocationPausedCost.h>
+#include <ocs2_oc/test/DoubleIntegratorReachingTask.h>
+
+OCS2_DEFINE_ALLOCATION_COUNTER
+
+using namespace ocs2;
+
+/*
+ * Scope of these tests: the SQP iterations, i.e. the setup of the LQ approximation, the QP solve and the line search, reuse the workspace
+ * of the solver and do not allocate. This requires:
+ *  - models which evaluate in place. The linear dynamics do, the cost terms return their approximation by value and are therefore left
+ *    out of the count (test::AllocationPausedCost). Models based on Pinocchio or CppAD, e.g. those of the legged robot, are not covered.
+ *  - the parallel Riccati solver. The HPIPM interface is not covered.
+ *  - the work-stealing thread pool. The default thread pool allocates a future per parallel task.
+ *
+ * Each call of run() still allocates its bookkeeping, which scales with the number of nodes but not with the number of iterations:
+ * the time discretization, the initial guess of the state and input trajectories, the metrics of the nodes, the primal solution with its
+ * feedback policy and the problem metrics.
+ */
+
+namespace {
+
+class SqpWorkspaceAllocations : public DoubleIntegratorReachingTask, public testing::TestWithParam<size_t> {
+ protected:
+  SqpWorkspaceAllocations() {
+    // The dynamics are linear, the discretization and its sensitivities are evaluated in place
+    problem_.dynamicsPtr = getDynamicsPtr();
+    problem_.costPtr->add("cost", std::make_unique<test::AllocationPausedCost>(getCostPtr()));
+    problem_.finalCostPtr->add("finalCost", std::make_unique<test::AllocationPausedStateCost>(
+                                                std::make_unique<QuadraticStateCost>(matrix_t::Identity(STATE_DIM, STATE_DIM))));
+
+    referenceManagerPtr_ = std::make_shared<ReferenceManager>(TargetTrajectories({tGoal}, {xGoal}, {vector_t::Zero(INPUT_DIM)}));
+    problem_.targetTrajectoriesPtr = &referenceManagerPtr_->getTargetTrajectories();
+  }
+
+  sqp::Settings getSettings(size_t sqpIteration) const {
+    sqp::Settings settings;
+    settings.dt = 0.05;
+    settings.sqpIteration = sqpIteration;
+    settings.nThreads = GetParam();
+    settings.threadPoolWorkStealing = true;
+    settings.useParallelRiccatiSolver = true;
+    settings.printSolverStatistics = false;
+    settings.printSolverStatus = false;
+    settings.printLinesearch = false;
+    return settings;
+  }
+
+  /** Number of allocations of a cold-started run() with the given number of SQP iterations, after warming up the solver. */
+  size_t countRunAllocations(size_t sqpIteration) {
+    SqpSolver solver(getSettings(sqpIteration), problem_, *getInitializer());
+    solver.setReferenceManager(referenceManagerPtr_);
+
+    constexpr size_t numWarmUpRuns = 3;
+    for (size_t i = 0; i < numWarmUpRuns; i++) {
+      solver.reset();
+      solver.run(0.0, xInit, tGoal);
+    }
+
+    solver.reset();
+    test::ScopedAllocationCounter allocationCounter;
+    solver.run(0.0, xInit, tGoal);
+    const size_t numAllocations = allocationCounter.count();
+
+    numIterations_ = solver.getIterationsLog().size();
+    return numAllocations;
+  }
+
+  OptimalControlProblem problem_;
+  std::shared_ptr<ReferenceManager> referenceManagerPtr_;
+  size_t numIterations_ = 0;
+};
+
+}  // unnamed namespace
+
+TEST_P(SqpWorkspaceAllocations, noAllocationsPerIteration) {
+  // A run with more iterations does not allocate more, i.e. the second iteration does not allocate at all
+  const size_t oneIterationAllocations = countRunAllocations(1);
+  ASSERT_EQ(numIterations_, 1);
+  const size_t twoIterationsAllocations = countRunAllocations(2);
+  ASSERT_EQ(numIterations_, 2);
+
+  EXPECT_EQ(twoIterationsAllocations, oneIterationAllocations);
+}
+
+TEST_P(SqpWorkspaceAllocations, constantAllocationsPerMpcRun) {
+  // Warm-started runs on a receding horizon, as in an MPC loop
+  SqpSolver solver(getSettings(10), problem_, *getInitializer());
+  solver.setReferenceManager(referenceManagerPtr_);
+
+  constexpr scalar_t mpcTimeStep = 0.01;
+  constexpr size_t numWarmUpRuns = 3;
+  constexpr size_t numRuns = 10;
+  std::vector<size_t> runAllocations;
+  for (size_t i = 0; i < numWarmUpRuns + numRuns; i++) {
+    const scalar_t initTime = i * mpcTimeStep;
+    test::ScopedAllocationCounter allocationCounter;
+    solver.run(initTime, xInit, initTime + tGoal);
+    if (i >= numWarmUpRuns) {
+      runAllocations.push_back(allocationCounter.count());
+    }
+  }
+
+  // The workspace does not grow in steady state, only the bookkeeping of run() allocates
+  for (size_t i = 1; i < runAllocations.size(); i++) {
+    EXPECT_EQ(runAllocations[i], runAllocations.front()) << "run " << i;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(NumThreads, SqpWorkspaceAllocations, testing::Values(1, 3));